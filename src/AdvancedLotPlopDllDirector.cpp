@@ -54,6 +54,8 @@
 #include "lots/LotFilterer.h"
 #include "props/PropPainterControlManager.h"
 #include "props/PropPainterUI.h"
+#include "s3d/FSHTextureCache.h"
+#include "s3d/S3DThumbnailGenerator.h"
 #include "s3d/S3DRenderer.h"
 #include "utils/Config.h"
 #include "utils/D3D11Hook.h"
@@ -80,6 +82,9 @@ static constexpr uint32_t kKeyConfigType = 0xA2E3D533;
 static constexpr uint32_t kKeyConfigGroup = 0x8F1E6D69;
 static constexpr uint32_t kKeyConfigInstance = 0x5CBCFBF8;
 
+// Per-frame time spent loading lot icons for the visible rows
+static constexpr double kIconLoadBudgetMs = 2.0;
+
 AdvancedLotPlopDllDirector *GetLotPlopDirector();
 
 class AdvancedLotPlopDllDirector final : public cRZMessage2COMDirector {
@@ -108,8 +113,11 @@ public:
         lotPlopCb.OnPlop = [](uint32_t lotID) { if (GetLotPlopDirector()) GetLotPlopDirector()->TriggerLotPlop(lotID); };
         lotPlopCb.OnBuildCache = []() { if (GetLotPlopDirector()) GetLotPlopDirector()->BuildCache(); };
         lotPlopCb.OnRefreshList = []() { if (GetLotPlopDirector()) GetLotPlopDirector()->RefreshLotList(); };
+        lotPlopCb.OnRequestIcons = [](const std::vector<LotHandle>& handles) {
+            if (GetLotPlopDirector()) GetLotPlopDirector()->lotCacheManager.RequestIcons(handles);
+        };
         mLotPlopUI.SetCallbacks(lotPlopCb);
-        mLotPlopUI.SetLotEntries(&lotEntries);
+        mLotPlopUI.SetLotCache(&lotCacheManager);
 
         // Wire prop painter UI callbacks
         PropPainterUICallbacks propPaintCb{};
@@ -131,6 +139,8 @@ public:
 
         lotCacheManager.Clear();
         propCacheManager.Clear();
+        S3D::ThumbnailGenerator::Shutdown();
+        FSH::TextureCache::Clear();
 
         imGuiLifecycle.Shutdown();
         D3D11Hook::Shutdown();
@@ -263,13 +273,15 @@ public:
         pView3D = nullptr;
     }
 
-    void Update() {
+    void Update(ID3D11Device* pDevice) {
         // Update lot cache build if in progress
         if (lotCacheBuildOrchestrator.IsBuilding()) {
+            bool wasInitialized = lotCacheManager.IsInitialized();
             bool stillBuilding = lotCacheBuildOrchestrator.Update();
 
-            // If build just completed, refresh the lot list
-            if (!stillBuilding) {
+            // Refresh as soon as entries are available (snapshot restore), and again
+            // when the build completes so late-loaded icons are picked up
+            if (!stillBuilding || (!wasInitialized && lotCacheManager.IsInitialized())) {
                 RefreshLotList();
             }
         }
@@ -278,6 +290,12 @@ public:
         if (propCacheBuildOrchestrator.IsBuilding()) {
             propCacheBuildOrchestrator.Update();
         }
+
+        // Load icons for the lot rows on screen (requested by the UI last frame)
+        if (lotCacheManager.IsInitialized() && pDevice) {
+            cIGZPersistResourceManagerPtr pRM;
+            lotCacheManager.ProcessIconRequests(pRM, pDevice, kIconLoadBudgetMs);
+        }
     }
 
     void RenderUI() {
@@ -285,6 +303,9 @@ public:
         if (pShow && *pShow) {
             // Delegate to UI class
             mLotPlopUI.Render();
+        } else {
+            // No rows are drawn, so last frame's icon request is stale
+            lotCacheManager.CancelIconRequests();
         }
 
         // Render prop painter window independently
@@ -324,8 +345,9 @@ private:
     // Prop painter control manager
     PropPainterControlManager propPainterControlManager;
 
-    // Filtered lot list (populated by RefreshLotList)
-    std::vector<LotConfigEntry> lotEntries;
+    // Filtered lots as handles into lotCacheManager (populated by RefreshLotList)
+    std::vector<LotHandle> lotHandles;
+    LotFilterer lotFilterer; // Keeps the last result to narrow it as the search is typed
 
     void BuildCache() {
         lotCacheBuildOrchestrator.StartBuildCache(pCity);
@@ -338,17 +360,15 @@ private:
             return; // Defer filtering until the cache is ready
         }
 
-        LotFilterer::FilterLots(
-            pCity,
-            lotCacheManager.GetLotConfigCache(),
-            lotEntries,
-            mLotPlopUI.GetFilterZoneType(),
-            mLotPlopUI.GetFilterWealthType(),
-            mLotPlopUI.GetMinSizeX(), mLotPlopUI.GetMaxSizeX(),
-            mLotPlopUI.GetMinSizeZ(), mLotPlopUI.GetMaxSizeZ(),
-            mLotPlopUI.GetSearchBuffer(),
-            mLotPlopUI.GetSelectedOccupantGroups()
+        lotFilterer.FilterLots(
+            lotCacheManager.GetCatalog(),
+            lotCacheManager.GetSearchIndex(),
+            lotHandles,
+            mLotPlopUI.BuildQuery()
         );
+        LOG_TRACE("Filtered {} of {} lots: {}", lotHandles.size(),
+                  lotCacheManager.GetCatalog().GetCount(), lotFilterer.DescribeLastPlan());
+        mLotPlopUI.SetLotHandles(&lotHandles);
     }
 
     void ToggleWindow() {
@@ -497,7 +517,7 @@ private:
         pDirector->imGuiLifecycle.BeginFrame();
 
         // Business logic and UI rendering
-        pDirector->Update();
+        pDirector->Update(pDevice);
         pDirector->RenderUI();
 
         // End ImGui frame
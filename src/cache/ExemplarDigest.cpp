@@ -0,0 +1,207 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ExemplarDigest.h"
+
+#include <algorithm>
+
+#include "cGZPersistResourceKey.h"
+#include "cIGZPersistResourceKeyList.h"
+#include "cIGZPersistResourceManager.h"
+#include "cISCPropertyHolder.h"
+#include "cRZAutoRefCount.h"
+#include "cRZBaseString.h"
+#include "SCPropertyUtil.h"
+#include "StringResourceKey.h"
+#include "StringResourceManager.h"
+#include "../exemplar/ExemplarUtil.h"
+#include "../exemplar/IconResourceUtil.h"
+#include "../exemplar/PropertyUtil.h"
+#include "../utils/Logger.h"
+
+namespace {
+    constexpr uint32_t kExemplarType = 0x6534284A;
+    constexpr uint32_t kPropertyExemplarType = 0x00000010;
+    constexpr uint32_t kItemNameProperty = 0x899AFBAD;
+    constexpr uint32_t kUserVisibleNameKeyProperty = 0x8A416A99;
+    constexpr uint32_t kOccupantGroupProperty = 0xAA1DD396;
+
+    // Same order as ThumbnailGenerator::ReadModelRecord: RKT1, RKT0, RKT2, RKT3, RKT5
+    constexpr uint32_t kResourceKeyTypes[] = {0x27812821, 0x27812820, 0x27812822, 0x27812823, 0x27812825};
+} // namespace
+
+void ExemplarDigest::Build(cIGZPersistResourceManager* pRM) {
+    Clear();
+    if (!pRM) return;
+
+    cRZAutoRefCount<cIGZPersistResourceKeyList> pKeyList;
+    uint32_t totalCount = pRM->GetAvailableResourceList(pKeyList.AsPPObj(), nullptr);
+
+    if (totalCount == 0 || !pKeyList) {
+        LOG_WARN("Failed to enumerate resources for exemplar digest");
+        return;
+    }
+
+    LOG_INFO("Digesting exemplars from {} resources...", totalCount);
+
+    uint32_t exemplarCount = 0;
+    uint32_t keyListSize = pKeyList->Size();
+    for (uint32_t i = 0; i < keyListSize; i++) {
+        cGZPersistResourceKey key = pKeyList->GetKey(i);
+        if (key.type != kExemplarType) continue;
+
+        // Released at the end of the iteration; only the digest record outlives it
+        cRZAutoRefCount<cISCPropertyHolder> exemplar;
+        if (!pRM->GetResource(key, GZIID_cISCPropertyHolder, exemplar.AsPPVoid(), 0, nullptr)) continue;
+        exemplarCount++;
+
+        uint32_t exemplarType = 0;
+        if (!GetPropertyUint32(exemplar, kPropertyExemplarType, exemplarType)) continue;
+        if (exemplarType != kExemplarTypeBuilding && exemplarType != kExemplarTypeLotConfiguration) continue;
+
+        AddRecord(key.instance, key.group, exemplarType, exemplar);
+    }
+
+    // Stable, so Find still returns the first exemplar the resource manager listed
+    std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.instance < b.instance;
+    });
+    records.shrink_to_fit();
+    occupantGroups.shrink_to_fit();
+    strings.shrink_to_fit();
+
+    LOG_INFO("Exemplar digest built: {} of {} exemplars kept, {} KB",
+             records.size(), exemplarCount, GetMemoryUsage() / 1024);
+}
+
+void ExemplarDigest::AddRecord(uint32_t instance, uint32_t group, uint32_t exemplarType, cISCPropertyHolder* pExemplar) {
+    Record record{};
+    record.instance = instance;
+    record.group = group;
+    record.exemplarType = exemplarType;
+
+    if (exemplarType == kExemplarTypeLotConfiguration) {
+        GetLotBuildingExemplarID(pExemplar, record.buildingExemplarID);
+        records.push_back(record);
+        return;
+    }
+
+    ExemplarUtil::GetItemIconInstance(pExemplar, record.itemIcon);
+
+    // Display name sources; the localized string is looked up later, only for buildings in use
+    cRZBaseString name;
+    if (SCPropertyUtil::GetPropertyValue(pExemplar, kItemNameProperty, name)) {
+        AppendName(record, name);
+        record.flags |= kHasItemName;
+    }
+    else {
+        const uint32_t* pKey = nullptr;
+        uint32_t keyCount = 0;
+        if (GetPropertyUint32Array(pExemplar, kUserVisibleNameKeyProperty, pKey, keyCount) && pKey && keyCount == 3) {
+            record.nameKeyGroup = pKey[1];
+            record.nameKeyInstance = pKey[2];
+            record.flags |= kHasNameKey;
+        }
+        if (PropertyUtil::GetExemplarName(pExemplar, name)) {
+            AppendName(record, name);
+            record.flags |= kHasExemplarName;
+        }
+    }
+
+    const uint32_t* pGroups = nullptr;
+    uint32_t groupCount = 0;
+    if (GetPropertyUint32Array(pExemplar, kOccupantGroupProperty, pGroups, groupCount) && pGroups && groupCount > 0) {
+        record.groupsOffset = static_cast<uint32_t>(occupantGroups.size());
+        record.groupsCount = groupCount;
+        occupantGroups.insert(occupantGroups.end(), pGroups, pGroups + groupCount);
+    }
+
+    for (uint32_t rktProperty : kResourceKeyTypes) {
+        const uint32_t* pRkt = nullptr;
+        uint32_t rktCount = 0;
+        if (GetPropertyUint32Array(pExemplar, rktProperty, pRkt, rktCount) && pRkt && rktCount >= 3) {
+            record.modelType = pRkt[0];
+            record.modelGroup = pRkt[1];
+            record.modelInstance = pRkt[2];
+            record.flags |= kHasModel;
+            break;
+        }
+    }
+
+    records.push_back(record);
+}
+
+void ExemplarDigest::AppendName(Record& record, const cIGZString& name) {
+    record.nameOffset = static_cast<uint32_t>(strings.size());
+    record.nameLength = name.Strlen();
+    strings.insert(strings.end(), name.Data(), name.Data() + record.nameLength);
+}
+
+void ExemplarDigest::Clear() {
+    records = std::vector<Record>();
+    occupantGroups = std::vector<uint32_t>();
+    strings = std::vector<char>();
+}
+
+size_t ExemplarDigest::GetMemoryUsage() const {
+    return records.capacity() * sizeof(Record)
+         + occupantGroups.capacity() * sizeof(uint32_t)
+         + strings.capacity();
+}
+
+const ExemplarDigest::Record* ExemplarDigest::Find(uint32_t instance, uint32_t exemplarType) const {
+    auto it = std::lower_bound(records.begin(), records.end(), instance, [](const Record& record, uint32_t value) {
+        return record.instance < value;
+    });
+    for (; it != records.end() && it->instance == instance; ++it) {
+        if (it->exemplarType == exemplarType) return &*it;
+    }
+    return nullptr;
+}
+
+std::string_view ExemplarDigest::GetName(const Record& record) const {
+    if (!(record.flags & (kHasItemName | kHasExemplarName))) return {};
+    return std::string_view(strings.data() + record.nameOffset, record.nameLength);
+}
+
+const uint32_t* ExemplarDigest::GetOccupantGroups(const Record& record) const {
+    return record.groupsCount > 0 ? occupantGroups.data() + record.groupsOffset : nullptr;
+}
+
+bool ExemplarDigest::ResolveDisplayName(const Record& record, std::string& outName) const {
+    if (!(record.flags & kHasItemName) && (record.flags & kHasNameKey)) {
+        StringResourceKey key;
+        key.groupID = record.nameKeyGroup;
+        key.instanceID = record.nameKeyInstance;
+
+        cRZAutoRefCount<cIGZString> localized;
+        if (StringResourceManager::GetLocalizedString(key, localized) && localized) {
+            outName.assign(localized->Data(), localized->Strlen());
+            return true;
+        }
+    }
+
+    const std::string_view name = GetName(record);
+    if (record.flags & (kHasItemName | kHasExemplarName)) {
+        outName.assign(name.data(), name.size());
+        return true;
+    }
+    return false;
+}
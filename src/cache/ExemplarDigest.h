@@ -0,0 +1,94 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cIGZString.h"
+
+class cIGZPersistResourceManager;
+class cISCPropertyHolder;
+
+/**
+ * @brief Flat digest of the exemplar properties the lot cache is built from
+ *
+ * Built in one pass over the resource list: each exemplar is loaded, the handful of
+ * properties the lot cache needs are copied into a fixed-size record, and the exemplar
+ * is released straight away. Only lot configuration and building exemplars are kept.
+ *
+ * Layout (offsets index the shared arrays, so records stay trivially copyable):
+ *   Record records[]               sorted by instance, then by load order
+ *   uint32_t occupantGroups[]
+ *   char strings[]
+ */
+class ExemplarDigest {
+public:
+    static constexpr uint32_t kExemplarTypeBuilding = 0x02;
+    static constexpr uint32_t kExemplarTypeLotConfiguration = 0x10;
+
+    enum RecordFlags : uint8_t {
+        kHasItemName = 1 << 0,      // name is the Item Name string
+        kHasExemplarName = 1 << 1,  // name is the Exemplar Name (fallback after the name key)
+        kHasNameKey = 1 << 2,       // nameKeyGroup/nameKeyInstance hold a User Visible Name Key
+        kHasModel = 1 << 3          // modelType/Group/Instance hold the first RKT key found
+    };
+
+    struct Record {
+        uint32_t instance;
+        uint32_t group;
+        uint32_t exemplarType;
+        uint32_t buildingExemplarID;    // Lot configurations: first building in the lot objects
+        uint32_t itemIcon;              // Buildings: PNG menu icon instance
+        uint32_t nameKeyGroup, nameKeyInstance;
+        uint32_t nameOffset, nameLength;
+        uint32_t groupsOffset, groupsCount;
+        uint32_t modelType, modelGroup, modelInstance;
+        uint8_t flags;
+    };
+
+    // Loads every exemplar once and keeps only the digest; replaces any previous contents
+    void Build(cIGZPersistResourceManager* pRM);
+    void Clear();
+
+    bool IsEmpty() const { return records.empty(); }
+    size_t GetRecordCount() const { return records.size(); }
+    size_t GetMemoryUsage() const;
+
+    // First record (in load order) with this instance and exemplar type, or nullptr
+    const Record* Find(uint32_t instance, uint32_t exemplarType) const;
+
+    std::string_view GetName(const Record& record) const;
+    const uint32_t* GetOccupantGroups(const Record& record) const;
+
+    // Item Name, then the localized User Visible Name, then the Exemplar Name
+    // (the same order as PropertyUtil::GetDisplayName)
+    bool ResolveDisplayName(const Record& record, std::string& outName) const;
+
+private:
+    void AddRecord(uint32_t instance, uint32_t group, uint32_t exemplarType, cISCPropertyHolder* pExemplar);
+    void AppendName(Record& record, const cIGZString& name);
+
+    std::vector<Record> records;
+    std::vector<uint32_t> occupantGroups;
+    std::vector<char> strings;
+};
@@ -27,6 +27,7 @@
 #include "GZServPtrs.h"
 #include "LotCacheManager.h"
 #include "../lots/AdvancedLotPlopUI.h"
+#include "../s3d/FSHTextureCache.h"
 #include "../utils/Logger.h"
 
 LotCacheBuildOrchestrator::LotCacheBuildOrchestrator(
@@ -88,26 +89,34 @@ bool LotCacheBuildOrchestrator::Update() {
 
     switch (phase) {
         case Phase::BuildingExemplarCache: {
-            // Build exemplar cache synchronously (fast operation: 1-2 frames)
-            LOG_INFO("Building exemplar cache...");
+            // Digest exemplars synchronously (each exemplar is released as soon as it's read)
+            LOG_INFO("Building exemplar digest...");
             cIGZPersistResourceManagerPtr pRM;
 
             cacheManager.BeginIncrementalBuild();
-            cacheManager.BuildExemplarCacheSync(pRM);
+
+            // Unchanged plugin set: restore entries from disk (icons load lazily as rows become visible)
+            if (cacheManager.TryLoadSnapshot(pRM)) {
+                phase = Phase::Complete;
+                LOG_INFO("Lot cache restored from snapshot");
+                return true; // Still building
+            }
+
+            cacheManager.BuildExemplarDigestSync(pRM);
 
             // Move to next phase
             phase = Phase::BuildingLotConfigCache;
             cacheManager.BeginLotConfigProcessing(pCity);
-            LOG_INFO("Exemplar cache complete, starting lot config processing");
+            LOG_INFO("Exemplar digest complete, starting lot config processing");
 
             return true; // Still building
         }
 
         case Phase::BuildingLotConfigCache: {
-            // Process lots incrementally (20 per frame)
+            // Process lots incrementally (metadata only; icons load lazily as rows become visible)
             cIGZPersistResourceManagerPtr pRM;
 
-            int processed = cacheManager.ProcessLotConfigBatch(pRM, pDevice, LOTS_PER_FRAME);
+            int processed = cacheManager.ProcessLotConfigBatch(pRM, LOTS_PER_FRAME);
 
             // Update progress in UI
             int current = cacheManager.GetProcessedLotCount();
@@ -127,6 +136,7 @@ bool LotCacheBuildOrchestrator::Update() {
             // Finalize cache build
             cacheManager.FinalizeIncrementalBuild();
             LOG_INFO("Incremental cache build completed");
+            FSH::TextureCache::LogStats();
 
             // Hide loading UI
             ui.ShowLoadingWindow(false);
@@ -32,10 +32,13 @@ struct ID3D11DeviceContext;
  * @brief Orchestrates incremental lot cache building with UI feedback
  *
  * Manages the state machine for building the lot cache:
- * 1. BuildingExemplarCache - Fast synchronous phase (1-2 frames)
- * 2. BuildingLotConfigCache - Incremental processing (20 lots/frame)
+ * 1. BuildingExemplarCache - Fast synchronous phase (1-2 frames), or a snapshot restore
+ * 2. BuildingLotConfigCache - Incremental processing (LOTS_PER_FRAME lots/frame), metadata only
  * 3. Complete - Finalization
  *
+ * Icons aren't part of the build: the lot list requests them for the rows it shows
+ * (LotCacheManager::RequestIcons).
+ *
  * Call StartBuildCache() to begin, then Update() every frame until IsBuilding() returns false.
  */
 class LotCacheBuildOrchestrator : public CacheBuildOrchestratorBase {
@@ -93,5 +96,5 @@ private:
     ID3D11Device* pDevice;
     ID3D11DeviceContext* pContext;
 
-    static constexpr int LOTS_PER_FRAME = 20;
+    static constexpr int LOTS_PER_FRAME = 200;  // No icon work during the build, so batches can be large
 };
\ No newline at end of file
@@ -22,22 +22,21 @@
 #include <d3d11.h>
 #include <cache/LotCacheManager.h>
 
+#include <algorithm>
+#include <chrono>
+
 #include "cGZPersistResourceKey.h"
-#include "cIGZPersistResourceKeyList.h"
 #include "cIGZPersistResourceManager.h"
-#include "cIGZVariant.h"
 #include "cISC4City.h"
 #include "cISC4LotConfiguration.h"
 #include "cISC4LotConfigurationManager.h"
-#include "cISCProperty.h"
 #include "cRZBaseString.h"
 #include "GZServPtrs.h"
 #include "SC4HashSet.h"
-#include "../exemplar/ExemplarUtil.h"
-#include "../exemplar/IconResourceUtil.h"
-#include "../exemplar/PropertyUtil.h"
+#include "LotCacheSnapshot.h"
 #include "../gfx/IconLoader.h"
-#include "../s3d/S3DThumbnailGenerator.h"
+#include "../lots/LotFilterer.h"
+#include "../s3d/S3DThumbnailPipeline.h"
 #include "../utils/Logger.h"
 
 LotCacheManager::LotCacheManager()
@@ -45,7 +44,9 @@ LotCacheManager::LotCacheManager()
       currentLotSizeIndex(0),
       processedLotCount(0),
       totalLotCount(0),
-      pCityForIncremental(nullptr) {
+      pCityForIncremental(nullptr),
+      loadedFromSnapshot(false),
+      snapshotFingerprint(0) {
 }
 
 LotCacheManager::~LotCacheManager() {
@@ -53,78 +54,41 @@ LotCacheManager::~LotCacheManager() {
 }
 
 void LotCacheManager::Clear() {
-    // Release all icon SRVs (PNG or S3D)
-    for (auto& kv : lotConfigCache) {
-        auto& entry = kv.second;
-        if (entry.iconSRV) {
-            entry.iconSRV->Release();
-            entry.iconSRV = nullptr;
-        }
-        entry.iconType = LotConfigEntry::IconType::None;
-    }
-
-    lotConfigCache.clear();
-    exemplarCache.clear();
+    CancelThumbnails();
+
+    // Release all icons (PNG or S3D)
+    ClearEntries();
+    iconAtlas.Clear();
+    searchIndex.Clear();
+    exemplarDigest.Clear();
+    iconRequests.clear();
     cacheInitialized = false;
 }
 
-void LotCacheManager::BuildCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, LotCacheProgressCallback progressCallback) {
+void LotCacheManager::BuildCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, LotCacheProgressCallback progressCallback) {
     if (cacheInitialized) return;
 
     LOG_INFO("Building lot cache...");
     BuildExemplarCache(pRM, progressCallback);
-    BuildLotConfigCache(pCity, pRM, pDevice, progressCallback);
+    BuildLotConfigCache(pCity, pRM, progressCallback);
+    searchIndex.Build(catalog);
+
     cacheInitialized = true;
-    LOG_INFO("Lot cache built: {} entries", lotConfigCache.size());
+    ++generation;
+    LOG_INFO("Lot cache built: {} entries, {} KB catalog", lotEntries.size(), catalog.GetMemoryUsage() / 1024);
 }
 
 void LotCacheManager::BuildExemplarCache(cIGZPersistResourceManager* pRM, LotCacheProgressCallback progressCallback) {
-    if (!exemplarCache.empty()) return;
-
-    LOG_INFO("Building exemplar cache...");
+    if (!exemplarDigest.IsEmpty()) return;
 
     if (progressCallback) {
         progressCallback("Loading exemplars...", 0, 0);
     }
 
-    if (!pRM) return;
-
-    constexpr uint32_t kExemplarType = 0x6534284A;
-
-    cRZAutoRefCount<cIGZPersistResourceKeyList> pKeyList;
-    uint32_t totalCount = pRM->GetAvailableResourceList(pKeyList.AsPPObj(), nullptr);
-
-    if (totalCount == 0 || !pKeyList) {
-        LOG_WARN("Failed to enumerate resources for exemplar cache");
-        return;
-    }
-
-    LOG_INFO("Filtering {} resources for exemplars...", totalCount);
-
-    uint32_t exemplarCount = 0;
-    uint32_t keyListSize = pKeyList->Size();
-    for (uint32_t i = 0; i < keyListSize; i++) {
-        // Report progress every 1000 items
-        if (progressCallback && (i % 1000 == 0 || i == keyListSize - 1)) {
-            progressCallback("Loading exemplars...", static_cast<int>(i), static_cast<int>(keyListSize));
-        }
-
-        cGZPersistResourceKey key = pKeyList->GetKey(i);
-
-        // Only cache exemplars
-        if (key.type != kExemplarType) continue;
-
-        cRZAutoRefCount<cISCPropertyHolder> exemplar;
-        if (pRM->GetResource(key, GZIID_cISCPropertyHolder, exemplar.AsPPVoid(), 0, nullptr)) {
-            exemplarCache[key.instance].emplace_back(key.group, exemplar);
-            exemplarCount++;
-        }
-    }
-
-    LOG_INFO("Exemplar cache built: {} exemplars across {} unique instance IDs", exemplarCount, exemplarCache.size());
+    exemplarDigest.Build(pRM);
 }
 
-void LotCacheManager::BuildLotConfigCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, LotCacheProgressCallback progressCallback) {
+void LotCacheManager::BuildLotConfigCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, LotCacheProgressCallback progressCallback) {
     LOG_INFO("Building lot configuration cache...");
 
     if (progressCallback) {
@@ -134,10 +98,9 @@ void LotCacheManager::BuildLotConfigCache(cISC4City* pCity, cIGZPersistResourceM
     cISC4LotConfigurationManager* pLotConfigMgr = pCity->GetLotConfigurationManager();
     if (!pLotConfigMgr || !pRM) return;
 
-    lotConfigCache.reserve(2048);
-
-    constexpr uint32_t kPropertyExemplarType = 0x00000010;
-    constexpr uint32_t kPropertyExemplarTypeBuilding = 0x00000002;
+    lotEntries.reserve(2048);
+    catalog.Reserve(2048);
+    handleByID.reserve(2048);
 
     SC4HashSet<uint32_t> configIdTable{};
 
@@ -156,203 +119,229 @@ void LotCacheManager::BuildLotConfigCache(cISC4City* pCity, cIGZPersistResourceM
                 for (const auto it : configIdTable) {
                     uint32_t lotConfigID = it;
 
-                    if (lotConfigCache.contains(lotConfigID)) continue;
+                    if (handleByID.contains(lotConfigID)) continue;
 
                     cISC4LotConfiguration* pConfig = pLotConfigMgr->GetLotConfiguration(lotConfigID);
                     if (!pConfig) continue;
 
                     LotConfigEntry entry;
+                    LotCatalog::LotInfo info;
                     entry.id = lotConfigID;
+                    info.id = lotConfigID;
+                    PopulateEntry(entry, info, pConfig);
 
-                    cRZAutoRefCount<cISCPropertyHolder> pLotExemplar;
-                    if (GetCachedExemplar(lotConfigID, pLotExemplar)) {
-                        uint32_t buildingExemplarID = 0;
-                        if (GetLotBuildingExemplarID(pLotExemplar, buildingExemplarID)) {
-                            cRZAutoRefCount<cISCPropertyHolder> pBuildingExemplar;
-                            if (GetCachedExemplarByType(
-                                buildingExemplarID,
-                                kPropertyExemplarType,
-                                kPropertyExemplarTypeBuilding,
-                                pBuildingExemplar
-                            )) {
-                                // Get display name
-                                cRZBaseString displayName;
-                                if (PropertyUtil::GetDisplayName(pBuildingExemplar, displayName)) {
-                                    cRZBaseString techName;
-                                    pConfig->GetName(techName);
-                                    entry.name.reserve(displayName.Strlen() + techName.Strlen() + 3);
-                                    entry.name = displayName.Data();
-                                    entry.name += " (";
-                                    entry.name += techName.Data();
-                                    entry.name += ")";
-                                }
-
-                                // Load icon immediately
-                                uint32_t iconInstance = 0;
-                                if (ExemplarUtil::GetItemIconInstance(pBuildingExemplar, iconInstance)) {
-                                    entry.iconInstance = iconInstance;
-
-                                    if (pDevice) {
-                                        ID3D11ShaderResourceView* srv = nullptr;
-                                        int w = 0, h = 0;
-                                        if (IconLoader::LoadIconFromPNG(pRM, iconInstance, pDevice, &srv, &w, &h)) {
-                                            entry.iconSRV = srv;
-                                            entry.iconWidth = w;
-                                            entry.iconHeight = h;
-                                            entry.iconType = LotConfigEntry::IconType::PNG;
-                                        }
-                                    }
-                                }
-
-                                // If no PNG icon loaded, try S3D thumbnail as fallback
-                                if (entry.iconType == LotConfigEntry::IconType::None && pDevice) {
-                                    // Get device context for rendering
-                                    ID3D11DeviceContext* pContext = nullptr;
-                                    pDevice->GetImmediateContext(&pContext);
-
-                                    if (pContext) {
-                                        // Generate S3D thumbnail (64x64, zoom 5, rotation 0 for standard view)
-                                        ID3D11ShaderResourceView* s3dSRV = S3D::ThumbnailGenerator::GenerateThumbnailFromExemplar(
-                                            pBuildingExemplar, pRM, pDevice, pContext, 44, 5, 0
-                                        );
-
-                                        if (s3dSRV) {
-                                            entry.iconSRV = s3dSRV;
-                                            entry.iconWidth = 44;
-                                            entry.iconHeight = 44;
-                                            entry.iconType = LotConfigEntry::IconType::S3D;
-                                            LOG_DEBUG("Generated S3D thumbnail for lot 0x{:08X} ({})", lotConfigID, entry.name);
-                                        }
-
-                                        pContext->Release();
-                                    }
-                                }
-
-                                // Occupant groups
-                                constexpr uint32_t kOccupantGroupProperty = 0xAA1DD396;
-                                const cISCProperty* prop = pBuildingExemplar->GetProperty(kOccupantGroupProperty);
-                                if (prop) {
-                                    const cIGZVariant* val = prop->GetPropertyValue();
-                                    if (val && val->GetType() == cIGZVariant::Type::Uint32Array) {
-                                        uint32_t count = val->GetCount();
-                                        const uint32_t* pVals = val->RefUint32();
-                                        if (pVals && count > 0) {
-                                            for (uint32_t i = 0; i < count; ++i) {
-                                                entry.occupantGroups.insert(pVals[i]);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    // Fallback to technical name
-                    if (entry.name.empty()) {
-                        cRZBaseString techName;
-                        if (pConfig->GetName(techName)) {
-                            entry.name = techName.Data();
-                        }
-                    }
-
-                    pConfig->GetSize(entry.sizeX, entry.sizeZ);
-                    entry.minCapacity = pConfig->GetMinBuildingCapacity();
-                    entry.maxCapacity = pConfig->GetMaxBuildingCapacity();
-                    entry.growthStage = pConfig->GetGrowthStage();
-
-                    lotConfigCache[lotConfigID] = entry;
+                    AddEntry(std::move(entry), info);
                 }
             }
         }
     }
 
-    LOG_INFO("Lot configuration cache built: {} entries", lotConfigCache.size());
+    LOG_INFO("Lot configuration cache built: {} entries", lotEntries.size());
 }
 
-bool LotCacheManager::GetCachedExemplar(uint32_t instanceID, cRZAutoRefCount<cISCPropertyHolder>& outExemplar) {
-    auto it = exemplarCache.find(instanceID);
-    if (it != exemplarCache.end() && !it->second.empty()) {
-        outExemplar = it->second[0].second;
-        return true;
+void LotCacheManager::PopulateEntry(LotConfigEntry& entry, LotCatalog::LotInfo& info, cISC4LotConfiguration* pConfig) {
+    const ExemplarDigest::Record* pLot = exemplarDigest.Find(entry.id, ExemplarDigest::kExemplarTypeLotConfiguration);
+    const ExemplarDigest::Record* pBuilding = nullptr;
+    if (pLot && pLot->buildingExemplarID != 0) {
+        pBuilding = exemplarDigest.Find(pLot->buildingExemplarID, ExemplarDigest::kExemplarTypeBuilding);
     }
-    return false;
+
+    if (pBuilding) {
+        // The key is only kept to render a thumbnail, so a building without a model doesn't need it
+        if (pBuilding->flags & ExemplarDigest::kHasModel) {
+            entry.buildingExemplarGroup = pBuilding->group;
+            entry.buildingExemplarID = pBuilding->instance;
+        }
+
+        // Get display name
+        std::string displayName;
+        if (exemplarDigest.ResolveDisplayName(*pBuilding, displayName)) {
+            cRZBaseString techName;
+            pConfig->GetName(techName);
+            info.name.reserve(displayName.size() + techName.Strlen() + 3);
+            info.name = displayName;
+            info.name += " (";
+            info.name += techName.Data();
+            info.name += ")";
+        }
+
+        // Icons are loaded later, when their rows become visible
+        entry.iconInstance = pBuilding->itemIcon;
+
+        // Occupant groups
+        const uint32_t* pGroups = exemplarDigest.GetOccupantGroups(*pBuilding);
+        info.occupantGroups.assign(pGroups, pGroups + pBuilding->groupsCount);
+    }
+
+    // Nothing to load: no menu icon and no model to render a thumbnail from
+    entry.iconRequested = entry.iconInstance == 0 && entry.buildingExemplarID == 0;
+
+    // Fallback to technical name
+    if (info.name.empty()) {
+        cRZBaseString techName;
+        if (pConfig->GetName(techName)) {
+            info.name = techName.Data();
+        }
+    }
+
+    pConfig->GetSize(info.sizeX, info.sizeZ);
+    info.minCapacity = pConfig->GetMinBuildingCapacity();
+    info.maxCapacity = pConfig->GetMaxBuildingCapacity();
+    info.growthStage = pConfig->GetGrowthStage();
+    info.zoneMask = LotFilterer::ComputeZoneMask(pConfig);
+    info.wealthMask = LotFilterer::ComputeWealthMask(pConfig);
 }
 
-bool LotCacheManager::GetCachedExemplarByType(
-    uint32_t instanceID,
-    uint32_t exemplarTypePropertyID,
-    uint32_t expectedTypeValue,
-    cRZAutoRefCount<cISCPropertyHolder>& outExemplar
+void LotCacheManager::LoadEntryIcon(
+    LotConfigEntry& entry,
+    cISCPropertyHolder* pBuildingExemplar,
+    cIGZPersistResourceManager* pRM,
+    ID3D11Device* pDevice
 ) {
-    auto it = exemplarCache.find(instanceID);
-    if (it != exemplarCache.end()) {
-        for (const auto& pair : it->second) {
-            uint32_t actualType = 0;
-            const cISCProperty* pProp = pair.second->GetProperty(exemplarTypePropertyID);
-            if (pProp) {
-                const cIGZVariant* pVal = pProp->GetPropertyValue();
-                if (pVal && pVal->GetType() == cIGZVariant::Type::Uint32) {
-                    pVal->GetValUint32(actualType);
-                }
-            }
-
-            if (actualType == expectedTypeValue) {
-                outExemplar = pair.second;
-                return true;
+    if (!pDevice || !pRM || entry.iconType != LotConfigEntry::IconType::None) return;
+
+    if (entry.iconInstance != 0) {
+        std::vector<uint8_t> rgba;
+        int w = 0, h = 0;
+        if (IconLoader::LoadIconPixelsFromPNG(pRM, entry.iconInstance, rgba, &w, &h)) {
+            // Lot PNG icons are 176x44 made of four 44x44 states; keep the second (enabled) one
+            const int x = w >= 88 ? 44 : 0;
+            int size = (w - x < h) ? w - x : h;
+            if (size > 44) size = 44;
+            if (size > 0 && iconAtlas.AddPixels(pDevice, rgba.data() + x * 4, size, size, w * 4, entry.icon)) {
+                entry.iconWidth = size;
+                entry.iconHeight = size;
+                entry.iconType = LotConfigEntry::IconType::PNG;
+                return;
             }
         }
     }
-    return false;
-}
 
-// Incremental cache building methods
+    // If no PNG icon loaded, try S3D thumbnail as fallback
+    if (!pBuildingExemplar) return;
 
-void LotCacheManager::BeginIncrementalBuild() {
-    exemplarCache.clear();
-    lotConfigCache.clear();
-    lotSizesToProcess.clear();
-    currentLotSizeIndex = 0;
-    processedLotCount = 0;
-    totalLotCount = 0;
-    pCityForIncremental = nullptr;
-    cacheInitialized = false;
+    // Render on the worker threads; ProcessThumbnailResults attaches the result later
+    if (!thumbnailPipeline) {
+        thumbnailPipeline = std::make_unique<S3D::ThumbnailPipeline>();
+    }
+    // Requests are tagged with the handle; CancelThumbnails runs before the storage is rebuilt
+    thumbnailPipeline->Submit(static_cast<uint32_t>(&entry - lotEntries.data()), pBuildingExemplar, pRM, kThumbnailSize, 5, 0);
 }
 
-void LotCacheManager::BuildExemplarCacheSync(cIGZPersistResourceManager* pRM) {
-    if (!exemplarCache.empty()) return;
+// Persistent snapshot
 
-    LOG_INFO("Building exemplar cache (sync)...");
+bool LotCacheManager::TryLoadSnapshot(cIGZPersistResourceManager* pRM) {
+    loadedFromSnapshot = false;
+    snapshotFingerprint = LotCacheSnapshot::ComputeFingerprint(pRM, LotCacheSnapshot::GetPluginDirectories());
+    if (snapshotFingerprint == 0) return false;
 
-    if (!pRM) return;
+    std::vector<LotConfigEntry> loaded;
+    LotCatalog loadedCatalog;
+    if (!LotCacheSnapshot::Load(LotCacheSnapshot::GetDefaultPath(), snapshotFingerprint, loaded, loadedCatalog)) {
+        return false;
+    }
 
-    constexpr uint32_t kExemplarType = 0x6534284A;
+    // Snapshots are written from a cache, so IDs are already unique and rows line up
+    ClearEntries();
+    lotEntries = std::move(loaded);
+    catalog = std::move(loadedCatalog);
+    handleByID.reserve(lotEntries.size());
+    for (size_t i = 0; i < lotEntries.size(); ++i) {
+        handleByID.emplace(lotEntries[i].id, static_cast<LotHandle>(i));
+    }
 
-    cRZAutoRefCount<cIGZPersistResourceKeyList> pKeyList;
-    uint32_t totalCount = pRM->GetAvailableResourceList(pKeyList.AsPPObj(), nullptr);
+    // The list is refreshed as soon as the cache reports initialized, before the build finalizes
+    searchIndex.Build(catalog);
 
-    if (totalCount == 0 || !pKeyList) {
-        LOG_WARN("Failed to enumerate resources for exemplar cache");
-        return;
-    }
+    loadedFromSnapshot = true;
+    cacheInitialized = true;
+    return true;
+}
+
+void LotCacheManager::SaveSnapshot() const {
+    if (snapshotFingerprint == 0 || lotEntries.empty()) return;
+    LotCacheSnapshot::Save(LotCacheSnapshot::GetDefaultPath(), snapshotFingerprint, lotEntries, catalog);
+}
+
+// Visibility-driven icon loading
 
-    LOG_INFO("Filtering {} resources for exemplars...", totalCount);
+void LotCacheManager::RequestIcons(const std::vector<LotHandle>& handles) {
+    // The new list replaces the old one, so rows that scrolled away are dropped
+    iconRequests.clear();
+    for (size_t i = 0; i < handles.size(); ++i) {
+        const LotConfigEntry* entry = GetEntry(handles[i]);
+        if (!entry) continue;
+        if (entry->iconRequested || entry->iconType != LotConfigEntry::IconType::None) continue;
+        if (entry->iconInstance == 0 && entry->buildingExemplarID == 0) continue;
+
+        iconRequests.push_back({handles[i], static_cast<uint32_t>(i)});
+        std::push_heap(iconRequests.begin(), iconRequests.end());
+    }
+}
 
-    uint32_t exemplarCount = 0;
-    uint32_t keyListSize = pKeyList->Size();
-    for (uint32_t i = 0; i < keyListSize; i++) {
-        cGZPersistResourceKey key = pKeyList->GetKey(i);
+int LotCacheManager::ProcessIconRequests(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, double budgetMs) {
+    if (!pRM || !pDevice) return 0;
 
-        // Only cache exemplars
-        if (key.type != kExemplarType) continue;
+    ProcessThumbnailResults(pRM, pDevice, kThumbnailResultsPerFrame);
 
-        cRZAutoRefCount<cISCPropertyHolder> exemplar;
-        if (pRM->GetResource(key, GZIID_cISCPropertyHolder, exemplar.AsPPVoid(), 0, nullptr)) {
-            exemplarCache[key.instance].emplace_back(key.group, exemplar);
-            exemplarCount++;
+    constexpr uint32_t kExemplarType = 0x6534284A;
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::duration<double, std::milli>(budgetMs);
+
+    int loaded = 0;
+    while (!iconRequests.empty()) {
+        // Always make some progress, then stop once the frame budget is spent
+        if (loaded > 0 && std::chrono::steady_clock::now() - start >= budget) break;
+
+        std::pop_heap(iconRequests.begin(), iconRequests.end());
+        const LotHandle handle = iconRequests.back().handle;
+        iconRequests.pop_back();
+        if (handle >= lotEntries.size()) continue;
+
+        LotConfigEntry& entry = lotEntries[handle];
+        if (entry.iconRequested) continue; // Listed twice (e.g. in the recent lots too)
+        entry.iconRequested = true;
+        loaded++;
+
+        // Try the PNG first so the building exemplar is only loaded when a thumbnail is needed
+        LoadEntryIcon(entry, nullptr, pRM, pDevice);
+        if (entry.iconType != LotConfigEntry::IconType::None || entry.buildingExemplarID == 0) continue;
+
+        cGZPersistResourceKey key(kExemplarType, entry.buildingExemplarGroup, entry.buildingExemplarID);
+        cRZAutoRefCount<cISCPropertyHolder> pBuildingExemplar;
+        if (pRM->GetResource(key, GZIID_cISCPropertyHolder, pBuildingExemplar.AsPPVoid(), 0, nullptr)) {
+            LoadEntryIcon(entry, pBuildingExemplar, pRM, pDevice);
         }
     }
 
-    LOG_INFO("Exemplar cache built: {} exemplars across {} unique instance IDs", exemplarCount, exemplarCache.size());
+    return loaded;
+}
+
+// Incremental cache building methods
+
+void LotCacheManager::BeginIncrementalBuild() {
+    CancelThumbnails();
+    iconAtlas.Clear();
+
+    exemplarDigest.Clear();
+    ClearEntries();
+    searchIndex.Clear();
+    lotSizesToProcess.clear();
+    currentLotSizeIndex = 0;
+    processedLotCount = 0;
+    totalLotCount = 0;
+    pCityForIncremental = nullptr;
+    iconRequests.clear();
+    loadedFromSnapshot = false;
+    snapshotFingerprint = 0;
+    cacheInitialized = false;
+}
+
+void LotCacheManager::BuildExemplarDigestSync(cIGZPersistResourceManager* pRM) {
+    if (!exemplarDigest.IsEmpty()) return;
+
+    LOG_INFO("Building exemplar digest (sync)...");
+    exemplarDigest.Build(pRM);
 }
 
 void LotCacheManager::BeginLotConfigProcessing(cISC4City* pCity) {
@@ -370,18 +359,17 @@ void LotCacheManager::BeginLotConfigProcessing(cISC4City* pCity) {
     processedLotCount = 0;
     totalLotCount = static_cast<int>(lotSizesToProcess.size());
 
-    lotConfigCache.reserve(2048);
+    lotEntries.reserve(2048);
+    catalog.Reserve(2048);
+    handleByID.reserve(2048);
 }
 
-int LotCacheManager::ProcessLotConfigBatch(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, int maxLotsToProcess) {
+int LotCacheManager::ProcessLotConfigBatch(cIGZPersistResourceManager* pRM, int maxLotsToProcess) {
     if (!pCityForIncremental || !pRM) return 0;
 
     cISC4LotConfigurationManager* pLotConfigMgr = pCityForIncremental->GetLotConfigurationManager();
     if (!pLotConfigMgr) return 0;
 
-    constexpr uint32_t kPropertyExemplarType = 0x00000010;
-    constexpr uint32_t kPropertyExemplarTypeBuilding = 0x00000002;
-
     SC4HashSet<uint32_t> configIdTable{};
 
     int processedThisBatch = 0;
@@ -402,110 +390,18 @@ int LotCacheManager::ProcessLotConfigBatch(cIGZPersistResourceManager* pRM, ID3D
 
                 uint32_t lotConfigID = it;
 
-                if (lotConfigCache.count(lotConfigID)) continue;
+                if (handleByID.contains(lotConfigID)) continue;
 
                 cISC4LotConfiguration* pConfig = pLotConfigMgr->GetLotConfiguration(lotConfigID);
                 if (!pConfig) continue;
 
                 LotConfigEntry entry;
+                LotCatalog::LotInfo info;
                 entry.id = lotConfigID;
+                info.id = lotConfigID;
+                PopulateEntry(entry, info, pConfig);
 
-                cRZAutoRefCount<cISCPropertyHolder> pLotExemplar;
-                if (GetCachedExemplar(lotConfigID, pLotExemplar)) {
-                    uint32_t buildingExemplarID = 0;
-                    if (GetLotBuildingExemplarID(pLotExemplar, buildingExemplarID)) {
-                        cRZAutoRefCount<cISCPropertyHolder> pBuildingExemplar;
-                        if (GetCachedExemplarByType(
-                            buildingExemplarID,
-                            kPropertyExemplarType,
-                            kPropertyExemplarTypeBuilding,
-                            pBuildingExemplar
-                        )) {
-                            // Get display name
-                            cRZBaseString displayName;
-                            if (PropertyUtil::GetDisplayName(pBuildingExemplar, displayName)) {
-                                cRZBaseString techName;
-                                pConfig->GetName(techName);
-                                entry.name.reserve(displayName.Strlen() + techName.Strlen() + 3);
-                                entry.name = displayName.Data();
-                                entry.name += " (";
-                                entry.name += techName.Data();
-                                entry.name += ")";
-                            }
-
-                            // Load icon immediately
-                            uint32_t iconInstance = 0;
-                            if (ExemplarUtil::GetItemIconInstance(pBuildingExemplar, iconInstance)) {
-                                entry.iconInstance = iconInstance;
-
-                                if (pDevice) {
-                                    ID3D11ShaderResourceView* srv = nullptr;
-                                    int w = 0, h = 0;
-                                    if (IconLoader::LoadIconFromPNG(pRM, iconInstance, pDevice, &srv, &w, &h)) {
-                                        entry.iconSRV = srv;
-                                        entry.iconWidth = w;
-                                        entry.iconHeight = h;
-                                        entry.iconType = LotConfigEntry::IconType::PNG;
-                                    }
-                                }
-                            }
-
-                            // If no PNG icon loaded, try S3D thumbnail as fallback
-                            if (entry.iconType == LotConfigEntry::IconType::None && pDevice) {
-                                ID3D11DeviceContext* pContext = nullptr;
-                                pDevice->GetImmediateContext(&pContext);
-
-
-                                if (pContext) {
-                                    ID3D11ShaderResourceView* s3dSRV = S3D::ThumbnailGenerator::GenerateThumbnailFromExemplar(
-                                        pBuildingExemplar, pRM, pDevice, pContext, kThumbnailSize, 5, 0
-                                    );
-
-                                    if (s3dSRV) {
-                                        entry.iconSRV = s3dSRV;
-                                        entry.iconWidth = kThumbnailSize;
-                                        entry.iconHeight = kThumbnailSize;
-                                        entry.iconType = LotConfigEntry::IconType::S3D;
-                                        LOG_DEBUG("Generated S3D thumbnail for lot 0x{:08X} ({})", lotConfigID, entry.name);
-                                    }
-
-                                    pContext->Release();
-                                }
-                            }
-
-                            // Occupant groups
-                            constexpr uint32_t kOccupantGroupProperty = 0xAA1DD396;
-                            const cISCProperty* prop = pBuildingExemplar->GetProperty(kOccupantGroupProperty);
-                            if (prop) {
-                                const cIGZVariant* val = prop->GetPropertyValue();
-                                if (val && val->GetType() == cIGZVariant::Type::Uint32Array) {
-                                    uint32_t count = val->GetCount();
-                                    const uint32_t* pVals = val->RefUint32();
-                                    if (pVals && count > 0) {
-                                        for (uint32_t i = 0; i < count; ++i) {
-                                            entry.occupantGroups.insert(pVals[i]);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-                // Fallback to technical name
-                if (entry.name.empty()) {
-                    cRZBaseString techName;
-                    if (pConfig->GetName(techName)) {
-                        entry.name = techName.Data();
-                    }
-                }
-
-                pConfig->GetSize(entry.sizeX, entry.sizeZ);
-                entry.minCapacity = pConfig->GetMinBuildingCapacity();
-                entry.maxCapacity = pConfig->GetMaxBuildingCapacity();
-                entry.growthStage = pConfig->GetGrowthStage();
-
-                lotConfigCache[lotConfigID] = entry;
+                AddEntry(std::move(entry), info);
 
                 // Increment per individual lot, not per lot size
                 processedThisBatch++;
@@ -522,8 +418,67 @@ int LotCacheManager::ProcessLotConfigBatch(cIGZPersistResourceManager* pRM, ID3D
     return processedThisBatch;
 }
 
+int LotCacheManager::ProcessThumbnailResults(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, int maxThumbnails) {
+    if (!thumbnailPipeline) return 0;
+
+    std::vector<S3D::ThumbnailPipeline::Result> results;
+    thumbnailPipeline->Pump(pRM, maxThumbnails, results);
+    for (const auto& result : results) {
+        ApplyThumbnail(pDevice, result.id, result.rgba, result.size);
+    }
+    return static_cast<int>(results.size());
+}
+
+int LotCacheManager::GetPendingThumbnailCount() const {
+    return thumbnailPipeline ? static_cast<int>(thumbnailPipeline->GetPendingCount()) : 0;
+}
+
+void LotCacheManager::CancelThumbnails() {
+    if (thumbnailPipeline) {
+        thumbnailPipeline->Cancel();
+    }
+}
+
+void LotCacheManager::ApplyThumbnail(ID3D11Device* pDevice, LotHandle handle, const std::vector<uint8_t>& rgba, int size) {
+    if (!pDevice || rgba.empty() || handle >= lotEntries.size()) return;
+
+    LotConfigEntry& entry = lotEntries[handle];
+    if (entry.iconType != LotConfigEntry::IconType::None) return;
+
+    if (!iconAtlas.AddPixels(pDevice, rgba.data(), size, size, size * 4, entry.icon)) return;
+    entry.iconWidth = size;
+    entry.iconHeight = size;
+    entry.iconType = LotConfigEntry::IconType::S3D;
+    LOG_DEBUG("Generated S3D thumbnail for lot 0x{:08X} ({})", entry.id, catalog.GetName(handle));
+}
+
+void LotCacheManager::AddEntry(LotConfigEntry&& entry, const LotCatalog::LotInfo& info) {
+    const auto [it, inserted] = handleByID.emplace(entry.id, static_cast<LotHandle>(lotEntries.size()));
+    if (!inserted) return;
+    lotEntries.push_back(std::move(entry));
+    catalog.Add(info);
+}
+
+void LotCacheManager::ClearEntries() {
+    lotEntries.clear();
+    catalog.Clear();
+    handleByID.clear();
+    ++generation;
+}
+
 void LotCacheManager::FinalizeIncrementalBuild() {
+    if (!loadedFromSnapshot) {
+        SaveSnapshot();
+    }
+
+    // The digest is only needed while building entries
+    exemplarDigest.Clear();
+    if (!loadedFromSnapshot) {
+        searchIndex.Build(catalog); // Already built by TryLoadSnapshot
+    }
+
     cacheInitialized = true;
+    ++generation;
     pCityForIncremental = nullptr;
-    LOG_INFO("Incremental cache build finalized: {} lot entries", lotConfigCache.size());
+    LOG_INFO("Incremental cache build finalized: {} lot entries, {} KB catalog", lotEntries.size(), catalog.GetMemoryUsage() / 1024);
 }
@@ -22,37 +22,69 @@
 #include <unordered_map>
 #include <vector>
 #include <functional>
+#include <memory>
 
 #include "cISCPropertyHolder.h"
 #include "cRZAutoRefCount.h"
+#include "ExemplarDigest.h"
+#include "../gfx/IconAtlas.h"
+#include "../lots/LotCatalog.h"
 #include "../lots/LotConfigEntry.h"
+#include "../lots/LotSearchIndex.h"
 
 class cISC4City;
+class cISC4LotConfiguration;
 class cIGZPersistResourceManager;
 struct ID3D11Device;
 
+namespace S3D { class ThumbnailPipeline; }
+
 // Progress callback: stage description, current progress, total steps
 using LotCacheProgressCallback = std::function<void(const char* stage, int current, int total)>;
 constexpr uint8_t kThumbnailSize = 44;
+constexpr int kThumbnailResultsPerFrame = 16;   // Finished S3D thumbnails added to the atlas per frame
 
 /**
- * Manages the lot configuration cache, including exemplar loading and icon processing.
+ * Manages the lot configuration cache, including exemplar digesting and icon processing.
  */
 class LotCacheManager {
 public:
     LotCacheManager();
     ~LotCacheManager();
 
-    // Build the complete cache
-    void BuildCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, LotCacheProgressCallback progressCallback = nullptr);
+    // Build the complete cache (metadata only; icons are loaded on demand via RequestIcons)
+    void BuildCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, LotCacheProgressCallback progressCallback = nullptr);
 
     // Incremental cache building
     void BeginIncrementalBuild();
-    void BuildExemplarCacheSync(cIGZPersistResourceManager* pRM);
+    void BuildExemplarDigestSync(cIGZPersistResourceManager* pRM);
     void BeginLotConfigProcessing(cISC4City* pCity);
-    int ProcessLotConfigBatch(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, int maxLotsToProcess);
+    int ProcessLotConfigBatch(cIGZPersistResourceManager* pRM, int maxLotsToProcess);
     void FinalizeIncrementalBuild();
 
+    // Persistent snapshot: restores the cache from disk when the plugin set is unchanged.
+    // Must be called after BeginIncrementalBuild(); on success the cache is initialized.
+    bool TryLoadSnapshot(cIGZPersistResourceManager* pRM);
+    void SaveSnapshot() const;
+    bool WasLoadedFromSnapshot() const { return loadedFromSnapshot; }
+
+    // Visibility-driven icon loading. The UI passes the lots whose rows are on screen, followed
+    // by the rows around them, most important first; the list replaces the previous request.
+    // Each entry's icon is attempted once (iconRequested).
+    void RequestIcons(const std::vector<LotHandle>& handles);
+    // Loads requested icons until budgetMs is spent (at least one per call) and adds finished
+    // S3D thumbnails to the atlas. Call once per frame.
+    int ProcessIconRequests(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, double budgetMs);
+    size_t GetPendingIconRequestCount() const { return iconRequests.size(); }
+    // Drops the pending request, e.g. while the lot window isn't drawn
+    void CancelIconRequests() { iconRequests.clear(); }
+
+    // S3D thumbnails rendered on worker threads.
+    // Adds up to maxThumbnails finished thumbnails to the atlas.
+    int ProcessThumbnailResults(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, int maxThumbnails);
+    int GetPendingThumbnailCount() const;
+    void CancelThumbnails();
+
     // Incremental build progress
     int GetProcessedLotCount() const { return processedLotCount; }
     int GetTotalLotCount() const { return totalLotCount; }
@@ -64,29 +96,56 @@ public:
     // Check if cache is ready
     bool IsInitialized() const { return cacheInitialized; }
 
-    // Access the cache
-    const std::unordered_map<uint32_t, LotConfigEntry>& GetLotConfigCache() const { return lotConfigCache; }
+    // Access the cache. Entries live in one vector for the lifetime of a build and are addressed by
+    // LotHandle (their index); GetGeneration changes whenever the storage is cleared or rebuilt.
+    const std::vector<LotConfigEntry>& GetEntries() const { return lotEntries; }
+    const LotConfigEntry* GetEntry(LotHandle handle) const {
+        return handle < lotEntries.size() ? &lotEntries[handle] : nullptr;
+    }
+    LotHandle FindHandle(uint32_t lotConfigID) const {
+        auto it = handleByID.find(lotConfigID);
+        return it != handleByID.end() ? it->second : kInvalidLotHandle;
+    }
+    const LotConfigEntry* FindEntry(uint32_t lotConfigID) const { return GetEntry(FindHandle(lotConfigID)); }
+    uint32_t GetGeneration() const { return generation; }
+
+    // Names, sizes, compatibility and occupant groups of every entry, indexed by LotHandle
+    const LotCatalog& GetCatalog() const { return catalog; }
+
+    // Folded name/description text for searching (rebuilt whenever the cache is)
+    const LotSearchIndex& GetSearchIndex() const { return searchIndex; }
+
+    // Atlas holding every entry's icon (LotConfigEntry::icon refers to its pages)
+    const gfx::IconAtlas& GetIconAtlas() const { return iconAtlas; }
 
 private:
-    // Build exemplar cache
+    // Build the exemplar digest
     void BuildExemplarCache(cIGZPersistResourceManager* pRM, LotCacheProgressCallback progressCallback);
 
     // Build lot configuration cache
-    void BuildLotConfigCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, LotCacheProgressCallback progressCallback);
+    void BuildLotConfigCache(cISC4City* pCity, cIGZPersistResourceManager* pRM, LotCacheProgressCallback progressCallback);
 
-    // Helper to get cached exemplar by instance ID
-    bool GetCachedExemplar(uint32_t instanceID, cRZAutoRefCount<cISCPropertyHolder>& outExemplar);
+    // Fill a cache entry and its catalog row from the lot configuration and the exemplar digest
+    void PopulateEntry(LotConfigEntry& entry, LotCatalog::LotInfo& info, cISC4LotConfiguration* pConfig);
 
-    // Helper to get cached exemplar by instance ID and type
-    bool GetCachedExemplarByType(
-        uint32_t instanceID,
-        uint32_t exemplarTypePropertyID,
-        uint32_t expectedTypeValue,
-        cRZAutoRefCount<cISCPropertyHolder>& outExemplar
-    );
+    // Load the PNG menu icon, falling back to an S3D thumbnail of the building exemplar (if given)
+    void LoadEntryIcon(LotConfigEntry& entry, cISCPropertyHolder* pBuildingExemplar, cIGZPersistResourceManager* pRM, ID3D11Device* pDevice);
 
-    std::unordered_map<uint32_t, LotConfigEntry> lotConfigCache;
-    std::unordered_map<uint32_t, std::vector<std::pair<uint32_t, cRZAutoRefCount<cISCPropertyHolder>>>> exemplarCache;
+    // Add a finished thumbnail to the atlas and attach it to its entry (skipped if the entry is gone)
+    void ApplyThumbnail(ID3D11Device* pDevice, LotHandle handle, const std::vector<uint8_t>& rgba, int size);
+
+    // Append a finished entry and its catalog row (ignored if its ID is already cached)
+    void AddEntry(LotConfigEntry&& entry, const LotCatalog::LotInfo& info);
+    // Drop all entries and invalidate outstanding handles
+    void ClearEntries();
+
+    std::vector<LotConfigEntry> lotEntries;
+    LotCatalog catalog;                 // Row i belongs to lotEntries[i]
+    std::unordered_map<uint32_t, LotHandle> handleByID;
+    uint32_t generation = 0;
+    gfx::IconAtlas iconAtlas;
+    LotSearchIndex searchIndex;
+    ExemplarDigest exemplarDigest;  // Only populated during a build
     bool cacheInitialized;
 
     // Incremental processing state
@@ -95,4 +154,19 @@ private:
     int processedLotCount;
     int totalLotCount;
     cISC4City* pCityForIncremental;
+
+    // Icon requests from the UI, as a heap ordered by priority (lower = sooner)
+    struct IconRequest {
+        LotHandle handle;
+        uint32_t priority;
+        bool operator<(const IconRequest& other) const { return priority > other.priority; }
+    };
+    std::vector<IconRequest> iconRequests;
+
+    // Worker-thread S3D thumbnails (created by the first thumbnail request)
+    std::unique_ptr<S3D::ThumbnailPipeline> thumbnailPipeline;
+
+    // Snapshot state
+    bool loadedFromSnapshot;
+    uint64_t snapshotFingerprint;
 };
@@ -0,0 +1,400 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LotCacheSnapshot.h"
+
+#include <windows.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "cGZPersistResourceKey.h"
+#include "cIGZPersistResourceKeyList.h"
+#include "cIGZPersistResourceManager.h"
+#include "cISC4App.h"
+#include "cRZAutoRefCount.h"
+#include "cRZBaseString.h"
+#include "GZServPtrs.h"
+#include "../s3d/QFSCompressor.h"
+#include "../s3d/QFSDecompressor.h"
+#include "../utils/Config.h"
+#include "../utils/Logger.h"
+#include "../version.h"
+
+namespace LotCacheSnapshot {
+    namespace {
+        // splitmix64 finalizer: cheap, well-distributed 64-bit mix
+        uint64_t Mix64(uint64_t x) {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        uint64_t HashString(const char* s) {
+            uint64_t h = 0xCBF29CE484222325ull; // FNV-1a
+            for (; *s; ++s) {
+                h ^= static_cast<uint8_t>(*s);
+                h *= 0x100000001B3ull;
+            }
+            return h;
+        }
+
+        // RAII wrapper around a read-only file mapping
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string& path) {
+                hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (hFile == INVALID_HANDLE_VALUE) return;
+
+                LARGE_INTEGER fileSize{};
+                if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0 || fileSize.HighPart != 0) return;
+
+                hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!hMapping) return;
+
+                view = static_cast<const uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+                if (view) size = static_cast<size_t>(fileSize.LowPart);
+            }
+
+            ~MappedFile() {
+                if (view) UnmapViewOfFile(view);
+                if (hMapping) CloseHandle(hMapping);
+                if (hFile != INVALID_HANDLE_VALUE) CloseHandle(hFile);
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const uint8_t* Data() const { return view; }
+            size_t Size() const { return size; }
+
+        private:
+            HANDLE hFile = INVALID_HANDLE_VALUE;
+            HANDLE hMapping = nullptr;
+            const uint8_t* view = nullptr;
+            size_t size = 0;
+        };
+
+        // Extensions the game loads plugin files from
+        bool IsPluginFile(const std::filesystem::path& path) {
+            std::string ext = path.extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(),
+                           [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+            return ext == ".dat" || ext == ".sc4lot" || ext == ".sc4desc" || ext == ".sc4model";
+        }
+
+        // Adds the relative path, size and modification time of every plugin file under root
+        // (order independent, like the resource keys)
+        void HashPluginFiles(const std::string& root, uint64_t& sum, uint64_t& xr, uint32_t& fileCount) {
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            const fs::path rootPath(root);
+            fs::recursive_directory_iterator it(rootPath, fs::directory_options::skip_permission_denied, ec);
+            for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+                std::error_code fileEc;
+                if (!it->is_regular_file(fileEc) || !IsPluginFile(it->path())) continue;
+
+                const uint64_t size = it->file_size(fileEc);
+                const auto modified = it->last_write_time(fileEc);
+                if (fileEc) continue;
+
+                const std::string relative = it->path().lexically_relative(rootPath).string();
+                uint64_t h = Mix64(HashString(relative.c_str()) ^ Mix64(size));
+                h = Mix64(h ^ static_cast<uint64_t>(modified.time_since_epoch().count()));
+                sum += h;
+                xr ^= h;
+                fileCount++;
+            }
+        }
+
+        uint32_t AppendString(std::vector<char>& strings, std::string_view s) {
+            auto offset = static_cast<uint32_t>(strings.size());
+            strings.insert(strings.end(), s.begin(), s.end());
+            return offset;
+        }
+    }
+
+    uint64_t ComputeFingerprint(cIGZPersistResourceManager* pRM, const std::vector<std::string>& pluginDirs) {
+        if (!pRM) return 0;
+
+        cRZAutoRefCount<cIGZPersistResourceKeyList> pKeyList;
+        uint32_t totalCount = pRM->GetAvailableResourceList(pKeyList.AsPPObj(), nullptr);
+        if (totalCount == 0 || !pKeyList) {
+            LOG_WARN("Failed to enumerate resources for lot cache fingerprint");
+            return 0;
+        }
+
+        // Sum and xor of per-key hashes are both independent of enumeration order;
+        // combining the two makes accidental cancellation very unlikely.
+        uint64_t sum = 0;
+        uint64_t xr = 0;
+        uint32_t keyListSize = pKeyList->Size();
+        for (uint32_t i = 0; i < keyListSize; i++) {
+            cGZPersistResourceKey key = pKeyList->GetKey(i);
+            uint64_t h = Mix64((static_cast<uint64_t>(key.type) << 32) | key.group);
+            h = Mix64(h ^ key.instance);
+            sum += h;
+            xr ^= h;
+        }
+
+        // An edited exemplar keeps its TGI, so the files themselves are part of the fingerprint too
+        uint32_t fileCount = 0;
+        for (const std::string& dir : pluginDirs) {
+            HashPluginFiles(dir, sum, xr, fileCount);
+        }
+
+        uint64_t fingerprint = Mix64(sum ^ Mix64(xr));
+        fingerprint = Mix64(fingerprint ^ keyListSize);
+        fingerprint = Mix64(fingerprint ^ fileCount);
+        fingerprint = Mix64(fingerprint ^ kFormatVersion);
+        fingerprint = Mix64(fingerprint ^ HashString(PLUGIN_VERSION_STR));
+
+        // 0 is reserved for "no fingerprint"
+        return fingerprint != 0 ? fingerprint : 1;
+    }
+
+    std::vector<std::string> GetPluginDirectories() {
+        std::vector<std::string> dirs;
+
+        // <install>\Apps\SimCity 4.exe -> <install>\Plugins
+        char exePath[MAX_PATH] = {0};
+        if (GetModuleFileNameA(nullptr, exePath, MAX_PATH) != 0) {
+            const std::filesystem::path exe(exePath);
+            dirs.push_back((exe.parent_path().parent_path() / "Plugins").string());
+        }
+
+        cISC4AppPtr pSC4App;
+        cRZBaseString userDir;
+        if (pSC4App && pSC4App->GetUserDataDirectory(userDir)) {
+            dirs.push_back((std::filesystem::path(userDir.Data()) / "Plugins").string());
+        }
+
+        // The DLL may have been installed somewhere else, e.g. through a launcher argument
+        dirs.push_back(Config::GetModuleDir());
+
+        // Usually the user's Plugins folder holds the DLL too; hash each folder once
+        std::vector<std::string> unique;
+        for (const std::string& dir : dirs) {
+            std::error_code ec;
+            const std::string canonical = std::filesystem::weakly_canonical(dir, ec).string();
+            if (!ec && !canonical.empty()) unique.push_back(canonical);
+        }
+        std::sort(unique.begin(), unique.end());
+        unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+        return unique;
+    }
+
+    std::string GetDefaultPath() {
+        return Config::GetModuleDir() + "\\SC4AdvancedLotPlop.lotcache";
+    }
+
+    bool Save(const std::string& path, uint64_t fingerprint, const std::vector<LotConfigEntry>& cache, const LotCatalog& catalog) {
+        std::vector<SnapshotEntry> entries;
+        std::vector<uint32_t> groups;
+        std::vector<char> strings;
+        entries.reserve(cache.size());
+        groups.reserve(cache.size() * 2);
+        strings.reserve(cache.size() * 48);
+
+        for (LotHandle handle = 0; handle < cache.size(); ++handle) {
+            const LotConfigEntry& entry = cache[handle];
+            const std::string_view name = catalog.GetName(handle);
+            const std::string_view description = catalog.GetDescription(handle);
+
+            SnapshotEntry rec{};
+            rec.id = entry.id;
+            rec.nameOffset = AppendString(strings, name);
+            rec.nameLength = static_cast<uint32_t>(name.size());
+            rec.descriptionOffset = AppendString(strings, description);
+            rec.descriptionLength = static_cast<uint32_t>(description.size());
+            rec.sizeX = catalog.GetSizeX(handle);
+            rec.sizeZ = catalog.GetSizeZ(handle);
+            rec.minCapacity = catalog.GetMinCapacity(handle);
+            rec.maxCapacity = catalog.GetMaxCapacity(handle);
+            rec.growthStage = catalog.GetGrowthStage(handle);
+            rec.wealthMask = catalog.GetWealthMask(handle);
+            rec.zoneMask = catalog.GetZoneMask(handle);
+            rec.groupsOffset = static_cast<uint32_t>(groups.size());
+            catalog.GetOccupantGroups(handle, groups);
+            rec.groupsCount = static_cast<uint32_t>(groups.size() - rec.groupsOffset);
+            rec.iconInstance = entry.iconInstance;
+            rec.buildingExemplarGroup = entry.buildingExemplarGroup;
+            rec.buildingExemplarID = entry.buildingExemplarID;
+            entries.push_back(rec);
+        }
+
+        // One contiguous payload, compressed as a whole
+        const size_t entryBytes = entries.size() * sizeof(SnapshotEntry);
+        const size_t groupBytes = groups.size() * sizeof(uint32_t);
+        std::vector<uint8_t> payload(entryBytes + groupBytes + strings.size());
+        if (entryBytes) std::memcpy(payload.data(), entries.data(), entryBytes);
+        if (groupBytes) std::memcpy(payload.data() + entryBytes, groups.data(), groupBytes);
+        if (!strings.empty()) std::memcpy(payload.data() + entryBytes + groupBytes, strings.data(), strings.size());
+
+        std::vector<uint8_t> compressed;
+        if (!QFS::Compressor::Compress(payload.data(), payload.size(), compressed)) {
+            LOG_WARN("Failed to compress lot cache snapshot");
+            return false;
+        }
+
+        SnapshotHeader header{};
+        header.magic = kMagic;
+        header.version = kFormatVersion;
+        header.fingerprint = fingerprint;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.groupCount = static_cast<uint32_t>(groups.size());
+        header.stringBytes = static_cast<uint32_t>(strings.size());
+        header.payloadBytes = static_cast<uint32_t>(compressed.size());
+
+        // Write to a temporary file and swap it in, so a crash mid-write never leaves a torn snapshot
+        const std::string tempPath = path + ".tmp";
+        HANDLE hFile = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr,
+                                   CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE) {
+            LOG_WARN("Failed to create lot cache snapshot {} (error {})", tempPath, GetLastError());
+            return false;
+        }
+
+        auto writeBlock = [hFile](const void* data, size_t bytes) {
+            if (bytes == 0) return true;
+            DWORD written = 0;
+            return WriteFile(hFile, data, static_cast<DWORD>(bytes), &written, nullptr) && written == bytes;
+        };
+
+        bool ok = writeBlock(&header, sizeof(header))
+            && writeBlock(compressed.data(), compressed.size());
+        CloseHandle(hFile);
+
+        if (!ok || !MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+            LOG_WARN("Failed to write lot cache snapshot {} (error {})", path, GetLastError());
+            DeleteFileA(tempPath.c_str());
+            return false;
+        }
+
+        LOG_INFO("Saved lot cache snapshot: {} entries, {} bytes ({} uncompressed)", entries.size(),
+                 sizeof(header) + compressed.size(), sizeof(header) + payload.size());
+        return true;
+    }
+
+    bool Load(const std::string& path, uint64_t fingerprint, std::vector<LotConfigEntry>& outCache, LotCatalog& outCatalog) {
+        MappedFile file(path);
+        if (!file.Data()) {
+            LOG_DEBUG("No lot cache snapshot at {}", path);
+            return false;
+        }
+
+        if (file.Size() < sizeof(SnapshotHeader)) {
+            LOG_WARN("Lot cache snapshot is truncated, ignoring");
+            return false;
+        }
+
+        SnapshotHeader header;
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (header.magic != kMagic || header.version != kFormatVersion) {
+            LOG_INFO("Lot cache snapshot has an old format (version {}), rebuilding", header.version);
+            return false;
+        }
+        if (header.fingerprint != fingerprint) {
+            LOG_INFO("Plugin set changed since the lot cache snapshot was written, rebuilding");
+            return false;
+        }
+
+        if (sizeof(SnapshotHeader) + static_cast<uint64_t>(header.payloadBytes) != file.Size()) {
+            LOG_WARN("Lot cache snapshot size mismatch ({} != {}), ignoring", file.Size(),
+                     sizeof(SnapshotHeader) + static_cast<uint64_t>(header.payloadBytes));
+            return false;
+        }
+
+        const uint64_t expectedPayload = static_cast<uint64_t>(header.entryCount) * sizeof(SnapshotEntry)
+            + static_cast<uint64_t>(header.groupCount) * sizeof(uint32_t)
+            + header.stringBytes;
+        const uint8_t* stream = file.Data() + sizeof(SnapshotHeader);
+        if (QFS::Decompressor::GetUncompressedSize(stream, header.payloadBytes, QFS::Framing::Bare) != expectedPayload) {
+            LOG_WARN("Lot cache snapshot payload size mismatch, ignoring");
+            return false;
+        }
+
+        std::vector<uint8_t> payload;
+        if (!QFS::Decompressor::Decompress(stream, header.payloadBytes, QFS::Framing::Bare, payload)) {
+            LOG_WARN("Lot cache snapshot payload is corrupt, ignoring");
+            return false;
+        }
+
+        const uint8_t* entryBase = payload.data();
+        const uint8_t* groupBase = entryBase + static_cast<size_t>(header.entryCount) * sizeof(SnapshotEntry);
+        const char* stringBase = reinterpret_cast<const char*>(groupBase + static_cast<size_t>(header.groupCount) * sizeof(uint32_t));
+
+        std::vector<LotConfigEntry> loaded;
+        LotCatalog loadedCatalog;
+        LotCatalog::LotInfo info;   // Reused so its strings keep their capacity
+        loaded.reserve(header.entryCount);
+        loadedCatalog.Reserve(header.entryCount);
+
+        for (uint32_t i = 0; i < header.entryCount; i++) {
+            SnapshotEntry rec;
+            std::memcpy(&rec, entryBase + static_cast<size_t>(i) * sizeof(SnapshotEntry), sizeof(rec));
+
+            if (static_cast<uint64_t>(rec.nameOffset) + rec.nameLength > header.stringBytes
+                || static_cast<uint64_t>(rec.descriptionOffset) + rec.descriptionLength > header.stringBytes
+                || static_cast<uint64_t>(rec.groupsOffset) + rec.groupsCount > header.groupCount) {
+                LOG_WARN("Lot cache snapshot entry {} is out of bounds, ignoring snapshot", i);
+                return false;
+            }
+
+            info.id = rec.id;
+            info.name.assign(stringBase + rec.nameOffset, rec.nameLength);
+            info.description.assign(stringBase + rec.descriptionOffset, rec.descriptionLength);
+            info.sizeX = rec.sizeX;
+            info.sizeZ = rec.sizeZ;
+            info.minCapacity = rec.minCapacity;
+            info.maxCapacity = rec.maxCapacity;
+            info.growthStage = rec.growthStage;
+            info.wealthMask = rec.wealthMask;
+            info.zoneMask = rec.zoneMask;
+            info.occupantGroups.resize(rec.groupsCount);
+            if (rec.groupsCount > 0) {
+                std::memcpy(info.occupantGroups.data(), groupBase + static_cast<size_t>(rec.groupsOffset) * sizeof(uint32_t),
+                            static_cast<size_t>(rec.groupsCount) * sizeof(uint32_t));
+            }
+            loadedCatalog.Add(info);
+
+            LotConfigEntry entry;
+            entry.id = rec.id;
+            entry.iconInstance = rec.iconInstance;
+            entry.buildingExemplarGroup = rec.buildingExemplarGroup;
+            entry.buildingExemplarID = rec.buildingExemplarID;
+            // Same as a fresh build: with no icon and no model there is nothing to request
+            entry.iconRequested = entry.iconInstance == 0 && entry.buildingExemplarID == 0;
+
+            loaded.push_back(std::move(entry));
+        }
+
+        outCache = std::move(loaded);
+        outCatalog = std::move(loadedCatalog);
+        LOG_INFO("Loaded lot cache snapshot: {} entries", outCache.size());
+        return true;
+    }
+}
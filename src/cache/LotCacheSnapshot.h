@@ -0,0 +1,133 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../lots/LotCatalog.h"
+#include "../lots/LotConfigEntry.h"
+
+class cIGZPersistResourceManager;
+
+/**
+ * @brief Persistent on-disk snapshot of the lot configuration cache
+ *
+ * The snapshot stores everything the lot cache derives from exemplars and lot configurations
+ * (names, sizes, capacities, growth stage, zone/wealth masks, occupant groups, icon instance
+ * and building exemplar key) so a city load with an unchanged plugin set can skip loading
+ * every exemplar.
+ * Icons are never stored; they are recreated lazily from the saved keys. Entries with neither
+ * an icon instance nor a building exemplar key have nothing to load and are never requested.
+ *
+ * File layout (little-endian): an uncompressed SnapshotHeader, then a QFS stream of
+ * payloadBytes bytes that expands to fixed-size records followed by flat arrays:
+ *   SnapshotEntry[entryCount]
+ *   uint32_t occupantGroups[groupCount]
+ *   char strings[stringBytes]
+ * Names and descriptions repeat a lot across a plugin set, so the payload compresses well.
+ *
+ * A snapshot is only accepted when its magic, format version and plugin fingerprint
+ * all match; anything else is treated as a cache miss and the cache is rebuilt.
+ */
+namespace LotCacheSnapshot {
+    constexpr uint32_t kMagic = 0x43504C41; // 'ALPC'
+    // Bump whenever SnapshotHeader/SnapshotEntry or the fingerprint inputs change
+    constexpr uint32_t kFormatVersion = 4;
+
+    #pragma pack(push, 1)
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint32_t entryCount;
+        uint32_t groupCount;
+        uint32_t stringBytes;
+        uint32_t payloadBytes;      // Size of the QFS stream that follows the header
+    };
+
+    struct SnapshotEntry {
+        uint32_t id;
+        uint32_t nameOffset, nameLength;
+        uint32_t descriptionOffset, descriptionLength;
+        uint32_t sizeX, sizeZ;
+        uint16_t minCapacity, maxCapacity;
+        uint8_t growthStage;
+        uint8_t wealthMask;
+        uint8_t padding[2];
+        uint32_t zoneMask;
+        uint32_t groupsOffset, groupsCount;
+        uint32_t iconInstance;
+        uint32_t buildingExemplarGroup;
+        uint32_t buildingExemplarID;
+    };
+    #pragma pack(pop)
+
+    static_assert(sizeof(SnapshotHeader) == 32, "SnapshotHeader layout changed; bump kFormatVersion");
+    static_assert(sizeof(SnapshotEntry) == 60, "SnapshotEntry layout changed; bump kFormatVersion");
+
+    /**
+     * @brief Compute a fingerprint of the currently loaded plugin set
+     *
+     * Hashes the TGI of every resource known to the resource manager and the relative path,
+     * size and modification time of every plugin file under pluginDirs (both order independent),
+     * together with the resource and file counts, snapshot format version and plugin version.
+     * Editing an exemplar in place keeps its TGI but changes its file, so it invalidates the snapshot.
+     * @param pRM Resource manager
+     * @param pluginDirs Folders the game loads plugins from (see GetPluginDirectories)
+     * @return Fingerprint, or 0 if the resource list could not be enumerated
+     */
+    uint64_t ComputeFingerprint(cIGZPersistResourceManager* pRM, const std::vector<std::string>& pluginDirs);
+
+    /**
+     * @brief The game's and the user's Plugins folders and the folder holding this DLL
+     *
+     * Canonical paths, each listed once.
+     */
+    std::vector<std::string> GetPluginDirectories();
+
+    /**
+     * @brief Default snapshot location (next to the plugin DLL)
+     */
+    std::string GetDefaultPath();
+
+    /**
+     * @brief Write the lot cache to disk
+     * @param path Destination file (written to a temporary file, then swapped in)
+     * @param fingerprint Fingerprint the cache was built against
+     * @param cache Lot cache entries to serialize (icons are ignored)
+     * @param catalog Catalog rows of the entries (same order)
+     * @return true if the snapshot was written successfully
+     */
+    bool Save(const std::string& path, uint64_t fingerprint, const std::vector<LotConfigEntry>& cache, const LotCatalog& catalog);
+
+    /**
+     * @brief Load a lot cache snapshot from disk
+     *
+     * The file is memory-mapped and its payload decompressed and validated before any entry is materialized.
+     * @param path Snapshot file
+     * @param fingerprint Expected fingerprint; a mismatch rejects the snapshot
+     * @param outCache Receives the entries on success (left untouched on failure)
+     * @param outCatalog Receives the entries' catalog rows on success (left untouched on failure)
+     * @return true if a valid, matching snapshot was loaded
+     */
+    bool Load(const std::string& path, uint64_t fingerprint, std::vector<LotConfigEntry>& outCache, LotCatalog& outCatalog);
+}
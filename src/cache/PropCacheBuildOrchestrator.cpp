@@ -27,6 +27,7 @@
 #include "GZServPtrs.h"
 #include "PropCacheManager.h"
 #include "../props/PropPainterUI.h"
+#include "../s3d/FSHTextureCache.h"
 #include "../utils/Logger.h"
 
 PropCacheBuildOrchestrator::PropCacheBuildOrchestrator(
@@ -97,18 +98,23 @@ bool PropCacheBuildOrchestrator::Update() {
 
     switch (phase) {
         case Phase::BuildingPropCache: {
-            // Process props incrementally (5 per frame)
+            // Process props incrementally; thumbnails render on worker threads
             cIGZPersistResourceManagerPtr pRM;
 
             int processed = cacheManager.ProcessPropBatch(pRM, pDevice, pContext, PROPS_PER_FRAME);
+            cacheManager.ProcessThumbnailResults(pRM, pDevice, THUMBNAILS_PER_FRAME);
 
             // Update progress in UI
-            int current = cacheManager.GetProcessedPropCount();
-            int total = cacheManager.GetTotalPropCount();
-            ui.UpdateLoadingProgress("Processing props...", current, total);
+            if (!cacheManager.IsProcessingComplete()) {
+                int current = cacheManager.GetProcessedPropCount();
+                int total = cacheManager.GetTotalPropCount();
+                ui.UpdateLoadingProgress("Processing props...", current, total);
+            } else {
+                ui.UpdateLoadingProgress("Rendering thumbnails...", 0, 0);
+            }
 
             // Check if complete
-            if (cacheManager.IsProcessingComplete()) {
+            if (cacheManager.IsProcessingComplete() && cacheManager.IsThumbnailRenderingComplete()) {
                 phase = Phase::Complete;
                 LOG_INFO("Prop cache processing complete");
             }
@@ -120,6 +126,7 @@ bool PropCacheBuildOrchestrator::Update() {
             // Finalize cache build
             cacheManager.FinalizeIncrementalBuild();
             LOG_INFO("Incremental prop cache build completed with {} props", cacheManager.GetPropCount());
+            FSH::TextureCache::LogStats();
 
             // Hide loading UI
             ui.ShowLoadingWindow(false);
@@ -146,6 +153,9 @@ void PropCacheBuildOrchestrator::Cancel() {
 
     LOG_INFO("Cancelling incremental prop cache build");
 
+    // Drop thumbnails still being rendered
+    cacheManager.CancelThumbnails();
+
     // Hide loading UI
     ui.ShowLoadingWindow(false);
 
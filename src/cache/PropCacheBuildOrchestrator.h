@@ -88,5 +88,6 @@ private:
     ID3D11Device* pDevice;
     ID3D11DeviceContext* pContext;
 
-    static constexpr int PROPS_PER_FRAME = 5;  // Conservative batch size for prop thumbnail generation
+    static constexpr int PROPS_PER_FRAME = 20;        // Exemplar and S3D reads per frame (rendering is off-thread)
+    static constexpr int THUMBNAILS_PER_FRAME = 16;   // Thumbnail texture reads and uploads per frame
 };
\ No newline at end of file
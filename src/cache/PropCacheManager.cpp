@@ -13,6 +13,7 @@
 #include "SC4Vector.h"
 #include "../exemplar/PropertyUtil.h"
 #include "../s3d/S3DThumbnailGenerator.h"
+#include "../s3d/S3DThumbnailPipeline.h"
 #include "../utils/Logger.h"
 
 static constexpr uint32_t kResourceKeyType1 = 0x27812821; // RKT1
@@ -29,7 +30,9 @@ PropCacheManager::~PropCacheManager() {
 }
 
 void PropCacheManager::Clear() {
+    CancelThumbnails();
     props.clear();
+    iconAtlas.Clear();
     propIDToIndex.clear();
     familyTypes.clear();
     pPropManager = nullptr;
@@ -100,6 +103,11 @@ bool PropCacheManager::BeginIncrementalBuild(cISC4City* pCity) {
         return false;
     }
 
+    CancelThumbnails();
+    if (!thumbnailPipeline) {
+        thumbnailPipeline = std::make_unique<S3D::ThumbnailPipeline>();
+    }
+
     // Load prop family types
     SC4Vector<uint32_t> families;
     this->pPropManager->GetAllPropFamilyTypes(families);
@@ -159,6 +167,40 @@ bool PropCacheManager::IsProcessingComplete() const {
     return propTypesToProcess.empty() || currentPropIndex >= static_cast<int>(propTypesToProcess.size());
 }
 
+int PropCacheManager::ProcessThumbnailResults(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, int maxThumbnails) {
+    if (!thumbnailPipeline) return 0;
+
+    std::vector<S3D::ThumbnailPipeline::Result> results;
+    thumbnailPipeline->Pump(pRM, maxThumbnails, results);
+    for (const auto& result : results) {
+        ApplyThumbnail(pDevice, result.id, result.rgba, result.size);
+    }
+    return static_cast<int>(results.size());
+}
+
+int PropCacheManager::GetPendingThumbnailCount() const {
+    return thumbnailPipeline ? static_cast<int>(thumbnailPipeline->GetPendingCount()) : 0;
+}
+
+void PropCacheManager::CancelThumbnails() {
+    if (thumbnailPipeline) {
+        thumbnailPipeline->Cancel();
+    }
+}
+
+void PropCacheManager::ApplyThumbnail(ID3D11Device* pDevice, uint32_t propID, const std::vector<uint8_t>& rgba, int size) {
+    if (!pDevice || rgba.empty()) return;
+
+    auto it = propIDToIndex.find(propID);
+    if (it == propIDToIndex.end() || props[it->second].iconType != PropCacheEntry::IconType::None) return;
+
+    PropCacheEntry& entry = props[it->second];
+    if (!iconAtlas.AddPixels(pDevice, rgba.data(), size, size, size * 4, entry.icon)) return;
+    entry.iconWidth = size;
+    entry.iconHeight = size;
+    entry.iconType = PropCacheEntry::IconType::S3D;
+}
+
 void PropCacheManager::FinalizeIncrementalBuild() {
     LOG_INFO("Finalizing prop cache with {} props", props.size());
     propTypesToProcess.clear();
@@ -216,8 +258,12 @@ bool PropCacheManager::ProcessPropEntry(
         entry.s3dGroup = s3dKey.group;
         entry.s3dInstance = s3dKey.instance;
 
+        // Render on the worker threads; ProcessThumbnailResults attaches the result later
+        if (thumbnailPipeline) {
+            thumbnailPipeline->Submit(propID, pPropExemplar, pRM, 64, 5, 0);
+        }
         // Generate S3D thumbnail if D3D11 is available
-        if (pDevice && pContext) {
+        else if (pDevice && pContext) {
             ID3D11ShaderResourceView* s3dSRV =
                 S3D::ThumbnailGenerator::GenerateThumbnailFromExemplar(
                     pPropExemplar,
@@ -230,10 +276,12 @@ bool PropCacheManager::ProcessPropEntry(
                 );
 
             if (s3dSRV) {
-                entry.iconSRV = s3dSRV;
-                entry.iconWidth = 64;
-                entry.iconHeight = 64;
-                entry.iconType = PropCacheEntry::IconType::S3D;
+                if (iconAtlas.AddTexture(pDevice, s3dSRV, entry.icon)) {
+                    entry.iconWidth = 64;
+                    entry.iconHeight = 64;
+                    entry.iconType = PropCacheEntry::IconType::S3D;
+                }
+                s3dSRV->Release();
             }
         }
     }
@@ -275,6 +323,15 @@ bool PropCacheManager::LoadPropsFromManager(
         ProcessPropEntry(propID, pRM, pDevice, pContext);
     }
 
+    // Thumbnails submitted to the pipeline (if an incremental build created it)
+    if (thumbnailPipeline) {
+        std::vector<S3D::ThumbnailPipeline::Result> results;
+        thumbnailPipeline->Drain(pRM, results);
+        for (const auto& result : results) {
+            ApplyThumbnail(pDevice, result.id, result.rgba, result.size);
+        }
+    }
+
     LOG_INFO("Successfully loaded {} props with thumbnails", props.size());
     return true;
 }
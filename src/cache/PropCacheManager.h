@@ -2,8 +2,10 @@
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 
+#include "../gfx/IconAtlas.h"
 #include "../props/PropCacheEntry.h"
 
 class cISC4City;
@@ -11,6 +13,9 @@ class cISC4PropManager;
 class cIGZPersistResourceManager;
 struct ID3D11Device;
 struct ID3D11DeviceContext;
+struct ID3D11ShaderResourceView;
+
+namespace S3D { class ThumbnailPipeline; }
 
 /**
  * @brief Manages a cache of all available props and their thumbnails
@@ -69,6 +74,28 @@ public:
      */
     bool IsProcessingComplete() const;
 
+    /**
+     * @brief Upload S3D thumbnails finished by the worker threads (call once per frame)
+     * @param maxThumbnails Cap on thumbnail texture reads and uploads in this call
+     * @return Number of thumbnails returned by the pipeline
+     */
+    int ProcessThumbnailResults(cIGZPersistResourceManager* pRM, ID3D11Device* pDevice, int maxThumbnails);
+
+    /**
+     * @brief Number of thumbnails still being rendered
+     */
+    int GetPendingThumbnailCount() const;
+
+    /**
+     * @brief Check if every submitted thumbnail has been uploaded
+     */
+    bool IsThumbnailRenderingComplete() const { return GetPendingThumbnailCount() == 0; }
+
+    /**
+     * @brief Drop thumbnails that are still being rendered
+     */
+    void CancelThumbnails();
+
     /**
      * @brief Get the number of props processed so far
      */
@@ -99,6 +126,11 @@ public:
      */
     const std::vector<PropCacheEntry>& GetAllProps() const { return props; }
 
+    /**
+     * @brief Atlas holding every prop thumbnail (PropCacheEntry::icon refers to its pages)
+     */
+    const gfx::IconAtlas& GetIconAtlas() const { return iconAtlas; }
+
     /**
      * @brief Get a prop entry by ID
      */
@@ -134,14 +166,20 @@ private:
         ID3D11DeviceContext* pContext
     );
 
+    void ApplyThumbnail(ID3D11Device* pDevice, uint32_t propID, const std::vector<uint8_t>& rgba, int size);
+
     bool initialized;
     std::vector<PropCacheEntry> props;
+    gfx::IconAtlas iconAtlas;
     std::map<uint32_t, size_t> propIDToIndex;
     std::vector<uint32_t> familyTypes;
     std::vector<uint32_t> propTypesToProcess;  // For incremental building
     cISC4PropManager* pPropManager;
     ProgressCallback progressCallback;
 
+    // Worker-thread S3D thumbnails (created by the first incremental build)
+    std::unique_ptr<S3D::ThumbnailPipeline> thumbnailPipeline;
+
     // Incremental build state
     int currentPropIndex = 0;
     int processedPropCount = 0;
@@ -59,6 +59,25 @@ static bool DecodePNGWithWIC(const void* data, size_t size, uint8_t** out_rgba,
     return true;
 }
 
+bool DecodePNGToRGBA(const void* data, size_t size,
+                     std::vector<uint8_t>& out_rgba,
+                     int* out_width,
+                     int* out_height)
+{
+    if (!data || !size) return false;
+
+    uint8_t* rgba = nullptr; UINT w = 0, h = 0;
+    if (!DecodePNGWithWIC(data, size, &rgba, &w, &h))
+        return false;
+
+    out_rgba.assign(rgba, rgba + static_cast<size_t>(w) * h * 4);
+    free(rgba);
+
+    if (out_width) *out_width = static_cast<int>(w);
+    if (out_height) *out_height = static_cast<int>(h);
+    return true;
+}
+
 bool CreateSRVFromPNGMemory(const void* data, size_t size,
                             ID3D11Device* device,
                             ID3D11ShaderResourceView** out_srv,
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <vector>
 
 struct ID3D11Device;
 struct ID3D11ShaderResourceView;
@@ -12,4 +13,10 @@ namespace gfx {
                                 ID3D11ShaderResourceView** out_srv,
                                 int* out_width,
                                 int* out_height);
+
+    // Decodes a PNG from memory using WIC into tightly packed RGBA8 pixels.
+    bool DecodePNGToRGBA(const void* data, size_t size,
+                         std::vector<uint8_t>& out_rgba,
+                         int* out_width,
+                         int* out_height);
 }
@@ -0,0 +1,171 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "IconAtlas.h"
+
+#include <d3d11.h>
+#include <wil/com.h>
+
+#include "../utils/Logger.h"
+
+namespace gfx {
+
+IconAtlas::Page::~Page() {
+    if (srv) srv->Release();
+    if (texture) texture->Release();
+}
+
+IconAtlas::~IconAtlas() {
+    Clear();
+}
+
+void IconAtlas::Clear() {
+    pages.clear();
+}
+
+ID3D11ShaderResourceView* IconAtlas::GetPageSRV(uint16_t page) const {
+    return page < pages.size() ? pages[page]->srv : nullptr;
+}
+
+bool IconAtlas::AddPixels(ID3D11Device* pDevice, const uint8_t* rgba, int width, int height, int pitch,
+                          IconAtlasRegion& outRegion) {
+    if (!pDevice || !rgba || width <= 0 || height <= 0 || pitch < width * 4) return false;
+
+    uint16_t page;
+    int x, y;
+    if (!Allocate(pDevice, width, height, page, x, y)) return false;
+
+    wil::com_ptr<ID3D11DeviceContext> context;
+    pDevice->GetImmediateContext(&context);
+    if (!context) return false;
+
+    D3D11_BOX box = {};
+    box.left = static_cast<UINT>(x);
+    box.top = static_cast<UINT>(y);
+    box.right = static_cast<UINT>(x + width);
+    box.bottom = static_cast<UINT>(y + height);
+    box.front = 0;
+    box.back = 1;
+    context->UpdateSubresource(pages[page]->texture, 0, &box, rgba, static_cast<UINT>(pitch), 0);
+
+    outRegion = MakeRegion(page, x, y, width, height);
+    return true;
+}
+
+bool IconAtlas::AddTexture(ID3D11Device* pDevice, ID3D11ShaderResourceView* pSRV, IconAtlasRegion& outRegion) {
+    if (!pDevice || !pSRV) return false;
+
+    wil::com_ptr<ID3D11Resource> resource;
+    pSRV->GetResource(&resource);
+    auto texture = resource.try_query<ID3D11Texture2D>();
+    if (!texture) return false;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    texture->GetDesc(&desc);
+    if (desc.Format != DXGI_FORMAT_R8G8B8A8_UNORM || desc.SampleDesc.Count != 1) {
+        LOG_WARN("IconAtlas: Can't copy texture with format {} into the atlas", static_cast<int>(desc.Format));
+        return false;
+    }
+
+    const int width = static_cast<int>(desc.Width);
+    const int height = static_cast<int>(desc.Height);
+    uint16_t page;
+    int x, y;
+    if (!Allocate(pDevice, width, height, page, x, y)) return false;
+
+    wil::com_ptr<ID3D11DeviceContext> context;
+    pDevice->GetImmediateContext(&context);
+    if (!context) return false;
+
+    context->CopySubresourceRegion(pages[page]->texture, 0, static_cast<UINT>(x), static_cast<UINT>(y), 0,
+                                   texture.get(), 0, nullptr);
+
+    outRegion = MakeRegion(page, x, y, width, height);
+    return true;
+}
+
+bool IconAtlas::Allocate(ID3D11Device* pDevice, int width, int height, uint16_t& outPage, int& outX, int& outY) {
+    const int paddedWidth = width + 2 * GUTTER;
+    const int paddedHeight = height + 2 * GUTTER;
+    if (paddedWidth > PAGE_SIZE || paddedHeight > PAGE_SIZE) {
+        LOG_WARN("IconAtlas: {}x{} icon is larger than an atlas page", width, height);
+        return false;
+    }
+
+    // Icons arrive in roughly uniform sizes, so only the newest page is worth trying
+    int x, y;
+    if (pages.empty() || !pages.back()->packer.Insert(paddedWidth, paddedHeight, x, y)) {
+        if (pages.size() >= UINT16_MAX || !AddPage(pDevice)) return false;
+        if (!pages.back()->packer.Insert(paddedWidth, paddedHeight, x, y)) return false;
+    }
+
+    outPage = static_cast<uint16_t>(pages.size() - 1);
+    outX = x + GUTTER;
+    outY = y + GUTTER;
+    return true;
+}
+
+bool IconAtlas::AddPage(ID3D11Device* pDevice) {
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = PAGE_SIZE;
+    texDesc.Height = PAGE_SIZE;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    // Start fully transparent so the gutters stay clear
+    std::vector<uint8_t> zeros(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE * 4, 0);
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = zeros.data();
+    initData.SysMemPitch = PAGE_SIZE * 4;
+
+    auto page = std::make_unique<Page>();
+    HRESULT hr = pDevice->CreateTexture2D(&texDesc, &initData, &page->texture);
+    if (FAILED(hr)) {
+        LOG_ERROR("IconAtlas: Failed to create atlas page: 0x{:08X}", hr);
+        return false;
+    }
+
+    hr = pDevice->CreateShaderResourceView(page->texture, nullptr, &page->srv);
+    if (FAILED(hr)) {
+        LOG_ERROR("IconAtlas: Failed to create atlas page SRV: 0x{:08X}", hr);
+        return false;
+    }
+
+    pages.push_back(std::move(page));
+    LOG_DEBUG("IconAtlas: Opened page {} ({}x{})", pages.size() - 1, PAGE_SIZE, PAGE_SIZE);
+    return true;
+}
+
+IconAtlasRegion IconAtlas::MakeRegion(uint16_t page, int x, int y, int width, int height) {
+    constexpr float kScale = 1.0f / PAGE_SIZE;
+    IconAtlasRegion region;
+    region.page = page;
+    region.u0 = x * kScale;
+    region.v0 = y * kScale;
+    region.u1 = (x + width) * kScale;
+    region.v1 = (y + height) * kScale;
+    return region;
+}
+
+} // namespace gfx
@@ -0,0 +1,92 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SkylinePacker.h"
+
+struct ID3D11Device;
+struct ID3D11ShaderResourceView;
+struct ID3D11Texture2D;
+
+namespace gfx {
+    // Where an icon lives in an IconAtlas: page index plus UV rectangle
+    struct IconAtlasRegion {
+        uint16_t page = 0;
+        float u0 = 0.0f, v0 = 0.0f;
+        float u1 = 0.0f, v1 = 0.0f;
+    };
+
+    /**
+     * Packs lot and prop icons into a few large RGBA8 pages instead of one texture per icon.
+     * Icons drawn from the same page share a texture, so ImGui can batch them into one draw call.
+     * Every icon gets a transparent gutter so bilinear filtering never picks up its neighbours.
+     * Main thread only (uses the immediate context).
+     */
+    class IconAtlas {
+    public:
+        static constexpr int PAGE_SIZE = 2048;
+        static constexpr int GUTTER = 1;
+
+        IconAtlas() = default;
+        ~IconAtlas();
+
+        IconAtlas(const IconAtlas&) = delete;
+        IconAtlas& operator=(const IconAtlas&) = delete;
+
+        /**
+         * Copy RGBA8 pixels into the atlas.
+         * @param pitch Bytes per source row (lets callers add a sub-rectangle of a larger image)
+         */
+        bool AddPixels(ID3D11Device* pDevice, const uint8_t* rgba, int width, int height, int pitch,
+                       IconAtlasRegion& outRegion);
+
+        /**
+         * Copy an existing RGBA8 texture into the atlas on the GPU. The caller keeps ownership of pSRV.
+         */
+        bool AddTexture(ID3D11Device* pDevice, ID3D11ShaderResourceView* pSRV, IconAtlasRegion& outRegion);
+
+        // nullptr if the page doesn't exist (e.g. the atlas was cleared after the region was handed out)
+        ID3D11ShaderResourceView* GetPageSRV(uint16_t page) const;
+        size_t GetPageCount() const { return pages.size(); }
+
+        // Release all pages; previously returned regions become invalid
+        void Clear();
+
+    private:
+        struct Page {
+            ID3D11Texture2D* texture = nullptr;
+            ID3D11ShaderResourceView* srv = nullptr;
+            SkylinePacker packer{PAGE_SIZE, PAGE_SIZE};
+
+            ~Page();
+        };
+
+        // Reserves space (gutter included) on the last page, opening a new page when it is full
+        bool Allocate(ID3D11Device* pDevice, int width, int height, uint16_t& outPage, int& outX, int& outY);
+        bool AddPage(ID3D11Device* pDevice);
+        static IconAtlasRegion MakeRegion(uint16_t page, int x, int y, int width, int height);
+
+        std::vector<std::unique_ptr<Page>> pages;
+    };
+}
@@ -55,3 +55,22 @@ bool IconLoader::LoadIconFromPNG(
     if (outHeight) *outHeight = h;
     return true;
 }
+
+bool IconLoader::LoadIconPixelsFromPNG(
+    cIGZPersistResourceManager* pRM,
+    uint32_t iconInstance,
+    std::vector<uint8_t>& outRGBA,
+    int* outWidth,
+    int* outHeight
+) {
+    if (!pRM || iconInstance == 0) {
+        return false;
+    }
+
+    std::vector<uint8_t> pngBytes;
+    if (!ExemplarUtil::LoadPNGByInstance(pRM, iconInstance, pngBytes) || pngBytes.empty()) {
+        return false;
+    }
+
+    return gfx::DecodePNGToRGBA(pngBytes.data(), pngBytes.size(), outRGBA, outWidth, outHeight);
+}
@@ -20,6 +20,7 @@
  */
 #pragma once
 #include <cstdint>
+#include <vector>
 
 class cIGZPersistResourceManager;
 struct ID3D11Device;
@@ -48,4 +49,17 @@ public:
         int* outWidth,
         int* outHeight
     );
+
+    /**
+     * Load an icon from a PNG resource instance ID as RGBA8 pixels (e.g. for an IconAtlas).
+     * @param outRGBA Output pixels, tightly packed (width * 4 bytes per row)
+     * @return true if successful, false otherwise
+     */
+    static bool LoadIconPixelsFromPNG(
+        cIGZPersistResourceManager* pRM,
+        uint32_t iconInstance,
+        std::vector<uint8_t>& outRGBA,
+        int* outWidth,
+        int* outHeight
+    );
 };
@@ -0,0 +1,120 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+namespace gfx {
+
+SkylinePacker::SkylinePacker(int width, int height)
+    : width(width), height(height) {
+    Reset();
+}
+
+void SkylinePacker::Reset() {
+    skyline.clear();
+    skyline.push_back({0, 0, width});
+    usedArea = 0;
+}
+
+bool SkylinePacker::Insert(int rectWidth, int rectHeight, int& outX, int& outY) {
+    if (rectWidth <= 0 || rectHeight <= 0 || rectWidth > width || rectHeight > height) {
+        return false;
+    }
+
+    size_t bestIndex = SIZE_MAX;
+    int bestTop = INT_MAX;
+    int bestX = 0;
+    int bestY = 0;
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int y;
+        if (!FitsAt(i, rectWidth, rectHeight, y)) continue;
+
+        // Lowest top edge wins; leftmost on ties
+        const int top = y + rectHeight;
+        if (top < bestTop || (top == bestTop && skyline[i].x < bestX)) {
+            bestIndex = i;
+            bestTop = top;
+            bestX = skyline[i].x;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == SIZE_MAX) return false;
+
+    AddLevel(bestIndex, bestX, bestY, rectWidth, rectHeight);
+    usedArea += static_cast<size_t>(rectWidth) * static_cast<size_t>(rectHeight);
+    outX = bestX;
+    outY = bestY;
+    return true;
+}
+
+bool SkylinePacker::FitsAt(size_t index, int rectWidth, int rectHeight, int& outY) const {
+    const int x = skyline[index].x;
+    if (x + rectWidth > width) return false;
+
+    // The rectangle rests on the highest segment it spans
+    int y = 0;
+    int remaining = rectWidth;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, skyline[i].y);
+        if (y + rectHeight > height) return false;
+        remaining -= skyline[i].width;
+    }
+
+    outY = y;
+    return true;
+}
+
+void SkylinePacker::AddLevel(size_t index, int x, int y, int rectWidth, int rectHeight) {
+    skyline.insert(skyline.begin() + index, {x, y + rectHeight, rectWidth});
+
+    // Trim or drop the segments now covered by the new one
+    const int right = x + rectWidth;
+    for (size_t i = index + 1; i < skyline.size(); ) {
+        Segment& segment = skyline[i];
+        if (segment.x >= right) break;
+
+        const int overlap = right - segment.x;
+        if (overlap >= segment.width) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        segment.x += overlap;
+        segment.width -= overlap;
+        break;
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size(); ) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+
+} // namespace gfx
@@ -0,0 +1,64 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace gfx {
+    /**
+     * Skyline rectangle packer (bottom-left heuristic) for fixed-size atlas pages.
+     * Tracks the top edge of the packed area as a list of horizontal segments and places
+     * each rectangle where its top ends up lowest. Pure CPU code with no D3D dependency.
+     */
+    class SkylinePacker {
+    public:
+        SkylinePacker(int width, int height);
+
+        /**
+         * Reserve a width x height rectangle.
+         * @return false if it doesn't fit anywhere on the page
+         */
+        bool Insert(int width, int height, int& outX, int& outY);
+
+        // Forget all placed rectangles
+        void Reset();
+
+        int GetWidth() const { return width; }
+        int GetHeight() const { return height; }
+        size_t GetUsedArea() const { return usedArea; }
+
+    private:
+        struct Segment {
+            int x;
+            int y;      // Top of the packed area over [x, x + width)
+            int width;
+        };
+
+        // Lowest y at which a rectangle starting at segment 'index' fits, or false
+        bool FitsAt(size_t index, int rectWidth, int rectHeight, int& outY) const;
+        void AddLevel(size_t index, int x, int y, int rectWidth, int rectHeight);
+
+        int width;
+        int height;
+        size_t usedArea = 0;
+        std::vector<Segment> skyline;
+    };
+}
@@ -1,10 +1,12 @@
 #include "AdvancedLotPlopUI.h"
 
 #include <algorithm>
+#include <climits>
 #include <unordered_set>
 
 #include "LotConfigEntry.h"
 #include "LotConfigTableEntry.h"
+#include "../cache/LotCacheManager.h"
 #include "../utils/Config.h"
 #include "../vendor/imgui/imgui.h"
 #include "utils/Logger.h"
@@ -25,25 +27,17 @@ void AdvancedLotPlopUI::SetCity(cISC4City* city)
 	pCity = city;
 }
 
-void AdvancedLotPlopUI::SetLotEntries(const std::vector<LotConfigEntry>* entries)
+void AdvancedLotPlopUI::SetLotHandles(const std::vector<LotHandle>* handles)
 {
-	lotEntries = entries;
-	// Rebuild MRU list with fresh copies from new entries (drop stale ones)
-	if (lotEntries)
-	{
-		std::vector<LotConfigEntry> refreshed;
-		refreshed.reserve(mruOrdered.size());
-		for (const auto& old : mruOrdered)
-		{
-			auto it = std::find_if(lotEntries->begin(), lotEntries->end(), [&old](const LotConfigEntry& e){ return e.id == old.id; });
-			if (it != lotEntries->end()) refreshed.push_back(*it);
-		}
-		mruOrdered.swap(refreshed);
-	}
-	else
-	{
-		mruOrdered.clear();
-	}
+	lotHandles = handles;
+	lotHandlesGeneration = lotCache ? lotCache->GetGeneration() : 0;
+	MarkListDirty();
+}
+
+bool AdvancedLotPlopUI::HasCurrentHandles() const
+{
+	// Handles from before a cache rebuild may point past (or at different) entries
+	return lotCache && lotHandles && lotHandlesGeneration == lotCache->GetGeneration();
 }
 
 bool* AdvancedLotPlopUI::GetShowWindowPtr()
@@ -67,6 +61,18 @@ uint32_t AdvancedLotPlopUI::GetMinSizeZ() const { return minSizeZ; }
 uint32_t AdvancedLotPlopUI::GetMaxSizeZ() const { return maxSizeZ; }
 const char* AdvancedLotPlopUI::GetSearchBuffer() const { return searchBuffer; }
 
+LotQuery AdvancedLotPlopUI::BuildQuery() const
+{
+	LotQuery query;
+	query.sizeX = {minSizeX, maxSizeX};
+	query.sizeZ = {minSizeZ, maxSizeZ};
+	query.AddZoneFilter(filterZoneType);
+	query.AddWealthFilter(filterWealthType);
+	query.groups = groupQuery;
+	query.ParseSearch(searchBuffer, &Config::GetOccupantGroupNames());
+	return query;
+}
+
 void AdvancedLotPlopUI::SetFilters(uint8_t zone, uint8_t wealth, uint32_t minX, uint32_t maxX, uint32_t minZ,
                                    uint32_t maxZ, const char* search)
 {
@@ -135,6 +141,8 @@ void AdvancedLotPlopUI::Render()
 	RenderLoadingWindow();
 	if (!showWindow) return;
 
+	iconRequests.clear();
+
 	ImGui::SetNextWindowSize(ImVec2(700, 600), ImGuiCond_FirstUseEver);
 	if (ImGui::Begin("Advanced LotPlop", &showWindow))
 	{
@@ -162,6 +170,9 @@ void AdvancedLotPlopUI::Render()
 		}
 	}
 	ImGui::End();
+
+	// Replaces last frame's request, which cancels rows that scrolled out of range
+	if (callbacks.OnRequestIcons) callbacks.OnRequestIcons(iconRequests);
 }
 
 void AdvancedLotPlopUI::RenderFilters()
@@ -250,6 +261,19 @@ void AdvancedLotPlopUI::RenderFilters()
 		SavePersistedState();
 		if (callbacks.OnRefreshList) callbacks.OnRefreshList();
 	}
+	ImGui::SameLine();
+	ImGui::TextDisabled("(?)");
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::SetTooltip(
+			"Words and \"quoted phrases\" must all appear in the name or description.\n"
+			"Fields narrow further:\n"
+			"  size:2x3  size:2x3..4x4  size:..3x3\n"
+			"  zone:R|C|I|A|P|none|other  wealth:$|$$|$$$\n"
+			"  stage:>=3  cap:>200  cap:100..500  (maximum capacity)\n"
+			"  group:0x1500  group:Landmark  -group:Reward\n"
+			"Example: size:2x3..4x4 zone:R wealth:$$ stage:>=3 \"high school\"");
+	}
 
 	if (ImGui::Button("Clear filters"))
 	{
@@ -260,7 +284,7 @@ void AdvancedLotPlopUI::RenderFilters()
 		minSizeZ = 1;
 		maxSizeZ = 16;
 		searchBuffer[0] = '\0';
-		selectedOccupantGroups.clear();
+		groupQuery.Clear();
 		favoritesOnly = false; // reset favoritesOnly when clearing filters
 		MarkListDirty();
 		SavePersistedState();
@@ -272,8 +296,6 @@ void AdvancedLotPlopUI::RenderOccupantGroupFilter()
 {
 	const auto& names = Config::GetOccupantGroupNames();
 
-	// Build a set for quick lookup and change tracking
-	std::unordered_set<uint32_t> selectedSet(selectedOccupantGroups.begin(), selectedOccupantGroups.end());
 	bool anyChanged = false;
 
 	// Helpers: trim and split prefix before ':'
@@ -334,7 +356,21 @@ void AdvancedLotPlopUI::RenderOccupantGroupFilter()
 		return a.min_id < b.min_id;
 	});
 
+	ImGui::TextDisabled("Click a group to cycle Any / All / Not; right-click to clear it");
+	if (!groupQuery.IsEmpty())
+	{
+		ImGui::Text("Any of %zu, all of %zu, none of %zu groups",
+		            groupQuery.anyOf.size(), groupQuery.allOf.size(), groupQuery.noneOf.size());
+		if (groupQuery.matchesNothing)
+		{
+			// Only reachable from hand-edited settings; the role buttons never create it
+			ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "These groups contradict each other, so no lot matches");
+		}
+	}
+
 	// Render groups collapsed by default
+	using Role = OccupantGroupQuery::Role;
+	static const char* kRoleLabels[] = {"##role", "Any##role", "All##role", "Not##role"};
 	for (const auto& row : groupRows)
 	{
 		auto& vec = groups[row.label];
@@ -343,16 +379,23 @@ void AdvancedLotPlopUI::RenderOccupantGroupFilter()
 		{
 			for (const auto& it : vec)
 			{
-				bool checked = selectedSet.count(it.id) != 0;
-				char buf[256];
-				const std::string& base = it.short_name.empty() ? it.full : it.short_name;
-				snprintf(buf, sizeof(buf), "%s (0x%08X)", base.c_str(), it.id);
-				if (ImGui::Checkbox(buf, &checked))
+				const Role role = groupQuery.GetRole(it.id);
+				ImGui::PushID(static_cast<int>(it.id));
+				if (ImGui::Button(kRoleLabels[static_cast<int>(role)], ImVec2(36.0f, 0.0f)))
+				{
+					// None -> Any -> All -> Not -> None
+					groupQuery.SetRole(it.id, static_cast<Role>((static_cast<int>(role) + 1) % 4));
+					anyChanged = true;
+				}
+				if (ImGui::IsItemClicked(ImGuiMouseButton_Right) && role != Role::None)
 				{
+					groupQuery.SetRole(it.id, Role::None);
 					anyChanged = true;
-					if (checked) selectedSet.insert(it.id);
-					else selectedSet.erase(it.id);
 				}
+				ImGui::SameLine();
+				const std::string& base = it.short_name.empty() ? it.full : it.short_name;
+				ImGui::Text("%s (0x%08X)", base.c_str(), it.id);
+				ImGui::PopID();
 			}
 			ImGui::TreePop();
 		}
@@ -360,14 +403,13 @@ void AdvancedLotPlopUI::RenderOccupantGroupFilter()
 
 	if (anyChanged)
 	{
-		selectedOccupantGroups.assign(selectedSet.begin(), selectedSet.end());
 		MarkListDirty();
 		SavePersistedState();
 		if (callbacks.OnRefreshList) callbacks.OnRefreshList();
 	}
 	if (ImGui::Button("Clear Group Selection"))
 	{
-		selectedOccupantGroups.clear();
+		groupQuery.Clear();
 		MarkListDirty();
 		SavePersistedState();
 		if (callbacks.OnRefreshList) callbacks.OnRefreshList();
@@ -376,7 +418,7 @@ void AdvancedLotPlopUI::RenderOccupantGroupFilter()
 
 void AdvancedLotPlopUI::RenderLotList()
 {
-	size_t count = lotEntries ? lotEntries->size() : 0;
+	size_t count = HasCurrentHandles() ? lotHandles->size() : 0;
 	ImGui::Text("Lot Configurations (%zu found)", count);
 
 	if (ImGui::BeginTable("LotTable", 5,
@@ -395,41 +437,37 @@ void AdvancedLotPlopUI::RenderLotList()
 		ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed, 60);
 		ImGui::TableHeadersRow();
 
-		// Determine sort order
-		static std::vector<int> indices; // indices into lotEntries
-		indices.clear();
-		if (lotEntries)
+		// Sort order persists across frames; only redo it when something it depends on changed
+		if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs(); sort_specs && sort_specs->SpecsDirty)
 		{
-			// Build filtered index first honoring favoritesOnly
-			std::vector<int> filtered;
-			filtered.reserve(lotEntries->size());
-			for (size_t i = 0; i < lotEntries->size(); ++i)
-			{
-				const auto& e = (*lotEntries)[i];
-				if (favoritesOnly && !IsFavorite(e.id)) continue;
-				filtered.push_back((int)i);
-			}
-			// Sort the filtered indices using existing helper by creating temp vector of entries
-			std::vector<LotConfigEntry> temp;
-			temp.reserve(filtered.size());
-			for (int idx : filtered) temp.push_back((*lotEntries)[(size_t)idx]);
-			std::vector<int> sortOrder = LotConfigTable::BuildSortedIndex(temp, favoritesSet, ImGui::TableGetSortSpecs());
-			indices.clear();
-			indices.reserve(sortOrder.size());
-			for (int si : sortOrder) indices.push_back(filtered[(size_t)si]);
-			if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs()) sort_specs->SpecsDirty = false;
+			sortColumns = LotConfigTable::CopySortSpecs(sort_specs);
+			sort_specs->SpecsDirty = false;
+			listDirty = true;
+		}
+		if (listDirty || !HasCurrentHandles()) RebuildSortedRows();
+		else ApplyFavoriteChanges();
+		favoriteChanges.clear();
+
+		if (!sortedRows.empty())
+		{
+			const std::vector<LotConfigEntry>& entries = lotCache->GetEntries();
+			const LotCatalog& catalog = lotCache->GetCatalog();
 			ImGuiListClipper clipper;
-			clipper.Begin(static_cast<int>(indices.size()));
+			clipper.Begin(static_cast<int>(sortedRows.size()));
+			int firstVisibleRow = INT_MAX;
+			int lastVisibleRow = -1;
 			while (clipper.Step())
 			{
+				firstVisibleRow = (std::min)(firstVisibleRow, clipper.DisplayStart);
+				lastVisibleRow = (std::max)(lastVisibleRow, clipper.DisplayEnd - 1);
 				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
 				{
-					int idx = indices.empty() ? row : indices[(size_t)row];
-					const auto& entry = (*lotEntries)[(size_t)idx];
+					const LotHandle handle = sortedRows[(size_t)row];
+					const auto& entry = entries[handle];
 					ImGui::TableNextRow();
 
 					// Ensure unique ImGui ID scope per row to avoid ID collisions when labels repeat
-					ImGui::PushID(idx);
+					ImGui::PushID(static_cast<int>(handle));
 
 					// Fav column
 					ImGui::TableSetColumnIndex(0);
@@ -438,7 +476,7 @@ void AdvancedLotPlopUI::RenderLotList()
 
 					// Icon column
 					ImGui::TableSetColumnIndex(1);
-					RenderIconForEntry(entry);
+					RenderIconForEntry(handle, entry);
 
 					// ID column + selection behavior spanning the row
 					ImGui::TableSetColumnIndex(2);
@@ -459,72 +497,82 @@ void AdvancedLotPlopUI::RenderLotList()
 					}
 
 					ImGui::TableSetColumnIndex(3);
-					ImGui::Text("%s", entry.name.c_str());
-					if (!entry.description.empty() && ImGui::IsItemHovered())
+					ImGui::Text("%s", catalog.GetName(handle));
+					const char* description = catalog.GetDescription(handle);
+					if (description[0] != '\0' && ImGui::IsItemHovered())
 					{
-						ImGui::SetTooltip("%s", entry.description.c_str());
+						ImGui::SetTooltip("%s", description);
 					}
 
 					ImGui::TableSetColumnIndex(4);
-					ImGui::Text("%ux%u", entry.sizeX, entry.sizeZ);
+					ImGui::Text("%ux%u", catalog.GetSizeX(handle), catalog.GetSizeZ(handle));
 
 					ImGui::PopID();
 				}
 			}
+
+			// Visible rows queued their icons while rendering; add the rows just outside the view
+			if (lastVisibleRow >= firstVisibleRow) RequestPrefetchIcons(firstVisibleRow, lastVisibleRow);
 		}
 
 		ImGui::EndTable();
 	}
 }
 
-void AdvancedLotPlopUI::RenderIconForEntry(const LotConfigEntry& entry)
+bool AdvancedLotPlopUI::NeedsIcon(LotHandle handle) const
 {
-	if (!entry.iconSRV || entry.iconType == LotConfigEntry::IconType::None)
+	const LotConfigEntry* entry = lotCache ? lotCache->GetEntry(handle) : nullptr;
+	return entry && entry->iconType == LotConfigEntry::IconType::None && !entry->iconRequested
+		&& (entry->iconInstance != 0 || entry->buildingExemplarID != 0);
+}
+
+void AdvancedLotPlopUI::RequestPrefetchIcons(int firstVisibleRow, int lastVisibleRow)
+{
+	// Nearest rows first, alternating below and above the visible range
+	const int rowCount = static_cast<int>(sortedRows.size());
+	for (int d = 1; d <= kIconPrefetchRows; ++d)
 	{
-		// No icon available - show placeholder
-		ImGui::Dummy(ImVec2(44, 44));
-		return;
+		const int below = lastVisibleRow + d;
+		const int above = firstVisibleRow - d;
+		if (below < rowCount && NeedsIcon(sortedRows[(size_t)below])) iconRequests.push_back(sortedRows[(size_t)below]);
+		if (above >= 0 && NeedsIcon(sortedRows[(size_t)above])) iconRequests.push_back(sortedRows[(size_t)above]);
 	}
+}
 
-	switch (entry.iconType)
-	{
-	case LotConfigEntry::IconType::PNG:
-		{
-			// Lot PNG icons are 176x44 made of four 44x44 states; show the second 44x44 (enabled) [pixels 44..88]
-			float u1 = (entry.iconWidth > 0) ? (44.0f / (float)entry.iconWidth) : 0.0f;
-			float v1 = 0.0f;
-			float u2 = (entry.iconWidth > 0) ? (88.0f / (float)entry.iconWidth) : 0.0f;
-			float v2 = (entry.iconHeight > 0) ? (44.0f / (float)entry.iconHeight) : 0.0f;
-			ImGui::Image((ImTextureID)entry.iconSRV, ImVec2(44, 44), ImVec2(u1, v1), ImVec2(u2, v2));
-		}
-		break;
+void AdvancedLotPlopUI::RenderIconForEntry(LotHandle handle, const LotConfigEntry& entry)
+{
+	// entry is the cache's own storage, so icons loaded after filtering show up directly
+	ID3D11ShaderResourceView* page = nullptr;
+	if (entry.iconType != LotConfigEntry::IconType::None)
+		page = lotCache->GetIconAtlas().GetPageSRV(entry.icon.page);
 
-	case LotConfigEntry::IconType::S3D:
-		{
-			// S3D thumbnail - display full square texture
-			// Center it in the 44x44 space if thumbnail is smaller
-			float displaySize = 44.0f;
-			ImVec2 cursorPos = ImGui::GetCursorPos();
-
-			if (entry.iconWidth < 44) {
-				float offset = (44.0f - entry.iconWidth) / 2.0f;
-				ImGui::SetCursorPos(ImVec2(cursorPos.x + offset, cursorPos.y + offset));
-				displaySize = (float)entry.iconWidth;
-			}
+	if (!page)
+	{
+		// No icon yet - show placeholder and ask for it (visible rows get the highest priority)
+		if (NeedsIcon(handle)) iconRequests.push_back(handle);
+		ImGui::Dummy(ImVec2(44, 44));
+		return;
+	}
 
-			ImGui::Image((ImTextureID)entry.iconSRV, ImVec2(displaySize, displaySize));
+	// Icons share a few atlas pages, so consecutive rows batch into the same draw call.
+	// PNG icons are stored as their 44x44 enabled state; S3D thumbnails are square.
+	// Center the icon in the 44x44 space if it is smaller
+	const ImVec2 uv0(entry.icon.u0, entry.icon.v0);
+	const ImVec2 uv1(entry.icon.u1, entry.icon.v1);
+	float displaySize = 44.0f;
+	ImVec2 cursorPos = ImGui::GetCursorPos();
+
+	if (entry.iconWidth < 44) {
+		float offset = (44.0f - entry.iconWidth) / 2.0f;
+		ImGui::SetCursorPos(ImVec2(cursorPos.x + offset, cursorPos.y + offset));
+		displaySize = (float)entry.iconWidth;
+	}
 
-			// Reset cursor if we offset it
-			if (entry.iconWidth < 44) {
-				ImGui::SetCursorPos(ImVec2(cursorPos.x, cursorPos.y + 44.0f));
-			}
-		}
-		break;
+	ImGui::Image((ImTextureID)page, ImVec2(displaySize, displaySize), uv0, uv1);
 
-	default:
-		// Unknown type - show placeholder
-		ImGui::Dummy(ImVec2(44, 44));
-		break;
+	// Reset cursor if we offset it
+	if (entry.iconWidth < 44) {
+		ImGui::SetCursorPos(ImVec2(cursorPos.x, cursorPos.y + 44.0f));
 	}
 }
 
@@ -536,21 +584,20 @@ void AdvancedLotPlopUI::RenderDetails()
 		return;
 	}
 
-	if (!lotEntries) return;
-
-	auto it = std::find_if(lotEntries->begin(), lotEntries->end(),
-	                       [this](const LotConfigEntry& e) { return e.id == selectedLotIID; });
+	const LotHandle handle = lotCache ? lotCache->FindHandle(selectedLotIID) : kInvalidLotHandle;
 
-	if (it != lotEntries->end())
+	if (handle != kInvalidLotHandle)
 	{
-		ImGui::Text("Selected Lot: %s", it->name.c_str());
-		ImGui::Text("ID: 0x%08X", it->id);
-		ImGui::Text("Size: %ux%u", it->sizeX, it->sizeZ);
+		const LotCatalog& catalog = lotCache->GetCatalog();
+		ImGui::Text("Selected Lot: %s", catalog.GetName(handle));
+		ImGui::Text("ID: 0x%08X", catalog.GetID(handle));
+		ImGui::Text("Size: %ux%u", catalog.GetSizeX(handle), catalog.GetSizeZ(handle));
 
-		if (!it->description.empty())
+		const char* description = catalog.GetDescription(handle);
+		if (description[0] != '\0')
 		{
 			ImGui::Separator();
-			ImGui::TextWrapped("%s", it->description.c_str());
+			ImGui::TextWrapped("%s", description);
 		}
 
 		ImGui::Spacing();
@@ -578,7 +625,10 @@ void AdvancedLotPlopUI::LoadPersistedState()
 	maxSizeZ = st.maxSizeZ;
 	strncpy_s(searchBuffer, st.search.c_str(), sizeof(searchBuffer) - 1);
 	searchBuffer[sizeof(searchBuffer) - 1] = '\0';
-	selectedOccupantGroups = st.selectedGroups;
+	groupQuery.anyOf = st.selectedGroups;
+	groupQuery.allOf = st.requiredGroups;
+	groupQuery.noneOf = st.excludedGroups;
+	groupQuery.Normalize();
 	selectedLotIID = st.selectedLotID;
 	favoritesOnly = st.favoritesOnly;
 
@@ -604,7 +654,9 @@ void AdvancedLotPlopUI::SavePersistedState()
 	st.minSizeZ = minSizeZ;
 	st.maxSizeZ = maxSizeZ;
 	st.search = searchBuffer;
-	st.selectedGroups = selectedOccupantGroups;
+	st.selectedGroups = groupQuery.anyOf;
+	st.requiredGroups = groupQuery.allOf;
+	st.excludedGroups = groupQuery.noneOf;
 	st.selectedLotID = selectedLotIID;
 	st.favorites.assign(favoritesOrdered.begin(), favoritesOrdered.end());
 	st.favoritesOnly = favoritesOnly;
@@ -613,6 +665,44 @@ void AdvancedLotPlopUI::SavePersistedState()
 
 void AdvancedLotPlopUI::MarkListDirty() { listDirty = true; }
 
+void AdvancedLotPlopUI::RebuildSortedRows()
+{
+	listDirty = false;
+	sortedRows.clear();
+	if (!HasCurrentHandles()) return;
+
+	const LotCatalog& catalog = lotCache->GetCatalog();
+	sortedRows.reserve(lotHandles->size());
+	for (LotHandle handle : *lotHandles)
+	{
+		if (favoritesOnly && !IsFavorite(catalog.GetID(handle))) continue;
+		sortedRows.push_back(handle);
+	}
+	LotConfigTable::SortRows(sortedRows, catalog, favoritesSet, sortColumns);
+}
+
+void AdvancedLotPlopUI::ApplyFavoriteChanges()
+{
+	if (!HasCurrentHandles() || favoriteChanges.empty()) return;
+
+	// Only the favorites filter and the Fav column depend on favorite state
+	constexpr int kFavColumn = 0;
+	if (!favoritesOnly && !LotConfigTable::SortsByColumn(sortColumns, kFavColumn)) return;
+
+	const LotCatalog& catalog = lotCache->GetCatalog();
+	for (uint32_t lotID : favoriteChanges)
+	{
+		// Only lots that passed the filters have a row; FilterLots returns handles in ascending order
+		const LotHandle handle = lotCache->FindHandle(lotID);
+		if (handle == kInvalidLotHandle || !std::binary_search(lotHandles->begin(), lotHandles->end(), handle)) continue;
+
+		// Take the row out and put it back where it now belongs (or leave it out)
+		sortedRows.erase(std::remove(sortedRows.begin(), sortedRows.end(), handle), sortedRows.end());
+		if (favoritesOnly && !IsFavorite(lotID)) continue;
+		LotConfigTable::InsertSortedRow(sortedRows, handle, catalog, favoritesSet, sortColumns);
+	}
+}
+
 void AdvancedLotPlopUI::ToggleFavorite(uint32_t lotID)
 {
 	if (favoritesSet.count(lotID))
@@ -625,28 +715,50 @@ void AdvancedLotPlopUI::ToggleFavorite(uint32_t lotID)
 		favoritesSet.insert(lotID);
 		favoritesOrdered.push_back(lotID);
 	}
+	// Applied before the next frame's rows are drawn, not while they're being iterated
+	favoriteChanges.push_back(lotID);
 	SavePersistedState();
 }
 
 void AdvancedLotPlopUI::RegisterPlop(uint32_t lotID)
 {
-	if (!lotEntries) return;
-	auto srcIt = std::find_if(lotEntries->begin(), lotEntries->end(), [lotID](const LotConfigEntry& e){ return e.id == lotID; });
-	if (srcIt == lotEntries->end())
+	if (!lotCache) return;
+	const LotHandle handle = lotCache->FindHandle(lotID);
+	if (handle == kInvalidLotHandle)
 	{
-		LOG_DEBUG("Register plop skipped, lot 0x{:x} not found in entries", lotID);
+		LOG_DEBUG("Register plop skipped, lot 0x{:x} not found in cache", lotID);
 		return;
 	}
-	auto existing = std::find_if(mruOrdered.begin(), mruOrdered.end(), [lotID](const LotConfigEntry& e){ return e.id == lotID; });
+	RefreshRecentHandles();
+	auto existing = std::find_if(mruOrdered.begin(), mruOrdered.end(), [lotID](const RecentLot& r){ return r.lotID == lotID; });
 	if (existing != mruOrdered.end()) mruOrdered.erase(existing);
-	mruOrdered.insert(mruOrdered.begin(), *srcIt);
+	mruOrdered.insert(mruOrdered.begin(), RecentLot{lotID, handle});
 	if (mruOrdered.size() > kMaxMRU) mruOrdered.resize(kMaxMRU);
 	LOG_DEBUG("Register plop 0x{:x}", lotID);
 }
 
+void AdvancedLotPlopUI::RefreshRecentHandles()
+{
+	if (!lotCache || mruGeneration == lotCache->GetGeneration()) return;
+	mruGeneration = lotCache->GetGeneration();
+	// Keep lots that are missing for now (e.g. mid-rebuild); they reappear once the cache has them again
+	for (RecentLot& recent : mruOrdered)
+	{
+		recent.handle = lotCache->FindHandle(recent.lotID);
+	}
+}
+
 void AdvancedLotPlopUI::RenderRecentLotList()
 {
-	ImGui::Text("Recent Plops (%zu)", mruOrdered.size());
+	RefreshRecentHandles();
+	std::vector<LotHandle> recentHandles;
+	recentHandles.reserve(mruOrdered.size());
+	for (const RecentLot& recent : mruOrdered)
+	{
+		if (recent.handle != kInvalidLotHandle) recentHandles.push_back(recent.handle);
+	}
+
+	ImGui::Text("Recent Plops (%zu)", recentHandles.size());
 	if (ImGui::BeginTable("RecentLotTable", 5,
 		ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
 		ImVec2(0.0f, 48.0f * 8)))
@@ -660,12 +772,14 @@ void AdvancedLotPlopUI::RenderRecentLotList()
 		ImGui::TableHeadersRow();
 
 		ImGuiListClipper clipper;
-		clipper.Begin(static_cast<int>(mruOrdered.size()));
+		clipper.Begin(static_cast<int>(recentHandles.size()));
 		while (clipper.Step())
 		{
 			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
 			{
-				const LotConfigEntry& entry = mruOrdered[static_cast<size_t>(row)];
+				const LotHandle handle = recentHandles[static_cast<size_t>(row)];
+				const LotConfigEntry& entry = lotCache->GetEntries()[handle];
+				const LotCatalog& catalog = lotCache->GetCatalog();
 				ImGui::TableNextRow();
 				ImGui::PushID(entry.id);
 				// Fav column
@@ -674,7 +788,7 @@ void AdvancedLotPlopUI::RenderRecentLotList()
 				if (ImGui::SmallButton(fav ? "Y" : "N")) { ToggleFavorite(entry.id); }
 				// Icon column
 				ImGui::TableSetColumnIndex(1);
-				RenderIconForEntry(entry);
+				RenderIconForEntry(handle, entry);
 				// ID/select column
 				ImGui::TableSetColumnIndex(2);
 				bool isSelected = (entry.id == selectedLotIID);
@@ -693,13 +807,14 @@ void AdvancedLotPlopUI::RenderRecentLotList()
 					if (callbacks.OnPlop) callbacks.OnPlop(entry.id);
 				}
 				ImGui::TableSetColumnIndex(3);
-				ImGui::Text("%s", entry.name.c_str());
-				if (!entry.description.empty() && ImGui::IsItemHovered())
+				ImGui::Text("%s", catalog.GetName(handle));
+				const char* description = catalog.GetDescription(handle);
+				if (description[0] != '\0' && ImGui::IsItemHovered())
 				{
-					ImGui::SetTooltip("%s", entry.description.c_str());
+					ImGui::SetTooltip("%s", description);
 				}
 				ImGui::TableSetColumnIndex(4);
-				ImGui::Text("%ux%u", entry.sizeX, entry.sizeZ);
+				ImGui::Text("%ux%u", catalog.GetSizeX(handle), catalog.GetSizeZ(handle));
 				ImGui::PopID();
 			}
 		}
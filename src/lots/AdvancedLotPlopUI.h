@@ -6,8 +6,12 @@
 #include "cISC4City.h"
 #include "cISC4LotConfiguration.h"
 #include "LotConfigEntry.h"
+#include "LotConfigTableEntry.h"
+#include "LotQuery.h"
+#include "OccupantGroupQuery.h"
 
 struct LotConfigEntry;
+class LotCacheManager;
 
 struct AdvancedLotPlopUICallbacks
 {
@@ -17,6 +21,8 @@ struct AdvancedLotPlopUICallbacks
 	void (*OnBuildCache)() = nullptr;
 	// Rebuild filtered list
 	void (*OnRefreshList)() = nullptr;
+	// Lots whose icons should be loaded, most important first (visible rows, then the rows around them)
+	void (*OnRequestIcons)(const std::vector<LotHandle>& handles) = nullptr;
 };
 
 class AdvancedLotPlopUI
@@ -25,7 +31,9 @@ public:
 	AdvancedLotPlopUI();
 	void SetCallbacks(const AdvancedLotPlopUICallbacks& cb);
 	void SetCity(cISC4City* city);
-	void SetLotEntries(const std::vector<LotConfigEntry>* entries);
+	void SetLotCache(const LotCacheManager* cache) { lotCache = cache; }
+	// Filtered handles into the lot cache; call again after every re-filter
+	void SetLotHandles(const std::vector<LotHandle>* handles);
 	bool* GetShowWindowPtr();
 	uint32_t GetSelectedLotIID() const;
 	void SetSelectedLotIID(uint32_t iid);
@@ -36,7 +44,9 @@ public:
 	uint32_t GetMinSizeZ() const;
 	uint32_t GetMaxSizeZ() const;
 	const char* GetSearchBuffer() const;
-	const std::vector<uint32_t>& GetSelectedOccupantGroups() const { return selectedOccupantGroups; }
+	const OccupantGroupQuery& GetOccupantGroupQuery() const { return groupQuery; }
+	// The filter widgets and the parsed search box as one query
+	LotQuery BuildQuery() const;
 	void Render();
 	void ShowLoadingWindow(bool show);
 	void SetLoadingProgress(const char* stage, int current, int total);
@@ -49,9 +59,10 @@ public:
 	bool IsFavorite(uint32_t lotID) const { return favoritesSet.count(lotID) != 0; }
 	void ToggleFavorite(uint32_t lotID);
 	void RegisterPlop(uint32_t lotID);
-	const std::vector<LotConfigEntry>& GetMRUEntries() const { return mruOrdered; }
 	bool IsFavoritesOnly() const { return favoritesOnly; }
 	void SetFavoritesOnly(bool v) { favoritesOnly = v; MarkListDirty(); SavePersistedState(); if (callbacks.OnRefreshList) callbacks.OnRefreshList(); }
+	// Filters or favorites changed; the table's sort order is rebuilt on the next frame
+	void MarkListDirty();
 
 private:
 	// Tabbed view helpers
@@ -59,10 +70,15 @@ private:
 	void RenderFilters();
 	void RenderLotList(); // All lots (filtered)
 	void RenderRecentLotList(); // MRU lots (unordered by filters) always most recent first
-	void RenderIconForEntry(const LotConfigEntry& entry);
+	void RenderIconForEntry(LotHandle handle, const LotConfigEntry& entry);
+	bool NeedsIcon(LotHandle handle) const;
+	bool HasCurrentHandles() const;
+	void RefreshRecentHandles();
+	void RequestPrefetchIcons(int firstVisibleRow, int lastVisibleRow);
 	void RenderDetails();
 	void RenderOccupantGroupFilter();
-	void MarkListDirty();
+	void RebuildSortedRows();
+	void ApplyFavoriteChanges();
 	AdvancedLotPlopUICallbacks callbacks{};
 	cISC4City* pCity = nullptr;
 	bool showWindow = false;
@@ -71,9 +87,17 @@ private:
 	uint32_t minSizeX = 1, maxSizeX = 16;
 	uint32_t minSizeZ = 1, maxSizeZ = 16;
 	char searchBuffer[256]{};
-	const std::vector<LotConfigEntry>* lotEntries = nullptr;
+	const LotCacheManager* lotCache = nullptr;
+	const std::vector<LotHandle>* lotHandles = nullptr;
+	uint32_t lotHandlesGeneration = 0; // Cache generation the handles were filtered against
+	std::vector<LotHandle> iconRequests; // Collected while rendering, sent once per frame
+	// Row -> handle; only rebuilt when the handles, sort specs or favorites filter change
+	std::vector<LotHandle> sortedRows;
+	std::vector<LotConfigTable::SortColumn> sortColumns;
+	std::vector<uint32_t> favoriteChanges; // Toggled since the last frame, applied to sortedRows in place
+	static constexpr int kIconPrefetchRows = 24;
 	uint32_t selectedLotIID = 0;
-	std::vector<uint32_t> selectedOccupantGroups;
+	OccupantGroupQuery groupQuery;
 	bool showLoadingWindow = false;
 	char loadingStage[256]{};
 	int loadingCurrent = 0;
@@ -81,7 +105,13 @@ private:
 	bool listDirty = true;
 	std::unordered_set<uint32_t> favoritesSet;
 	std::vector<uint32_t> favoritesOrdered;
-	std::vector<LotConfigEntry> mruOrdered; // store full entries instead of IDs; not persisted
+	struct RecentLot
+	{
+		uint32_t lotID;
+		LotHandle handle; // Re-resolved from lotID when the cache generation changes
+	};
+	std::vector<RecentLot> mruOrdered; // Not persisted
+	uint32_t mruGeneration = 0;
 	static constexpr size_t kMaxMRU = 10;
 	LotViewMode currentViewMode = LotViewMode::All; // Active tab
 	bool favoritesOnly = false; // filter toggle
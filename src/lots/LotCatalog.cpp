@@ -0,0 +1,164 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LotCatalog.h"
+
+#include <bit>
+#include <functional>
+
+LotCatalog::LotCatalog() {
+    Clear();
+}
+
+LotHandle LotCatalog::Add(const LotInfo& lot) {
+    const auto handle = static_cast<LotHandle>(ids.size());
+
+    ids.push_back(lot.id);
+    sizeX.push_back(static_cast<uint8_t>(lot.sizeX < 0xFF ? lot.sizeX : 0xFF));
+    sizeZ.push_back(static_cast<uint8_t>(lot.sizeZ < 0xFF ? lot.sizeZ : 0xFF));
+    minCapacity.push_back(lot.minCapacity);
+    maxCapacity.push_back(lot.maxCapacity);
+    growthStages.push_back(lot.growthStage);
+    zoneMasks.push_back(lot.zoneMask);
+    wealthMasks.push_back(lot.wealthMask);
+    nameOffsets.push_back(InternString(lot.name));
+    descriptionOffsets.push_back(InternString(lot.description));
+
+    groupBits.resize(groupBits.size() + groupWords, 0);
+    for (uint32_t groupID : lot.occupantGroups) {
+        const size_t index = InternGroup(groupID);
+        groupBits[static_cast<size_t>(handle) * groupWords + index / 64] |= uint64_t{1} << (index % 64);
+    }
+    return handle;
+}
+
+void LotCatalog::Clear() {
+    ids.clear();
+    sizeX.clear();
+    sizeZ.clear();
+    minCapacity.clear();
+    maxCapacity.clear();
+    growthStages.clear();
+    zoneMasks.clear();
+    wealthMasks.clear();
+
+    // Offset 0 is the empty string
+    text.assign(1, '\0');
+    nameOffsets.clear();
+    descriptionOffsets.clear();
+    stringOffsetByHash.clear();
+
+    groupIDs.clear();
+    groupIndexByID.clear();
+    groupBits.clear();
+    groupWords = 1;
+}
+
+void LotCatalog::Reserve(size_t lotCount) {
+    ids.reserve(lotCount);
+    sizeX.reserve(lotCount);
+    sizeZ.reserve(lotCount);
+    minCapacity.reserve(lotCount);
+    maxCapacity.reserve(lotCount);
+    growthStages.reserve(lotCount);
+    zoneMasks.reserve(lotCount);
+    wealthMasks.reserve(lotCount);
+    nameOffsets.reserve(lotCount);
+    descriptionOffsets.reserve(lotCount);
+    text.reserve(lotCount * 48);
+    groupBits.reserve(lotCount * groupWords);
+}
+
+size_t LotCatalog::GetMemoryUsage() const {
+    return ids.capacity() * sizeof(uint32_t)
+         + (sizeX.capacity() + sizeZ.capacity() + growthStages.capacity() + wealthMasks.capacity())
+         + (minCapacity.capacity() + maxCapacity.capacity()) * sizeof(uint16_t)
+         + zoneMasks.capacity() * sizeof(uint32_t)
+         + text.capacity()
+         + (nameOffsets.capacity() + descriptionOffsets.capacity()) * sizeof(uint32_t)
+         + groupIDs.capacity() * sizeof(uint32_t)
+         + groupBits.capacity() * sizeof(uint64_t);
+}
+
+size_t LotCatalog::BuildGroupMask(const std::vector<uint32_t>& groups, std::vector<uint64_t>& outMask) const {
+    outMask.assign(groupWords, 0);
+    size_t found = 0;
+    for (uint32_t groupID : groups) {
+        auto it = groupIndexByID.find(groupID);
+        if (it == groupIndexByID.end()) continue;
+        outMask[it->second / 64] |= uint64_t{1} << (it->second % 64);
+        ++found;
+    }
+    return found;
+}
+
+bool LotCatalog::HasOccupantGroup(LotHandle handle, uint32_t groupID) const {
+    auto it = groupIndexByID.find(groupID);
+    if (it == groupIndexByID.end()) return false;
+    return (GetGroupBits(handle)[it->second / 64] >> (it->second % 64)) & 1;
+}
+
+void LotCatalog::GetOccupantGroups(LotHandle handle, std::vector<uint32_t>& out) const {
+    const uint64_t* bits = GetGroupBits(handle);
+    for (size_t word = 0; word < groupWords; ++word) {
+        for (uint64_t w = bits[word]; w != 0; w &= w - 1) {
+            out.push_back(groupIDs[word * 64 + static_cast<size_t>(std::countr_zero(w))]);
+        }
+    }
+}
+
+uint32_t LotCatalog::InternString(std::string_view s) {
+    if (s.empty()) return 0;
+
+    // Lot variants of one building share its description, and often its name
+    const size_t hash = std::hash<std::string_view>{}(s);
+    auto it = stringOffsetByHash.find(hash);
+    if (it != stringOffsetByHash.end() && std::string_view(text.data() + it->second) == s) {
+        return it->second;
+    }
+
+    const auto offset = static_cast<uint32_t>(text.size());
+    text.insert(text.end(), s.begin(), s.end());
+    text.push_back('\0');
+    // On a hash collision the first string keeps the slot; the other is simply stored twice
+    stringOffsetByHash.emplace(hash, offset);
+    return offset;
+}
+
+size_t LotCatalog::InternGroup(uint32_t groupID) {
+    const auto [it, inserted] = groupIndexByID.emplace(groupID, static_cast<uint32_t>(groupIDs.size()));
+    if (inserted) {
+        groupIDs.push_back(groupID);
+        if (groupIDs.size() > groupWords * 64) WidenGroupBits(groupWords * 2);
+    }
+    return it->second;
+}
+
+void LotCatalog::WidenGroupBits(size_t words) {
+    // Rare: only when a new group doesn't fit; every row is re-laid out at the new width
+    std::vector<uint64_t> widened(ids.size() * words, 0);
+    for (size_t row = 0; row < ids.size(); ++row) {
+        for (size_t word = 0; word < groupWords; ++word) {
+            widened[row * words + word] = groupBits[row * groupWords + word];
+        }
+    }
+    groupBits.swap(widened);
+    groupWords = words;
+}
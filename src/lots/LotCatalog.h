@@ -0,0 +1,119 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "LotConfigEntry.h"
+
+/**
+ * Column store for the lot fields that filtering, sorting and searching read.
+ *
+ * Row i is the lot with LotHandle i; LotCacheManager keeps that lot's icon state
+ * (LotConfigEntry) at the same index. Every field lives in its own dense array, so a
+ * filter pass only touches the bytes it tests:
+ *   ids, sizeX/sizeZ, growth stages, capacities, zone and wealth masks
+ *   name/description offsets into one arena of NUL-terminated strings (identical strings stored once)
+ *   occupant groups, mapped to dense indices and stored as one fixed-width bitset per lot
+ */
+class LotCatalog {
+public:
+    // Build-time form of one lot, appended with Add
+    struct LotInfo {
+        uint32_t id = 0;
+        std::string name;
+        std::string description;
+        uint32_t sizeX = 0, sizeZ = 0;
+        uint16_t minCapacity = 0, maxCapacity = 0;
+        uint8_t growthStage = 0;
+        // bit (1 << ZoneType) per compatible zone type, bit (1 << WealthType) per wealth type
+        uint32_t zoneMask = 0;
+        uint8_t wealthMask = 0;
+        std::vector<uint32_t> occupantGroups;   // Raw occupant group IDs
+    };
+
+    LotCatalog();
+
+    // Appends a lot; the returned handle is its row
+    LotHandle Add(const LotInfo& lot);
+    void Clear();
+    void Reserve(size_t lotCount);
+
+    size_t GetCount() const { return ids.size(); }
+    size_t GetMemoryUsage() const;
+
+    uint32_t GetID(LotHandle handle) const { return ids[handle]; }
+    // NUL-terminated; valid until the next Add or Clear
+    const char* GetName(LotHandle handle) const { return text.data() + nameOffsets[handle]; }
+    const char* GetDescription(LotHandle handle) const { return text.data() + descriptionOffsets[handle]; }
+    uint32_t GetSizeX(LotHandle handle) const { return sizeX[handle]; }
+    uint32_t GetSizeZ(LotHandle handle) const { return sizeZ[handle]; }
+    uint16_t GetMinCapacity(LotHandle handle) const { return minCapacity[handle]; }
+    uint16_t GetMaxCapacity(LotHandle handle) const { return maxCapacity[handle]; }
+    uint8_t GetGrowthStage(LotHandle handle) const { return growthStages[handle]; }
+    uint32_t GetZoneMask(LotHandle handle) const { return zoneMasks[handle]; }
+    uint8_t GetWealthMask(LotHandle handle) const { return wealthMasks[handle]; }
+
+    // Whole columns, indexed by LotHandle, for scans over every lot
+    const std::vector<uint8_t>& GetSizeXColumn() const { return sizeX; }
+    const std::vector<uint8_t>& GetSizeZColumn() const { return sizeZ; }
+    const std::vector<uint32_t>& GetZoneMaskColumn() const { return zoneMasks; }
+    const std::vector<uint8_t>& GetWealthMaskColumn() const { return wealthMasks; }
+
+    // Occupant group bitsets: GetGroupWords() 64-bit words per lot, bit i = GetGroupID(i)
+    size_t GetGroupWords() const { return groupWords; }
+    size_t GetGroupCount() const { return groupIDs.size(); }
+    uint32_t GetGroupID(size_t groupIndex) const { return groupIDs[groupIndex]; }
+    const uint64_t* GetGroupBits(LotHandle handle) const { return groupBits.data() + static_cast<size_t>(handle) * groupWords; }
+    const std::vector<uint64_t>& GetGroupBitsColumn() const { return groupBits; }
+
+    // GetGroupWords() wide mask with the given groups set; groups no lot has are left out.
+    // Returns how many of the groups were set.
+    size_t BuildGroupMask(const std::vector<uint32_t>& groups, std::vector<uint64_t>& outMask) const;
+    bool HasOccupantGroup(LotHandle handle, uint32_t groupID) const;
+    // Appends the lot's raw occupant group IDs
+    void GetOccupantGroups(LotHandle handle, std::vector<uint32_t>& out) const;
+
+private:
+    uint32_t InternString(std::string_view s);
+    size_t InternGroup(uint32_t groupID);
+    void WidenGroupBits(size_t words);
+
+    std::vector<uint32_t> ids;
+    std::vector<uint8_t> sizeX, sizeZ;          // Tiles; real lots are far below 255
+    std::vector<uint16_t> minCapacity, maxCapacity;
+    std::vector<uint8_t> growthStages;
+    std::vector<uint32_t> zoneMasks;
+    std::vector<uint8_t> wealthMasks;
+
+    std::vector<char> text;                     // "\0" followed by every distinct string, NUL-terminated
+    std::vector<uint32_t> nameOffsets, descriptionOffsets;
+    std::unordered_map<size_t, uint32_t> stringOffsetByHash;
+
+    std::vector<uint32_t> groupIDs;             // Dense index -> raw occupant group ID
+    std::unordered_map<uint32_t, uint32_t> groupIndexByID;
+    std::vector<uint64_t> groupBits;            // groupWords words per lot
+    size_t groupWords = 1;
+};
@@ -1,44 +1,46 @@
 #pragma once
 #include <cstdint>
-#include <string>
-#include <unordered_set>
 
-// Forward declare D3D11 SRV to avoid including d3d11.h here.
-struct ID3D11ShaderResourceView;
+#include "../gfx/IconAtlas.h"
 
+// Index of an entry in the lot cache's storage. Only valid for the cache generation it was
+// taken from (LotCacheManager::GetGeneration); a rebuild invalidates every handle.
+using LotHandle = uint32_t;
+constexpr LotHandle kInvalidLotHandle = 0xFFFFFFFF;
+
+// Per-lot icon state; changes after the build as icons load lazily
 struct LotConfigEntry {
     // Icon type enumeration
     enum class IconType : uint8_t {
         None = 0,       // No icon available
-        PNG = 1,        // PNG menu icon (176x44, show middle 44x44)
+        PNG = 1,        // PNG menu icon (middle 44x44 state of the 176x44 sprite sheet)
         S3D = 2         // S3D thumbnail (square, typically 64x64)
     };
 
     uint32_t id;
-    std::string name;
-    std::string description; // Item Description (localized if available)
-    uint32_t sizeX, sizeZ;
-    uint16_t minCapacity, maxCapacity;
-    uint8_t growthStage;
 
-    // Building classification
-    std::unordered_set<uint32_t> occupantGroups; // Raw occupant group IDs
+    // Name, size, compatibility and occupant groups are in the cache's LotCatalog (same handle)
 
     // Item Icon instance (PNG resource instance id) saved during cache build
     uint32_t iconInstance = 0;
 
-    // Unified icon/thumbnail SRV (either PNG icon or S3D thumbnail, never both)
-    // SRV owned by the cache manager; UI only reads it.
-    ID3D11ShaderResourceView* iconSRV = nullptr;
+    // Building exemplar key (type is always exemplar), used to regenerate S3D thumbnails
+    // lazily when the cache was restored from a snapshot
+    uint32_t buildingExemplarGroup = 0;
+    uint32_t buildingExemplarID = 0;
+
+    // Unified icon/thumbnail (either PNG icon or S3D thumbnail, never both), stored in the
+    // cache manager's icon atlas; only valid while iconType != None.
+    gfx::IconAtlasRegion icon;
     IconType iconType = IconType::None;
 
-    // Dimensions - interpretation depends on iconType:
-    // - PNG: iconWidth=176, iconHeight=44 (full sprite sheet)
+    // Size of the icon in the atlas:
+    // - PNG: 44x44 (the enabled state; the other sprite sheet states aren't kept)
     // - S3D: iconWidth=iconHeight=size (square thumbnail, e.g., 64x64)
     int iconWidth = 0;
     int iconHeight = 0;
 
-    // Lazy load state (set by director when a decode job is queued)
+    // Lazy load state (iconRequested is set by the cache manager once the icon load was attempted)
     bool iconRequested = false;
     bool descriptionLoaded = false;
 };
@@ -6,28 +6,31 @@
 
 namespace LotConfigTable {
 
-    bool LessForColumn(const LotConfigEntry& a, const LotConfigEntry& b,
+    bool LessForColumn(const LotCatalog& catalog, LotHandle a, LotHandle b,
                        const std::unordered_set<uint32_t>& favIDs,
                        int column_index, bool ascending) {
         switch (column_index) {
 			case 0:	{ // Fav
-				const auto aIsFav = favIDs.contains(a.id);
-        		const auto bIsFav = favIDs.contains(b.id);
+				const auto aIsFav = favIDs.contains(catalog.GetID(a));
+        		const auto bIsFav = favIDs.contains(catalog.GetID(b));
         		if (aIsFav != bIsFav) return ascending ? (aIsFav < bIsFav) : (aIsFav > bIsFav);
         		return false;
 			}
             case 2: { // ID
-                if (a.id != b.id) return ascending ? (a.id < b.id) : (a.id > b.id);
+                const uint32_t idA = catalog.GetID(a), idB = catalog.GetID(b);
+                if (idA != idB) return ascending ? (idA < idB) : (idA > idB);
                 return false;
             }
             case 3: { // Name (case-insensitive)
-                int cmp = _stricmp(a.name.c_str(), b.name.c_str());
+                int cmp = _stricmp(catalog.GetName(a), catalog.GetName(b));
                 if (cmp != 0) return ascending ? (cmp < 0) : (cmp > 0);
                 return false;
             }
             case 4: { // Size: width then depth
-                if (a.sizeX != b.sizeX) return ascending ? (a.sizeX < b.sizeX) : (a.sizeX > b.sizeX);
-                if (a.sizeZ != b.sizeZ) return ascending ? (a.sizeZ < b.sizeZ) : (a.sizeZ > b.sizeZ);
+                const uint32_t xA = catalog.GetSizeX(a), xB = catalog.GetSizeX(b);
+                if (xA != xB) return ascending ? (xA < xB) : (xA > xB);
+                const uint32_t zA = catalog.GetSizeZ(a), zB = catalog.GetSizeZ(b);
+                if (zA != zB) return ascending ? (zA < zB) : (zA > zB);
                 return false;
             }
             default:
@@ -35,30 +38,57 @@ namespace LotConfigTable {
         }
     }
 
-    std::vector<int> BuildSortedIndex(const std::vector<LotConfigEntry>& entries,
-									  const std::unordered_set<uint32_t>& favIDs,
-                                      const ImGuiTableSortSpecs* sort_specs) {
-        const int n = static_cast<int>(entries.size());
-        std::vector<int> idx;
-        idx.reserve(n);
-        for (int i = 0; i < n; ++i) idx.push_back(i);
+    std::vector<SortColumn> CopySortSpecs(const ImGuiTableSortSpecs* sort_specs) {
+        std::vector<SortColumn> columns;
+        if (!sort_specs) return columns;
 
-        if (!sort_specs || sort_specs->SpecsCount == 0) {
-            return idx; // no sorting, identity order
+        columns.reserve(static_cast<size_t>(sort_specs->SpecsCount));
+        for (int i = 0; i < sort_specs->SpecsCount; ++i) {
+            const ImGuiTableColumnSortSpecs& s = sort_specs->Specs[i];
+            columns.push_back({s.ColumnIndex, s.SortDirection == ImGuiSortDirection_Ascending});
         }
+        return columns;
+    }
+
+    bool SortsByColumn(const std::vector<SortColumn>& columns, int column_index) {
+        return std::ranges::any_of(columns, [column_index](const SortColumn& c) { return c.columnIndex == column_index; });
+    }
+
+    namespace {
+        // Lexicographic over the columns, then by row index so the order is total
+        struct RowLess {
+            const LotCatalog& catalog;
+            const std::unordered_set<uint32_t>& favIDs;
+            const std::vector<SortColumn>& columns;
 
-        // Copy specs so we can iterate from lowest to highest priority
-        std::vector<ImGuiTableColumnSortSpecs> specs(sort_specs->Specs, sort_specs->Specs + sort_specs->SpecsCount);
-        for (int si = static_cast<int>(specs.size()) - 1; si >= 0; --si) {
-            const ImGuiTableColumnSortSpecs& s = specs[si];
-            const bool ascending = (s.SortDirection == ImGuiSortDirection_Ascending);
-            auto less = [&](int a, int b) {
-                return LessForColumn(entries[static_cast<size_t>(a)], entries[static_cast<size_t>(b)], favIDs,
-                                     s.ColumnIndex, ascending);
-            };
-            std::ranges::stable_sort(idx, less);
+            bool operator()(LotHandle a, LotHandle b) const {
+                for (const SortColumn& c : columns) {
+                    if (LessForColumn(catalog, a, b, favIDs, c.columnIndex, c.ascending)) return true;
+                    if (LessForColumn(catalog, b, a, favIDs, c.columnIndex, c.ascending)) return false;
+                }
+                return a < b;
+            }
+        };
+    }
+
+    void SortRows(std::vector<LotHandle>& rows,
+                  const LotCatalog& catalog,
+                  const std::unordered_set<uint32_t>& favIDs,
+                  const std::vector<SortColumn>& columns) {
+        if (columns.empty()) {
+            std::ranges::sort(rows); // no sorting, entry order
+            return;
         }
+        std::ranges::sort(rows, RowLess{catalog, favIDs, columns});
+    }
 
-        return idx;
+    void InsertSortedRow(std::vector<LotHandle>& rows, LotHandle row,
+                         const LotCatalog& catalog,
+                         const std::unordered_set<uint32_t>& favIDs,
+                         const std::vector<SortColumn>& columns) {
+        auto it = columns.empty()
+            ? std::ranges::lower_bound(rows, row)
+            : std::ranges::lower_bound(rows, row, RowLess{catalog, favIDs, columns});
+        rows.insert(it, row);
     }
 }
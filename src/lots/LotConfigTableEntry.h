@@ -1,30 +1,49 @@
 #pragma once
+#include <unordered_set>
 #include <vector>
 
-#include "LotConfigEntry.h"
+#include "LotCatalog.h"
 
 // Forward declare ImGui types to avoid forcing all includes here
 struct ImGuiTableSortSpecs;
 struct ImGuiTableColumnSortSpecs;
 
-// Table-facing helpers for displaying/sorting LotConfigEntry rows without
+// Table-facing helpers for displaying/sorting lot rows (catalog handles) without
 // mutating the underlying storage. The name mirrors the intention that these
 // are specifically for the UI table.
 namespace LotConfigTable
 {
-	// Build an index vector [0..N-1] sorted according to ImGui's current table
-	// sort specs. When no specs are provided, returns a straight 0..N-1 order.
-	// The function is stable across multiple columns, applying lower-priority
-	// specs first and higher-priority last using stable_sort.
-	std::vector<int> BuildSortedIndex(const std::vector<LotConfigEntry>& entries,
-	                                  const std::unordered_set<uint32_t>& favIDs,
-	                                  const ImGuiTableSortSpecs* sort_specs);
-
-	// Compare two entries for a specific column used in the UI table.
+	// One column of ImGui's sort specs, copied so the order can be kept across frames
+	struct SortColumn
+	{
+		int columnIndex;
+		bool ascending;
+	};
+
+	// Copy ImGui's current table sort specs (highest priority first)
+	std::vector<SortColumn> CopySortSpecs(const ImGuiTableSortSpecs* sort_specs);
+
+	// True if any of the columns sorts on column_index
+	bool SortsByColumn(const std::vector<SortColumn>& columns, int column_index);
+
+	// Sort rows (handles into the catalog) by the columns in priority order.
+	// Ties keep ascending handle order, which matches applying one stable_sort per column.
+	void SortRows(std::vector<LotHandle>& rows,
+	              const LotCatalog& catalog,
+	              const std::unordered_set<uint32_t>& favIDs,
+	              const std::vector<SortColumn>& columns);
+
+	// Insert one row into already sorted rows at its sorted position
+	void InsertSortedRow(std::vector<LotHandle>& rows, LotHandle row,
+	                     const LotCatalog& catalog,
+	                     const std::unordered_set<uint32_t>& favIDs,
+	                     const std::vector<SortColumn>& columns);
+
+	// Compare two lots for a specific column used in the UI table.
 	// Column indices:
-	// 1 = ID, 2 = Name, 3 = Size (X then Z). Column 0 (Icon) is intentionally
+	// 0 = Fav, 2 = ID, 3 = Name, 4 = Size (X then Z). Column 1 (Icon) is intentionally
 	// not sortable.
-	bool LessForColumn(const LotConfigEntry& a, const LotConfigEntry& b,
+	bool LessForColumn(const LotCatalog& catalog, LotHandle a, LotHandle b,
 	                   const std::unordered_set<uint32_t>& favIDs,
 	                   int column_index, bool ascending);
 }
@@ -21,173 +21,323 @@
 #include "LotFilterer.h"
 
 #include <algorithm>
-#include <cctype>
 #include <cISC4BuildingOccupant.h>
-#include <string>
+#include <cstdio>
+#include <numeric>
 
-#include "cISC4City.h"
 #include "cISC4LotConfiguration.h"
-#include "cISC4LotConfigurationManager.h"
 #include "cISC4ZoneManager.h"
-#include "SC4HashSet.h"
-#include "lots/LotConfigEntry.h"
+#include "LotCatalog.h"
+#include "LotSearchIndex.h"
 
-void LotFilterer::FilterLots(
-    cISC4City* pCity,
-    const std::unordered_map<uint32_t, LotConfigEntry>& lotConfigCache,
-    std::vector<LotConfigEntry>& outFilteredEntries,
-    uint8_t filterZoneType,
-    uint8_t filterWealthType,
-    uint32_t minSizeX, uint32_t maxSizeX,
-    uint32_t minSizeZ, uint32_t maxSizeZ,
-    const char* searchBuffer,
-    const std::vector<uint32_t>& selectedOccupantGroups
-) {
-    outFilteredEntries.clear();
+namespace {
+    using ZoneType = cISC4ZoneManager::ZoneType;
 
-    cISC4LotConfigurationManager* pLotConfigMgr = pCity->GetLotConfigurationManager();
-    if (!pLotConfigMgr) return;
-
-    SC4HashSet<uint32_t> configIdTable{};
+    constexpr uint32_t ZoneBit(ZoneType zone) {
+        return 1u << static_cast<uint32_t>(zone);
+    }
 
-    for (uint32_t x = minSizeX; x <= maxSizeX; x++) {
-        for (uint32_t z = minSizeZ; z <= maxSizeZ; z++) {
-            // Reset the temporary set per size to avoid accumulating IDs across iterations
-			configIdTable = {};
+    // Every zone type a lot configuration can be compatible with
+    constexpr ZoneType kAllZoneTypes[] = {
+        ZoneType::None,
+        ZoneType::ResidentialLowDensity,
+        ZoneType::ResidentialMediumDensity,
+        ZoneType::ResidentialHighDensity,
+        ZoneType::CommercialLowDensity,
+        ZoneType::CommercialMediumDensity,
+        ZoneType::CommercialHighDensity,
+        ZoneType::Agriculture,
+        ZoneType::IndustrialMediumDensity,
+        ZoneType::IndustrialHighDensity,
+        ZoneType::Military,
+        ZoneType::Airport,
+        ZoneType::Seaport,
+        ZoneType::Spaceport,
+        ZoneType::Landfill,
+        ZoneType::Plopped,
+    };
 
-            if (pLotConfigMgr->GetLotConfigurationIDsBySize(configIdTable, x, z)) {
-                for (const auto it : configIdTable) {
-                    auto cacheIt = lotConfigCache.find(it);
-                    if (cacheIt == lotConfigCache.end()) continue;
+    // WealthType values 1..3 (low, medium, high); UI wealth index i is WealthType i + 1
+    constexpr uint32_t kMinWealthType = 1;
+    constexpr uint32_t kMaxWealthType = 3;
 
-                    const LotConfigEntry& cachedEntry = cacheIt->second;
+    // Candidates tested to estimate a predicate's selectivity
+    constexpr size_t kSampleSize = 128;
 
-                    // Get lot config for filtering
-                    cISC4LotConfiguration* pConfig = pLotConfigMgr->GetLotConfiguration(it);
-                    if (!pConfig) continue;
+    // Relative cost of testing one lot. A text term is a substring search over the lot's name
+    // and description; a group test is one AND per bitset word.
+    constexpr float kColumnCost = 1.0f;
+    constexpr float kGroupWordCost = 0.5f;
+    constexpr float kTextCost = 16.0f;
 
-                    // Apply filters
-                    if (!MatchesZoneFilter(pConfig, filterZoneType)) continue;
-                    if (!MatchesWealthFilter(pConfig, filterWealthType)) continue;
-                    if (!MatchesSearchFilter(cachedEntry, searchBuffer)) continue;
-                    if (!MatchesOccupantGroupFilter(cachedEntry, selectedOccupantGroups)) continue;
+    // One search over the whole text arena reads every lot; checking lots one by one only reads the
+    // candidates, so the arena only wins once more than half the catalog is left
+    constexpr size_t kArenaSearchDivisor = 2;
 
-                    outFilteredEntries.push_back(cachedEntry);
-                }
+    // Narrows candidates to the lots passing test; with all set, tests every lot and clears all
+    template <typename Test>
+    void KeepMatching(size_t count, bool& all, std::vector<LotHandle>& candidates, Test&& test) {
+        if (all) {
+            candidates.clear();
+            for (size_t i = 0; i < count; ++i) {
+                const auto handle = static_cast<LotHandle>(i);
+                if (test(handle)) candidates.push_back(handle);
             }
+            all = false;
+            return;
         }
+
+        size_t kept = 0;
+        for (LotHandle handle : candidates) {
+            if (test(handle)) candidates[kept++] = handle;
+        }
+        candidates.resize(kept);
     }
-}
 
-bool LotFilterer::MatchesZoneFilter(cISC4LotConfiguration* pConfig, uint8_t filterZoneType) {
-    if (filterZoneType == 0xFF) return true; // Any
-
-    const uint8_t zoneCategory = filterZoneType;
-    bool zoneOk = false;
-
-    if (zoneCategory == 0) {
-        // Residential
-        cISC4ZoneManager::ZoneType resZones[] = {
-            cISC4ZoneManager::ZoneType::ResidentialLowDensity,
-            cISC4ZoneManager::ZoneType::ResidentialMediumDensity,
-            cISC4ZoneManager::ZoneType::ResidentialHighDensity,
-        };
-        for (auto z : resZones) {
-            if (pConfig->IsCompatibleWithZoneType(z)) {
-                zoneOk = true;
-                break;
-            }
+    const char* PredicateName(LotFilterer::PredicateKind kind) {
+        switch (kind) {
+            case LotFilterer::PredicateKind::SizeX: return "width";
+            case LotFilterer::PredicateKind::SizeZ: return "depth";
+            case LotFilterer::PredicateKind::Zone: return "zone";
+            case LotFilterer::PredicateKind::Wealth: return "wealth";
+            case LotFilterer::PredicateKind::GrowthStage: return "stage";
+            case LotFilterer::PredicateKind::Capacity: return "capacity";
+            case LotFilterer::PredicateKind::Groups: return "groups";
+            case LotFilterer::PredicateKind::Text: return "text";
         }
-    } else if (zoneCategory == 1) {
-        // Commercial
-        cISC4ZoneManager::ZoneType comZones[] = {
-            cISC4ZoneManager::ZoneType::CommercialLowDensity,
-            cISC4ZoneManager::ZoneType::CommercialMediumDensity,
-            cISC4ZoneManager::ZoneType::CommercialHighDensity,
-        };
-        for (auto z : comZones) {
-            if (pConfig->IsCompatibleWithZoneType(z)) {
-                zoneOk = true;
-                break;
+        return "?";
+    }
+} // namespace
+
+void LotFilterer::FilterLots(
+    const LotCatalog& catalog,
+    const LotSearchIndex& searchIndex,
+    std::vector<LotHandle>& outFilteredHandles,
+    const LotQuery& query
+) {
+    FilterState state;
+    state.query = query;
+    state.query.Normalize();
+    state.compiledGroups.Compile(state.query.groups, catalog);
+
+    const size_t count = catalog.GetCount();
+    const bool canNarrow = hasLastResult
+        && lastIndexGeneration == searchIndex.GetGeneration()
+        && lastState.query.IsNarrowedBy(state.query);
+
+    std::vector<LotHandle> matches;
+    std::vector<PlanStep> plan;
+
+    if (!state.query.matchesNothing && !state.compiledGroups.matchesNothing) {
+        // Narrowing starts from the previous matches, which already pass every unchanged predicate
+        bool all = !canNarrow;
+        if (canNarrow) {
+            matches.reserve(lastMatches.size());
+            for (LotHandle handle : lastMatches) {
+                if (handle < count) matches.push_back(handle);
             }
         }
-    } else if (zoneCategory == 2) {
-        // Industrial
-        cISC4ZoneManager::ZoneType indZones[] = {
-            cISC4ZoneManager::ZoneType::IndustrialMediumDensity,
-            cISC4ZoneManager::ZoneType::IndustrialHighDensity,
-        };
-        for (auto z : indZones) {
-            if (pConfig->IsCompatibleWithZoneType(z)) {
-                zoneOk = true;
-                break;
-            }
+
+        std::vector<Predicate> predicates;
+        BuildPredicates(catalog, state, canNarrow ? &lastState.query : nullptr, predicates);
+        OrderPredicates(catalog, searchIndex, state, canNarrow ? &matches : nullptr, predicates);
+
+        for (const Predicate& predicate : predicates) {
+            if (!all && matches.empty()) break;
+            ApplyPredicate(catalog, searchIndex, state, predicate, all, matches);
+            plan.push_back({predicate.kind, predicate.selectivity, matches.size()});
         }
-    } else if (zoneCategory == 3) {
-        // Agriculture
-        if (pConfig->IsCompatibleWithZoneType(cISC4ZoneManager::ZoneType::Agriculture)) zoneOk = true;
-    } else if (zoneCategory == 4) {
-        // Plopped
-        if (pConfig->IsCompatibleWithZoneType(cISC4ZoneManager::ZoneType::Plopped)) zoneOk = true;
-    } else if (zoneCategory == 5) {
-        // None
-        if (pConfig->IsCompatibleWithZoneType(cISC4ZoneManager::ZoneType::None)) zoneOk = true;
-    } else if (zoneCategory == 6) {
-        // Other
-        cISC4ZoneManager::ZoneType otherZones[] = {
-            cISC4ZoneManager::ZoneType::Military,
-            cISC4ZoneManager::ZoneType::Airport,
-            cISC4ZoneManager::ZoneType::Seaport,
-            cISC4ZoneManager::ZoneType::Spaceport,
-            cISC4ZoneManager::ZoneType::Landfill,
-        };
-        for (auto z : otherZones) {
-            if (pConfig->IsCompatibleWithZoneType(z)) {
-                zoneOk = true;
-                break;
-            }
+
+        if (all) {
+            matches.resize(count);
+            std::iota(matches.begin(), matches.end(), LotHandle{0});
         }
     }
 
-    return zoneOk;
+    outFilteredHandles = matches;
+    lastState = std::move(state);
+    lastMatches = std::move(matches);
+    lastPlan = std::move(plan);
+    lastIndexGeneration = searchIndex.GetGeneration();
+    lastNarrowed = canNarrow;
+    hasLastResult = true;
+}
+
+void LotFilterer::Reset() {
+    hasLastResult = false;
+    lastMatches.clear();
+    lastPlan.clear();
+}
+
+std::string LotFilterer::DescribeLastPlan() const {
+    std::string description = lastNarrowed ? "narrowed" : "full scan";
+    for (const PlanStep& step : lastPlan) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), ", %s (~%.0f%%) -> %zu",
+                 PredicateName(step.kind), step.selectivity * 100.0f, step.remaining);
+        description += buffer;
+    }
+    return description;
+}
+
+template <typename Visitor>
+void LotFilterer::VisitTest(
+    const LotCatalog& catalog,
+    const LotSearchIndex& searchIndex,
+    const FilterState& state,
+    const Predicate& predicate,
+    Visitor&& visit
+) {
+    const LotQuery& query = state.query;
+    switch (predicate.kind) {
+        case PredicateKind::SizeX:
+            visit([&](LotHandle handle) { return query.sizeX.Contains(catalog.GetSizeX(handle)); });
+            break;
+        case PredicateKind::SizeZ:
+            visit([&](LotHandle handle) { return query.sizeZ.Contains(catalog.GetSizeZ(handle)); });
+            break;
+        case PredicateKind::Zone: {
+            const uint32_t mask = query.zoneMasks[predicate.index];
+            visit([&](LotHandle handle) { return (catalog.GetZoneMask(handle) & mask) != 0; });
+            break;
+        }
+        case PredicateKind::Wealth: {
+            const uint8_t mask = query.wealthMasks[predicate.index];
+            visit([&](LotHandle handle) { return (catalog.GetWealthMask(handle) & mask) != 0; });
+            break;
+        }
+        case PredicateKind::GrowthStage:
+            visit([&](LotHandle handle) { return query.growthStage.Contains(catalog.GetGrowthStage(handle)); });
+            break;
+        case PredicateKind::Capacity:
+            visit([&](LotHandle handle) { return query.capacity.Contains(catalog.GetMaxCapacity(handle)); });
+            break;
+        case PredicateKind::Groups:
+            visit([&](LotHandle handle) { return state.compiledGroups.Matches(catalog.GetGroupBits(handle)); });
+            break;
+        case PredicateKind::Text: {
+            const std::string& term = query.textTerms[predicate.index];
+            visit([&](LotHandle handle) { return searchIndex.SlotContains(handle, term); });
+            break;
+        }
+    }
 }
 
-bool LotFilterer::MatchesWealthFilter(cISC4LotConfiguration* pConfig, uint8_t filterWealthType) {
-    if (filterWealthType == 0xFF) return true; // Any
+void LotFilterer::BuildPredicates(
+    const LotCatalog& catalog,
+    const FilterState& state,
+    const LotQuery* satisfied,
+    std::vector<Predicate>& outPredicates
+) {
+    // A predicate the previous query also had is already true for every previous match
+    const LotQuery& query = state.query;
+    auto addRange = [&](PredicateKind kind, const LotQuery::Range& range, const LotQuery::Range* previous) {
+        if (range.IsAll() || (previous && *previous == range)) return;
+        outPredicates.push_back({kind, 0, kColumnCost, 1.0f});
+    };
+
+    addRange(PredicateKind::SizeX, query.sizeX, satisfied ? &satisfied->sizeX : nullptr);
+    addRange(PredicateKind::SizeZ, query.sizeZ, satisfied ? &satisfied->sizeZ : nullptr);
+    addRange(PredicateKind::GrowthStage, query.growthStage, satisfied ? &satisfied->growthStage : nullptr);
+    addRange(PredicateKind::Capacity, query.capacity, satisfied ? &satisfied->capacity : nullptr);
+
+    for (size_t i = 0; i < query.zoneMasks.size(); ++i) {
+        if (satisfied && std::binary_search(satisfied->zoneMasks.begin(), satisfied->zoneMasks.end(),
+                                            query.zoneMasks[i])) continue;
+        outPredicates.push_back({PredicateKind::Zone, i, kColumnCost, 1.0f});
+    }
+    for (size_t i = 0; i < query.wealthMasks.size(); ++i) {
+        if (satisfied && std::binary_search(satisfied->wealthMasks.begin(), satisfied->wealthMasks.end(),
+                                            query.wealthMasks[i])) continue;
+        outPredicates.push_back({PredicateKind::Wealth, i, kColumnCost, 1.0f});
+    }
+
+    if (state.compiledGroups.active && !(satisfied && satisfied->groups == query.groups)) {
+        const float cost = kColumnCost + kGroupWordCost * static_cast<float>(catalog.GetGroupWords());
+        outPredicates.push_back({PredicateKind::Groups, 0, cost, 1.0f});
+    }
 
-    const uint8_t wealthIdx = filterWealthType;
-    cISC4BuildingOccupant::WealthType wealthType = static_cast<cISC4BuildingOccupant::WealthType>(wealthIdx + 1);
-    return pConfig->IsCompatibleWithWealthType(wealthType);
+    for (size_t i = 0; i < query.textTerms.size(); ++i) {
+        if (satisfied && std::binary_search(satisfied->textTerms.begin(), satisfied->textTerms.end(),
+                                            query.textTerms[i])) continue;
+        outPredicates.push_back({PredicateKind::Text, i, kTextCost, 1.0f});
+    }
 }
 
-bool LotFilterer::MatchesSearchFilter(const LotConfigEntry& entry, const char* searchText) {
-    if (!searchText || searchText[0] == '\0') return true;
+void LotFilterer::OrderPredicates(
+    const LotCatalog& catalog,
+    const LotSearchIndex& searchIndex,
+    const FilterState& state,
+    const std::vector<LotHandle>* candidates,
+    std::vector<Predicate>& predicates
+) {
+    if (predicates.empty()) return;
 
-    std::string searchLower = searchText;
-    std::transform(searchLower.begin(), searchLower.end(), searchLower.begin(),
-        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    // Evenly spaced candidates, so runs of similar lots (one plugin's set) don't skew the estimate
+    const size_t total = candidates ? candidates->size() : catalog.GetCount();
+    const size_t stride = (std::max)(total / kSampleSize, size_t{1});
+    std::vector<LotHandle> sample;
+    for (size_t i = 0; i < total && sample.size() < kSampleSize; i += stride) {
+        sample.push_back(candidates ? (*candidates)[i] : static_cast<LotHandle>(i));
+    }
 
-    std::string nameLower = entry.name;
-    std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(),
-        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (Predicate& predicate : predicates) {
+        size_t passed = 0;
+        VisitTest(catalog, searchIndex, state, predicate, [&](auto&& test) {
+            for (LotHandle handle : sample) {
+                if (test(handle)) ++passed;
+            }
+        });
+        // Smoothed, so a predicate no sampled lot passed still counts as keeping a few
+        predicate.selectivity = static_cast<float>(passed + 1) / static_cast<float>(sample.size() + 2);
+    }
 
-    if (nameLower.find(searchLower) != std::string::npos) return true;
+    std::stable_sort(predicates.begin(), predicates.end(), [](const Predicate& a, const Predicate& b) {
+        return a.cost / (1.0f - a.selectivity) < b.cost / (1.0f - b.selectivity);
+    });
+}
 
-    // Also search description if available
-    std::string descLower = entry.description;
-    std::transform(descLower.begin(), descLower.end(), descLower.begin(),
-        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+void LotFilterer::ApplyPredicate(
+    const LotCatalog& catalog,
+    const LotSearchIndex& searchIndex,
+    const FilterState& state,
+    const Predicate& predicate,
+    bool& all,
+    std::vector<LotHandle>& candidates
+) {
+    const size_t count = catalog.GetCount();
 
-    return descLower.find(searchLower) != std::string::npos;
+    if (predicate.kind == PredicateKind::Text && (all || candidates.size() > count / kArenaSearchDivisor)) {
+        std::vector<uint8_t> hits;
+        searchIndex.Search(state.query.textTerms[predicate.index], hits);
+        hits.resize(count, 0);
+        KeepMatching(count, all, candidates, [&](LotHandle handle) { return hits[handle] != 0; });
+        return;
+    }
+
+    VisitTest(catalog, searchIndex, state, predicate, [&](auto&& test) {
+        KeepMatching(count, all, candidates, test);
+    });
+}
+
+uint32_t LotFilterer::ComputeZoneMask(cISC4LotConfiguration* pConfig) {
+    uint32_t mask = 0;
+    if (!pConfig) return mask;
+
+    for (auto zone : kAllZoneTypes) {
+        if (pConfig->IsCompatibleWithZoneType(zone)) mask |= ZoneBit(zone);
+    }
+    return mask;
 }
 
-bool LotFilterer::MatchesOccupantGroupFilter(const LotConfigEntry& entry, const std::vector<uint32_t>& selectedGroups) {
-    if (selectedGroups.empty()) return true;
+uint8_t LotFilterer::ComputeWealthMask(cISC4LotConfiguration* pConfig) {
+    uint8_t mask = 0;
+    if (!pConfig) return mask;
 
-    for (uint32_t g : selectedGroups) {
-        if (entry.occupantGroups.count(g) != 0) {
-            return true; // Any-match
+    for (uint32_t wealth = kMinWealthType; wealth <= kMaxWealthType; ++wealth) {
+        if (pConfig->IsCompatibleWithWealthType(static_cast<cISC4BuildingOccupant::WealthType>(wealth))) {
+            mask |= static_cast<uint8_t>(1u << wealth);
         }
     }
-    return false;
+    return mask;
 }
@@ -19,44 +19,129 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 #pragma once
+#include <cstddef>
 #include <cstdint>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
+#include "LotConfigEntry.h"
+#include "LotQuery.h"
+#include "OccupantGroupQuery.h"
+
 class cISC4LotConfiguration;
-class cISC4City;
-struct LotConfigEntry;
+class LotCatalog;
+class LotSearchIndex;
 
 /**
- * Filters lot configurations based on zone, wealth, size, search text, and occupant groups.
+ * Filters lot configurations with a LotQuery (the filter widgets plus the parsed search box).
+ * Filtering only reads the cache's LotCatalog and LotSearchIndex; zone and wealth compatibility
+ * are captured per lot at build time.
+ *
+ * Each criterion is a predicate. Their selectivity is estimated on a sample of the candidates,
+ * and they run cheapest and most selective first, each over the handles the previous ones kept,
+ * so the costlier checks (occupant groups, text) only see the lots that survived.
+ *
+ * The last result is kept: when the new query can only remove lots (the search was extended,
+ * a range shrunk, "Any" became a specific value, ...), only the previous matches are rechecked,
+ * and only against the predicates that changed. Any other change falls back to a full scan.
  */
 class LotFilterer {
 public:
+    enum class PredicateKind : uint8_t {
+        SizeX,
+        SizeZ,
+        Zone,
+        Wealth,
+        GrowthStage,
+        Capacity,
+        Groups,
+        Text
+    };
+
+    // One predicate as run by the last FilterLots
+    struct PlanStep {
+        PredicateKind kind;
+        float selectivity;      // Estimated share of the candidates it keeps
+        size_t remaining;       // Candidates left after it ran
+    };
+
     /**
-     * Filter lots from cache and populate the output list.
+     * Filter lots from cache and populate the output list with their handles (ascending).
      */
-    static void FilterLots(
-        cISC4City* pCity,
-        const std::unordered_map<uint32_t, LotConfigEntry>& lotConfigCache,
-        std::vector<LotConfigEntry>& outFilteredEntries,
-        uint8_t filterZoneType,
-        uint8_t filterWealthType,
-        uint32_t minSizeX, uint32_t maxSizeX,
-        uint32_t minSizeZ, uint32_t maxSizeZ,
-        const char* searchBuffer,
-        const std::vector<uint32_t>& selectedOccupantGroups
+    void FilterLots(
+        const LotCatalog& catalog,
+        const LotSearchIndex& searchIndex,
+        std::vector<LotHandle>& outFilteredHandles,
+        const LotQuery& query
     );
 
+    // Forget the previous result; the next FilterLots does a full scan
+    void Reset();
+
+    // Predicates in the order the last FilterLots ran them (for profiling the ordering)
+    const std::vector<PlanStep>& GetLastPlan() const { return lastPlan; }
+    bool WasLastNarrowed() const { return lastNarrowed; }
+    std::string DescribeLastPlan() const;
+
+    // Compatibility masks stored in the catalog's zone/wealth columns (queried once per lot)
+    static uint32_t ComputeZoneMask(cISC4LotConfiguration* pConfig);
+    static uint8_t ComputeWealthMask(cISC4LotConfiguration* pConfig);
+
 private:
-    // Check if lot config matches zone filter
-    static bool MatchesZoneFilter(cISC4LotConfiguration* pConfig, uint8_t filterZoneType);
+    struct FilterState {
+        LotQuery query;                       // Normalized
+        CompiledGroupQuery compiledGroups;    // query.groups as masks over the catalog's group bitsets
+    };
 
-    // Check if lot config matches wealth filter
-    static bool MatchesWealthFilter(cISC4LotConfiguration* pConfig, uint8_t filterWealthType);
+    struct Predicate {
+        PredicateKind kind;
+        size_t index;           // Which zone mask, wealth mask or text term
+        float cost;             // Relative cost of testing one lot
+        float selectivity;
+    };
 
-    // Check if lot entry matches search text
-    static bool MatchesSearchFilter(const LotConfigEntry& entry, const char* searchText);
+    // Calls visit with a callable that tests one lot handle against predicate
+    template <typename Visitor>
+    static void VisitTest(
+        const LotCatalog& catalog,
+        const LotSearchIndex& searchIndex,
+        const FilterState& state,
+        const Predicate& predicate,
+        Visitor&& visit
+    );
+
+    // The predicates of state not already guaranteed by satisfied (nullptr for a full scan)
+    static void BuildPredicates(
+        const LotCatalog& catalog,
+        const FilterState& state,
+        const LotQuery* satisfied,
+        std::vector<Predicate>& outPredicates
+    );
+
+    // Estimates each predicate's selectivity on a sample of the candidates and sorts them by
+    // cost / (1 - selectivity), so a predicate runs early if it is cheap or rejects most lots
+    static void OrderPredicates(
+        const LotCatalog& catalog,
+        const LotSearchIndex& searchIndex,
+        const FilterState& state,
+        const std::vector<LotHandle>* candidates,
+        std::vector<Predicate>& predicates
+    );
+
+    // Narrows candidates to the lots matching predicate (every lot if all is set; clears all)
+    static void ApplyPredicate(
+        const LotCatalog& catalog,
+        const LotSearchIndex& searchIndex,
+        const FilterState& state,
+        const Predicate& predicate,
+        bool& all,
+        std::vector<LotHandle>& candidates
+    );
 
-    // Check if lot entry matches occupant group filter
-    static bool MatchesOccupantGroupFilter(const LotConfigEntry& entry, const std::vector<uint32_t>& selectedGroups);
+    FilterState lastState;
+    std::vector<LotHandle> lastMatches;
+    std::vector<PlanStep> lastPlan;
+    uint32_t lastIndexGeneration = 0;
+    bool hasLastResult = false;
+    bool lastNarrowed = false;
 };
@@ -0,0 +1,354 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LotQuery.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+
+#include "cISC4ZoneManager.h"
+#include "LotSearchIndex.h"
+
+namespace {
+    using ZoneType = cISC4ZoneManager::ZoneType;
+
+    constexpr uint32_t ZoneBit(ZoneType zone) {
+        return 1u << static_cast<uint32_t>(zone);
+    }
+
+    // Zone filter categories (UI index -> compatible zone types)
+    constexpr uint32_t kZoneCategoryMasks[] = {
+        // Residential
+        ZoneBit(ZoneType::ResidentialLowDensity) | ZoneBit(ZoneType::ResidentialMediumDensity) |
+            ZoneBit(ZoneType::ResidentialHighDensity),
+        // Commercial
+        ZoneBit(ZoneType::CommercialLowDensity) | ZoneBit(ZoneType::CommercialMediumDensity) |
+            ZoneBit(ZoneType::CommercialHighDensity),
+        // Industrial
+        ZoneBit(ZoneType::IndustrialMediumDensity) | ZoneBit(ZoneType::IndustrialHighDensity),
+        // Agriculture
+        ZoneBit(ZoneType::Agriculture),
+        // Plopped
+        ZoneBit(ZoneType::Plopped),
+        // None
+        ZoneBit(ZoneType::None),
+        // Other
+        ZoneBit(ZoneType::Military) | ZoneBit(ZoneType::Airport) | ZoneBit(ZoneType::Seaport) |
+            ZoneBit(ZoneType::Spaceport) | ZoneBit(ZoneType::Landfill),
+    };
+
+    // Search box names for the zone categories, in the same order
+    constexpr std::string_view kZoneNames[][3] = {
+        {"r", "res", "residential"},
+        {"c", "com", "commercial"},
+        {"i", "ind", "industrial"},
+        {"a", "ag", "agriculture"},
+        {"p", "plop", "plopped"},
+        {"n", "none", "none"},
+        {"o", "other", "other"},
+    };
+
+    constexpr std::string_view kWealthNames[][3] = {
+        {"$", "low", "1"},
+        {"$$", "med", "2"},
+        {"$$$", "high", "3"},
+    };
+
+    // WealthType values 1..3 (low, medium, high); UI wealth index i is WealthType i + 1
+    constexpr uint32_t kMaxWealthType = 3;
+
+    std::string ToLower(std::string_view text) {
+        std::string out(text);
+        for (char& c : out) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        return out;
+    }
+
+    // Decimal or 0x-prefixed hex; the whole text must be the number
+    bool ParseNumber(std::string_view text, uint32_t& out) {
+        int base = 10;
+        if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+            text.remove_prefix(2);
+            base = 16;
+        }
+        if (text.empty()) return false;
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), out, base);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    // N, >N, >=N, <N, <=N, =N, N..M, N.. or ..M
+    bool ParseRange(std::string_view text, LotQuery::Range& out) {
+        LotQuery::Range range;
+        uint32_t value = 0;
+
+        if (const size_t dots = text.find(".."); dots != std::string_view::npos) {
+            const std::string_view low = text.substr(0, dots);
+            const std::string_view high = text.substr(dots + 2);
+            if (low.empty() && high.empty()) return false;
+            if (!low.empty() && !ParseNumber(low, range.min)) return false;
+            if (!high.empty() && !ParseNumber(high, range.max)) return false;
+        }
+        else if (text.starts_with(">=")) {
+            if (!ParseNumber(text.substr(2), range.min)) return false;
+        }
+        else if (text.starts_with("<=")) {
+            if (!ParseNumber(text.substr(2), range.max)) return false;
+        }
+        else if (text.starts_with('>')) {
+            if (!ParseNumber(text.substr(1), value) || value == UINT32_MAX) return false;
+            range.min = value + 1;
+        }
+        else if (text.starts_with('<')) {
+            if (!ParseNumber(text.substr(1), value) || value == 0) return false;
+            range.max = value - 1;
+        }
+        else {
+            if (text.starts_with('=')) text.remove_prefix(1);
+            if (!ParseNumber(text, value)) return false;
+            range.min = range.max = value;
+        }
+
+        out = range;
+        return true;
+    }
+
+    // WxD; either side may be 0x-prefixed hex, so the separator is the first x past that prefix
+    bool ParseSize(std::string_view text, uint32_t& outX, uint32_t& outZ) {
+        const size_t start = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X') ? 2 : 0;
+        const size_t x = text.find_first_of("xX", start);
+        if (x == std::string_view::npos) return false;
+        return ParseNumber(text.substr(0, x), outX) && ParseNumber(text.substr(x + 1), outZ);
+    }
+
+    // WxD, WxD..WxD, WxD.. or ..WxD
+    bool ParseSizeRange(std::string_view text, LotQuery::Range& outX, LotQuery::Range& outZ) {
+        LotQuery::Range rangeX, rangeZ;
+
+        if (const size_t dots = text.find(".."); dots != std::string_view::npos) {
+            const std::string_view low = text.substr(0, dots);
+            const std::string_view high = text.substr(dots + 2);
+            if (low.empty() && high.empty()) return false;
+            if (!low.empty() && !ParseSize(low, rangeX.min, rangeZ.min)) return false;
+            if (!high.empty() && !ParseSize(high, rangeX.max, rangeZ.max)) return false;
+        }
+        else {
+            if (!ParseSize(text, rangeX.min, rangeZ.min)) return false;
+            rangeX.max = rangeX.min;
+            rangeZ.max = rangeZ.min;
+        }
+
+        outX = rangeX;
+        outZ = rangeZ;
+        return true;
+    }
+
+    template <size_t N>
+    int FindName(const std::string_view (&names)[N][3], std::string_view value) {
+        const std::string lower = ToLower(value);
+        for (size_t i = 0; i < N; ++i) {
+            for (std::string_view name : names[i]) {
+                if (lower == name) return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    // Letters and digits only, lowercased, so "high school" and "HighSchool" compare equal
+    std::string NameKey(std::string_view name) {
+        std::string key;
+        for (char c : ToLower(name)) {
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) key.push_back(c);
+        }
+        return key;
+    }
+
+    uint32_t ParseGroup(std::string_view value, const std::unordered_map<uint32_t, std::string>* groupNames) {
+        uint32_t groupID = 0;
+        if (ParseNumber(value, groupID)) return groupID;
+        if (!groupNames) return 0;
+
+        const std::string key = NameKey(value);
+        if (key.empty()) return 0;
+        for (const auto& [id, name] : *groupNames) {
+            if (NameKey(name) == key) return id;
+        }
+        return 0;
+    }
+
+    // (X or Y) and X is X, so a required group lifts the whole any-of condition it's part of
+    void RequireGroup(LotQuery& query, uint32_t groupID) {
+        auto& groups = query.groups;
+        if (std::find(groups.noneOf.begin(), groups.noneOf.end(), groupID) != groups.noneOf.end()) {
+            query.matchesNothing = true;
+        }
+        if (std::find(groups.anyOf.begin(), groups.anyOf.end(), groupID) != groups.anyOf.end()) {
+            groups.anyOf.clear();
+        }
+        groups.allOf.push_back(groupID);
+    }
+
+    // (X or Y) and not X is Y and not X; with nothing left to pick from, no lot matches
+    void ExcludeGroup(LotQuery& query, uint32_t groupID) {
+        auto& groups = query.groups;
+        if (std::find(groups.allOf.begin(), groups.allOf.end(), groupID) != groups.allOf.end()) {
+            query.matchesNothing = true;
+        }
+        const auto any = std::find(groups.anyOf.begin(), groups.anyOf.end(), groupID);
+        if (any != groups.anyOf.end()) {
+            groups.anyOf.erase(any);
+            if (groups.anyOf.empty()) query.matchesNothing = true;
+        }
+        groups.noneOf.push_back(groupID);
+    }
+
+    // Splits on whitespace; double quotes group words and are dropped.
+    // quoted is set when the token began with a quote (a phrase rather than a field term).
+    bool NextToken(std::string_view& text, std::string& out, bool& quoted) {
+        size_t pos = 0;
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) ++pos;
+        if (pos == text.size()) return false;
+
+        out.clear();
+        quoted = text[pos] == '"';
+        bool inQuote = false;
+        for (; pos < text.size(); ++pos) {
+            const char c = text[pos];
+            if (c == '"') {
+                inQuote = !inQuote;
+                continue;
+            }
+            if (!inQuote && (c == ' ' || c == '\t')) break;
+            out.push_back(c);
+        }
+        text.remove_prefix(pos);
+        return true;
+    }
+} // namespace
+
+void LotQuery::Range::Intersect(const Range& other) {
+    min = (std::max)(min, other.min);
+    max = (std::min)(max, other.max);
+}
+
+void LotQuery::AddZoneFilter(uint8_t filterZoneType) {
+    if (filterZoneType == 0xFF) return;
+    zoneMasks.push_back(filterZoneType < std::size(kZoneCategoryMasks) ? kZoneCategoryMasks[filterZoneType] : 0);
+}
+
+void LotQuery::AddWealthFilter(uint8_t filterWealthType) {
+    if (filterWealthType == 0xFF) return;
+    wealthMasks.push_back(filterWealthType + 1u > kMaxWealthType
+        ? 0
+        : static_cast<uint8_t>(1u << (filterWealthType + 1u)));
+}
+
+void LotQuery::ParseSearch(std::string_view text, const std::unordered_map<uint32_t, std::string>* groupNames) {
+    std::string token;
+    bool quoted = false;
+    while (NextToken(text, token, quoted)) {
+        if (token.empty()) continue;
+
+        const size_t colon = quoted ? std::string::npos : token.find(':');
+        if (colon != std::string::npos) {
+            const std::string key = ToLower(std::string_view(token).substr(0, colon));
+            const std::string_view value = std::string_view(token).substr(colon + 1);
+            bool parsed = false;
+
+            if (key == "size") {
+                Range rangeX, rangeZ;
+                if ((parsed = ParseSizeRange(value, rangeX, rangeZ))) {
+                    sizeX.Intersect(rangeX);
+                    sizeZ.Intersect(rangeZ);
+                }
+            }
+            else if (key == "zone") {
+                const int zone = FindName(kZoneNames, value);
+                if ((parsed = zone >= 0)) AddZoneFilter(static_cast<uint8_t>(zone));
+            }
+            else if (key == "wealth") {
+                const int wealth = FindName(kWealthNames, value);
+                if ((parsed = wealth >= 0)) AddWealthFilter(static_cast<uint8_t>(wealth));
+            }
+            else if (key == "stage") {
+                Range range;
+                if ((parsed = ParseRange(value, range))) growthStage.Intersect(range);
+            }
+            else if (key == "cap" || key == "capacity") {
+                Range range;
+                if ((parsed = ParseRange(value, range))) capacity.Intersect(range);
+            }
+            else if (key == "group" || key == "-group") {
+                const uint32_t groupID = ParseGroup(value, groupNames);
+                if ((parsed = groupID != 0)) {
+                    if (key == "group") RequireGroup(*this, groupID);
+                    else ExcludeGroup(*this, groupID);
+                }
+            }
+
+            if (parsed) continue;
+        }
+
+        std::string folded;
+        LotSearchIndex::Fold(token, folded);
+        textTerms.push_back(std::move(folded));
+    }
+}
+
+void LotQuery::Normalize() {
+    std::sort(zoneMasks.begin(), zoneMasks.end());
+    zoneMasks.erase(std::unique(zoneMasks.begin(), zoneMasks.end()), zoneMasks.end());
+    std::sort(wealthMasks.begin(), wealthMasks.end());
+    wealthMasks.erase(std::unique(wealthMasks.begin(), wealthMasks.end()), wealthMasks.end());
+
+    textTerms.erase(std::remove(textTerms.begin(), textTerms.end(), std::string()), textTerms.end());
+    std::sort(textTerms.begin(), textTerms.end());
+    textTerms.erase(std::unique(textTerms.begin(), textTerms.end()), textTerms.end());
+
+    groups.Normalize();
+    if (groups.matchesNothing) matchesNothing = true;
+}
+
+bool LotQuery::IsNarrowedBy(const LotQuery& narrower) const {
+    if (narrower.matchesNothing) return true;
+    if (matchesNothing) return false;
+
+    if (!narrower.sizeX.IsWithin(sizeX) || !narrower.sizeZ.IsWithin(sizeZ)) return false;
+    if (!narrower.growthStage.IsWithin(growthStage) || !narrower.capacity.IsWithin(capacity)) return false;
+
+    // Each mask is one more condition, so the narrower query must keep all of ours
+    if (!std::includes(narrower.zoneMasks.begin(), narrower.zoneMasks.end(), zoneMasks.begin(), zoneMasks.end())) {
+        return false;
+    }
+    if (!std::includes(narrower.wealthMasks.begin(), narrower.wealthMasks.end(),
+                       wealthMasks.begin(), wealthMasks.end())) {
+        return false;
+    }
+
+    // Every term of ours must be implied by a term that contains it (typing extends the last word)
+    for (const std::string& term : textTerms) {
+        const bool implied = std::any_of(narrower.textTerms.begin(), narrower.textTerms.end(),
+            [&](const std::string& other) { return other.find(term) != std::string::npos; });
+        if (!implied) return false;
+    }
+
+    return groups.IsNarrowedBy(narrower.groups);
+}
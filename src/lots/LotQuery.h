@@ -0,0 +1,87 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "OccupantGroupQuery.h"
+
+/**
+ * Everything the lot list is filtered by: the filter widgets plus whatever the search box
+ * adds. All criteria are ANDed. The search box accepts field terms alongside plain text:
+ *
+ *   size:2x3..4x4 zone:R wealth:$$ stage:>=3 cap:>200 group:0x1500 -group:Reward "high school"
+ *
+ * size:WxD (exact), WxD..WxD, WxD.. or ..WxD
+ * zone:R|C|I|A|P|none|other, wealth:$|$$|$$$ (or low/med/high)
+ * stage: and cap: (maximum building capacity) take N, >N, >=N, <N, <=N, N..M, N.. or ..M
+ * Numbers are decimal or 0x-prefixed hex, sizes included (size:0x2x3 is 2 by 3)
+ * group:ID or group:Name requires an occupant group, -group: excludes it
+ *
+ * Quoted phrases and other words are text terms that must each occur in the name or
+ * description. A field term that doesn't parse is searched for as text.
+ */
+struct LotQuery {
+    // Inclusive; an empty range (min > max) matches nothing
+    struct Range {
+        uint32_t min = 0;
+        uint32_t max = UINT32_MAX;
+
+        bool IsAll() const { return min == 0 && max == UINT32_MAX; }
+        bool Contains(uint32_t value) const { return value >= min && value <= max; }
+        bool IsWithin(const Range& outer) const { return min >= outer.min && max <= outer.max; }
+        void Intersect(const Range& other);
+
+        bool operator==(const Range& other) const = default;
+    };
+
+    Range sizeX, sizeZ;
+    Range growthStage;
+    Range capacity;                     // Compared with the lot's maximum capacity
+    std::vector<uint32_t> zoneMasks;    // The lot's zone mask must share a bit with each
+    std::vector<uint8_t> wealthMasks;   // The lot's wealth mask must share a bit with each
+    OccupantGroupQuery groups;
+    std::vector<std::string> textTerms; // Folded (see LotSearchIndex::Fold)
+    bool matchesNothing = false;        // Contradictory terms, e.g. a group both required and excluded
+
+    // Adds the zone filter widget's value (0xFF = any; others as in the Zone combo)
+    void AddZoneFilter(uint8_t filterZoneType);
+
+    // Adds the wealth filter widget's value (0xFF = any, 0..2 = low..high)
+    void AddWealthFilter(uint8_t filterWealthType);
+
+    /**
+     * Parses search box text and ANDs its terms into this query.
+     * @param groupNames Occupant group display names accepted by group: (optional)
+     */
+    void ParseSearch(std::string_view text, const std::unordered_map<uint32_t, std::string>* groupNames = nullptr);
+
+    // Sorts and de-duplicates the mask lists, text terms and groups
+    void Normalize();
+
+    // True if every lot matching narrower also matches this query (both normalized)
+    bool IsNarrowedBy(const LotQuery& narrower) const;
+
+    bool operator==(const LotQuery& other) const = default;
+};
@@ -0,0 +1,185 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LotSearchIndex.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "LotCatalog.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define LOT_SEARCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Folded form of U+00C0..U+00FF; nullptr keeps the character as it is
+    const char* const kLatin1Fold[64] = {
+        "a", "a", "a", "a", "a", "a", "ae", "c",        // C0-C7
+        "e", "e", "e", "e", "i", "i", "i", "i",         // C8-CF
+        "d", "n", "o", "o", "o", "o", "o", nullptr,     // D0-D7 (multiplication sign)
+        "o", "u", "u", "u", "u", "y", "th", "ss",       // D8-DF
+        "a", "a", "a", "a", "a", "a", "ae", "c",        // E0-E7
+        "e", "e", "e", "e", "i", "i", "i", "i",         // E8-EF
+        "d", "n", "o", "o", "o", "o", "o", nullptr,     // F0-F7 (division sign)
+        "o", "u", "u", "u", "u", "y", "th", "y",        // F8-FF
+    };
+
+    bool IsContinuation(unsigned char c) {
+        return (c & 0xC0) == 0x80;
+    }
+
+    // Length of a well-formed UTF-8 sequence starting at text[i], or 0 if there isn't one
+    size_t Utf8SequenceLength(std::string_view text, size_t i) {
+        const unsigned char lead = static_cast<unsigned char>(text[i]);
+        size_t length = 0;
+        if (lead >= 0xC2 && lead <= 0xDF) length = 2;
+        else if (lead >= 0xE0 && lead <= 0xEF) length = 3;
+        else if (lead >= 0xF0 && lead <= 0xF4) length = 4;
+        else return 0;
+
+        if (i + length > text.size()) return 0;
+        for (size_t k = 1; k < length; ++k) {
+            if (!IsContinuation(static_cast<unsigned char>(text[i + k]))) return 0;
+        }
+        return length;
+    }
+
+    // Offset of the first match of needle in haystack[from, end), or end if there is none
+    size_t FindNext(const std::string& haystack, size_t from, size_t end, std::string_view needle) {
+        const size_t n = needle.size();
+        if (end - from < n) return end;
+        const size_t last = end - n; // Last possible match start
+        const char* data = haystack.data();
+        size_t i = from;
+
+#if LOT_SEARCH_SSE2
+        // Compare the needle's first and last bytes 16 positions at a time; only positions
+        // where both match are checked in full
+        if (n > 1) {
+            const __m128i first = _mm_set1_epi8(needle.front());
+            const __m128i lastByte = _mm_set1_epi8(needle.back());
+            for (; i + 16 <= last + 1; i += 16) {
+                const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + n - 1));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, lastByte))));
+                while (mask) {
+                    const size_t pos = i + static_cast<size_t>(std::countr_zero(mask));
+                    if (std::memcmp(data + pos + 1, needle.data() + 1, n - 2) == 0) return pos;
+                    mask &= mask - 1;
+                }
+            }
+        }
+#endif
+
+        const char* found = std::search(data + i, data + end, needle.begin(), needle.end());
+        return found != data + end ? static_cast<size_t>(found - data) : end;
+    }
+} // namespace
+
+void LotSearchIndex::Fold(std::string_view text, std::string& out) {
+    for (size_t i = 0; i < text.size();) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            out += (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : static_cast<char>(c);
+            ++i;
+            continue;
+        }
+
+        const size_t length = Utf8SequenceLength(text, i);
+        if (length == 2 && c == 0xC3) {
+            // U+00C0..U+00FF
+            const unsigned char code = static_cast<unsigned char>(0xC0 + (static_cast<unsigned char>(text[i + 1]) - 0x80));
+            if (const char* folded = kLatin1Fold[code - 0xC0]) out += folded;
+            else out.append(text.data() + i, 2);
+            i += 2;
+        }
+        else if (length > 0) {
+            out.append(text.data() + i, length);
+            i += length;
+        }
+        else {
+            // Not UTF-8: treat as a single-byte Latin-1 / Windows-1252 character
+            const char* folded = c >= 0xC0 ? kLatin1Fold[c - 0xC0] : nullptr;
+            if (folded) out += folded;
+            else out += static_cast<char>(c);
+            ++i;
+        }
+    }
+}
+
+void LotSearchIndex::Build(const LotCatalog& catalog) {
+    Clear();
+    arena.reserve(catalog.GetCount() * 48);
+    slotOffsets.reserve(catalog.GetCount());
+
+    for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+        slotOffsets.push_back(static_cast<uint32_t>(arena.size()));
+
+        // Separators can't occur in a folded query, so matches never span two fields
+        Fold(catalog.GetName(handle), arena);
+        arena += '\0';
+        Fold(catalog.GetDescription(handle), arena);
+        arena += '\0';
+    }
+}
+
+void LotSearchIndex::Clear() {
+    ++generation;
+    arena.clear();
+    slotOffsets.clear();
+}
+
+void LotSearchIndex::Search(std::string_view query, std::vector<uint8_t>& outMatches) const {
+    std::string folded;
+    Fold(query, folded);
+
+    if (folded.empty()) {
+        outMatches.assign(slotOffsets.size(), 1);
+        return;
+    }
+    outMatches.assign(slotOffsets.size(), 0);
+    if (slotOffsets.empty()) return;
+
+    size_t pos = 0;
+    while (true) {
+        pos = FindNext(arena, pos, arena.size(), folded);
+        if (pos >= arena.size()) break;
+
+        // Mark the lot containing the match and continue after it
+        const auto next = std::upper_bound(slotOffsets.begin(), slotOffsets.end(), static_cast<uint32_t>(pos));
+        const size_t slot = static_cast<size_t>(next - slotOffsets.begin()) - 1;
+        outMatches[slot] = 1;
+        if (next == slotOffsets.end()) break;
+        pos = *next;
+    }
+}
+
+bool LotSearchIndex::SlotContains(uint32_t slot, std::string_view foldedQuery) const {
+    if (slot >= slotOffsets.size()) return false;
+    if (foldedQuery.empty()) return true;
+
+    const size_t begin = slotOffsets[slot];
+    const size_t end = slot + 1 < slotOffsets.size() ? slotOffsets[slot + 1] : arena.size();
+    return FindNext(arena, begin, end, foldedQuery) < end;
+}
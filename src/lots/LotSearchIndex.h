@@ -0,0 +1,68 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class LotCatalog;
+
+/**
+ * Search text for every cached lot, normalised once when the cache is built.
+ *
+ * Names and descriptions are lowercased and accent-folded into one contiguous arena
+ * (name '\0' description '\0' per lot), so a query is folded once and matched with a
+ * single substring scan over the arena instead of allocating lowercase copies per lot.
+ */
+class LotSearchIndex {
+public:
+    // Slot i holds catalog row i, so slots are the cache's LotHandles
+    void Build(const LotCatalog& catalog);
+    void Clear();
+
+    /**
+     * Marks every lot whose name or description contains the query.
+     * @param query Raw search text (folded here); empty matches everything
+     * @param outMatches Resized to the slot count; non-zero for matching slots (indexed by LotHandle)
+     */
+    void Search(std::string_view query, std::vector<uint8_t>& outMatches) const;
+
+    // Whether one lot's text contains an already folded query (for narrowing a previous result)
+    bool SlotContains(uint32_t slot, std::string_view foldedQuery) const;
+
+    // Changes whenever the index is rebuilt or cleared, so callers can tell their slots are stale
+    uint32_t GetGeneration() const { return generation; }
+
+    size_t GetSlotCount() const { return slotOffsets.size(); }
+    size_t GetArenaSize() const { return arena.size(); }
+
+    /**
+     * Appends the lowercase, accent-folded form of text to out.
+     * Folds ASCII and Latin-1 letters (UTF-8 or single-byte); other characters are kept.
+     */
+    static void Fold(std::string_view text, std::string& out);
+
+private:
+    std::string arena;
+    std::vector<uint32_t> slotOffsets;  // Start of each lot's text in the arena
+    uint32_t generation = 0;
+};
@@ -0,0 +1,136 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "OccupantGroupQuery.h"
+
+#include <algorithm>
+
+#include "LotCatalog.h"
+
+namespace {
+    bool Contains(const std::vector<uint32_t>& sorted, uint32_t groupID) {
+        return std::binary_search(sorted.begin(), sorted.end(), groupID);
+    }
+
+    void Remove(std::vector<uint32_t>& sorted, uint32_t groupID) {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), groupID);
+        if (it != sorted.end() && *it == groupID) sorted.erase(it);
+    }
+
+    void Insert(std::vector<uint32_t>& sorted, uint32_t groupID) {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), groupID);
+        if (it == sorted.end() || *it != groupID) sorted.insert(it, groupID);
+    }
+
+    void SortUnique(std::vector<uint32_t>& groups) {
+        std::sort(groups.begin(), groups.end());
+        groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+    }
+
+    // Both sorted
+    bool IsSubset(const std::vector<uint32_t>& subset, const std::vector<uint32_t>& set) {
+        return std::includes(set.begin(), set.end(), subset.begin(), subset.end());
+    }
+
+    // Both sorted
+    bool Intersects(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        auto ia = a.begin();
+        auto ib = b.begin();
+        while (ia != a.end() && ib != b.end()) {
+            if (*ia < *ib) ++ia;
+            else if (*ib < *ia) ++ib;
+            else return true;
+        }
+        return false;
+    }
+
+    // Sets must be sorted
+    bool IsContradictory(const OccupantGroupQuery& query) {
+        return Intersects(query.allOf, query.noneOf) || (!query.anyOf.empty() && IsSubset(query.anyOf, query.noneOf));
+    }
+} // namespace
+
+void OccupantGroupQuery::Clear() {
+    anyOf.clear();
+    allOf.clear();
+    noneOf.clear();
+    matchesNothing = false;
+}
+
+OccupantGroupQuery::Role OccupantGroupQuery::GetRole(uint32_t groupID) const {
+    if (Contains(anyOf, groupID)) return Role::Any;
+    if (Contains(allOf, groupID)) return Role::All;
+    if (Contains(noneOf, groupID)) return Role::Exclude;
+    return Role::None;
+}
+
+void OccupantGroupQuery::SetRole(uint32_t groupID, Role role) {
+    Remove(anyOf, groupID);
+    Remove(allOf, groupID);
+    Remove(noneOf, groupID);
+
+    switch (role) {
+        case Role::Any: Insert(anyOf, groupID); break;
+        case Role::All: Insert(allOf, groupID); break;
+        case Role::Exclude: Insert(noneOf, groupID); break;
+        case Role::None: break;
+    }
+
+    // Moving a group can resolve (or, with hand-edited sets, leave) a contradiction elsewhere
+    matchesNothing = IsContradictory(*this);
+}
+
+void OccupantGroupQuery::Normalize() {
+    SortUnique(anyOf);
+    SortUnique(allOf);
+    SortUnique(noneOf);
+
+    // Hand-edited settings can list a group in several sets.
+    // A required group satisfies the whole any-of condition it is part of.
+    if (Intersects(anyOf, allOf)) anyOf.clear();
+
+    matchesNothing = IsContradictory(*this);
+    if (!matchesNothing) {
+        // Excluded groups can never be the one that satisfies any-of
+        std::erase_if(anyOf, [this](uint32_t g) { return Contains(noneOf, g); });
+    }
+}
+
+bool OccupantGroupQuery::IsNarrowedBy(const OccupantGroupQuery& narrower) const {
+    if (narrower.matchesNothing) return true;
+    if (matchesNothing) return false;
+
+    // Any-of only narrows by dropping groups (an empty any-of matches everything)
+    if (!anyOf.empty() && (narrower.anyOf.empty() || !IsSubset(narrower.anyOf, anyOf))) return false;
+    // Requiring or excluding more groups only narrows
+    return IsSubset(allOf, narrower.allOf) && IsSubset(noneOf, narrower.noneOf);
+}
+
+void CompiledGroupQuery::Compile(const OccupantGroupQuery& query, const LotCatalog& catalog) {
+    active = !query.IsEmpty();
+    hasAny = !query.anyOf.empty();
+
+    // Groups no lot has get no bit: they can't satisfy anyOf or allOf, and never exclude anything
+    const size_t anyFound = catalog.BuildGroupMask(query.anyOf, anyMask);
+    const size_t allFound = catalog.BuildGroupMask(query.allOf, allMask);
+    catalog.BuildGroupMask(query.noneOf, noneMask);
+
+    matchesNothing = query.matchesNothing || (hasAny && anyFound == 0) || allFound < query.allOf.size();
+}
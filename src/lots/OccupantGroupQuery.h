@@ -0,0 +1,96 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class LotCatalog;
+
+/**
+ * Boolean occupant group filter. A lot matches when it has at least one of anyOf (if that
+ * set isn't empty), every group in allOf, and no group in noneOf; an empty query matches
+ * every lot. For example "Residential AND Landmark AND NOT Worship" is
+ * allOf = {Residential, Landmark}, noneOf = {Worship}.
+ *
+ * Each set is kept sorted. A group is in at most one of them unless the query is
+ * contradictory (matchesNothing); such sets, e.g. from hand-edited settings, are kept as
+ * they are so saving them doesn't quietly turn them into a different query.
+ */
+struct OccupantGroupQuery {
+    enum class Role : uint8_t {
+        None = 0,
+        Any,        // anyOf: include
+        All,        // allOf: require
+        Exclude     // noneOf: exclude
+    };
+
+    std::vector<uint32_t> anyOf;
+    std::vector<uint32_t> allOf;
+    std::vector<uint32_t> noneOf;
+    // A group is both required and excluded, or every anyOf group is excluded.
+    // Kept up to date by Normalize and SetRole.
+    bool matchesNothing = false;
+
+    bool IsEmpty() const { return anyOf.empty() && allOf.empty() && noneOf.empty(); }
+    void Clear();
+
+    Role GetRole(uint32_t groupID) const;
+    // Moves the group into the set for role (or out of every set for Role::None)
+    void SetRole(uint32_t groupID, Role role);
+
+    // Sorts and de-duplicates the sets, drops anyOf groups that can't change the result
+    // ((X or Y) and X is X; (X or Y) and not X is Y and not X) and sets matchesNothing
+    void Normalize();
+
+    // True if every lot matching narrower also matches this query
+    bool IsNarrowedBy(const OccupantGroupQuery& narrower) const;
+
+    bool operator==(const OccupantGroupQuery& other) const = default;
+};
+
+/**
+ * An OccupantGroupQuery turned into masks over one LotCatalog's group bitsets, so matching
+ * a lot is a word-wise OR of (bits & any), OR of (all & ~bits) and OR of (bits & none),
+ * however many groups the query names.
+ */
+struct CompiledGroupQuery {
+    std::vector<uint64_t> anyMask, allMask, noneMask;  // LotCatalog::GetGroupWords() wide
+    bool active = false;            // The query names at least one group
+    bool hasAny = false;            // anyOf wasn't empty, so one of its bits must be set
+    bool matchesNothing = false;    // A required group, or every anyOf group, is on no lot
+
+    // query must be normalized
+    void Compile(const OccupantGroupQuery& query, const LotCatalog& catalog);
+
+    bool Matches(const uint64_t* bits) const {
+        const size_t words = anyMask.size();
+        uint64_t any = hasAny ? 0 : 1;
+        uint64_t missing = 0;
+        uint64_t excluded = 0;
+        for (size_t word = 0; word < words; ++word) {
+            any |= bits[word] & anyMask[word];
+            missing |= allMask[word] & ~bits[word];
+            excluded |= bits[word] & noneMask[word];
+        }
+        return !matchesNothing && any != 0 && missing == 0 && excluded == 0;
+    }
+};
@@ -1,7 +1,8 @@
 #pragma once
 #include <cstdint>
 #include <string>
-#include <d3d11.h>
+
+#include "../gfx/IconAtlas.h"
 
 /**
  * @brief Represents a cached prop entry with metadata and thumbnail
@@ -22,63 +23,12 @@ struct PropCacheEntry {
     uint32_t s3dGroup = 0;
     uint32_t s3dInstance = 0;
 
-    // Thumbnail data
+    // Thumbnail data (stored in the cache manager's icon atlas; only valid while iconType != None)
     IconType iconType = IconType::None;
-    ID3D11ShaderResourceView* iconSRV = nullptr;
+    gfx::IconAtlasRegion icon;
     int iconWidth = 0;
     int iconHeight = 0;
 
     // Metadata
     uint32_t familyType = 0;           // Prop family (if applicable)
-
-    ~PropCacheEntry() {
-        if (iconSRV) {
-            iconSRV->Release();
-            iconSRV = nullptr;
-        }
-    }
-
-    // Disable copy to prevent double-free
-    PropCacheEntry(const PropCacheEntry&) = delete;
-    PropCacheEntry& operator=(const PropCacheEntry&) = delete;
-
-    // Enable move
-    PropCacheEntry(PropCacheEntry&& other) noexcept
-        : propID(other.propID)
-        , name(std::move(other.name))
-        , exemplarIID(other.exemplarIID)
-        , s3dType(other.s3dType)
-        , s3dGroup(other.s3dGroup)
-        , s3dInstance(other.s3dInstance)
-        , iconType(other.iconType)
-        , iconSRV(other.iconSRV)
-        , iconWidth(other.iconWidth)
-        , iconHeight(other.iconHeight)
-        , familyType(other.familyType)
-    {
-        other.iconSRV = nullptr;
-    }
-
-    PropCacheEntry& operator=(PropCacheEntry&& other) noexcept {
-        if (this != &other) {
-            if (iconSRV) {
-                iconSRV->Release();
-            }
-            propID = other.propID;
-            name = std::move(other.name);
-            exemplarIID = other.exemplarIID;
-            s3dType = other.s3dType;
-            s3dGroup = other.s3dGroup;
-            s3dInstance = other.s3dInstance;
-            iconType = other.iconType;
-            iconSRV = other.iconSRV;
-            iconWidth = other.iconWidth;
-            iconHeight = other.iconHeight;
-            familyType = other.familyType;
-            other.iconSRV = nullptr;
-        }
-        return *this;
-    }
-
-    PropCacheEntry() = default;
 };
@@ -150,7 +150,11 @@ void PropPainterUI::RenderPropPreview() {
     }
 
     const PropCacheEntry* entry = pCacheManager->GetPropByID(selectedPropID);
-    if (!entry || !entry->iconSRV) {
+    ID3D11ShaderResourceView* page = nullptr;
+    if (entry && entry->iconType != PropCacheEntry::IconType::None) {
+        page = pCacheManager->GetIconAtlas().GetPageSRV(entry->icon.page);
+    }
+    if (!page) {
         ImGui::TextWrapped("No preview available");
         return;
     }
@@ -163,7 +167,8 @@ void PropPainterUI::RenderPropPreview() {
     float offset = (availWidth - previewSize) / 2.0f;
     ImGui::SetCursorPos(ImVec2(cursorPos.x + offset, cursorPos.y));
 
-    ImGui::Image(entry->iconSRV, ImVec2(previewSize, previewSize));
+    ImGui::Image(page, ImVec2(previewSize, previewSize),
+                 ImVec2(entry->icon.u0, entry->icon.v0), ImVec2(entry->icon.u1, entry->icon.v1));
 }
 
 void PropPainterUI::RenderPropBrowser() {
@@ -172,6 +177,7 @@ void PropPainterUI::RenderPropBrowser() {
     }
 
     const auto& allProps = pCacheManager->GetAllProps();
+    const gfx::IconAtlas& iconAtlas = pCacheManager->GetIconAtlas();
 
     // Count filtered props
     size_t filteredCount = 0;
@@ -223,7 +229,10 @@ void PropPainterUI::RenderPropBrowser() {
 
                 // Icon column
                 ImGui::TableSetColumnIndex(0);
-                if (prop.iconSRV) {
+                ID3D11ShaderResourceView* page = prop.iconType != PropCacheEntry::IconType::None
+                    ? iconAtlas.GetPageSRV(prop.icon.page)
+                    : nullptr;
+                if (page) {
                     float displaySize = 44.0f;
                     ImVec2 cursorPos = ImGui::GetCursorPos();
 
@@ -233,7 +242,9 @@ void PropPainterUI::RenderPropBrowser() {
                         displaySize = static_cast<float>(prop.iconWidth);
                     }
 
-                    ImGui::Image(prop.iconSRV, ImVec2(displaySize, displaySize));
+                    // Thumbnails share a few atlas pages, so visible rows batch into few draw calls
+                    ImGui::Image(page, ImVec2(displaySize, displaySize),
+                                 ImVec2(prop.icon.u0, prop.icon.v0), ImVec2(prop.icon.u1, prop.icon.v1));
                 } else {
                     ImGui::Dummy(ImVec2(44, 44));
                 }
@@ -0,0 +1,223 @@
+#include "FSHDXTDecoder.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define FSH_DXT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace FSH {
+namespace DXT {
+
+namespace {
+
+inline uint16_t Load16(const uint8_t* p) {
+	return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t Load32(const uint8_t* p) {
+	return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+	       (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+#if FSH_DXT_SSE2
+
+// Build the 4-entry palette of a BC1/BC2 color block as four RGBA8 lanes.
+// BC2 color blocks always use the 4-color mode regardless of endpoint order.
+inline __m128i BuildPalette(const uint8_t* colorBlock, bool allowPunchThrough) {
+	const uint16_t c0 = Load16(colorBlock);
+	const uint16_t c1 = Load16(colorBlock + 2);
+
+	// 16-bit lanes [r0 g0 b0 - r1 g1 b1 -]: mask out each field, move blue to the top of its
+	// lane, then one high multiply replicates the top bits (x << 3 | x >> 2 and x << 2 | x >> 4)
+	const short s0 = static_cast<short>(c0), s1 = static_cast<short>(c1);
+	__m128i e = _mm_set_epi16(0, s1, s1, s1, 0, s0, s0, s0);
+	e = _mm_and_si128(e, _mm_set_epi16(0, 0x001F, 0x07E0, static_cast<short>(0xF800),
+	                                   0, 0x001F, 0x07E0, static_cast<short>(0xF800)));
+	e = _mm_mullo_epi16(e, _mm_set_epi16(0, 2048, 1, 1, 0, 2048, 1, 1));
+	e = _mm_mulhi_epu16(e, _mm_set_epi16(0, 264, 8320, 264, 0, 264, 8320, 264));
+
+	const __m128i e0 = _mm_unpacklo_epi64(e, e);
+	const __m128i e1 = _mm_unpackhi_epi64(e, e);
+	const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+	__m128i mixed;
+	if (c0 > c1 || !allowPunchThrough) {
+		// x * 21846 >> 16 equals x / 3 for every x <= 765
+		const __m128i third = _mm_set1_epi16(21846);
+		const __m128i p2 = _mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(e0, e0), e1), third);
+		const __m128i p3 = _mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(e1, e1), e0), third);
+		mixed = _mm_or_si128(_mm_unpacklo_epi64(p2, p3), opaque);
+	} else {
+		// Midpoint, then transparent black
+		const __m128i p2 = _mm_srli_epi16(_mm_add_epi16(e0, e1), 1);
+		mixed = _mm_or_si128(_mm_move_epi64(p2), _mm_set_epi16(0, 0, 0, 0, 255, 0, 0, 0));
+	}
+	return _mm_packus_epi16(_mm_or_si128(e, opaque), mixed);
+}
+
+// Expand one byte of 2-bit indices (a row of four texels) to palette colors
+inline __m128i SelectRow(uint32_t indexByte, const __m128i pal[4]) {
+	const __m128i lanes = _mm_and_si128(_mm_set1_epi32(static_cast<int>(indexByte)), _mm_set_epi32(0xC0, 0x30, 0x0C, 0x03));
+	__m128i row = _mm_and_si128(_mm_cmpeq_epi32(lanes, _mm_setzero_si128()), pal[0]);
+	row = _mm_or_si128(row, _mm_and_si128(_mm_cmpeq_epi32(lanes, _mm_set_epi32(0x40, 0x10, 0x04, 0x01)), pal[1]));
+	row = _mm_or_si128(row, _mm_and_si128(_mm_cmpeq_epi32(lanes, _mm_set_epi32(0x80, 0x20, 0x08, 0x02)), pal[2]));
+	row = _mm_or_si128(row, _mm_and_si128(_mm_cmpeq_epi32(lanes, _mm_set_epi32(0xC0, 0x30, 0x0C, 0x03)), pal[3]));
+	return row;
+}
+
+// Replace the alpha of a row with four 4-bit values (n * 17, i.e. n << 4 | n)
+inline __m128i ApplyExplicitAlphaRow(__m128i row, uint16_t alphaBits) {
+	__m128i a = _mm_and_si128(_mm_set1_epi32(alphaBits), _mm_set_epi32(0xF000, 0x0F00, 0x00F0, 0x000F));
+	a = _mm_mullo_epi16(a, _mm_set_epi32(1, 16, 256, 4096)); // every nibble to bits 12..15
+	a = _mm_or_si128(_mm_slli_epi32(a, 12), _mm_slli_epi32(a, 16));
+	return _mm_or_si128(_mm_and_si128(row, _mm_set1_epi32(0x00FFFFFF)), a);
+}
+
+// Decode one block into four 16-byte rows starting at dst, rowPitch bytes apart
+template <bool IsBC2>
+inline void DecodeTile(const uint8_t* block, uint8_t* dst, size_t rowPitch) {
+	const uint8_t* colorBlock = IsBC2 ? block + 8 : block;
+	const __m128i palette = BuildPalette(colorBlock, !IsBC2);
+	const __m128i pal[4] = {
+		_mm_shuffle_epi32(palette, 0x00), _mm_shuffle_epi32(palette, 0x55),
+		_mm_shuffle_epi32(palette, 0xAA), _mm_shuffle_epi32(palette, 0xFF),
+	};
+
+	for (int y = 0; y < 4; ++y, dst += rowPitch) {
+		__m128i row = SelectRow(colorBlock[4 + y], pal);
+		if constexpr (IsBC2) {
+			row = ApplyExplicitAlphaRow(row, Load16(block + y * 2));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), row);
+	}
+}
+
+#else
+
+// Pixels are kept as little-endian uint32 (R in the low byte), i.e. RGBA8 in memory
+inline uint32_t PackRGBA(uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+inline void Expand565(uint16_t c, uint32_t& r, uint32_t& g, uint32_t& b) {
+	r = (c >> 11) & 0x1F;
+	g = (c >> 5) & 0x3F;
+	b = c & 0x1F;
+	r = (r << 3) | (r >> 2);
+	g = (g << 2) | (g >> 4);
+	b = (b << 3) | (b >> 2);
+}
+
+// Build the 4-entry palette of a BC1/BC2 color block.
+// BC2 color blocks always use the 4-color mode regardless of endpoint order.
+inline void BuildPalette(const uint8_t* colorBlock, bool allowPunchThrough, uint32_t palette[4]) {
+	const uint16_t c0 = Load16(colorBlock);
+	const uint16_t c1 = Load16(colorBlock + 2);
+
+	uint32_t r0, g0, b0, r1, g1, b1;
+	Expand565(c0, r0, g0, b0);
+	Expand565(c1, r1, g1, b1);
+
+	palette[0] = PackRGBA(r0, g0, b0, 255);
+	palette[1] = PackRGBA(r1, g1, b1, 255);
+
+	if (c0 > c1 || !allowPunchThrough) {
+		palette[2] = PackRGBA((2 * r0 + r1) / 3, (2 * g0 + g1) / 3, (2 * b0 + b1) / 3, 255);
+		palette[3] = PackRGBA((r0 + 2 * r1) / 3, (g0 + 2 * g1) / 3, (b0 + 2 * b1) / 3, 255);
+	} else {
+		palette[2] = PackRGBA((r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 255);
+		palette[3] = 0; // Transparent black
+	}
+}
+
+// Decode one block into four 16-byte rows starting at dst, rowPitch bytes apart
+template <bool IsBC2>
+inline void DecodeTile(const uint8_t* block, uint8_t* dst, size_t rowPitch) {
+	const uint8_t* colorBlock = IsBC2 ? block + 8 : block;
+	uint32_t palette[4];
+	BuildPalette(colorBlock, !IsBC2, palette);
+
+	uint32_t indices = Load32(colorBlock + 4);
+	for (int y = 0; y < 4; ++y, dst += rowPitch) {
+		uint32_t row[4];
+		for (int x = 0; x < 4; ++x, indices >>= 2) {
+			row[x] = palette[indices & 0x3];
+		}
+		if constexpr (IsBC2) {
+			const uint32_t alphaBits = Load16(block + y * 2);
+			for (int x = 0; x < 4; ++x) {
+				row[x] = (row[x] & 0x00FFFFFF) | ((((alphaBits >> (x * 4)) & 0xF) * 17) << 24);
+			}
+		}
+		std::memcpy(dst, row, sizeof(row));
+	}
+}
+
+#endif
+
+template <bool IsBC2>
+bool DecodeImage(const uint8_t* blocks, size_t size, uint32_t width, uint32_t height, uint8_t* rgba) {
+	if (!blocks || !rgba || width == 0 || height == 0) return false;
+
+	const size_t required = IsBC2 ? GetBC2Size(width, height) : GetBC1Size(width, height);
+	if (size < required) return false;
+
+	constexpr size_t blockBytes = IsBC2 ? 16 : 8;
+	const uint32_t blocksX = (width + 3) / 4;
+	const uint32_t blocksY = (height + 3) / 4;
+	const size_t rowPitch = static_cast<size_t>(width) * 4;
+
+	const uint8_t* block = blocks;
+	uint8_t tile[64];
+	for (uint32_t by = 0; by < blocksY; ++by) {
+		const uint32_t rows = (std::min)(4u, height - by * 4);
+		uint8_t* dstRow = rgba + static_cast<size_t>(by) * 4 * rowPitch;
+
+		for (uint32_t bx = 0; bx < blocksX; ++bx, block += blockBytes) {
+			const uint32_t cols = (std::min)(4u, width - bx * 4);
+			uint8_t* dst = dstRow + static_cast<size_t>(bx) * 16;
+			if (rows == 4 && cols == 4) {
+				DecodeTile<IsBC2>(block, dst, rowPitch);
+				continue;
+			}
+
+			// Partial block on the right or bottom edge
+			DecodeTile<IsBC2>(block, tile, 16);
+			for (uint32_t y = 0; y < rows; ++y, dst += rowPitch) {
+				std::memcpy(dst, tile + y * 16, cols * 4);
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+size_t GetBC1Size(uint32_t width, uint32_t height) {
+	return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 8;
+}
+
+size_t GetBC2Size(uint32_t width, uint32_t height) {
+	return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+}
+
+bool DecodeBC1(const uint8_t* blocks, size_t size, uint32_t width, uint32_t height, uint8_t* rgba) {
+	return DecodeImage<false>(blocks, size, width, height, rgba);
+}
+
+bool DecodeBC2(const uint8_t* blocks, size_t size, uint32_t width, uint32_t height, uint8_t* rgba) {
+	return DecodeImage<true>(blocks, size, width, height, rgba);
+}
+
+void DecodeBC1Block(const uint8_t* block, uint8_t* rgba16) {
+	DecodeTile<false>(block, rgba16, 16);
+}
+
+void DecodeBC2Block(const uint8_t* block, uint8_t* rgba16) {
+	DecodeTile<true>(block, rgba16, 16);
+}
+
+} // namespace DXT
+} // namespace FSH
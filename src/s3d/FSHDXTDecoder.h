@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Software BC1 (DXT1) / BC2 (DXT3) decoder -> RGBA8
+// OS-independent; SSE2 on x86, scalar elsewhere. Decodes on the calling thread: callers already
+// run on the thumbnail worker pool, so the decoder doesn't spawn threads of its own.
+
+namespace FSH {
+namespace DXT {
+
+// Size in bytes of a BC1/BC2 image of the given dimensions
+size_t GetBC1Size(uint32_t width, uint32_t height);
+size_t GetBC2Size(uint32_t width, uint32_t height);
+
+// Decode a full image. 'rgba' receives width * height * 4 bytes (tightly packed rows).
+// Returns false if the input is smaller than the image requires.
+bool DecodeBC1(const uint8_t* blocks, size_t size, uint32_t width, uint32_t height, uint8_t* rgba);
+bool DecodeBC2(const uint8_t* blocks, size_t size, uint32_t width, uint32_t height, uint8_t* rgba);
+
+// Decode a single 4x4 block into 16 RGBA8 pixels (64 bytes, row-major)
+void DecodeBC1Block(const uint8_t* block, uint8_t* rgba16);
+void DecodeBC2Block(const uint8_t* block, uint8_t* rgba16);
+
+} // namespace DXT
+} // namespace FSH
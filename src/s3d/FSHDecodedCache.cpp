@@ -0,0 +1,123 @@
+#include "FSHDecodedCache.h"
+
+namespace FSH {
+
+// Settles a load on every path out of DecodedFileCache::Load, exceptions included: the pending
+// entry is dropped (unless a Clear() already replaced it) and waiters are released.
+class DecodedFileCache::PendingLoadGuard {
+public:
+	PendingLoadGuard(DecodedFileCache& cache, const TextureKey& key, uint64_t clearCount,
+	                 std::promise<std::shared_ptr<const File>>& promise)
+		: m_cache(cache), m_key(key), m_clearCount(clearCount), m_promise(promise) {}
+	PendingLoadGuard(const PendingLoadGuard&) = delete;
+	PendingLoadGuard& operator=(const PendingLoadGuard&) = delete;
+
+	// Call with the cache lock held
+	void Release() {
+		auto it = m_cache.m_loading.find(m_key);
+		if (it != m_cache.m_loading.end() && it->second.clearCount == m_clearCount) {
+			m_cache.m_loading.erase(it);
+		}
+		m_released = true;
+	}
+
+	void SetResult(std::shared_ptr<const File> result) {
+		m_promise.set_value(std::move(result));
+		m_settled = true;
+	}
+
+	~PendingLoadGuard() {
+		if (!m_released) {
+			std::lock_guard<std::mutex> lock(m_cache.m_mutex);
+			Release();
+		}
+		if (!m_settled) {
+			m_promise.set_value(nullptr);
+		}
+	}
+
+private:
+	DecodedFileCache& m_cache;
+	TextureKey m_key;
+	uint64_t m_clearCount;
+	std::promise<std::shared_ptr<const File>>& m_promise;
+	bool m_released = false;
+	bool m_settled = false;
+};
+
+std::shared_ptr<const File> DecodedFileCache::Load(const TextureKey& key, const Loader& loader) {
+	std::promise<std::shared_ptr<const File>> promise;
+	uint64_t clearCount;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (auto* cached = m_files.Find(key)) {
+			return *cached;
+		}
+		auto pending = m_loading.find(key);
+		if (pending != m_loading.end()) {
+			auto result = pending->second.result;
+			lock.unlock();
+			return result.get();
+		}
+		clearCount = m_clearCount;
+		m_loading.emplace(key, PendingLoad{promise.get_future().share(), clearCount});
+	}
+
+	PendingLoadGuard guard(*this, key, clearCount, promise);
+
+	std::shared_ptr<const File> result;
+	size_t bytes = NEGATIVE_ENTRY_BYTES;
+	auto file = std::make_shared<File>();
+	if (loader(*file) && !file->bitmaps.empty()) {
+		bytes = TrimToMainBitmap(*file);
+		result = std::move(file);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		guard.Release();
+		if (clearCount == m_clearCount) {
+			m_files.Insert(key, result, bytes);
+		}
+	}
+	guard.SetResult(result);
+	return result;
+}
+
+std::shared_ptr<const File> DecodedFileCache::Find(const TextureKey& key) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (auto* cached = m_files.Find(key)) {
+		return *cached;
+	}
+	return nullptr;
+}
+
+std::shared_ptr<const File> DecodedFileCache::Store(const TextureKey& key, std::shared_ptr<File> file) {
+	if (!file || file->bitmaps.empty()) return nullptr;
+
+	const size_t bytes = TrimToMainBitmap(*file);
+	std::shared_ptr<const File> shared = std::move(file);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_files.Insert(key, shared, bytes);
+	return shared;
+}
+
+void DecodedFileCache::Clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_files.Clear();
+	m_loading.clear(); // Their loaders still settle the futures other callers hold
+	++m_clearCount;
+}
+
+LRUCache<TextureKey, std::shared_ptr<const File>, TextureKeyHash>::Stats DecodedFileCache::GetStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_files.GetStats();
+}
+
+size_t DecodedFileCache::TrimToMainBitmap(File& file) {
+	file.bitmaps.resize(1);
+	return sizeof(File) + file.bitmaps[0].data.size();
+}
+
+} // namespace FSH
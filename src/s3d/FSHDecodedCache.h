@@ -0,0 +1,82 @@
+#pragma once
+#include "FSHStructures.h"
+#include "LRUCache.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Parsed FSH files shared between the texture cache and CPU-side users.
+// OS-independent: the file is produced by a loader callback, so no resource manager or D3D is needed here.
+
+namespace FSH {
+
+struct TextureKey {
+	uint32_t groupID;
+	uint32_t instanceID;
+	uint32_t targetSize; // Requested output size; 0 for decoded files, which keep the whole chain
+
+	bool operator==(const TextureKey& other) const = default;
+};
+
+struct TextureKeyHash {
+	size_t operator()(const TextureKey& key) const {
+		uint64_t h = (static_cast<uint64_t>(key.groupID) << 32) | key.instanceID;
+		h ^= static_cast<uint64_t>(key.targetSize) * 0x9E3779B97F4A7C15ull;
+		h ^= h >> 29;
+		h *= 0xBF58476D1CE4E5B9ull;
+		h ^= h >> 32;
+		return static_cast<size_t>(h);
+	}
+};
+
+// Byte-budgeted, thread-safe cache of parsed FSH files (QFS expanded, main bitmap and its mip chain).
+// Failed loads are cached as nullptr so a missing file is not searched for again.
+class DecodedFileCache {
+public:
+	// Fills the file; returns false if it can't be loaded
+	using Loader = std::function<bool(File&)>;
+
+	// Negative entries still cost something so they age out like any other entry
+	static constexpr size_t NEGATIVE_ENTRY_BYTES = 64;
+
+	explicit DecodedFileCache(size_t byteBudget) : m_files(byteBudget) {}
+
+	// Returns the cached file, waits for a load of the same key already in flight, or runs the
+	// loader without the cache lock held. A loader that throws is not cached: the exception
+	// reaches this caller, and callers waiting on the same load get nullptr.
+	std::shared_ptr<const File> Load(const TextureKey& key, const Loader& loader);
+
+	// nullptr both for files not loaded yet and for known failures
+	std::shared_ptr<const File> Find(const TextureKey& key);
+
+	// Insert a file parsed elsewhere (e.g. on a worker thread). Trims it to the main bitmap
+	// and returns the shared copy, or nullptr if it has no bitmaps.
+	std::shared_ptr<const File> Store(const TextureKey& key, std::shared_ptr<File> file);
+
+	// Drop every entry. Loads in flight still return their file but don't repopulate the cache.
+	void Clear();
+
+	LRUCache<TextureKey, std::shared_ptr<const File>, TextureKeyHash>::Stats GetStats() const;
+
+	// Only the main bitmap (and its mip chain) is ever used. Returns the bytes to charge.
+	static size_t TrimToMainBitmap(File& file);
+
+private:
+	// A load in flight; other callers wanting the same file wait on its future
+	struct PendingLoad {
+		std::shared_future<std::shared_ptr<const File>> result;
+		uint64_t clearCount;
+	};
+	class PendingLoadGuard;
+
+	mutable std::mutex m_mutex;
+	LRUCache<TextureKey, std::shared_ptr<const File>, TextureKeyHash> m_files; // nullptr marks a failed load
+	std::unordered_map<TextureKey, PendingLoad, TextureKeyHash> m_loading;
+	uint64_t m_clearCount = 0;
+};
+
+} // namespace FSH
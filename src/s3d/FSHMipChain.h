@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FSHStructures.h"
+
+// Mip chain layout and level selection for FSH bitmaps
+// OS-independent: only describes where each level lives inside Bitmap::data.
+
+namespace FSH {
+
+struct MipLevelInfo {
+	uint32_t width;
+	uint32_t height;
+	size_t offset;   // Byte offset of the level inside Bitmap::data
+	size_t size;     // Byte size of the level
+};
+
+// Byte size of one level of the given format (0 for unknown formats)
+inline size_t GetLevelDataSize(uint8_t code, uint32_t width, uint32_t height) {
+	const size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+	switch (code) {
+		case CODE_DXT1: return blocks * 8;
+		case CODE_DXT3: return blocks * 16;
+		case CODE_32BIT: return static_cast<size_t>(width) * height * 4;
+		case CODE_24BIT: return static_cast<size_t>(width) * height * 3;
+		case CODE_16BIT_4444:
+		case CODE_16BIT_0565:
+		case CODE_16BIT_1555: return static_cast<size_t>(width) * height * 2;
+		default: return 0;
+	}
+}
+
+// Number of levels a full chain of the given size can hold (including the main level)
+inline uint32_t GetMaxMipLevels(uint32_t width, uint32_t height) {
+	uint32_t levels = 1;
+	while (width > 1 || height > 1) {
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+		++levels;
+	}
+	return levels;
+}
+
+// Lay out 'levelCount' levels (main level first) back to back, stopping early if a
+// level would run past 'availableBytes'. Levels halve in size down to 1x1.
+inline std::vector<MipLevelInfo> ComputeMipChain(uint8_t code, uint32_t width, uint32_t height,
+                                                 uint32_t levelCount, size_t availableBytes)
+{
+	std::vector<MipLevelInfo> levels;
+	if (width == 0 || height == 0) return levels;
+
+	if (levelCount > GetMaxMipLevels(width, height)) levelCount = GetMaxMipLevels(width, height);
+	levels.reserve(levelCount);
+
+	size_t offset = 0;
+	for (uint32_t i = 0; i < levelCount; ++i) {
+		const size_t size = GetLevelDataSize(code, width, height);
+		if (size == 0 || offset + size > availableBytes) break;
+
+		levels.push_back({width, height, offset, size});
+		offset += size;
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+	return levels;
+}
+
+// Pick the first (most detailed) level to upload for output rendered at 'targetSize' pixels:
+// the smallest level whose larger dimension still covers the target. A target of 0 keeps
+// the main level. Block-compressed top levels must have dimensions divisible by 4.
+inline uint32_t SelectFirstMip(const std::vector<MipLevelInfo>& levels, uint8_t code, uint32_t targetSize) {
+	if (levels.empty() || targetSize == 0) return 0;
+
+	const bool blockCompressed = code == CODE_DXT1 || code == CODE_DXT3;
+	uint32_t selected = 0;
+	for (uint32_t i = 1; i < levels.size(); ++i) {
+		const MipLevelInfo& level = levels[i];
+		const uint32_t larger = level.width > level.height ? level.width : level.height;
+		if (larger < targetSize) break;
+		if (blockCompressed && ((level.width % 4) != 0 || (level.height % 4) != 0)) break;
+		selected = i;
+	}
+	return selected;
+}
+
+} // namespace FSH
@@ -0,0 +1,298 @@
+#include "FSHPixelConvert.h"
+#include "FSHDXTDecoder.h"
+#include "FSHMipChain.h"
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define FSH_PIXELCONVERT_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace FSH {
+namespace PixelConvert {
+
+// ---------------------------------------------------------------------------
+// Scalar reference kernels
+// ---------------------------------------------------------------------------
+
+namespace {
+
+inline uint16_t Load16(const uint8_t* p) {
+	uint16_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+void ScalarBGRA8888(const uint8_t* src, uint8_t* dst, size_t count) {
+	for (size_t i = 0; i < count; ++i, src += 4, dst += 4) {
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = src[0];
+		dst[3] = src[3];
+	}
+}
+
+void ScalarBGR888(const uint8_t* src, uint8_t* dst, size_t count) {
+	for (size_t i = 0; i < count; ++i, src += 3, dst += 4) {
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = src[0];
+		dst[3] = 255; // Fully opaque
+	}
+}
+
+void ScalarARGB4444(const uint8_t* src, uint8_t* dst, size_t count) {
+	for (size_t i = 0; i < count; ++i, src += 2, dst += 4) {
+		const uint16_t color = Load16(src);
+		const uint8_t a = (color >> 12) & 0xF;
+		const uint8_t r = (color >> 8) & 0xF;
+		const uint8_t g = (color >> 4) & 0xF;
+		const uint8_t b = color & 0xF;
+
+		// Expand 4-bit to 8-bit
+		dst[0] = static_cast<uint8_t>((r << 4) | r);
+		dst[1] = static_cast<uint8_t>((g << 4) | g);
+		dst[2] = static_cast<uint8_t>((b << 4) | b);
+		dst[3] = static_cast<uint8_t>((a << 4) | a);
+	}
+}
+
+void ScalarRGB565(const uint8_t* src, uint8_t* dst, size_t count) {
+	for (size_t i = 0; i < count; ++i, src += 2, dst += 4) {
+		const uint16_t color = Load16(src);
+		const uint8_t r = (color >> 11) & 0x1F;
+		const uint8_t g = (color >> 5) & 0x3F;
+		const uint8_t b = color & 0x1F;
+
+		// Expand to 8-bit
+		dst[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+		dst[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+		dst[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+		dst[3] = 255; // Fully opaque
+	}
+}
+
+void ScalarARGB1555(const uint8_t* src, uint8_t* dst, size_t count) {
+	for (size_t i = 0; i < count; ++i, src += 2, dst += 4) {
+		const uint16_t color = Load16(src);
+		const uint8_t a = (color >> 15) & 0x1;
+		const uint8_t r = (color >> 10) & 0x1F;
+		const uint8_t g = (color >> 5) & 0x1F;
+		const uint8_t b = color & 0x1F;
+
+		// Expand to 8-bit
+		dst[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+		dst[1] = static_cast<uint8_t>((g << 3) | (g >> 2));
+		dst[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+		dst[3] = a ? 255 : 0;
+	}
+}
+
+const KernelSet kScalarKernels = {
+	"scalar", ScalarBGRA8888, ScalarBGR888, ScalarARGB4444, ScalarRGB565, ScalarARGB1555
+};
+
+} // namespace
+
+const KernelSet& GetScalarKernels() {
+	return kScalarKernels;
+}
+
+// ---------------------------------------------------------------------------
+// SSE2 kernels
+// 16-bit formats build two 16-bit lanes per pixel (R|G<<8 and B|A<<8) and
+// interleave them, so each 16-byte load of 8 pixels yields two 16-byte stores.
+// ---------------------------------------------------------------------------
+
+#if FSH_PIXELCONVERT_X86
+
+namespace {
+
+void SSE2BGRA8888(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m128i maskAG = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+	const __m128i maskRB = _mm_set1_epi32(0x00FF00FF);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+		__m128i rb = _mm_and_si128(v, maskRB);
+		// Swap the R and B words inside each pixel
+		rb = _mm_shufflelo_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+		rb = _mm_shufflehi_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+		const __m128i out = _mm_or_si128(_mm_and_si128(v, maskAG), rb);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+	}
+	ScalarBGRA8888(src + i * 4, dst + i * 4, count - i);
+}
+
+inline void Store2x(uint8_t* dst, __m128i rg, __m128i ba) {
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(rg, ba));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(rg, ba));
+}
+
+void SSE2ARGB4444(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m128i lowNibble = _mm_set1_epi16(0x000F);
+	const __m128i highNibble = _mm_set1_epi16(0x0F00);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+		// r in byte 0, g in byte 1 (one nibble each), then n -> n * 17
+		__m128i rg = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 8), lowNibble),
+		                          _mm_and_si128(_mm_slli_epi16(v, 4), highNibble));
+		__m128i ba = _mm_or_si128(_mm_and_si128(v, lowNibble),
+		                          _mm_and_si128(_mm_srli_epi16(v, 4), highNibble));
+		rg = _mm_or_si128(rg, _mm_slli_epi16(rg, 4));
+		ba = _mm_or_si128(ba, _mm_slli_epi16(ba, 4));
+		Store2x(dst + i * 4, rg, ba);
+	}
+	ScalarARGB4444(src + i * 2, dst + i * 4, count - i);
+}
+
+void SSE2RGB565(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m128i maskF8 = _mm_set1_epi16(0x00F8);
+	const __m128i maskFC = _mm_set1_epi16(0x00FC);
+	const __m128i mask03 = _mm_set1_epi16(0x0003);
+	const __m128i mask07 = _mm_set1_epi16(0x0007);
+	const __m128i alpha = _mm_set1_epi16(static_cast<short>(0xFF00));
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+		const __m128i r = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 8), maskF8), _mm_srli_epi16(v, 13));
+		const __m128i g = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 3), maskFC),
+		                               _mm_and_si128(_mm_srli_epi16(v, 9), mask03));
+		const __m128i b = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(v, 3), maskF8),
+		                               _mm_and_si128(_mm_srli_epi16(v, 2), mask07));
+		Store2x(dst + i * 4, _mm_or_si128(r, _mm_slli_epi16(g, 8)), _mm_or_si128(b, alpha));
+	}
+	ScalarRGB565(src + i * 2, dst + i * 4, count - i);
+}
+
+void SSE2ARGB1555(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m128i maskF8 = _mm_set1_epi16(0x00F8);
+	const __m128i mask07 = _mm_set1_epi16(0x0007);
+	const __m128i alphaMask = _mm_set1_epi16(static_cast<short>(0xFF00));
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+		const __m128i r = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 7), maskF8),
+		                               _mm_and_si128(_mm_srli_epi16(v, 12), mask07));
+		const __m128i g = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 2), maskF8),
+		                               _mm_and_si128(_mm_srli_epi16(v, 7), mask07));
+		const __m128i b = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(v, 3), maskF8),
+		                               _mm_and_si128(_mm_srli_epi16(v, 2), mask07));
+		// Arithmetic shift smears the alpha bit across the word
+		const __m128i a = _mm_and_si128(_mm_srai_epi16(v, 15), alphaMask);
+		Store2x(dst + i * 4, _mm_or_si128(r, _mm_slli_epi16(g, 8)), _mm_or_si128(b, a));
+	}
+	ScalarARGB1555(src + i * 2, dst + i * 4, count - i);
+}
+
+// 24-bit needs a byte shuffle (SSSE3); plain SSE2 keeps the scalar kernel
+const KernelSet kSSE2Kernels = {
+	"sse2", SSE2BGRA8888, ScalarBGR888, SSE2ARGB4444, SSE2RGB565, SSE2ARGB1555
+};
+
+void CpuId(int leaf, int subleaf, int regs[4]) {
+#if defined(_MSC_VER)
+	__cpuidex(regs, leaf, subleaf);
+#else
+	unsigned int a, b, c, d;
+	__cpuid_count(leaf, subleaf, a, b, c, d);
+	regs[0] = static_cast<int>(a);
+	regs[1] = static_cast<int>(b);
+	regs[2] = static_cast<int>(c);
+	regs[3] = static_cast<int>(d);
+#endif
+}
+
+uint64_t ReadXCR0() {
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+bool CpuSupportsAVX2() {
+	int regs[4];
+	CpuId(0, 0, regs);
+	if (regs[0] < 7) return false;
+
+	CpuId(1, 0, regs);
+	const bool osxsave = (regs[2] & (1 << 27)) != 0;
+	const bool avx = (regs[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx) return false;
+
+	// The OS must save YMM state across context switches
+	if ((ReadXCR0() & 0x6) != 0x6) return false;
+
+	CpuId(7, 0, regs);
+	return (regs[1] & (1 << 5)) != 0;
+}
+
+} // namespace
+
+const KernelSet* GetSSE2Kernels() {
+	return &kSSE2Kernels;
+}
+
+const KernelSet* GetAVX2Kernels() {
+	static const bool supported = CpuSupportsAVX2();
+	return supported ? &detail::kAVX2Kernels : nullptr;
+}
+
+#else
+
+const KernelSet* GetSSE2Kernels() {
+	return nullptr;
+}
+
+const KernelSet* GetAVX2Kernels() {
+	return nullptr;
+}
+
+#endif
+
+const KernelSet& GetKernels() {
+	static const KernelSet* selected = [] {
+		if (const KernelSet* avx2 = GetAVX2Kernels()) return avx2;
+		if (const KernelSet* sse2 = GetSSE2Kernels()) return sse2;
+		return &kScalarKernels;
+	}();
+	return *selected;
+}
+
+bool ConvertLevelToRGBA8(uint8_t code, uint32_t width, uint32_t height,
+                         const uint8_t* data, size_t size, uint8_t* rgba)
+{
+	const size_t required = GetLevelDataSize(code, width, height);
+	if (!data || !rgba || required == 0 || size < required) return false;
+
+	const size_t pixelCount = static_cast<size_t>(width) * height;
+	const KernelSet& kernels = GetKernels();
+
+	switch (code) {
+		case CODE_32BIT:      kernels.bgra8888(data, rgba, pixelCount); return true;
+		case CODE_24BIT:      kernels.bgr888(data, rgba, pixelCount); return true;
+		case CODE_16BIT_4444: kernels.argb4444(data, rgba, pixelCount); return true;
+		case CODE_16BIT_0565: kernels.rgb565(data, rgba, pixelCount); return true;
+		case CODE_16BIT_1555: kernels.argb1555(data, rgba, pixelCount); return true;
+		case CODE_DXT1:       return DXT::DecodeBC1(data, size, width, height, rgba);
+		case CODE_DXT3:       return DXT::DecodeBC2(data, size, width, height, rgba);
+		default:              return false;
+	}
+}
+
+} // namespace PixelConvert
+} // namespace FSH
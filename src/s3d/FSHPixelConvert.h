@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Pixel conversion kernels for uncompressed FSH bitmap formats -> RGBA8
+// OS-independent; SIMD variants are selected at runtime from CPU features.
+// The scalar kernels are the reference implementation: every SIMD kernel must
+// produce bit-identical output.
+
+namespace FSH {
+namespace PixelConvert {
+
+// Convert 'count' source pixels at 'src' to RGBA8 at 'dst' (count * 4 bytes).
+// Source pixels are little-endian and need no particular alignment.
+using ConvertFn = void (*)(const uint8_t* src, uint8_t* dst, size_t count);
+
+struct KernelSet {
+	const char* name;
+	ConvertFn bgra8888;   // CODE_32BIT
+	ConvertFn bgr888;     // CODE_24BIT
+	ConvertFn argb4444;   // CODE_16BIT_4444
+	ConvertFn rgb565;     // CODE_16BIT_0565
+	ConvertFn argb1555;   // CODE_16BIT_1555
+};
+
+// Reference kernels (always available)
+const KernelSet& GetScalarKernels();
+
+// SSE2 kernels, or nullptr when not built for x86
+const KernelSet* GetSSE2Kernels();
+
+// AVX2 kernels, or nullptr when not built for x86 or the CPU/OS lacks AVX2
+const KernelSet* GetAVX2Kernels();
+
+// Fastest kernel set supported by this CPU (resolved once)
+const KernelSet& GetKernels();
+
+// Convert one level of raw FSH pixel data in any supported format (including DXT1/DXT3)
+// to RGBA8. 'rgba' receives width * height * 4 bytes.
+// Returns false for unsupported formats or when 'size' is smaller than the level.
+bool ConvertLevelToRGBA8(uint8_t code, uint32_t width, uint32_t height,
+                         const uint8_t* data, size_t size, uint8_t* rgba);
+
+namespace detail {
+// Defined in FSHPixelConvertAVX2.cpp, which is the only file compiled with AVX2 enabled
+extern const KernelSet kAVX2Kernels;
+}
+
+} // namespace PixelConvert
+} // namespace FSH
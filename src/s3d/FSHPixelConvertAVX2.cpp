@@ -0,0 +1,125 @@
+// AVX2 pixel conversion kernels.
+// This is the only translation unit built with AVX2 code generation enabled (see
+// CMakeLists.txt), so it must stay free of shared inline code: anything inlined here
+// could be picked by the linker for callers running on CPUs without AVX2.
+// Tails are handed to the scalar reference kernels.
+#include "FSHPixelConvert.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+
+namespace FSH {
+namespace PixelConvert {
+
+namespace {
+
+// Each 128-bit lane of an unpack holds pixels from the matching source lane;
+// reorder so the two stores are sequential
+inline void Store2x(uint8_t* dst, __m256i rg, __m256i ba) {
+	const __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+	const __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(lo, hi, 0x20));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+void AVX2BGRA8888(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m256i swapRB = _mm256_setr_epi8(
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(v, swapRB));
+	}
+	GetScalarKernels().bgra8888(src + i * 4, dst + i * 4, count - i);
+}
+
+void AVX2BGR888(const uint8_t* src, uint8_t* dst, size_t count) {
+	// Spread 24 source bytes so each lane holds 12 (4 pixels), then expand to BGRA order
+	const __m256i spread = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+	const __m256i expand = _mm256_setr_epi8(
+		2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+		2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+	size_t i = 0;
+	// Each iteration reads 32 bytes but consumes 24, so keep 3 extra pixels in range
+	for (; i + 11 <= count; i += 8) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 3));
+		const __m256i rgb = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(v, spread), expand);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_or_si256(rgb, alpha));
+	}
+	GetScalarKernels().bgr888(src + i * 3, dst + i * 4, count - i);
+}
+
+void AVX2ARGB4444(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m256i lowNibble = _mm256_set1_epi16(0x000F);
+	const __m256i highNibble = _mm256_set1_epi16(0x0F00);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+		__m256i rg = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 8), lowNibble),
+		                             _mm256_and_si256(_mm256_slli_epi16(v, 4), highNibble));
+		__m256i ba = _mm256_or_si256(_mm256_and_si256(v, lowNibble),
+		                             _mm256_and_si256(_mm256_srli_epi16(v, 4), highNibble));
+		rg = _mm256_or_si256(rg, _mm256_slli_epi16(rg, 4));
+		ba = _mm256_or_si256(ba, _mm256_slli_epi16(ba, 4));
+		Store2x(dst + i * 4, rg, ba);
+	}
+	GetScalarKernels().argb4444(src + i * 2, dst + i * 4, count - i);
+}
+
+void AVX2RGB565(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m256i maskF8 = _mm256_set1_epi16(0x00F8);
+	const __m256i maskFC = _mm256_set1_epi16(0x00FC);
+	const __m256i mask03 = _mm256_set1_epi16(0x0003);
+	const __m256i mask07 = _mm256_set1_epi16(0x0007);
+	const __m256i alpha = _mm256_set1_epi16(static_cast<short>(0xFF00));
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+		const __m256i r = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 8), maskF8), _mm256_srli_epi16(v, 13));
+		const __m256i g = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 3), maskFC),
+		                                  _mm256_and_si256(_mm256_srli_epi16(v, 9), mask03));
+		const __m256i b = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(v, 3), maskF8),
+		                                  _mm256_and_si256(_mm256_srli_epi16(v, 2), mask07));
+		Store2x(dst + i * 4, _mm256_or_si256(r, _mm256_slli_epi16(g, 8)), _mm256_or_si256(b, alpha));
+	}
+	GetScalarKernels().rgb565(src + i * 2, dst + i * 4, count - i);
+}
+
+void AVX2ARGB1555(const uint8_t* src, uint8_t* dst, size_t count) {
+	const __m256i maskF8 = _mm256_set1_epi16(0x00F8);
+	const __m256i mask07 = _mm256_set1_epi16(0x0007);
+	const __m256i alphaMask = _mm256_set1_epi16(static_cast<short>(0xFF00));
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+		const __m256i r = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 7), maskF8),
+		                                  _mm256_and_si256(_mm256_srli_epi16(v, 12), mask07));
+		const __m256i g = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 2), maskF8),
+		                                  _mm256_and_si256(_mm256_srli_epi16(v, 7), mask07));
+		const __m256i b = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(v, 3), maskF8),
+		                                  _mm256_and_si256(_mm256_srli_epi16(v, 2), mask07));
+		const __m256i a = _mm256_and_si256(_mm256_srai_epi16(v, 15), alphaMask);
+		Store2x(dst + i * 4, _mm256_or_si256(r, _mm256_slli_epi16(g, 8)), _mm256_or_si256(b, a));
+	}
+	GetScalarKernels().argb1555(src + i * 2, dst + i * 4, count - i);
+}
+
+} // namespace
+
+namespace detail {
+const KernelSet kAVX2Kernels = {
+	"avx2", AVX2BGRA8888, AVX2BGR888, AVX2ARGB4444, AVX2RGB565, AVX2ARGB1555
+};
+}
+
+} // namespace PixelConvert
+} // namespace FSH
+
+#endif
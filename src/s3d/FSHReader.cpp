@@ -1,5 +1,7 @@
 // ReSharper disable CppDFAConstantConditions
 #include "FSHReader.h"
+#include "FSHMipChain.h"
+#include "FSHPixelConvert.h"
 #include "QFSDecompressor.h"
 #include "../utils/Logger.h"
 #include "cISC4DBSegment.h"
@@ -28,9 +30,10 @@ bool Reader::Parse(const uint8_t* buffer, size_t bufferSize, File& outFile) {
 	const uint8_t* dataPtr = buffer;
 	size_t dataSize = bufferSize;
 
-	if (QFS::Decompressor::IsQFSCompressed(buffer, bufferSize)) {
+	// Resource manager records start at the QFS header; they never carry the DBPF size prefix
+	if (QFS::Decompressor::IsQFSCompressed(buffer, bufferSize, QFS::Framing::Bare)) {
 		LOG_TRACE("FSH is QFS-compressed, decompressing...");
-		if (!QFS::Decompressor::Decompress(buffer, bufferSize, decompressedData)) {
+		if (!QFS::Decompressor::Decompress(buffer, bufferSize, QFS::Framing::Bare, decompressedData)) {
 			LOG_ERROR("Failed to decompress QFS-compressed FSH");
 			return false;
 		}
@@ -55,6 +58,15 @@ bool Reader::Parse(const uint8_t* buffer, size_t bufferSize, File& outFile) {
 	LOG_TRACE("FSH header: magic=0x{:08X}, entries={}, hasMipmaps={}",
 	          outFile.header.magic, outFile.header.numEntries, outFile.header.HasMipmaps());
 
+	// Each directory entry takes 8 bytes; a count the data can't hold is a corrupt header,
+	// and must be rejected before it sizes any allocation
+	constexpr size_t kDirectoryEntrySize = 8;
+	if (outFile.header.numEntries > static_cast<size_t>(end - ptr) / kDirectoryEntrySize) {
+		LOG_ERROR("FSH directory of {} entries runs past the end of the data ({} bytes)",
+		          outFile.header.numEntries, dataSize);
+		return false;
+	}
+
 	// Read directory entries
 	std::vector<DirectoryEntry> directory(outFile.header.numEntries);
 	for (uint32_t i = 0; i < outFile.header.numEntries; ++i) {
@@ -67,11 +79,11 @@ bool Reader::Parse(const uint8_t* buffer, size_t bufferSize, File& outFile) {
 
 	for (uint32_t i = 0; i < outFile.header.numEntries; ++i) {
 		// Seek to bitmap offset (use dataPtr instead of buffer to handle decompressed data)
-		const uint8_t* bitmapPtr = dataPtr + directory[i].offset;
-		if (bitmapPtr >= end) {
+		if (directory[i].offset >= dataSize) {
 			LOG_ERROR("Invalid bitmap offset: {}", directory[i].offset);
 			return false;
 		}
+		const uint8_t* bitmapPtr = dataPtr + directory[i].offset;
 
 		Bitmap bitmap;
 		if (!ParseBitmap(bitmapPtr, end, bitmap)) {
@@ -117,79 +129,68 @@ bool Reader::ParseBitmap(const uint8_t*& ptr, const uint8_t* end, Bitmap& outBit
 		return false;
 	}
 
+	// The top nibble of misc[3] holds the number of mip levels that follow the main image
+	const uint32_t declaredMips = header.misc[3] >> 12;
+	size_t chainSize = dataSize;
+	if (declaredMips > 0) {
+		auto chain = ComputeMipChain(outBitmap.code, outBitmap.width, outBitmap.height,
+		                             1 + declaredMips, SIZE_MAX);
+		if (!chain.empty()) chainSize = chain.back().offset + chain.back().size;
+	}
+
 	// Read bitmap data
 	size_t remainingBytes = end - ptr;
 	if (remainingBytes < dataSize) {
 		LOG_WARN("FSH bitmap data truncated: expected {}, got {}", dataSize, remainingBytes);
 		dataSize = remainingBytes;
+		chainSize = remainingBytes;
+	} else if (remainingBytes < chainSize) {
+		LOG_DEBUG("FSH mip chain truncated: expected {}, got {}; keeping complete levels", chainSize, remainingBytes);
+		chainSize = remainingBytes;
 	}
 
-	outBitmap.data.resize(dataSize);
-	if (!ReadBytes(ptr, end, outBitmap.data.data(), dataSize)) return false;
-
-	LOG_TRACE("Parsed FSH bitmap: {}x{}, code=0x{:02X}, size={}",
-	          outBitmap.width, outBitmap.height, outBitmap.code, dataSize);
-
-	return true;
-}
+	outBitmap.data.resize(chainSize);
+	if (!ReadBytes(ptr, end, outBitmap.data.data(), chainSize)) return false;
 
-void Reader::ARGB4444ToRGBA8(uint16_t color, uint8_t* rgba) {
-	uint8_t a = (color >> 12) & 0xF;
-	uint8_t r = (color >> 8) & 0xF;
-	uint8_t g = (color >> 4) & 0xF;
-	uint8_t b = color & 0xF;
-
-	// Expand 4-bit to 8-bit
-	rgba[0] = (r << 4) | r;
-	rgba[1] = (g << 4) | g;
-	rgba[2] = (b << 4) | b;
-	rgba[3] = (a << 4) | a;
-}
+	if (declaredMips > 0) {
+		auto chain = ComputeMipChain(outBitmap.code, outBitmap.width, outBitmap.height,
+		                             1 + declaredMips, chainSize);
+		outBitmap.mipCount = chain.empty() ? 0 : static_cast<uint8_t>(chain.size() - 1);
+	}
 
-void Reader::RGB565ToRGBA8(uint16_t color, uint8_t* rgba) {
-	uint8_t r = (color >> 11) & 0x1F;
-	uint8_t g = (color >> 5) & 0x3F;
-	uint8_t b = color & 0x1F;
+	LOG_TRACE("Parsed FSH bitmap: {}x{}, code=0x{:02X}, size={}, mips={}",
+	          outBitmap.width, outBitmap.height, outBitmap.code, chainSize, outBitmap.mipCount);
 
-	// Expand to 8-bit
-	rgba[0] = (r << 3) | (r >> 2);
-	rgba[1] = (g << 2) | (g >> 4);
-	rgba[2] = (b << 3) | (b >> 2);
-	rgba[3] = 255; // Fully opaque
+	return true;
 }
 
-void Reader::ARGB1555ToRGBA8(uint16_t color, uint8_t* rgba) {
-	uint8_t a = (color >> 15) & 0x1;
-	uint8_t r = (color >> 10) & 0x1F;
-	uint8_t g = (color >> 5) & 0x1F;
-	uint8_t b = color & 0x1F;
-
-	// Expand to 8-bit
-	rgba[0] = (r << 3) | (r >> 2);
-	rgba[1] = (g << 3) | (g >> 2);
-	rgba[2] = (b << 3) | (b >> 2);
-	rgba[3] = a ? 255 : 0;
+bool Reader::ConvertToRGBA8(const Bitmap& bitmap, std::vector<uint8_t>& outRGBA) {
+	// Main level only; mip levels are converted by CreateTexture as needed
+	return ConvertLevelToRGBA8(bitmap.code, bitmap.width, bitmap.height,
+	                           bitmap.data.data(), bitmap.data.size(), outRGBA);
 }
 
-bool Reader::ConvertToRGBA8(const Bitmap& bitmap, std::vector<uint8_t>& outRGBA) {
+bool Reader::ConvertLevelToRGBA8(uint8_t code, uint32_t width, uint32_t height,
+                                 const uint8_t* data, size_t dataSize, std::vector<uint8_t>& outRGBA)
+{
 	// CRITICAL: Validate against integer overflow
-	if (bitmap.width == 0 || bitmap.height == 0) {
-		LOG_ERROR("FSH: Invalid bitmap dimensions: {}x{}", bitmap.width, bitmap.height);
+	if (width == 0 || height == 0) {
+		LOG_ERROR("FSH: Invalid bitmap dimensions: {}x{}", width, height);
 		return false;
 	}
 
-	if (bitmap.width > 65536 || bitmap.height > 65536) {
-		LOG_ERROR("FSH: Bitmap dimensions too large: {}x{}", bitmap.width, bitmap.height);
+	if (width > 65536 || height > 65536) {
+		LOG_ERROR("FSH: Bitmap dimensions too large: {}x{}", width, height);
 		return false;
 	}
 
-	size_t pixelCount = static_cast<size_t>(bitmap.width) * static_cast<size_t>(bitmap.height);
-	size_t expectedInputSize = pixelCount * bitmap.GetBytesPerPixel();
+	size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+	size_t expectedInputSize = GetLevelDataSize(code, width, height);
 
 	// CRITICAL: Validate buffer size before reading
-	if (bitmap.data.size() < expectedInputSize) {
+	if (dataSize < expectedInputSize) {
 		LOG_ERROR("FSH: Data buffer too small: expected {} bytes, got {} ({}x{}, format=0x{:02X})",
-		          expectedInputSize, bitmap.data.size(), bitmap.width, bitmap.height, bitmap.code);
+		          expectedInputSize, dataSize, width, height, code);
 		return false;
 	}
 
@@ -202,106 +203,22 @@ bool Reader::ConvertToRGBA8(const Bitmap& bitmap, std::vector<uint8_t>& outRGBA)
 
 	outRGBA.resize(outputSize);
 
-	switch (bitmap.code) {
-		case CODE_32BIT: {
-			// ARGB -> RGBA conversion
-			const uint8_t* src = bitmap.data.data();
-			uint8_t* dst = outRGBA.data();
-
-			for (size_t i = 0; i < pixelCount; ++i) {
-				uint8_t b = *src++;
-				uint8_t g = *src++;
-				uint8_t r = *src++;
-				uint8_t a = *src++;
-
-				*dst++ = r;
-				*dst++ = g;
-				*dst++ = b;
-				*dst++ = a;
-			}
-			return true;
-		}
-
-		case CODE_24BIT: {
-			// BGR -> RGBA conversion
-			const uint8_t* src = bitmap.data.data();
-			uint8_t* dst = outRGBA.data();
-
-			for (size_t i = 0; i < pixelCount; ++i) {
-				uint8_t b = *src++;
-				uint8_t g = *src++;
-				uint8_t r = *src++;
-
-				*dst++ = r;
-				*dst++ = g;
-				*dst++ = b;
-				*dst++ = 255; // Fully opaque
-			}
-			return true;
-		}
-
-		case CODE_16BIT_4444: {
-			// Use memcpy for alignment safety instead of reinterpret_cast
-			const uint8_t* src = bitmap.data.data();
-			uint8_t* dst = outRGBA.data();
-
-			for (size_t i = 0; i < pixelCount; ++i) {
-				uint16_t pixel;
-				std::memcpy(&pixel, src, sizeof(uint16_t));
-				src += sizeof(uint16_t);
-				ARGB4444ToRGBA8(pixel, dst);
-				dst += 4;
-			}
-			return true;
-		}
-
-		case CODE_16BIT_0565: {
-			// Use memcpy for alignment safety
-			const uint8_t* src = bitmap.data.data();
-			uint8_t* dst = outRGBA.data();
-
-			for (size_t i = 0; i < pixelCount; ++i) {
-				uint16_t pixel;
-				std::memcpy(&pixel, src, sizeof(uint16_t));
-				src += sizeof(uint16_t);
-				RGB565ToRGBA8(pixel, dst);
-				dst += 4;
-			}
-			return true;
-		}
-
-		case CODE_16BIT_1555: {
-			// Use memcpy for alignment safety
-			const uint8_t* src = bitmap.data.data();
-			uint8_t* dst = outRGBA.data();
-
-			for (size_t i = 0; i < pixelCount; ++i) {
-				uint16_t pixel;
-				std::memcpy(&pixel, src, sizeof(uint16_t));
-				src += sizeof(uint16_t);
-				ARGB1555ToRGBA8(pixel, dst);
-				dst += 4;
-			}
-			return true;
-		}
-
-		case CODE_DXT1:
-		case CODE_DXT3:
-			// DXT formats are handled natively by D3D11, no conversion needed
-			LOG_ERROR("DXT textures should be uploaded directly to GPU, not converted to RGBA8");
-			return false;
-
-		default:
-			LOG_ERROR("Unsupported FSH format for RGBA8 conversion: 0x{:02X}", bitmap.code);
-			return false;
+	// SIMD kernels (scalar fallback) selected once for this CPU; DXT is decoded in software
+	if (!PixelConvert::ConvertLevelToRGBA8(code, width, height, data, dataSize, outRGBA.data())) {
+		LOG_ERROR("Unsupported FSH format for RGBA8 conversion: 0x{:02X}", code);
+		return false;
 	}
+	return true;
 }
 
 ID3D11ShaderResourceView* Reader::CreateTexture(
 	ID3D11Device* device,
 	const File& fshFile,
-	bool generateMipmaps)
+	bool generateMipmaps,
+	uint32_t targetSize)
 {
+	(void)generateMipmaps; // FSH mip chains are used as-is
+
 	if (!device || fshFile.bitmaps.empty()) {
 		LOG_ERROR("Invalid device or empty FSH file");
 		return nullptr;
@@ -313,11 +230,24 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 		return nullptr;
 	}
 
+	// Only upload the levels needed for the requested output size
+	const std::vector<MipLevelInfo> chain = ComputeMipChain(
+		mainBitmap->code, mainBitmap->width, mainBitmap->height,
+		1u + mainBitmap->mipCount, mainBitmap->data.size());
+	if (chain.empty()) {
+		LOG_ERROR("FSH bitmap has no complete level (format=0x{:02X}, {}x{}, {} bytes)",
+		          mainBitmap->code, mainBitmap->width, mainBitmap->height, mainBitmap->data.size());
+		return nullptr;
+	}
+
+	const uint32_t firstMip = SelectFirstMip(chain, mainBitmap->code, targetSize);
+	const uint32_t levelCount = static_cast<uint32_t>(chain.size()) - firstMip;
+
 	// Prepare texture description
 	D3D11_TEXTURE2D_DESC texDesc = {};
-	texDesc.Width = mainBitmap->width;
-	texDesc.Height = mainBitmap->height;
-	texDesc.MipLevels = 1; // TODO: Support mipmaps from FSH
+	texDesc.Width = chain[firstMip].width;
+	texDesc.Height = chain[firstMip].height;
+	texDesc.MipLevels = levelCount;
 	texDesc.ArraySize = 1;
 	texDesc.SampleDesc.Count = 1;
 	texDesc.SampleDesc.Quality = 0;
@@ -326,24 +256,24 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 	texDesc.CPUAccessFlags = 0;
 	texDesc.MiscFlags = 0;
 
-	// Determine D3D format and prepare data
+	// Determine D3D format and prepare per-level data
 	DXGI_FORMAT format;
-	std::vector<uint8_t> textureData;
-	const void* initialData = nullptr;
-	UINT rowPitch = 0;
+	std::vector<D3D11_SUBRESOURCE_DATA> initData(levelCount);
+	std::vector<std::vector<uint8_t>> convertedLevels;
 
 	switch (mainBitmap->code) {
 		case CODE_DXT1:
-			format = DXGI_FORMAT_BC1_UNORM;
-			initialData = mainBitmap->data.data();
-			rowPitch = ((mainBitmap->width + 3) / 4) * 8; // 8 bytes per 4x4 block
-			break;
-
-		case CODE_DXT3:
-			format = DXGI_FORMAT_BC2_UNORM;
-			initialData = mainBitmap->data.data();
-			rowPitch = ((mainBitmap->width + 3) / 4) * 16; // 16 bytes per 4x4 block
+		case CODE_DXT3: {
+			const bool isDXT1 = mainBitmap->code == CODE_DXT1;
+			format = isDXT1 ? DXGI_FORMAT_BC1_UNORM : DXGI_FORMAT_BC2_UNORM;
+			const UINT blockBytes = isDXT1 ? 8 : 16; // per 4x4 block
+			for (uint32_t i = 0; i < levelCount; ++i) {
+				const MipLevelInfo& level = chain[firstMip + i];
+				initData[i].pSysMem = mainBitmap->data.data() + level.offset;
+				initData[i].SysMemPitch = ((level.width + 3) / 4) * blockBytes;
+			}
 			break;
+		}
 
 		case CODE_32BIT:
 		case CODE_24BIT:
@@ -352,12 +282,17 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 		case CODE_16BIT_1555:
 			// Convert to RGBA8
 			format = DXGI_FORMAT_R8G8B8A8_UNORM;
-			if (!ConvertToRGBA8(*mainBitmap, textureData)) {
-				LOG_ERROR("Failed to convert FSH bitmap to RGBA8");
-				return nullptr;
+			convertedLevels.resize(levelCount);
+			for (uint32_t i = 0; i < levelCount; ++i) {
+				const MipLevelInfo& level = chain[firstMip + i];
+				if (!ConvertLevelToRGBA8(mainBitmap->code, level.width, level.height,
+				                         mainBitmap->data.data() + level.offset, level.size, convertedLevels[i])) {
+					LOG_ERROR("Failed to convert FSH bitmap level {} to RGBA8", firstMip + i);
+					return nullptr;
+				}
+				initData[i].pSysMem = convertedLevels[i].data();
+				initData[i].SysMemPitch = level.width * 4;
 			}
-			initialData = textureData.data();
-			rowPitch = mainBitmap->width * 4;
 			break;
 
 		default:
@@ -368,13 +303,8 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 	texDesc.Format = format;
 
 	// Create texture
-	D3D11_SUBRESOURCE_DATA initData = {};
-	initData.pSysMem = initialData;
-	initData.SysMemPitch = rowPitch;
-	initData.SysMemSlicePitch = 0;
-
 	ID3D11Texture2D* texture = nullptr;
-	HRESULT hr = device->CreateTexture2D(&texDesc, &initData, &texture);
+	HRESULT hr = device->CreateTexture2D(&texDesc, initData.data(), &texture);
 	if (FAILED(hr)) {
 		LOG_ERROR("Failed to create D3D11 texture: 0x{:08X}", hr);
 		return nullptr;
@@ -385,7 +315,7 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 	srvDesc.Format = format;
 	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
 	srvDesc.Texture2D.MostDetailedMip = 0;
-	srvDesc.Texture2D.MipLevels = 1;
+	srvDesc.Texture2D.MipLevels = levelCount;
 
 	ID3D11ShaderResourceView* srv = nullptr;
 	hr = device->CreateShaderResourceView(texture, &srvDesc, &srv);
@@ -396,8 +326,9 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 		return nullptr;
 	}
 
-	LOG_TRACE("Created D3D11 texture from FSH: {}x{}, format=0x{:02X}",
-	          mainBitmap->width, mainBitmap->height, mainBitmap->code);
+	LOG_TRACE("Created D3D11 texture from FSH: {}x{} (source {}x{}, levels {}-{}), format=0x{:02X}",
+	          texDesc.Width, texDesc.Height, mainBitmap->width, mainBitmap->height,
+	          firstMip, firstMip + levelCount - 1, mainBitmap->code);
 
 	return srv;
 }
@@ -405,7 +336,7 @@ ID3D11ShaderResourceView* Reader::CreateTexture(
 bool Reader::DecompressQFS(const uint8_t* compressed, size_t compressedSize,
                            std::vector<uint8_t>& decompressed)
 {
-	return QFS::Decompressor::Decompress(compressed, compressedSize, decompressed);
+	return QFS::Decompressor::Decompress(compressed, compressedSize, QFS::Framing::Bare, decompressed);
 }
 
 ID3D11ShaderResourceView* Reader::LoadTextureFromDBPF(
@@ -423,13 +354,54 @@ ID3D11ShaderResourceView* Reader::LoadTextureFromResourceManager(
 	ID3D11Device* device,
 	cIGZPersistResourceManager* pRM,
 	uint32_t groupID,
-	uint32_t instanceID)
+	uint32_t instanceID,
+	uint32_t targetSize)
 {
 	if (!device || !pRM) {
 		LOG_ERROR("Invalid device or ResourceManager");
 		return nullptr;
 	}
 
+	File fshFile;
+	if (!LoadFileFromResourceManager(pRM, groupID, instanceID, fshFile)) {
+		return nullptr;
+	}
+
+	// Create texture
+	return CreateTexture(device, fshFile, false, targetSize);
+}
+
+bool Reader::LoadFileFromResourceManager(
+	cIGZPersistResourceManager* pRM,
+	uint32_t groupID,
+	uint32_t instanceID,
+	File& outFile)
+{
+	std::vector<uint8_t> fshData;
+	if (!ReadRecordFromResourceManager(pRM, groupID, instanceID, fshData)) {
+		return false;
+	}
+
+	// Parse FSH
+	if (!Parse(fshData.data(), fshData.size(), outFile)) {
+		LOG_ERROR("Failed to parse FSH file");
+		return false;
+	}
+
+	return true;
+}
+
+bool Reader::ReadRecordFromResourceManager(
+	cIGZPersistResourceManager* pRM,
+	uint32_t groupID,
+	uint32_t instanceID,
+	std::vector<uint8_t>& outData)
+{
+	if (!pRM) {
+		LOG_ERROR("Invalid ResourceManager");
+		return false;
+	}
+
 	// FSH type ID
 	constexpr uint32_t FSH_TYPE_ID = 0x7AB50E44;
 
@@ -447,7 +419,7 @@ ID3D11ShaderResourceView* Reader::LoadTextureFromResourceManager(
 		if (!pKeyList)
 		{
 			LOG_ERROR("Failed to get available resource list");
-			return nullptr;
+			return false;
 		}
 
 		auto found = false;
@@ -469,7 +441,7 @@ ID3D11ShaderResourceView* Reader::LoadTextureFromResourceManager(
 		{
 			LOG_WARN("FSH texture not found exhaustively either: type=0x{:08X}, group=0x{:08X}, instance=0x{:08X}",
 				FSH_TYPE_ID, groupID, instanceID);
-			return nullptr;
+			return false;
 		}
 	}
 
@@ -479,25 +451,18 @@ ID3D11ShaderResourceView* Reader::LoadTextureFromResourceManager(
 	uint32_t dataSize = record->GetSize();
 	if (dataSize == 0) {
 		LOG_ERROR("FSH record has zero size");
-		return nullptr;
+		return false;
 	}
 
 	// Read data using GetFieldVoid
-	std::vector<uint8_t> fshData(dataSize);
-	if (!record->GetFieldVoid(fshData.data(), dataSize)) {
+	outData.resize(dataSize);
+	if (!record->GetFieldVoid(outData.data(), dataSize)) {
 		LOG_ERROR("Failed to read FSH data from ResourceManager");
-		return nullptr;
-	}
-
-	// Parse FSH
-	File fshFile;
-	if (!Parse(fshData.data(), dataSize, fshFile)) {
-		LOG_ERROR("Failed to parse FSH file");
-		return nullptr;
+		outData.clear();
+		return false;
 	}
 
-	// Create texture
-	return CreateTexture(device, fshFile, false);
+	return true;
 }
 
 } // namespace FSH
@@ -14,11 +14,30 @@ public:
 	static bool Parse(const uint8_t* buffer, size_t bufferSize, File& outFile);
 
 	// Load FSH from ResourceManager and create D3D11 texture (recommended)
+	// targetSize: output size in pixels the texture is rendered at (0 = upload the full chain)
 	static ID3D11ShaderResourceView* LoadTextureFromResourceManager(
 		ID3D11Device* device,
 		cIGZPersistResourceManager* pRM,
 		uint32_t groupID,
-		uint32_t instanceID
+		uint32_t instanceID,
+		uint32_t targetSize = 0
+	);
+
+	// Read the raw (possibly QFS-compressed) bytes of an FSH resource without parsing them
+	// Falls back to any group holding the instance if the exact key is missing
+	static bool ReadRecordFromResourceManager(
+		cIGZPersistResourceManager* pRM,
+		uint32_t groupID,
+		uint32_t instanceID,
+		std::vector<uint8_t>& outData
+	);
+
+	// Read and parse an FSH resource from ResourceManager without creating a texture
+	static bool LoadFileFromResourceManager(
+		cIGZPersistResourceManager* pRM,
+		uint32_t groupID,
+		uint32_t instanceID,
+		File& outFile
 	);
 
 	// Load FSH from DBPF and create D3D11 texture (deprecated - use ResourceManager)
@@ -29,16 +48,22 @@ public:
 		uint32_t instanceID
 	);
 
-	// Create D3D11 texture from FSH file (uses main bitmap, handles mipmaps)
+	// Create D3D11 texture from FSH file (uses main bitmap and its mip chain)
+	// Levels larger than needed for targetSize are skipped (0 = upload the full chain)
 	static ID3D11ShaderResourceView* CreateTexture(
 		ID3D11Device* device,
 		const File& fshFile,
-		bool generateMipmaps = false
+		bool generateMipmaps = false,
+		uint32_t targetSize = 0
 	);
 
-	// Convert uncompressed FSH bitmap to RGBA8 format
+	// Convert FSH bitmap to RGBA8 format (DXT1/DXT3 are decoded in software)
 	static bool ConvertToRGBA8(const Bitmap& bitmap, std::vector<uint8_t>& outRGBA);
 
+	// Convert a single level of raw FSH pixel data to RGBA8
+	static bool ConvertLevelToRGBA8(uint8_t code, uint32_t width, uint32_t height,
+	                                const uint8_t* data, size_t dataSize, std::vector<uint8_t>& outRGBA);
+
 private:
 	// Parse individual bitmap entry
 	static bool ParseBitmap(const uint8_t*& ptr, const uint8_t* end, Bitmap& outBitmap);
@@ -68,11 +93,6 @@ private:
 		ptr += count;
 		return true;
 	}
-
-	// Color conversion helpers
-	static void ARGB4444ToRGBA8(uint16_t color, uint8_t* rgba);
-	static void RGB565ToRGBA8(uint16_t color, uint8_t* rgba);
-	static void ARGB1555ToRGBA8(uint16_t color, uint8_t* rgba);
 };
 
 } // namespace FSH
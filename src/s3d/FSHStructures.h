@@ -66,7 +66,8 @@ struct Bitmap {
 	uint8_t code;            // Format code
 	uint16_t width;
 	uint16_t height;
-	std::vector<uint8_t> data; // Raw bitmap data (compressed or uncompressed)
+	uint8_t mipCount = 0;      // Extra mip levels stored after the main image in 'data'
+	std::vector<uint8_t> data; // Raw bitmap data (compressed or uncompressed), main level first
 
 	// Helper methods
 	bool IsDXT() const {
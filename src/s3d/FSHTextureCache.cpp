@@ -0,0 +1,177 @@
+#include "FSHTextureCache.h"
+#include "FSHMipChain.h"
+#include "FSHReader.h"
+#include "../utils/Logger.h"
+#include <d3d11.h>
+#include <exception>
+#include <mutex>
+
+namespace FSH {
+
+namespace {
+
+// Holds one reference to a cached SRV; nullptr marks a texture known to be missing
+class SRVRef {
+public:
+	explicit SRVRef(ID3D11ShaderResourceView* srv) : m_srv(srv) {}
+	SRVRef(SRVRef&& other) noexcept : m_srv(other.m_srv) { other.m_srv = nullptr; }
+	SRVRef& operator=(SRVRef&& other) noexcept {
+		if (this != &other) {
+			if (m_srv) m_srv->Release();
+			m_srv = other.m_srv;
+			other.m_srv = nullptr;
+		}
+		return *this;
+	}
+	SRVRef(const SRVRef&) = delete;
+	SRVRef& operator=(const SRVRef&) = delete;
+	~SRVRef() { if (m_srv) m_srv->Release(); }
+
+	ID3D11ShaderResourceView* Get() const { return m_srv; }
+
+private:
+	ID3D11ShaderResourceView* m_srv;
+};
+
+constexpr size_t NEGATIVE_ENTRY_BYTES = DecodedFileCache::NEGATIVE_ENTRY_BYTES;
+
+std::mutex s_mutex;
+ID3D11Device* s_device = nullptr; // Identity only, not owned
+LRUCache<TextureKey, SRVRef, TextureKeyHash> s_textures(TextureCache::DEFAULT_TEXTURE_BUDGET);
+uint64_t s_clearCount = 0; // Uploads started before a Clear() don't repopulate the cache
+DecodedFileCache s_decoded(TextureCache::DEFAULT_DECODED_BUDGET); // Has its own lock
+
+// GPU bytes of the levels CreateTexture uploads for this target size
+size_t EstimateTextureBytes(const Bitmap& bitmap, uint32_t targetSize) {
+	const auto chain = ComputeMipChain(bitmap.code, bitmap.width, bitmap.height,
+	                                   1u + bitmap.mipCount, bitmap.data.size());
+	if (chain.empty()) return 0;
+
+	size_t total = 0;
+	for (size_t i = SelectFirstMip(chain, bitmap.code, targetSize); i < chain.size(); ++i) {
+		// Uncompressed formats are expanded to RGBA8 on upload
+		total += bitmap.IsDXT() ? chain[i].size : static_cast<size_t>(chain[i].width) * chain[i].height * 4;
+	}
+	return total;
+}
+
+// Returns the cached file, waits for a load already in flight, or loads it. The DBPF read,
+// QFS expansion and FSH parse run without any cache lock held.
+std::shared_ptr<const File> LoadDecoded(cIGZPersistResourceManager* pRM, uint32_t groupID, uint32_t instanceID) {
+	return s_decoded.Load(TextureKey{groupID, instanceID, 0}, [&](File& file) {
+		try {
+			return Reader::LoadFileFromResourceManager(pRM, groupID, instanceID, file);
+		}
+		catch (const std::exception& e) {
+			LOG_ERROR("Failed to load FSH 0x{:08X}/0x{:08X}: {}", groupID, instanceID, e.what());
+			return false;
+		}
+	});
+}
+
+} // namespace
+
+ID3D11ShaderResourceView* TextureCache::Acquire(
+	ID3D11Device* device,
+	cIGZPersistResourceManager* pRM,
+	uint32_t groupID,
+	uint32_t instanceID,
+	uint32_t targetSize)
+{
+	if (!device || !pRM) {
+		LOG_ERROR("Invalid device or ResourceManager");
+		return nullptr;
+	}
+
+	const TextureKey key{groupID, instanceID, targetSize};
+	uint64_t clearCount;
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+
+		// Textures belong to the device that created them
+		if (device != s_device) {
+			if (s_device) {
+				LOG_INFO("FSH texture cache: device changed, dropping {} textures", s_textures.GetStats().entries);
+			}
+			s_textures.Clear();
+			s_device = device;
+		}
+
+		if (const SRVRef* cached = s_textures.Find(key)) {
+			ID3D11ShaderResourceView* srv = cached->Get();
+			if (srv) srv->AddRef();
+			return srv;
+		}
+		clearCount = s_clearCount;
+	}
+
+	// Load and upload without the lock; ID3D11Device resource creation is free-threaded
+	ID3D11ShaderResourceView* srv = nullptr;
+	size_t bytes = NEGATIVE_ENTRY_BYTES;
+	if (auto file = LoadDecoded(pRM, groupID, instanceID)) {
+		srv = Reader::CreateTexture(device, *file, false, targetSize);
+		if (srv) {
+			bytes = EstimateTextureBytes(file->bitmaps[0], targetSize);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (device != s_device || clearCount != s_clearCount) {
+		return srv; // The cache moved on while we loaded; the caller keeps the only reference
+	}
+
+	// Another caller may have uploaded the same texture meanwhile; keep the cached copy
+	if (const SRVRef* cached = s_textures.Find(key); cached && cached->Get()) {
+		if (srv) srv->Release();
+		srv = cached->Get();
+		srv->AddRef();
+		return srv;
+	}
+
+	if (srv) srv->AddRef(); // One reference for the cache, one for the caller
+	s_textures.Insert(key, SRVRef(srv), bytes);
+	return srv;
+}
+
+std::shared_ptr<const File> TextureCache::AcquireDecoded(
+	cIGZPersistResourceManager* pRM,
+	uint32_t groupID,
+	uint32_t instanceID)
+{
+	if (!pRM) {
+		LOG_ERROR("Invalid ResourceManager");
+		return nullptr;
+	}
+
+	return LoadDecoded(pRM, groupID, instanceID);
+}
+
+std::shared_ptr<const File> TextureCache::FindDecoded(uint32_t groupID, uint32_t instanceID) {
+	return s_decoded.Find(TextureKey{groupID, instanceID, 0});
+}
+
+std::shared_ptr<const File> TextureCache::StoreDecoded(uint32_t groupID, uint32_t instanceID, std::shared_ptr<File> file) {
+	return s_decoded.Store(TextureKey{groupID, instanceID, 0}, std::move(file));
+}
+
+void TextureCache::Clear() {
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_textures.Clear();
+		s_device = nullptr;
+		++s_clearCount;
+	}
+	s_decoded.Clear();
+}
+
+void TextureCache::LogStats() {
+	const auto dec = s_decoded.GetStats();
+	std::lock_guard<std::mutex> lock(s_mutex);
+	const auto& tex = s_textures.GetStats();
+	LOG_INFO("FSH texture cache: {} hits, {} misses, {} evictions, {} entries ({:.1f} MB)",
+	         tex.hits, tex.misses, tex.evictions, tex.entries, tex.bytes / (1024.0 * 1024.0));
+	LOG_INFO("FSH decoded file cache: {} hits, {} misses, {} evictions, {} entries ({:.1f} MB)",
+	         dec.hits, dec.misses, dec.evictions, dec.entries, dec.bytes / (1024.0 * 1024.0));
+}
+
+} // namespace FSH
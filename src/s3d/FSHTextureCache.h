@@ -0,0 +1,57 @@
+#pragma once
+#include "FSHDecodedCache.h"
+#include "FSHStructures.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Forward declarations (keeps this header usable without D3D)
+struct ID3D11Device;
+struct ID3D11ShaderResourceView;
+class cIGZPersistResourceManager;
+
+namespace FSH {
+
+// Process-wide cache of FSH textures for the S3D renderer.
+// Shared textures (e.g. the Maxis group 0x1abe787d) are read, decompressed and uploaded once.
+class TextureCache {
+public:
+	static constexpr size_t DEFAULT_TEXTURE_BUDGET = 48 * 1024 * 1024;
+	static constexpr size_t DEFAULT_DECODED_BUDGET = 16 * 1024 * 1024;
+
+	// Returns an AddRef'd SRV the caller must Release(), or nullptr if the texture can't be loaded.
+	// Failures are remembered so a missing texture is not searched for again.
+	static ID3D11ShaderResourceView* Acquire(
+		ID3D11Device* device,
+		cIGZPersistResourceManager* pRM,
+		uint32_t groupID,
+		uint32_t instanceID,
+		uint32_t targetSize = 0
+	);
+
+	// Parsed FSH file (main bitmap and its mip chain) for CPU-side use such as the software
+	// rasterizer. Shares the decoded file cache with Acquire; nullptr if it can't be loaded.
+	// The file is read outside the cache lock; concurrent callers for the same file share one
+	// load, and failures are remembered like Acquire's.
+	static std::shared_ptr<const File> AcquireDecoded(
+		cIGZPersistResourceManager* pRM,
+		uint32_t groupID,
+		uint32_t instanceID
+	);
+
+	// Thread-safe lookup of an already decoded file; never touches the resource manager.
+	// nullptr both for files not loaded yet and for known failures.
+	static std::shared_ptr<const File> FindDecoded(uint32_t groupID, uint32_t instanceID);
+
+	// Thread-safe insert of a file parsed elsewhere (e.g. on a worker thread).
+	// Trims it to the main bitmap and returns the shared copy.
+	static std::shared_ptr<const File> StoreDecoded(uint32_t groupID, uint32_t instanceID, std::shared_ptr<File> file);
+
+	// Release every cached texture and decoded file (call before the device goes away)
+	static void Clear();
+
+	// Write hit/miss/eviction counters to the log
+	static void LogStats();
+};
+
+} // namespace FSH
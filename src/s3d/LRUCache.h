@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Byte-budgeted LRU cache
+// OS-independent. Values are destroyed when evicted, so RAII wrappers release their resources.
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+	struct Stats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		size_t bytes = 0;
+		size_t entries = 0;
+	};
+
+	explicit LRUCache(size_t byteBudget) : m_budget(byteBudget) {}
+
+	// Look up a value and mark it most recently used. Returns nullptr on a miss.
+	// The pointer stays valid until the next Insert/Erase/Clear.
+	Value* Find(const Key& key) {
+		auto it = m_index.find(key);
+		if (it == m_index.end()) {
+			++m_stats.misses;
+			return nullptr;
+		}
+		++m_stats.hits;
+		m_order.splice(m_order.begin(), m_order, it->second);
+		return &it->second->value;
+	}
+
+	// Insert or replace a value charged at 'bytes' against the budget, then evict least
+	// recently used entries until the cache fits. The new entry itself is never evicted.
+	Value& Insert(const Key& key, Value value, size_t bytes) {
+		Erase(key);
+		m_order.push_front(Node{key, std::move(value), bytes});
+		m_index.emplace(key, m_order.begin());
+		m_stats.bytes += bytes;
+
+		while (m_stats.bytes > m_budget && m_order.size() > 1) {
+			Node& victim = m_order.back();
+			m_stats.bytes -= victim.bytes;
+			m_index.erase(victim.key);
+			m_order.pop_back();
+			++m_stats.evictions;
+		}
+
+		m_stats.entries = m_order.size();
+		return m_order.front().value;
+	}
+
+	bool Erase(const Key& key) {
+		auto it = m_index.find(key);
+		if (it == m_index.end()) return false;
+		m_stats.bytes -= it->second->bytes;
+		m_order.erase(it->second);
+		m_index.erase(it);
+		m_stats.entries = m_order.size();
+		return true;
+	}
+
+	// Drop every entry; counters are kept
+	void Clear() {
+		m_index.clear();
+		m_order.clear();
+		m_stats.bytes = 0;
+		m_stats.entries = 0;
+	}
+
+	void SetBudget(size_t byteBudget) { m_budget = byteBudget; }
+	size_t GetBudget() const { return m_budget; }
+	const Stats& GetStats() const { return m_stats; }
+
+private:
+	struct Node {
+		Key key;
+		Value value;
+		size_t bytes;
+	};
+
+	size_t m_budget;
+	std::list<Node> m_order; // Most recently used first
+	std::unordered_map<Key, typename std::list<Node>::iterator, Hash> m_index;
+	Stats m_stats;
+};
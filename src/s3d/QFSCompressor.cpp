@@ -0,0 +1,211 @@
+#include "QFSCompressor.h"
+#include <algorithm>
+#include <cstring>
+
+namespace QFS {
+
+namespace {
+
+// RefPack encoding limits
+constexpr size_t MIN_MATCH = 3;
+constexpr size_t MAX_MATCH = 1028;
+constexpr size_t MAX_OFFSET = 131072;
+constexpr size_t MAX_LITERAL_RUN = 112;
+
+constexpr size_t WINDOW_MASK = MAX_OFFSET - 1;
+constexpr uint32_t HASH_BITS = 16;
+constexpr uint32_t NO_POSITION = 0xFFFFFFFF;
+
+struct LevelParams {
+	uint32_t maxChain;
+	bool lazy;
+};
+
+LevelParams GetLevelParams(CompressionLevel level) {
+	switch (level) {
+		case CompressionLevel::Fast: return {8, false};
+		case CompressionLevel::Best: return {1024, true};
+		case CompressionLevel::Normal:
+		default: return {64, true};
+	}
+}
+
+inline uint32_t Hash3(const uint8_t* p) {
+	const uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+	return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Shortest match each opcode form can express at a given offset
+inline size_t MinMatchForOffset(size_t offset) {
+	if (offset <= 1024) return 3;
+	if (offset <= 16384) return 4;
+	return 5;
+}
+
+class MatchFinder {
+public:
+	MatchFinder(const uint8_t* data, size_t size, uint32_t maxChain)
+		: data(data), size(size), maxChain(maxChain),
+		  head(size_t(1) << HASH_BITS, NO_POSITION),
+		  prev(std::min(size, MAX_OFFSET), NO_POSITION) {
+	}
+
+	// Add position 'pos' to the chains (requires 3 readable bytes)
+	void Insert(size_t pos) {
+		if (pos + MIN_MATCH > size) return;
+		const uint32_t h = Hash3(data + pos);
+		prev[pos & WINDOW_MASK] = head[h];
+		head[h] = static_cast<uint32_t>(pos);
+	}
+
+	// Longest usable match at 'pos' among positions already inserted
+	void FindMatch(size_t pos, size_t& bestLength, size_t& bestOffset) const {
+		bestLength = 0;
+		bestOffset = 0;
+		if (pos + MIN_MATCH > size) return;
+
+		const size_t maxLength = std::min(MAX_MATCH, size - pos);
+		const uint8_t* cur = data + pos;
+		uint32_t candidate = head[Hash3(cur)];
+
+		for (uint32_t chain = 0; chain < maxChain && candidate != NO_POSITION; ++chain) {
+			const size_t offset = pos - candidate;
+			if (offset == 0 || offset > MAX_OFFSET) break;
+
+			const uint8_t* ref = data + candidate;
+			// Cheap rejection: a longer match must also agree at the current best length
+			if (ref[bestLength] == cur[bestLength]) {
+				size_t length = 0;
+				while (length < maxLength && ref[length] == cur[length]) ++length;
+
+				if (length >= MinMatchForOffset(offset) && length > bestLength) {
+					bestLength = length;
+					bestOffset = offset;
+					if (length == maxLength) break;
+				}
+			}
+
+			const uint32_t next = prev[candidate & WINDOW_MASK];
+			// Chains only point backwards; anything else is a stale slot from a wrapped window
+			if (next == NO_POSITION || next >= candidate) break;
+			candidate = next;
+		}
+	}
+
+private:
+	const uint8_t* data;
+	size_t size;
+	uint32_t maxChain;
+	std::vector<uint32_t> head;
+	std::vector<uint32_t> prev;
+};
+
+class Emitter {
+public:
+	explicit Emitter(std::vector<uint8_t>& out) : out(out) {}
+
+	// Flush pending literals in 4-byte-multiple runs, leaving 0-3 to attach to the next opcode
+	void FlushLiteralRuns(const uint8_t*& literals, size_t& count) {
+		while (count >= 4) {
+			const size_t run = std::min(MAX_LITERAL_RUN, count & ~size_t(3));
+			out.push_back(static_cast<uint8_t>(0xE0 | ((run - 4) >> 2)));
+			out.insert(out.end(), literals, literals + run);
+			literals += run;
+			count -= run;
+		}
+	}
+
+	void EmitMatch(const uint8_t* literals, size_t literalCount, size_t length, size_t offset) {
+		const size_t off = offset - 1;
+		if (length <= 10 && offset <= 1024) {
+			out.push_back(static_cast<uint8_t>(((off >> 3) & 0x60) | ((length - 3) << 2) | literalCount));
+			out.push_back(static_cast<uint8_t>(off & 0xFF));
+		} else if (length <= 67 && offset <= 16384) {
+			out.push_back(static_cast<uint8_t>(0x80 | (length - 4)));
+			out.push_back(static_cast<uint8_t>((literalCount << 6) | (off >> 8)));
+			out.push_back(static_cast<uint8_t>(off & 0xFF));
+		} else {
+			const size_t len = length - 5;
+			out.push_back(static_cast<uint8_t>(0xC0 | ((off >> 12) & 0x10) | ((len >> 6) & 0x0C) | literalCount));
+			out.push_back(static_cast<uint8_t>((off >> 8) & 0xFF));
+			out.push_back(static_cast<uint8_t>(off & 0xFF));
+			out.push_back(static_cast<uint8_t>(len & 0xFF));
+		}
+		out.insert(out.end(), literals, literals + literalCount);
+	}
+
+	void EmitStop(const uint8_t* literals, size_t literalCount) {
+		out.push_back(static_cast<uint8_t>(0xFC | literalCount));
+		out.insert(out.end(), literals, literals + literalCount);
+	}
+
+private:
+	std::vector<uint8_t>& out;
+};
+
+} // namespace
+
+size_t Compressor::GetMaxCompressedSize(size_t inputSize) {
+	// Header (up to 2 + 4 + 4) + one opcode per literal run + stop opcode
+	return 10 + inputSize + inputSize / MAX_LITERAL_RUN + 2;
+}
+
+bool Compressor::Compress(const uint8_t* input, size_t inputSize, std::vector<uint8_t>& output,
+                          CompressionLevel level)
+{
+	if (!input && inputSize) return false;
+	if (static_cast<uint64_t>(inputSize) > 0xFFFFFFFFull) return false;
+
+	output.clear();
+	output.reserve(GetMaxCompressedSize(inputSize));
+
+	// Header: flags + magic, then the big-endian uncompressed size
+	const bool largeSizes = inputSize > 0xFFFFFF;
+	output.push_back(static_cast<uint8_t>((MAGIC_COMPRESSED & 0xFF) | (largeSizes ? FLAG_LARGE_SIZES : 0)));
+	output.push_back(static_cast<uint8_t>(MAGIC_COMPRESSED >> 8));
+	if (largeSizes) output.push_back(static_cast<uint8_t>(inputSize >> 24));
+	output.push_back(static_cast<uint8_t>(inputSize >> 16));
+	output.push_back(static_cast<uint8_t>(inputSize >> 8));
+	output.push_back(static_cast<uint8_t>(inputSize));
+
+	const LevelParams params = GetLevelParams(level);
+	MatchFinder finder(input, inputSize, params.maxChain);
+	Emitter emitter(output);
+
+	const uint8_t* literals = input;
+	size_t literalCount = 0;
+	size_t pos = 0;
+
+	while (pos < inputSize) {
+		size_t length, offset;
+		finder.FindMatch(pos, length, offset);
+		finder.Insert(pos);
+
+		if (length && params.lazy) {
+			// One-step lazy evaluation: if the next byte starts a longer match,
+			// emit this byte as a literal and take that match instead
+			size_t nextLength, nextOffset;
+			finder.FindMatch(pos + 1, nextLength, nextOffset);
+			if (nextLength > length) length = 0;
+		}
+
+		if (!length) {
+			++literalCount;
+			++pos;
+			continue;
+		}
+
+		emitter.FlushLiteralRuns(literals, literalCount);
+		emitter.EmitMatch(literals, literalCount, length, offset);
+		for (size_t i = 1; i < length; ++i) finder.Insert(pos + i);
+		pos += length;
+		literals = input + pos;
+		literalCount = 0;
+	}
+
+	emitter.FlushLiteralRuns(literals, literalCount);
+	emitter.EmitStop(literals, literalCount);
+	return true;
+}
+
+} // namespace QFS
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "QFSCore.h"
+
+// QFS/RefPack compression
+// Produces streams that QFS::Decompressor (and the game) can read back.
+// Matches are found with a hash chain over 3-byte prefixes; the level trades
+// chain depth and lazy matching for speed.
+
+namespace QFS {
+
+enum class CompressionLevel : uint8_t {
+	Fast,    // Shallow chains, greedy parsing
+	Normal,  // Moderate chains, one-step lazy matching
+	Best     // Deep chains, one-step lazy matching
+};
+
+class Compressor {
+public:
+	// Compress 'input' into a complete QFS stream (header + opcodes) in 'output'
+	// Returns false only for invalid arguments
+	static bool Compress(const uint8_t* input, size_t inputSize, std::vector<uint8_t>& output,
+	                     CompressionLevel level = CompressionLevel::Normal);
+
+	// Upper bound on the size of Compress() output for 'inputSize' bytes of input
+	static size_t GetMaxCompressedSize(size_t inputSize);
+};
+
+} // namespace QFS
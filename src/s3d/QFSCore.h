@@ -0,0 +1,216 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Header-only, OS-independent QFS/RefPack codec core.
+// No logging, allocation or platform headers: callers own the buffers and map
+// the returned Status to their own error reporting (see QFSDecompressor.cpp).
+// Based on: https://wiki.niotso.org/RefPack
+
+namespace QFS {
+
+// QFS magic numbers (read little-endian: byte 0 = 0x10, byte 1 = 0xFB)
+constexpr uint16_t MAGIC_COMPRESSED = 0xFB10;   // Compressed data marker
+constexpr uint16_t MAGIC_UNCOMPRESSED = 0x0010; // Uncompressed data marker
+
+// Header flag bits (low byte of the magic)
+constexpr uint8_t FLAG_COMPRESSED_SIZE = 0x01;  // A compressed-size field precedes the uncompressed size
+constexpr uint8_t FLAG_LARGE_SIZES = 0x80;      // Size fields are 4 bytes instead of 3
+
+// DBPF records prepend a 4-byte little-endian compressed size before the magic
+constexpr size_t DBPF_PREFIX_SIZE = 4;
+
+// Where the QFS header starts. The caller knows where its bytes came from; the header is
+// never probed for, since the first bytes of a bare stream may happen to look like a prefix.
+enum class Framing : uint8_t {
+	Bare,           // The stream starts with the magic (records read through the resource manager)
+	DBPFPrefix      // A DBPF_PREFIX_SIZE-byte compressed size comes first (raw DBPF entries)
+};
+
+// Extra writable bytes DecodeBody needs past the end of the output. Match copies
+// run in whole 8/16-byte chunks and may spill up to 15 bytes into this slack.
+constexpr size_t OUTPUT_SLACK = 32;
+
+enum class Status : uint8_t {
+	Ok = 0,
+	InvalidArgument,   // Null pointer or output buffer too small for the declared size
+	BadMagic,          // Not QFS data
+	TruncatedHeader,   // Header runs past the end of the input
+	TruncatedInput,    // An opcode, literal run or size field runs past the end of the input
+	BadOffset,         // Match references data before the start of the output
+	OutputOverrun,     // Literal run or match would write past the declared size
+	SizeMismatch       // Stream ended before producing the declared size
+};
+
+inline const char* StatusToString(Status status) {
+	switch (status) {
+		case Status::Ok: return "ok";
+		case Status::InvalidArgument: return "invalid argument";
+		case Status::BadMagic: return "bad magic";
+		case Status::TruncatedHeader: return "truncated header";
+		case Status::TruncatedInput: return "truncated input";
+		case Status::BadOffset: return "invalid lookback offset";
+		case Status::OutputOverrun: return "output overrun";
+		case Status::SizeMismatch: return "output size mismatch";
+	}
+	return "unknown";
+}
+
+struct Header {
+	uint32_t uncompressedSize = 0;
+	size_t headerSize = 0;       // Bytes before the first opcode (including any DBPF prefix)
+};
+
+namespace detail {
+
+inline bool IsMagicAt(const uint8_t* data, size_t size, size_t pos) {
+	return size >= pos + 2 && (data[pos] & 0x3E) == 0x10 && data[pos + 1] == 0xFB;
+}
+
+inline uint32_t ReadBigEndian(const uint8_t* p, size_t bytes) {
+	uint32_t v = 0;
+	for (size_t i = 0; i < bytes; ++i) {
+		v = (v << 8) | p[i];
+	}
+	return v;
+}
+
+// Copy a match of 'length' bytes from 'offset' bytes back. May write up to
+// 15 bytes past out + length; the caller guarantees OUTPUT_SLACK.
+inline void CopyMatch(uint8_t* out, size_t offset, size_t length) {
+	const uint8_t* src = out - offset;
+	uint8_t* const end = out + length;
+
+	if (offset >= 16) {
+		// Chunks never overlap their own source
+		do {
+			std::memcpy(out, src, 16);
+			out += 16;
+			src += 16;
+		} while (out < end);
+	} else if (offset >= 8) {
+		do {
+			std::memcpy(out, src, 8);
+			out += 8;
+			src += 8;
+		} while (out < end);
+	} else if (offset == 1) {
+		// Run of a single byte
+		std::memset(out, src[0], length);
+	} else {
+		// Short period: replicate the pattern into 8 bytes and advance by the
+		// largest multiple of the period that fits, so the phase is preserved
+		uint8_t pattern[8];
+		for (size_t i = 0; i < 8; ++i) pattern[i] = src[i % offset];
+		const size_t step = 8 - 8 % offset;
+		do {
+			std::memcpy(out, pattern, 8);
+			out += step;
+		} while (out < end);
+	}
+}
+
+} // namespace detail
+
+// Read the header of a stream framed as 'framing'
+inline Status ParseHeader(const uint8_t* data, size_t size, Framing framing, Header& out) {
+	if (!data) return Status::InvalidArgument;
+
+	size_t pos = 0;
+	if (framing == Framing::DBPFPrefix) {
+		if (size < DBPF_PREFIX_SIZE) return Status::TruncatedHeader;
+		pos = DBPF_PREFIX_SIZE;
+	}
+	if (!detail::IsMagicAt(data, size, pos)) return Status::BadMagic;
+
+	const uint8_t flags = data[pos];
+	const size_t sizeBytes = (flags & FLAG_LARGE_SIZES) ? 4 : 3;
+	pos += 2;
+
+	if (flags & FLAG_COMPRESSED_SIZE) pos += sizeBytes;
+	if (size < pos + sizeBytes) return Status::TruncatedHeader;
+
+	out.uncompressedSize = detail::ReadBigEndian(data + pos, sizeBytes);
+	out.headerSize = pos + sizeBytes;
+	return Status::Ok;
+}
+
+inline bool IsCompressed(const uint8_t* data, size_t size, Framing framing) {
+	Header header;
+	return ParseHeader(data, size, framing, header) == Status::Ok;
+}
+
+// Decode a RefPack opcode stream (no header) into exactly outputSize bytes.
+// Every literal run and match is bounds-checked against both buffers before it is copied.
+// 'output' must be writable for outputSize + OUTPUT_SLACK bytes; the slack contents are
+// unspecified afterwards.
+inline Status DecodeBody(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize) {
+	if ((!input && inputSize) || (!output && outputSize)) return Status::InvalidArgument;
+
+	const uint8_t* in = input;
+	const uint8_t* const inEnd = input + inputSize;
+	uint8_t* out = output;
+	uint8_t* const outEnd = output + outputSize;
+
+	while (in < inEnd) {
+		const uint8_t b0 = in[0];
+		size_t literal;
+		size_t length = 0;
+		size_t offset = 0;
+
+		if (b0 <= 0x7F) {
+			if (inEnd - in < 2) return Status::TruncatedInput;
+			const uint8_t b1 = in[1];
+			literal = b0 & 0x03;
+			length = ((b0 & 0x1C) >> 2) + 3;
+			offset = ((static_cast<size_t>(b0) & 0x60) << 3) + b1 + 1;
+			in += 2;
+		} else if (b0 <= 0xBF) {
+			if (inEnd - in < 3) return Status::TruncatedInput;
+			const uint8_t b1 = in[1], b2 = in[2];
+			literal = (b1 >> 6) & 0x03;
+			length = (b0 & 0x3F) + 4;
+			offset = ((static_cast<size_t>(b1) & 0x3F) << 8) + b2 + 1;
+			in += 3;
+		} else if (b0 <= 0xDF) {
+			if (inEnd - in < 4) return Status::TruncatedInput;
+			const uint8_t b1 = in[1], b2 = in[2], b3 = in[3];
+			literal = b0 & 0x03;
+			length = ((static_cast<size_t>(b0) & 0x0C) << 6) + b3 + 5;
+			offset = ((static_cast<size_t>(b0) & 0x10) << 12) + (static_cast<size_t>(b1) << 8) + b2 + 1;
+			in += 4;
+		} else if (b0 <= 0xFB) {
+			literal = ((static_cast<size_t>(b0) & 0x1F) << 2) + 4;
+			in += 1;
+		} else {
+			// Stop opcode, followed by up to three trailing literals
+			literal = b0 & 0x03;
+			in += 1;
+			if (static_cast<size_t>(inEnd - in) < literal) return Status::TruncatedInput;
+			if (static_cast<size_t>(outEnd - out) < literal) return Status::OutputOverrun;
+			std::memcpy(out, in, literal);
+			out += literal;
+			break;
+		}
+
+		// Literals precede the match
+		if (static_cast<size_t>(inEnd - in) < literal) return Status::TruncatedInput;
+		if (static_cast<size_t>(outEnd - out) < literal) return Status::OutputOverrun;
+		std::memcpy(out, in, literal);
+		out += literal;
+		in += literal;
+
+		if (length) {
+			if (offset > static_cast<size_t>(out - output)) return Status::BadOffset;
+			if (static_cast<size_t>(outEnd - out) < length) return Status::OutputOverrun;
+
+			detail::CopyMatch(out, offset, length);
+			out += length;
+		}
+	}
+
+	return out == outEnd ? Status::Ok : Status::SizeMismatch;
+}
+
+} // namespace QFS
@@ -0,0 +1,116 @@
+#pragma once
+#include "S3DStructures.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Thumbnail camera shared by the D3D11 renderer and the software rasterizer
+// OS-independent. Matrices use the DirectX conventions: row-major storage and row
+// vectors (clip = [x y z 1] * M), so they can be copied straight into SimpleMath::Matrix.
+
+namespace S3D {
+
+// Rendering constants
+namespace RenderConstants {
+	constexpr float BILLBOARD_ROTATION_Y = -22.5f;  // Isometric Y rotation (degrees)
+	constexpr float BILLBOARD_ROTATION_X = 45.0f;   // Isometric X rotation (degrees)
+	constexpr float BOUNDING_BOX_PADDING = 1.10f;   // 10% padding around model
+	constexpr float NEAR_PLANE = -40000.0f;         // Near clip plane for ortho projection
+	constexpr float FAR_PLANE = 40000.0f;           // Far clip plane for ortho projection
+}
+
+struct Matrix4 {
+	float m[4][4];
+
+	static Matrix4 Identity() {
+		return {{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}};
+	}
+
+	static Matrix4 RotationX(float radians) {
+		const float c = std::cos(radians), s = std::sin(radians);
+		return {{{1, 0, 0, 0}, {0, c, s, 0}, {0, -s, c, 0}, {0, 0, 0, 1}}};
+	}
+
+	static Matrix4 RotationY(float radians) {
+		const float c = std::cos(radians), s = std::sin(radians);
+		return {{{c, 0, -s, 0}, {0, 1, 0, 0}, {s, 0, c, 0}, {0, 0, 0, 1}}};
+	}
+
+	static Matrix4 Translation(float x, float y, float z) {
+		return {{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {x, y, z, 1}}};
+	}
+
+	// Same as XMMatrixOrthographicLH: depth maps [nearZ, farZ] to [0, 1]
+	static Matrix4 OrthographicLH(float width, float height, float nearZ, float farZ) {
+		const float range = 1.0f / (farZ - nearZ);
+		return {{{2.0f / width, 0, 0, 0}, {0, 2.0f / height, 0, 0}, {0, 0, range, 0}, {0, 0, -range * nearZ, 1}}};
+	}
+
+	Matrix4 operator*(const Matrix4& rhs) const {
+		Matrix4 out;
+		for (int r = 0; r < 4; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				out.m[r][c] = m[r][0] * rhs.m[0][c] + m[r][1] * rhs.m[1][c] +
+				              m[r][2] * rhs.m[2][c] + m[r][3] * rhs.m[3][c];
+			}
+		}
+		return out;
+	}
+
+	// Transform a point (w = 1) without the perspective divide
+	Vector4 Transform(const Vector3& v) const {
+		return Vector4(
+			v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + m[3][0],
+			v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + m[3][1],
+			v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + m[3][2],
+			v.x * m[0][3] + v.y * m[1][3] + v.z * m[2][3] + m[3][3]);
+	}
+};
+
+struct ThumbnailCamera {
+	Matrix4 viewProj;
+	float extent;   // Side length of the (square) orthographic view volume
+	bool clamped;   // Model was too small and the extent fell back to 1.0
+};
+
+inline float DegreesToRadians(float degrees) {
+	return degrees * (3.14159265358979f / 180.0f);
+}
+
+// SC4-style isometric billboard view, fitted around the model's bounding box
+inline ThumbnailCamera ComputeThumbnailCamera(const Vector3& bbMin, const Vector3& bbMax) {
+	// Bounds are measured in the view orientation (inverse rotations, applied Y then X)
+	const Matrix4 boundsRotation = Matrix4::RotationY(DegreesToRadians(-RenderConstants::BILLBOARD_ROTATION_Y)) *
+	                               Matrix4::RotationX(DegreesToRadians(-RenderConstants::BILLBOARD_ROTATION_X));
+
+	float minX = FLT_MAX, minY = FLT_MAX;
+	float maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float maxZ = -FLT_MAX;
+	for (int i = 0; i < 8; ++i) {
+		const Vector3 corner((i & 1) ? bbMax.x : bbMin.x, (i & 2) ? bbMax.y : bbMin.y, (i & 4) ? bbMax.z : bbMin.z);
+		const Vector4 v = boundsRotation.Transform(corner);
+		minX = (std::min)(minX, v.x); maxX = (std::max)(maxX, v.x);
+		minY = (std::min)(minY, v.y); maxY = (std::max)(maxY, v.y);
+		maxZ = (std::max)(maxZ, v.z);
+	}
+
+	ThumbnailCamera camera;
+	camera.extent = (std::max)(maxX - minX, maxY - minY) * RenderConstants::BOUNDING_BOX_PADDING;
+	camera.clamped = camera.extent < 1e-4f;
+	if (camera.clamped) camera.extent = 1.0f;
+
+	const float posx = (minX + maxX) * 0.5f;
+	const float posy = (minY + maxY) * 0.5f;
+	const float posz = maxZ;
+
+	// RotateY -> RotateX -> Translate (row vectors apply left to right)
+	const Matrix4 view = Matrix4::RotationY(DegreesToRadians(RenderConstants::BILLBOARD_ROTATION_Y)) *
+	                     Matrix4::RotationX(DegreesToRadians(RenderConstants::BILLBOARD_ROTATION_X)) *
+	                     Matrix4::Translation(-posx, -posy, -posz);
+	const Matrix4 proj = Matrix4::OrthographicLH(camera.extent, camera.extent,
+	                                             RenderConstants::NEAR_PLANE, RenderConstants::FAR_PLANE);
+	camera.viewProj = view * proj;
+	return camera;
+}
+
+} // namespace S3D
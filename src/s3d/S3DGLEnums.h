@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+
+// OpenGL enums stored in S3D materials, plus the mappings that don't depend on D3D
+// SimCity 4 uses OpenGL renderer on Mac, so S3D files store GL enums
+
+namespace S3D {
+namespace EnumMappings {
+
+// OpenGL comparison functions (for alpha test, depth test)
+constexpr uint8_t GL_NEVER    = 0x0200;
+constexpr uint8_t GL_LESS     = 0x0201;
+constexpr uint8_t GL_EQUAL    = 0x0202;
+constexpr uint8_t GL_LEQUAL   = 0x0203;
+constexpr uint8_t GL_GREATER  = 0x0204;
+constexpr uint8_t GL_NOTEQUAL = 0x0205;
+constexpr uint8_t GL_GEQUAL   = 0x0206;
+constexpr uint8_t GL_ALWAYS   = 0x0207;
+
+// OpenGL blend factors
+constexpr uint8_t GL_ZERO                = 0;
+constexpr uint8_t GL_ONE                 = 1;
+constexpr uint8_t GL_SRC_COLOR           = 0x0300;
+constexpr uint8_t GL_ONE_MINUS_SRC_COLOR = 0x0301;
+constexpr uint8_t GL_SRC_ALPHA           = 0x0302;
+constexpr uint8_t GL_ONE_MINUS_SRC_ALPHA = 0x0303;
+constexpr uint8_t GL_DST_ALPHA           = 0x0304;
+constexpr uint8_t GL_ONE_MINUS_DST_ALPHA = 0x0305;
+constexpr uint8_t GL_DST_COLOR           = 0x0306;
+constexpr uint8_t GL_ONE_MINUS_DST_COLOR = 0x0307;
+constexpr uint8_t GL_SRC_ALPHA_SATURATE  = 0x0308;
+
+// OpenGL texture wrap modes
+constexpr uint8_t GL_REPEAT          = 0x2901;
+constexpr uint8_t GL_CLAMP           = 0x2900;
+constexpr uint8_t GL_CLAMP_TO_EDGE   = 0x812F;
+constexpr uint8_t GL_MIRRORED_REPEAT = 0x8370;
+
+// OpenGL texture filter modes
+constexpr uint8_t GL_NEAREST                = 0x2600;
+constexpr uint8_t GL_LINEAR                 = 0x2601;
+constexpr uint8_t GL_NEAREST_MIPMAP_NEAREST = 0x2700;
+constexpr uint8_t GL_LINEAR_MIPMAP_NEAREST  = 0x2701;
+constexpr uint8_t GL_NEAREST_MIPMAP_LINEAR  = 0x2702;
+constexpr uint8_t GL_LINEAR_MIPMAP_LINEAR   = 0x2703;
+
+// Get alpha test comparison for shader constant
+// Returns: 0=NEVER, 1=LESS, 2=EQUAL, 3=LEQUAL, 4=GREATER, 5=NOTEQUAL, 6=GEQUAL, 7=ALWAYS
+inline uint32_t MapAlphaFunc(uint8_t glFunc) {
+	switch (glFunc) {
+		case GL_NEVER:    return 0;
+		case GL_LESS:     return 1;
+		case GL_EQUAL:    return 2;
+		case GL_LEQUAL:   return 3;
+		case GL_GREATER:  return 4;
+		case GL_NOTEQUAL: return 5;
+		case GL_GEQUAL:   return 6;
+		case GL_ALWAYS:   return 7;
+		default:          return 4; // GL_GREATER (most common for alpha test)
+	}
+}
+
+} // namespace EnumMappings
+} // namespace S3D
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define S3D_RASTERIZER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Triangle setup and pixel coverage for the software rasterizer, four pixels of a row at a time
+// OS-independent. The scalar path is always compiled so it can be checked against SSE2.
+
+namespace S3D::RasterCoverage {
+
+// Edge functions E(x, y) = A*x + B*y + C, edge i opposite vertex i, positive inside
+struct Edges {
+	float A[3], B[3], C[3];
+	bool topLeft[3];
+};
+
+// Screen-space vertices (y down) must wind so the inside is positive
+inline Edges SetupEdges(const float x[3], const float y[3]) {
+	Edges edges;
+	for (int i = 0; i < 3; ++i) {
+		const int a = (i + 1) % 3;
+		const int b = (i + 2) % 3;
+		edges.A[i] = y[a] - y[b];
+		edges.B[i] = x[b] - x[a];
+		// Anchor C at the same endpoint whichever way the edge runs, so a neighbour sharing the
+		// edge gets exactly the negated function and no pixel is drawn twice or dropped
+		const int anchor = (y[a] < y[b] || (y[a] == y[b] && x[a] < x[b])) ? a : b;
+		edges.C[i] = -(edges.A[i] * x[anchor] + edges.B[i] * y[anchor]);
+		// Top-left fill rule: pixels exactly on an edge belong to left and top edges only
+		edges.topLeft[i] = edges.A[i] > 0.0f || (edges.A[i] == 0.0f && edges.B[i] > 0.0f);
+	}
+	return edges;
+}
+
+// Evaluate the three edge functions at the centers of pixels x..x+3 of one row and return the
+// inside mask (bit n = pixel x+n). 'rowC' is B*py + C for the row; pixels exactly on an edge
+// count only for top-left edges. The edge values are written to 'e' for interpolation.
+inline int CoverScalar(const Edges& edges, const float rowC[3], int x, float e[3][4]) {
+	const float* A = edges.A;
+	const bool* topLeft = edges.topLeft;
+	int mask = 0;
+	for (int lane = 0; lane < 4; ++lane) {
+		const float px = static_cast<float>(x + lane) + 0.5f;
+		bool inside = true;
+		for (int i = 0; i < 3; ++i) {
+			e[i][lane] = A[i] * px + rowC[i];
+			inside = inside && (topLeft[i] ? e[i][lane] >= 0.0f : e[i][lane] > 0.0f);
+		}
+		if (inside) mask |= 1 << lane;
+	}
+	return mask;
+}
+
+#if S3D_RASTERIZER_SSE2
+// Same as CoverScalar; 'e' must be 16-byte aligned
+inline int CoverSSE2(const Edges& edges, const float rowC[3], int x, float e[3][4]) {
+	const float* A = edges.A;
+	const bool* topLeft = edges.topLeft;
+	const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+	const __m128 zero = _mm_setzero_ps();
+	__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	for (int i = 0; i < 3; ++i) {
+		const __m128 ev = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[i]), px), _mm_set1_ps(rowC[i]));
+		inside = _mm_and_ps(inside, topLeft[i] ? _mm_cmpge_ps(ev, zero) : _mm_cmpgt_ps(ev, zero));
+		_mm_store_ps(e[i], ev);
+	}
+	return _mm_movemask_ps(inside);
+}
+#endif
+
+inline int Cover(const Edges& edges, const float rowC[3], int x, float e[3][4]) {
+#if S3D_RASTERIZER_SSE2
+	return CoverSSE2(edges, rowC, x, e);
+#else
+	return CoverScalar(edges, rowC, x, e);
+#endif
+}
+
+} // namespace S3D::RasterCoverage
@@ -3,8 +3,65 @@
 #include "../utils/Logger.h"
 #include <algorithm>
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define S3D_READER_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace S3D {
 
+namespace {
+
+// BGRA8 -> RGBA float4 in [0, 1]. Divides (rather than multiplying by 1/255) so
+// both paths give bit-identical results.
+inline void DecodeColor(const uint8_t* src, Vector4& out) {
+#if S3D_READER_SSE2
+	int32_t packed;
+	std::memcpy(&packed, src, sizeof(packed));
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bytes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+	__m128 bgra = _mm_div_ps(_mm_cvtepi32_ps(bytes), _mm_set1_ps(255.0f));
+	_mm_storeu_ps(&out.x, _mm_shuffle_ps(bgra, bgra, _MM_SHUFFLE(3, 0, 1, 2)));
+#else
+	out = Vector4(src[2] / 255.0f, src[1] / 255.0f, src[0] / 255.0f, src[3] / 255.0f);
+#endif
+}
+
+// Decodes a pre-validated block of `count` vertices spaced `stride` bytes apart.
+// Specialised per layout so the inner loop has no format branches.
+template<bool HasColor, int UVSets>
+void DecodeVertexBlock(const uint8_t* src, size_t stride, uint16_t count, Vertex* out) {
+	for (uint16_t v = 0; v < count; ++v, src += stride) {
+		Vertex& vert = out[v];
+		const uint8_t* p = src;
+
+		std::memcpy(&vert.position.x, p, 3 * sizeof(float));
+		p += 3 * sizeof(float);
+
+		if constexpr (HasColor) {
+			DecodeColor(p, vert.color);
+			p += 4;
+		} else {
+			vert.color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		}
+
+		if constexpr (UVSets > 0) {
+			std::memcpy(&vert.uv.x, p, 2 * sizeof(float));
+			p += 2 * sizeof(float);
+		} else {
+			vert.uv = Vector2(0.0f, 0.0f);
+		}
+
+		if constexpr (UVSets > 1) {
+			std::memcpy(&vert.uv2.x, p, 2 * sizeof(float));
+		} else {
+			vert.uv2 = Vector2(0.0f, 0.0f);
+		}
+	}
+}
+
+} // namespace
+
 bool Reader::Parse(const uint8_t* buffer, size_t bufferSize, Model& outModel) {
 	if (!buffer || bufferSize < 12) {
 		LOG_ERROR("S3D buffer too small or null");
@@ -111,53 +168,51 @@ void Reader::DecodeVertexFormat(uint32_t format, uint8_t& coordsNb, uint8_t& col
 	}
 }
 
-bool Reader::ReadVertex(const uint8_t*& ptr, const uint8_t* end,
-                        uint32_t format, uint16_t minorVersion,
-                        uint32_t stride, Vertex& outVertex) {
-	const uint8_t* vertexStart = ptr;
-
-	// Decode format
+bool Reader::ReadVertices(const uint8_t*& ptr, const uint8_t* end,
+                          uint32_t format, uint32_t stride,
+                          uint16_t count, VertexBuffer& outBuffer) {
 	uint8_t coordsNb, colorsNb, texsNb;
 	DecodeVertexFormat(format, coordsNb, colorsNb, texsNb);
 
-	// Read position (always present)
-	// For billboard rendering, keep coordinates as-is from file
-	if (!ReadValue(ptr, end, outVertex.position.x)) return false;
-	if (!ReadValue(ptr, end, outVertex.position.y)) return false;
-	if (!ReadValue(ptr, end, outVertex.position.z)) return false;
-
-	// Read color if present (BGRA order!)
-	if (colorsNb > 0) {
-		uint8_t b, g, r, a;
-		if (!ReadValue(ptr, end, b)) return false;  // Blue first
-		if (!ReadValue(ptr, end, g)) return false;  // Green second
-		if (!ReadValue(ptr, end, r)) return false;  // Red third
-		if (!ReadValue(ptr, end, a)) return false;  // Alpha fourth
-		outVertex.color = DirectX::SimpleMath::Vector4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
-	} else {
-		outVertex.color = DirectX::SimpleMath::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+	// Only one position, one colour and two UV sets are kept; anything else the
+	// stride covers is skipped. A stride shorter than that (legacy headers) is
+	// treated as packed.
+	const bool hasColor = colorsNb > 0;
+	const uint8_t uvSets = std::min<uint8_t>(texsNb, 2);
+	const size_t packedSize = 12 + (hasColor ? 4 : 0) + 8 * uvSets;
+	const size_t advance = std::max<size_t>(stride, packedSize);
+
+	// Validate the whole block once, then decode without per-field checks
+	if (static_cast<size_t>(end - ptr) < advance * count) {
+		LOG_ERROR("S3D: Vertex block truncated ({} vertices of {} bytes)", count, advance);
+		return false;
 	}
 
-	// Read primary UV if present
-	if (texsNb > 0) {
-		if (!ReadValue(ptr, end, outVertex.uv.x)) return false;
-		if (!ReadValue(ptr, end, outVertex.uv.y)) return false;
-	} else {
-		outVertex.uv = DirectX::SimpleMath::Vector2(0.0f, 0.0f);
-	}
+	outBuffer.vertices.resize(count);
+	Vertex* out = outBuffer.vertices.data();
 
-	// Read secondary UV if present
-	if (texsNb > 1) {
-		if (!ReadValue(ptr, end, outVertex.uv2.x)) return false;
-		if (!ReadValue(ptr, end, outVertex.uv2.y)) return false;
-	} else {
-		outVertex.uv2 = DirectX::SimpleMath::Vector2(0.0f, 0.0f);
+	switch ((hasColor ? 3 : 0) + uvSets) {
+		case 0: DecodeVertexBlock<false, 0>(ptr, advance, count, out); break;
+		case 1: DecodeVertexBlock<false, 1>(ptr, advance, count, out); break;
+		case 2: DecodeVertexBlock<false, 2>(ptr, advance, count, out); break;
+		case 3: DecodeVertexBlock<true, 0>(ptr, advance, count, out); break;
+		case 4: DecodeVertexBlock<true, 1>(ptr, advance, count, out); break;
+		default: DecodeVertexBlock<true, 2>(ptr, advance, count, out); break;
 	}
-
-	// Skip to next vertex based on stride
-	size_t bytesRead = ptr - vertexStart;
-	if (bytesRead < stride) {
-		if (!SkipBytes(ptr, end, stride - bytesRead)) return false;
+	ptr += advance * count;
+
+	// Bounding box
+	if (count > 0) {
+		outBuffer.bbMin = outBuffer.bbMax = out[0].position;
+		for (uint16_t v = 1; v < count; ++v) {
+			const auto& pos = out[v].position;
+			outBuffer.bbMin.x = std::min(outBuffer.bbMin.x, pos.x);
+			outBuffer.bbMin.y = std::min(outBuffer.bbMin.y, pos.y);
+			outBuffer.bbMin.z = std::min(outBuffer.bbMin.z, pos.z);
+			outBuffer.bbMax.x = std::max(outBuffer.bbMax.x, pos.x);
+			outBuffer.bbMax.y = std::max(outBuffer.bbMax.y, pos.y);
+			outBuffer.bbMax.z = std::max(outBuffer.bbMax.z, pos.z);
+		}
 	}
 
 	return true;
@@ -213,31 +268,10 @@ bool Reader::ParseVERT(const uint8_t*& ptr, const uint8_t* end, Model& model) {
 		}
 
 		vb.format = format;
-		vb.vertices.resize(count);
-
-		// Initialize bounding box
-		bool firstVertex = true;
-
-		// Read vertices
-		for (uint16_t v = 0; v < count; ++v) {
-			if (!ReadVertex(ptr, end, format, model.minorVersion, stride, vb.vertices[v])) {
-				LOG_ERROR("Failed to read vertex {} in buffer {}", v, i);
-				return false;
-			}
 
-			// Update bounding box
-			const auto& pos = vb.vertices[v].position;
-			if (firstVertex) {
-				vb.bbMin = vb.bbMax = pos;
-				firstVertex = false;
-			} else {
-				vb.bbMin.x = std::min(vb.bbMin.x, pos.x);
-				vb.bbMin.y = std::min(vb.bbMin.y, pos.y);
-				vb.bbMin.z = std::min(vb.bbMin.z, pos.z);
-				vb.bbMax.x = std::max(vb.bbMax.x, pos.x);
-				vb.bbMax.y = std::max(vb.bbMax.y, pos.y);
-				vb.bbMax.z = std::max(vb.bbMax.z, pos.z);
-			}
+		if (!ReadVertices(ptr, end, format, stride, count, vb)) {
+			LOG_ERROR("Failed to read vertices in buffer {}", i);
+			return false;
 		}
 	}
 
@@ -277,14 +311,11 @@ bool Reader::ParseINDX(const uint8_t*& ptr, const uint8_t* end, Model& model) {
 		uint16_t count;
 		if (!ReadValue(ptr, end, count)) return false;
 
+		// Indices are little-endian uint16, same as the host: copy the block in one go
 		ib.indices.resize(count);
-
-		// Read indices
-		for (uint16_t j = 0; j < count; ++j) {
-			if (!ReadValue(ptr, end, ib.indices[j])) {
-				LOG_ERROR("Failed to read index {} in buffer {}", j, i);
-				return false;
-			}
+		if (count > 0 && !ReadBytes(ptr, end, ib.indices.data(), count * sizeof(uint16_t))) {
+			LOG_ERROR("Failed to read {} indices in buffer {}", count, i);
+			return false;
 		}
 	}
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "S3DStructures.h"
+#include <cstring>
 #include <memory>
 
 namespace S3D {
@@ -18,10 +19,11 @@ private:
 	static bool ParseMATS(const uint8_t*& ptr, const uint8_t* end, Model& model);
 	static bool ParseANIM(const uint8_t*& ptr, const uint8_t* end, Model& model);
 
-	// Helper to read vertex based on format
-	static bool ReadVertex(const uint8_t*& ptr, const uint8_t* end,
-	                       uint32_t format, uint16_t minorVersion,
-	                       uint32_t stride, Vertex& outVertex);
+	// Bounds-checks a whole vertex block once, then bulk-decodes it with a
+	// loop specialised for the format's layout (also fills the bounding box)
+	static bool ReadVertices(const uint8_t*& ptr, const uint8_t* end,
+	                         uint32_t format, uint32_t stride,
+	                         uint16_t count, VertexBuffer& outBuffer);
 
 	// Helper to decode vertex format flags (v4+)
 	static void DecodeVertexFormat(uint32_t format, uint8_t& coordsNb,
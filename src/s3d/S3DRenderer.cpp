@@ -1,28 +1,67 @@
 #include "S3DRenderer.h"
 #include "S3DShaders.h"
+#include "FSHTextureCache.h"
 #include "../utils/Logger.h"
 #include "cISC4DBSegment.h"
 #include "cIGZPersistResourceManager.h"
-#include <d3dcompiler.h>
 #include <algorithm>
 #include <cfloat>
 
+#if S3D_RUNTIME_SHADER_COMPILE
+#include <d3dcompiler.h>
 #pragma comment(lib, "d3dcompiler.lib")
+#endif
 
 namespace S3D {
 
+#if S3D_RUNTIME_SHADER_COMPILE
+// Debug fallback: compile the embedded HLSL source (release builds use fxc bytecode)
+static ID3DBlob* CompileShader(const char* source, const char* name, const char* profile) {
+	LOG_TRACE("  Compiling {} shader ({}, {} bytes)...", name, profile, strlen(source));
+	ID3DBlob* blob = nullptr;
+	ID3DBlob* errorBlob = nullptr;
+
+	HRESULT hr = D3DCompile(
+		source,
+		strlen(source),
+		name,
+		nullptr,
+		nullptr,
+		"main",
+		profile,
+		0,
+		0,
+		&blob,
+		&errorBlob
+	);
+
+	if (FAILED(hr)) {
+		if (errorBlob) {
+			LOG_ERROR("{} shader compilation failed (0x{:08X}): {}", name, hr, (char*)errorBlob->GetBufferPointer());
+			errorBlob->Release();
+		} else {
+			LOG_ERROR("{} shader compilation failed: 0x{:08X}", name, hr);
+		}
+		return nullptr;
+	}
+
+	LOG_TRACE("    {} shader compiled successfully ({} bytes bytecode)", name, blob->GetBufferSize());
+	return blob;
+}
+#endif
+
 Renderer::Renderer(ID3D11Device* device, ID3D11DeviceContext* context)
 	: m_device(device), m_context(context)
 {
 	if (m_device) m_device->AddRef();
 	if (m_context) m_context->AddRef();
 
-	CreateShaders();
-	CreateStates();
+	m_initialized = CreateShaders() && CreateStates();
 }
 
 Renderer::~Renderer() {
 	ClearModel();
+	ReleaseRenderTargets();
 
 	// m_states uses unique_ptr and cleans up automatically
 	if (m_wireframeRS) m_wireframeRS->Release();
@@ -39,94 +78,55 @@ bool Renderer::CreateShaders() {
 	LOG_TRACE("Creating S3D shaders and pipeline resources...");
 	HRESULT hr;
 
-	// Compile vertex shader
-	LOG_TRACE("  Compiling vertex shader (vs_4_0, {} bytes)...", strlen(Shaders::VERTEX_SHADER));
-	ID3DBlob* vsBlob = nullptr;
-	ID3DBlob* errorBlob = nullptr;
-
-	hr = D3DCompile(
-		Shaders::VERTEX_SHADER,
-		strlen(Shaders::VERTEX_SHADER),
-		"VS",
-		nullptr,
-		nullptr,
-		"main",
-		"vs_4_0",
-		0,
-		0,
-		&vsBlob,
-		&errorBlob
-	);
-
-	if (FAILED(hr)) {
-		if (errorBlob) {
-			LOG_ERROR("Vertex shader compilation failed (0x{:08X}): {}", hr, (char*)errorBlob->GetBufferPointer());
-			errorBlob->Release();
-		} else {
-			LOG_ERROR("Vertex shader compilation failed: 0x{:08X}", hr);
-		}
-		return false;
-	}
-
-	LOG_TRACE("    Vertex shader compiled successfully ({} bytes bytecode)", vsBlob->GetBufferSize());
-
-	hr = m_device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, &m_vertexShader);
+#if S3D_RUNTIME_SHADER_COMPILE
+	ID3DBlob* vsBlob = CompileShader(Shaders::VERTEX_SHADER_SOURCE, "VS", Shaders::VERTEX_SHADER_PROFILE);
+	if (!vsBlob) return false;
+	const void* vsData = vsBlob->GetBufferPointer();
+	const size_t vsSize = vsBlob->GetBufferSize();
+#else
+	const void* vsData = Shaders::VERTEX_SHADER.data;
+	const size_t vsSize = Shaders::VERTEX_SHADER.size;
+	LOG_TRACE("  Using precompiled vertex shader ({} bytes bytecode)", vsSize);
+#endif
+
+	hr = m_device->CreateVertexShader(vsData, vsSize, nullptr, &m_vertexShader);
 	if (FAILED(hr)) {
 		LOG_ERROR("Failed to create vertex shader object: 0x{:08X}", hr);
+#if S3D_RUNTIME_SHADER_COMPILE
 		vsBlob->Release();
+#endif
 		return false;
 	}
 
-	// Create input layout
-	LOG_TRACE("  Creating input layout (4 elements: POSITION, COLOR, TEXCOORD0, TEXCOORD1)...");
+	// Create input layout (PackedVertex: the second UV set is never sampled, so it isn't uploaded)
+	LOG_TRACE("  Creating input layout (3 elements: POSITION, COLOR, TEXCOORD0)...");
 	D3D11_INPUT_ELEMENT_DESC layout[] = {
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 28, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-		{ "TEXCOORD", 1, DXGI_FORMAT_R32G32_FLOAT, 0, 36, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(PackedVertex, position), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof(PackedVertex, color), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof(PackedVertex, uv), D3D11_INPUT_PER_VERTEX_DATA, 0 },
 	};
 
-	hr = m_device->CreateInputLayout(layout, 4, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &m_inputLayout);
+	hr = m_device->CreateInputLayout(layout, 3, vsData, vsSize, &m_inputLayout);
+#if S3D_RUNTIME_SHADER_COMPILE
 	vsBlob->Release();
+#endif
 
 	if (FAILED(hr)) {
 		LOG_ERROR("Failed to create input layout: 0x{:08X}", hr);
 		return false;
 	}
 
-	LOG_TRACE("    Input layout created (stride=44 bytes per vertex)");
-
-	// Compile pixel shader
-	LOG_TRACE("  Compiling pixel shader (ps_4_0, {} bytes)...", strlen(Shaders::PIXEL_SHADER));
-	ID3DBlob* psBlob = nullptr;
-	hr = D3DCompile(
-		Shaders::PIXEL_SHADER,
-		strlen(Shaders::PIXEL_SHADER),
-		"PS",
-		nullptr,
-		nullptr,
-		"main",
-		"ps_4_0",
-		0,
-		0,
-		&psBlob,
-		&errorBlob
-	);
-
-	if (FAILED(hr)) {
-		if (errorBlob) {
-			LOG_ERROR("Pixel shader compilation failed (0x{:08X}): {}", hr, (char*)errorBlob->GetBufferPointer());
-			errorBlob->Release();
-		} else {
-			LOG_ERROR("Pixel shader compilation failed: 0x{:08X}", hr);
-		}
-		return false;
-	}
-
-	LOG_TRACE("    Pixel shader compiled successfully ({} bytes bytecode)", psBlob->GetBufferSize());
+	LOG_TRACE("    Input layout created (stride={} bytes per vertex)", sizeof(PackedVertex));
 
+#if S3D_RUNTIME_SHADER_COMPILE
+	ID3DBlob* psBlob = CompileShader(Shaders::PIXEL_SHADER_SOURCE, "PS", Shaders::PIXEL_SHADER_PROFILE);
+	if (!psBlob) return false;
 	hr = m_device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &m_pixelShader);
 	psBlob->Release();
+#else
+	LOG_TRACE("  Using precompiled pixel shader ({} bytes bytecode)", Shaders::PIXEL_SHADER.size);
+	hr = m_device->CreatePixelShader(Shaders::PIXEL_SHADER.data, Shaders::PIXEL_SHADER.size, nullptr, &m_pixelShader);
+#endif
 
 	if (FAILED(hr)) {
 		LOG_ERROR("Failed to create pixel shader object: 0x{:08X}", hr);
@@ -188,16 +188,18 @@ bool Renderer::CreateVertexBuffers(const Model& model) {
 
 	for (const auto& vb : model.vertexBuffers) {
 		auto gpuVB = std::make_unique<GPUVertexBuffer>();
-		gpuVB->stride = sizeof(Vertex);
+		gpuVB->stride = sizeof(PackedVertex);
 		gpuVB->count = static_cast<uint32_t>(vb.vertices.size());
 
+		PackVertices(vb.vertices, m_packScratch);
+
 		D3D11_BUFFER_DESC bufferDesc = {};
 		bufferDesc.ByteWidth = gpuVB->stride * gpuVB->count;
 		bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
 		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 
 		D3D11_SUBRESOURCE_DATA initData = {};
-		initData.pSysMem = vb.vertices.data();
+		initData.pSysMem = m_packScratch.data();
 
 		HRESULT hr = m_device->CreateBuffer(&bufferDesc, &initData, &gpuVB->buffer);
 		if (FAILED(hr)) {
@@ -241,7 +243,7 @@ bool Renderer::CreateIndexBuffers(const Model& model) {
 	return true;
 }
 
-bool Renderer::CreateMaterials(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID) {
+bool Renderer::CreateMaterials(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID, uint32_t textureSizeHint) {
 	m_materials.clear();
 	m_materials.reserve(model.materials.size());
 
@@ -285,7 +287,7 @@ bool Renderer::CreateMaterials(const Model& model, cIGZPersistResourceManager* p
 			};
 
 			for (uint32_t tryGroup : textureGroups) {
-				gpuMat->textureSRV = FSH::Reader::LoadTextureFromResourceManager(m_device, pRM, tryGroup, textureID);
+				gpuMat->textureSRV = FSH::TextureCache::Acquire(m_device, pRM, tryGroup, textureID, textureSizeHint);
 				if (gpuMat->textureSRV) {
 					LOG_TRACE("    Loaded texture 0x{:08X} from group 0x{:08X}", textureID, tryGroup);
 					break;
@@ -389,7 +391,7 @@ bool Renderer::CreateMaterialsFromDBPF(const Model& model, cISC4DBSegmentPackedF
 	return false;
 }
 
-bool Renderer::LoadModel(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID) {
+bool Renderer::LoadModel(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID, uint32_t textureSizeHint) {
 	ClearModel();
 
 	LOG_INFO("Loading S3D model v{}.{} from group 0x{:08X}",
@@ -400,7 +402,7 @@ bool Renderer::LoadModel(const Model& model, cIGZPersistResourceManager* pRM, ui
 
 	if (!CreateVertexBuffers(model)) return false;
 	if (!CreateIndexBuffers(model)) return false;
-	if (!CreateMaterials(model, pRM, groupID)) return false;
+	if (!CreateMaterials(model, pRM, groupID, textureSizeHint)) return false;
 
 	// Copy primitive blocks
 	m_primitiveBlocks = model.primitiveBlocks;
@@ -487,77 +489,19 @@ void Renderer::ClearModel() {
 
 DirectX::SimpleMath::Matrix Renderer::CalculateViewProjMatrix() const
 {
-	using namespace DirectX;
-	using namespace DirectX::SimpleMath;
-
 	LOG_TRACE("Calculating view-projection matrix for S3D rendering...");
 	LOG_TRACE("  Model bounding box: min=({:.3f}, {:.3f}, {:.3f}), max=({:.3f}, {:.3f}, {:.3f})",
 		m_bbMin.x, m_bbMin.y, m_bbMin.z, m_bbMax.x, m_bbMax.y, m_bbMax.z);
 
-	const float ry_deg = RenderConstants::BILLBOARD_ROTATION_Y;  // -22.5° isometric Y rotation
-	const float rx_deg = RenderConstants::BILLBOARD_ROTATION_X;  // 45° isometric X tilt
-
-	LOG_TRACE("  Billboard rotation: Y={:.1f}°, X={:.1f}°", ry_deg, rx_deg);
-
-	Matrix rotY_pos = Matrix::CreateRotationY(XMConvertToRadians(22.5f));   // +22.5 for bounds calculation
-	Matrix rotX_neg = Matrix::CreateRotationX(XMConvertToRadians(-45.0f));  // -45 for bounds calculation
-
-	const float minx = m_bbMin.x, miny = m_bbMin.y, minz = m_bbMin.z;
-	const float maxx = m_bbMax.x, maxy = m_bbMax.y, maxz = m_bbMax.z;
-
-	Vector3 corners[8] = {
-		Vector3(minx, miny, minz), Vector3(maxx, miny, minz),
-		Vector3(minx, maxy, minz), Vector3(maxx, maxy, minz),
-		Vector3(minx, miny, maxz), Vector3(maxx, miny, maxz),
-		Vector3(minx, maxy, maxz), Vector3(maxx, maxy, maxz)
-	};
+	// Shared with the software rasterizer so both backends frame models identically
+	const ThumbnailCamera camera = ComputeThumbnailCamera(m_bbMin, m_bbMax);
+	if (camera.clamped) {
+		LOG_WARN("  Model size too small, clamping to 1.0");
+	}
+	LOG_TRACE("  Orthographic projection: size={:.3f} (padding={:.0f}%)",
+		camera.extent, (RenderConstants::BOUNDING_BOX_PADDING - 1.0f) * 100.0f);
 
-	float minX = FLT_MAX, minY = FLT_MAX;
-	float maxX = -FLT_MAX, maxY = -FLT_MAX;
-	float maxZ = -FLT_MAX;
-	for (int i = 0; i < 8; ++i) {
-		Vector3 v = Vector3::Transform(corners[i], rotY_pos);
-		v = Vector3::Transform(v, rotX_neg);
-		minX = (std::min)(minX, v.x); maxX = (std::max)(maxX, v.x);
-		minY = (std::min)(minY, v.y); maxY = (std::max)(maxY, v.y);
-		maxZ = (std::max)(maxZ, v.z);
-	}
-	LOG_TRACE("  Rotated bounds: X=[{:.3f}, {:.3f}], Y=[{:.3f}, {:.3f}], maxZ={:.3f}",
-		minX, maxX, minY, maxY, maxZ);
-
-	const float padding = RenderConstants::BOUNDING_BOX_PADDING;
-	float width = (maxX - minX);
-	float height = (maxY - minY);
-	float diff = (std::max)(width, height) * padding;
-	if (diff < 1e-4f) {
-		LOG_WARN("  Model size too small ({:.6f}), clamping to 1.0", diff);
-		diff = 1.0f;
-	}
-
-	float posx = (minX + maxX) * 0.5f;
-	float posy = (minY + maxY) * 0.5f;
-	float posz = maxZ;
-
-	LOG_TRACE("  Orthographic projection: size={:.3f} (width={:.3f}, height={:.3f}, padding={:.0f}%)",
-		diff, width, height, (padding - 1.0f) * 100.0f);
-	LOG_TRACE("  View center: ({:.3f}, {:.3f}, {:.3f})", posx, posy, posz);
-
-	// DirectX applies transformations left-to-right, OpenGL applies right-to-left
-	// To match Python OpenGL: RotateY -> RotateX -> Translate
-	LOG_TRACE("  Building view matrix (billboard: rotateY, rotateX, translate)...");
-	Matrix view = Matrix::Identity;
-	view *= Matrix::CreateRotationY(XMConvertToRadians(ry_deg));       // Rotate -22.5° (applied first to vertices)
-	view *= Matrix::CreateRotationX(XMConvertToRadians(rx_deg));       // Tilt down 45° (applied second)
-	view *= Matrix::CreateTranslation(-posx, -posy, -posz);            // Center model (applied last)
-
-	// Python OpenGL uses glOrtho(..., 40000, -40000) which creates a projection where
-	// the near plane is at -40000 and far at 40000 along the Z axis (after view transform)
-	// In DirectX LH, we need near < far, so we use symmetric range around 0
-	LOG_TRACE("  Building projection matrix (orthographic LH, near={:.1f}, far={:.1f})...",
-		RenderConstants::NEAR_PLANE, RenderConstants::FAR_PLANE);
-	Matrix proj = Matrix(XMMatrixOrthographicLH(diff, diff,
-		RenderConstants::NEAR_PLANE, RenderConstants::FAR_PLANE));
-	Matrix viewProj = view * proj;
+	const DirectX::SimpleMath::Matrix viewProj(&camera.viewProj.m[0][0]);
 
 	LOG_TRACE("  ViewProj matrix computed:");
 	LOG_TRACE("    [{:7.3f} {:7.3f} {:7.3f} {:7.3f}]",
@@ -822,16 +766,58 @@ std::unique_ptr<Renderer::RenderTarget> Renderer::CreateRenderTarget(uint32_t wi
 		return nullptr;
 	}
 
-	// Create SRV for ImGui
-	LOG_TRACE("  Creating shader resource view (for ImGui display)...");
-	hr = m_device->CreateShaderResourceView(rt->texture, nullptr, &rt->srv);
+	LOG_TRACE("Render target created successfully");
+	return rt;
+}
+
+Renderer::RenderTarget* Renderer::GetRenderTarget(uint32_t size) {
+	auto it = m_renderTargets.find(size);
+	if (it != m_renderTargets.end()) {
+		return it->second.get();
+	}
+
+	auto rt = CreateRenderTarget(size, size);
+	if (!rt) return nullptr;
+
+	RenderTarget* result = rt.get();
+	m_renderTargets.emplace(size, std::move(rt));
+	return result;
+}
+
+void Renderer::ReleaseRenderTargets() {
+	m_renderTargets.clear();
+}
+
+ID3D11ShaderResourceView* Renderer::CopyToTexture(const RenderTarget& rt) {
+	// The pooled target is reused for the next thumbnail, so the caller gets its own copy
+	D3D11_TEXTURE2D_DESC texDesc = {};
+	texDesc.Width = rt.width;
+	texDesc.Height = rt.height;
+	texDesc.MipLevels = 1;
+	texDesc.ArraySize = 1;
+	texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	texDesc.SampleDesc.Count = 1;
+	texDesc.Usage = D3D11_USAGE_DEFAULT;
+	texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	ID3D11Texture2D* texture = nullptr;
+	HRESULT hr = m_device->CreateTexture2D(&texDesc, nullptr, &texture);
+	if (FAILED(hr)) {
+		LOG_ERROR("Failed to create thumbnail texture ({}x{}): 0x{:08X}", rt.width, rt.height, hr);
+		return nullptr;
+	}
+
+	m_context->CopyResource(texture, rt.texture);
+
+	ID3D11ShaderResourceView* srv = nullptr;
+	hr = m_device->CreateShaderResourceView(texture, nullptr, &srv);
+	texture->Release(); // SRV holds reference
+
 	if (FAILED(hr)) {
 		LOG_ERROR("Failed to create shader resource view: 0x{:08X}", hr);
 		return nullptr;
 	}
-
-	LOG_TRACE("Render target created successfully");
-	return rt;
+	return srv;
 }
 
 ID3D11ShaderResourceView* Renderer::GenerateThumbnail(int size) {
@@ -842,9 +828,14 @@ ID3D11ShaderResourceView* Renderer::GenerateThumbnail(int size) {
 		return nullptr;
 	}
 
-	// Create render target
-	LOG_TRACE("  Creating offscreen render target...");
-	auto rt = CreateRenderTarget(size, size);
+	if (size <= 0) {
+		LOG_ERROR("GenerateThumbnail: Invalid size {}", size);
+		return nullptr;
+	}
+
+	// Get (or create) the pooled render target for this size
+	LOG_TRACE("  Acquiring offscreen render target...");
+	RenderTarget* rt = GetRenderTarget(static_cast<uint32_t>(size));
 	if (!rt) {
 		LOG_ERROR("  Failed to create render target for thumbnail");
 		return nullptr;
@@ -920,9 +911,12 @@ ID3D11ShaderResourceView* Renderer::GenerateThumbnail(int size) {
 	if (oldBS) oldBS->Release();
 	if (oldDSS) oldDSS->Release();
 
-	// Return SRV (caller takes ownership)
-	ID3D11ShaderResourceView* srv = rt->srv;
-	rt->srv = nullptr; // Prevent destructor from releasing it
+	// Copy out of the pooled target (caller takes ownership of the SRV)
+	ID3D11ShaderResourceView* srv = CopyToTexture(*rt);
+	if (!srv) {
+		LOG_ERROR("  Failed to copy thumbnail out of the render target");
+		return nullptr;
+	}
 
 	LOG_INFO("Thumbnail generated successfully: {}x{} (SRV={})", size, size, (void*)srv);
 	return srv;
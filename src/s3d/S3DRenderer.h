@@ -1,6 +1,8 @@
 #pragma once
 #include "S3DStructures.h"
+#include "S3DCamera.h"
 #include "S3DEnumMappings.h"
+#include "S3DVertexPacking.h"
 #include "FSHReader.h"
 #include <d3d11.h>
 #include <SimpleMath.h>
@@ -14,13 +16,8 @@ class cIGZPersistResourceManager;
 
 namespace S3D {
 
-// Rendering constants
+// Rendering constants (camera constants live in S3DCamera.h)
 namespace RenderConstants {
-	constexpr float BILLBOARD_ROTATION_Y = -22.5f;  // Isometric Y rotation (degrees)
-	constexpr float BILLBOARD_ROTATION_X = 45.0f;   // Isometric X rotation (degrees)
-	constexpr float BOUNDING_BOX_PADDING = 1.10f;   // 10% padding around model
-	constexpr float NEAR_PLANE = -40000.0f;         // Near clip plane for ortho projection
-	constexpr float FAR_PLANE = 40000.0f;           // Far clip plane for ortho projection
 	constexpr size_t SHADER_CONSTANTS_SIZE = 256;   // Constant buffer size in bytes
 }
 
@@ -57,7 +54,8 @@ public:
 	~Renderer();
 
 	// Load S3D model and create GPU resources (using ResourceManager - recommended)
-	bool LoadModel(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID);
+	// textureSizeHint: output size in pixels, lets textures skip mip levels that would never be sampled (0 = all)
+	bool LoadModel(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID, uint32_t textureSizeHint = 0);
 
 	// Load S3D model and create GPU resources (using DBPF - deprecated)
 	bool LoadModelFromDBPF(const Model& model, cISC4DBSegmentPackedFile* dbpf, uint32_t groupID);
@@ -72,11 +70,23 @@ public:
 	// Generate thumbnail texture from model
 	// Returns ID3D11ShaderResourceView* that can be used with ImGui::Image()
 	// Size is thumbnail dimension (e.g., 128 for 128x128)
+	// Renders into a pooled target of that size and copies the result into a new texture
 	ID3D11ShaderResourceView* GenerateThumbnail(int size = 128);
 
+	// Free the pooled render targets (they are recreated on demand)
+	void ReleaseRenderTargets();
+
 	// Check if model is loaded
 	bool HasModel() const { return m_modelLoaded; }
 
+	// Check if shaders and states were created
+	bool IsInitialized() const { return m_initialized; }
+
+	// Check if this renderer was created for the given device and context
+	bool UsesDevice(ID3D11Device* device, ID3D11DeviceContext* context) const {
+		return m_device == device && m_context == context;
+	}
+
 	// Debug visualization
 	void SetDebugMode(DebugMode mode) { m_debugMode = mode; }
 	DebugMode GetDebugMode() const { return m_debugMode; }
@@ -129,9 +139,11 @@ private:
 	std::vector<std::unique_ptr<GPUMaterial>> m_materials;
 	std::vector<Frame> m_frames;
 	std::vector<AnimatedMesh> m_meshes;
+	std::vector<PackedVertex> m_packScratch;  // Reused by CreateVertexBuffers
 
 	DirectX::SimpleMath::Vector3 m_bbMin, m_bbMax;
 	bool m_modelLoaded = false;
+	bool m_initialized = false;
 
 	// Shaders
 	ID3D11VertexShader* m_vertexShader = nullptr;
@@ -154,7 +166,7 @@ private:
 	// Resource creation
 	bool CreateVertexBuffers(const Model& model);
 	bool CreateIndexBuffers(const Model& model);
-	bool CreateMaterials(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID);
+	bool CreateMaterials(const Model& model, cIGZPersistResourceManager* pRM, uint32_t groupID, uint32_t textureSizeHint);
 	bool CreateMaterialsFromDBPF(const Model& model, cISC4DBSegmentPackedFile* dbpf, uint32_t groupID);
 
 	// Rendering helpers
@@ -167,12 +179,10 @@ private:
 		ID3D11RenderTargetView* rtv = nullptr;
 		ID3D11DepthStencilView* dsv = nullptr;
 		ID3D11Texture2D* depthBuffer = nullptr;
-		ID3D11ShaderResourceView* srv = nullptr;
 		uint32_t width = 0;
 		uint32_t height = 0;
 
 		~RenderTarget() {
-			if (srv) srv->Release();
 			if (dsv) dsv->Release();
 			if (depthBuffer) depthBuffer->Release();
 			if (rtv) rtv->Release();
@@ -180,7 +190,12 @@ private:
 		}
 	};
 
+	// Render targets kept between thumbnails, keyed by (square) size
+	std::unordered_map<uint32_t, std::unique_ptr<RenderTarget>> m_renderTargets;
+
 	std::unique_ptr<RenderTarget> CreateRenderTarget(uint32_t width, uint32_t height);
+	RenderTarget* GetRenderTarget(uint32_t size);
+	ID3D11ShaderResourceView* CopyToTexture(const RenderTarget& rt);
 };
 
 } // namespace S3D
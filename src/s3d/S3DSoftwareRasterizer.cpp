@@ -0,0 +1,514 @@
+#include "S3DSoftwareRasterizer.h"
+#include "S3DCamera.h"
+#include "S3DGLEnums.h"
+#include "FSHMipChain.h"
+#include "FSHPixelConvert.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace S3D {
+
+namespace {
+
+// Same background as the D3D11 renderer's clear color (0.15, 0.15, 0.15, 1.0)
+constexpr uint8_t CLEAR_GRAY = 38;
+
+// Index restarting a triangle strip (D3D11 always cuts strips on 0xFFFF for 16-bit indices)
+constexpr uint16_t STRIP_CUT_INDEX = 0xFFFF;
+
+inline float Saturate(float v) {
+	return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+}
+
+inline uint8_t ToUNorm8(float v) {
+	return static_cast<uint8_t>(Saturate(v) * 255.0f + 0.5f);
+}
+
+inline int WrapTexel(int i, int size, int mode) {
+	switch (mode) {
+		case 1: // Clamp
+			return i < 0 ? 0 : (i >= size ? size - 1 : i);
+		case 2: { // Mirror
+			const int period = size * 2;
+			int m = i % period;
+			if (m < 0) m += period;
+			return m < size ? m : period - 1 - m;
+		}
+		default: { // Repeat
+			int m = i % size;
+			return m < 0 ? m + size : m;
+		}
+	}
+}
+
+} // namespace
+
+bool SoftwareRasterizer::LoadModel(const Model& model, const TextureSource& textures, uint32_t textureSizeHint) {
+	ClearModel();
+
+	if (model.vertexBuffers.empty() || model.indexBuffers.empty()) {
+		LOG_ERROR("SoftwareRasterizer: model has no geometry");
+		return false;
+	}
+
+	m_model = model;
+
+	// Decode each distinct texture once; materials point into m_textures
+	for (const auto& mat : m_model.materials) {
+		if ((mat.flags & MAT_TEXTURE) && !mat.textures.empty() && textures) {
+			LoadTexture(mat.textures[0].textureID, textures, textureSizeHint);
+		}
+	}
+
+	m_materials.reserve(m_model.materials.size());
+	for (const auto& mat : m_model.materials) {
+		m_materials.push_back(BuildMaterial(mat));
+	}
+
+	m_modelLoaded = true;
+	LOG_DEBUG("SoftwareRasterizer: loaded model ({} vertex buffers, {} materials, {} textures)",
+		m_model.vertexBuffers.size(), m_materials.size(), m_textures.size());
+	return true;
+}
+
+void SoftwareRasterizer::ClearModel() {
+	m_model = Model();
+	m_textures.clear();
+	m_materials.clear();
+	m_modelLoaded = false;
+}
+
+void SoftwareRasterizer::LoadTexture(uint32_t textureID, const TextureSource& textures, uint32_t textureSizeHint) {
+	auto [it, inserted] = m_textures.try_emplace(textureID);
+	if (!inserted) return;
+
+	const auto file = textures(textureID);
+	if (!file || file->bitmaps.empty()) {
+		LOG_WARN("SoftwareRasterizer: failed to load texture 0x{:08X}", textureID);
+		return;
+	}
+
+	// Sample the level the D3D11 path would upload first for this output size
+	const FSH::Bitmap& bitmap = file->bitmaps[0];
+	const auto chain = FSH::ComputeMipChain(bitmap.code, bitmap.width, bitmap.height,
+	                                        1u + bitmap.mipCount, bitmap.data.size());
+	if (chain.empty()) {
+		LOG_WARN("SoftwareRasterizer: texture 0x{:08X} has no usable level", textureID);
+		return;
+	}
+	const FSH::MipLevelInfo& level = chain[FSH::SelectFirstMip(chain, bitmap.code, textureSizeHint)];
+
+	Texture& tex = it->second;
+	tex.rgba.resize(static_cast<size_t>(level.width) * level.height * 4);
+	if (!FSH::PixelConvert::ConvertLevelToRGBA8(bitmap.code, level.width, level.height,
+	                                            bitmap.data.data() + level.offset, level.size, tex.rgba.data())) {
+		LOG_WARN("SoftwareRasterizer: unsupported format 0x{:02X} for texture 0x{:08X}", bitmap.code, textureID);
+		tex.rgba.clear();
+		return;
+	}
+	tex.width = level.width;
+	tex.height = level.height;
+}
+
+// Mirrors the EnumMappings used by Renderer::CreateMaterials, including their fallbacks
+SoftwareRasterizer::RasterMaterial SoftwareRasterizer::BuildMaterial(const Material& mat) const {
+	using namespace EnumMappings;
+
+	auto mapCompare = [](uint8_t glFunc, CompareFunc fallback) {
+		switch (glFunc) {
+			case GL_NEVER:    return CompareFunc::Never;
+			case GL_LESS:     return CompareFunc::Less;
+			case GL_EQUAL:    return CompareFunc::Equal;
+			case GL_LEQUAL:   return CompareFunc::LessEqual;
+			case GL_GREATER:  return CompareFunc::Greater;
+			case GL_NOTEQUAL: return CompareFunc::NotEqual;
+			case GL_GEQUAL:   return CompareFunc::GreaterEqual;
+			case GL_ALWAYS:   return CompareFunc::Always;
+			default:          return fallback;
+		}
+	};
+
+	auto mapBlend = [](uint8_t glBlend) {
+		switch (glBlend) {
+			case GL_SRC_COLOR:           return BlendFactor::SrcColor;
+			case GL_ONE_MINUS_SRC_COLOR: return BlendFactor::InvSrcColor;
+			case GL_SRC_ALPHA:           return BlendFactor::SrcAlpha;
+			case GL_ONE_MINUS_SRC_ALPHA: return BlendFactor::InvSrcAlpha;
+			case GL_DST_ALPHA:           return BlendFactor::DstAlpha;
+			case GL_ONE_MINUS_DST_ALPHA: return BlendFactor::InvDstAlpha;
+			case GL_DST_COLOR:           return BlendFactor::DstColor;
+			case GL_ONE_MINUS_DST_COLOR: return BlendFactor::InvDstColor;
+			case GL_SRC_ALPHA_SATURATE:  return BlendFactor::SrcAlphaSat;
+			default:                     return BlendFactor::One;
+		}
+	};
+
+	auto mapWrap = [](uint8_t glWrap) {
+		switch (glWrap) {
+			case GL_REPEAT:          return Wrap::Repeat;
+			case GL_CLAMP:           return Wrap::Clamp;
+			case GL_CLAMP_TO_EDGE:   return Wrap::Clamp;
+			case GL_MIRRORED_REPEAT: return Wrap::Mirror;
+			default:                 return Wrap::Repeat;
+		}
+	};
+
+	RasterMaterial out;
+	out.alphaThreshold = mat.alphaThreshold;
+	out.alphaFunc = (mat.flags & MAT_ALPHA_TEST)
+		? static_cast<CompareFunc>(MapAlphaFunc(mat.alphaFunc))
+		: CompareFunc::Always;
+
+	if ((mat.flags & MAT_TEXTURE) && !mat.textures.empty()) {
+		const MaterialTexture& texInfo = mat.textures[0];
+		auto it = m_textures.find(texInfo.textureID);
+		if (it != m_textures.end() && !it->second.rgba.empty()) {
+			out.texture = &it->second;
+		}
+		out.wrapU = mapWrap(texInfo.wrapS);
+		out.wrapV = mapWrap(texInfo.wrapT);
+		// Thumbnails minify nearly every texture, so the min filter decides
+		out.linear = texInfo.minFilter == GL_LINEAR ||
+		             texInfo.minFilter == GL_LINEAR_MIPMAP_NEAREST ||
+		             texInfo.minFilter == GL_LINEAR_MIPMAP_LINEAR;
+	}
+
+	// Blending only applies to textured materials, as in the D3D11 path
+	out.blend = (mat.flags & MAT_BLEND) && out.texture;
+	if (out.blend) {
+		out.srcBlend = mapBlend(mat.srcBlend);
+		out.dstBlend = mapBlend(mat.dstBlend);
+	}
+
+	out.depthTest = (mat.flags & MAT_DEPTH_TEST) != 0;
+	out.depthWrite = out.depthTest && (mat.flags & MAT_DEPTH_WRITES);
+	out.depthFunc = mapCompare(mat.depthFunc, CompareFunc::LessEqual);
+	return out;
+}
+
+bool SoftwareRasterizer::RenderThumbnail(int size, std::vector<uint8_t>& outRGBA, int frameIdx) {
+	if (!m_modelLoaded) {
+		LOG_ERROR("SoftwareRasterizer: no model loaded");
+		return false;
+	}
+	if (size <= 0) {
+		LOG_ERROR("SoftwareRasterizer: invalid thumbnail size {}", size);
+		return false;
+	}
+
+	const size_t pixelCount = static_cast<size_t>(size) * size;
+	m_color.resize(pixelCount * 4);
+	for (size_t i = 0; i < pixelCount; ++i) {
+		m_color[i * 4 + 0] = CLEAR_GRAY;
+		m_color[i * 4 + 1] = CLEAR_GRAY;
+		m_color[i * 4 + 2] = CLEAR_GRAY;
+		m_color[i * 4 + 3] = 255;
+	}
+	m_depth.assign(pixelCount, 1.0f);
+
+	SetupTriangles(size, frameIdx);
+	BinTriangles(size);
+
+	const int tiles = (size + TILE_SIZE - 1) / TILE_SIZE;
+	for (int tileY = 0; tileY < tiles; ++tileY) {
+		for (int tileX = 0; tileX < tiles; ++tileX) {
+			RasterizeTile(tileX, tileY, size);
+		}
+	}
+
+	LOG_DEBUG("SoftwareRasterizer: rendered {} triangles at {}x{}", m_triangles.size(), size, size);
+	outRGBA = m_color;
+	return true;
+}
+
+void SoftwareRasterizer::SetupTriangles(int size, int frameIdx) {
+	m_triangles.clear();
+
+	const ThumbnailCamera camera = ComputeThumbnailCamera(m_model.bbMin, m_model.bbMax);
+	const float half = static_cast<float>(size) * 0.5f;
+
+	for (const auto& mesh : m_model.animation.animatedMeshes) {
+		if (frameIdx < 0 || frameIdx >= static_cast<int>(mesh.frames.size())) continue;
+
+		const Frame& frame = mesh.frames[frameIdx];
+		if (frame.vertBlock >= m_model.vertexBuffers.size() ||
+		    frame.indexBlock >= m_model.indexBuffers.size() ||
+		    frame.matsBlock >= m_materials.size()) {
+			continue;
+		}
+
+		// Orthographic camera: w stays 1, so screen-space interpolation is exact
+		const auto& vertices = m_model.vertexBuffers[frame.vertBlock].vertices;
+		m_screenVerts.resize(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			const Vertex& src = vertices[i];
+			const Vector4 clip = camera.viewProj.Transform(src.position);
+			const float invW = clip.w != 0.0f ? 1.0f / clip.w : 0.0f;
+
+			ScreenVertex& dst = m_screenVerts[i];
+			dst.x = (clip.x * invW + 1.0f) * half;
+			dst.y = (1.0f - clip.y * invW) * half;
+			dst.z = clip.z * invW;
+			dst.r = src.color.x;
+			dst.g = src.color.y;
+			dst.b = src.color.z;
+			dst.a = src.color.w;
+			dst.u = src.uv.x;
+			dst.v = src.uv.y;
+		}
+
+		const auto& indices = m_model.indexBuffers[frame.indexBlock].indices;
+		const uint32_t material = frame.matsBlock;
+		auto emitList = [&](size_t first, size_t length) {
+			const size_t end = (std::min)(first + length, indices.size());
+			for (size_t i = first; i + 2 < end; i += 3) {
+				AddTriangle(indices[i], indices[i + 1], indices[i + 2], material, size);
+			}
+		};
+		auto emitStrip = [&](size_t first, size_t length) {
+			const size_t end = (std::min)(first + length, indices.size());
+			size_t runStart = first;
+			for (size_t i = first; i < end; ++i) {
+				if (indices[i] == STRIP_CUT_INDEX) {
+					runStart = i + 1;
+					continue;
+				}
+				if (i < runStart + 2) continue;
+				// Winding alternates, but culling is off so only coverage matters
+				AddTriangle(indices[i - 2], indices[i - 1], indices[i], material, size);
+			}
+		};
+
+		if (frame.primBlock < m_model.primitiveBlocks.size() && !m_model.primitiveBlocks[frame.primBlock].empty()) {
+			for (const auto& prim : m_model.primitiveBlocks[frame.primBlock]) {
+				switch (prim.type) {
+					case 0: emitList(prim.first, prim.length); break;
+					case 1: emitStrip(prim.first, prim.length); break;
+					default: break; // Fans are skipped, like the D3D11 path
+				}
+			}
+		} else {
+			emitList(0, indices.size());
+		}
+	}
+}
+
+void SoftwareRasterizer::AddTriangle(uint32_t i0, uint32_t i1, uint32_t i2, uint32_t material, int size) {
+	if (i0 >= m_screenVerts.size() || i1 >= m_screenVerts.size() || i2 >= m_screenVerts.size()) return;
+
+	Triangle tri;
+	tri.v[0] = m_screenVerts[i0];
+	tri.v[1] = m_screenVerts[i1];
+	tri.v[2] = m_screenVerts[i2];
+
+	auto edge = [](const ScreenVertex& a, const ScreenVertex& b, float px, float py) {
+		return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+	};
+
+	// Culling is off: flip clockwise triangles so the inside is always positive
+	float area = edge(tri.v[0], tri.v[1], tri.v[2].x, tri.v[2].y);
+	if (area == 0.0f || !std::isfinite(area)) return;
+	if (area < 0.0f) {
+		std::swap(tri.v[1], tri.v[2]);
+		area = -area;
+	}
+
+	tri.minX = (std::min)({tri.v[0].x, tri.v[1].x, tri.v[2].x});
+	tri.maxX = (std::max)({tri.v[0].x, tri.v[1].x, tri.v[2].x});
+	tri.minY = (std::min)({tri.v[0].y, tri.v[1].y, tri.v[2].y});
+	tri.maxY = (std::max)({tri.v[0].y, tri.v[1].y, tri.v[2].y});
+	const float extent = static_cast<float>(size);
+	if (tri.maxX < 0.0f || tri.maxY < 0.0f || tri.minX > extent || tri.minY > extent) return;
+
+	// Bounds are only used to pick tiles and pixels, so keep them within int range
+	tri.minX = (std::max)(tri.minX, -1.0f);
+	tri.minY = (std::max)(tri.minY, -1.0f);
+	tri.maxX = (std::min)(tri.maxX, extent + 1.0f);
+	tri.maxY = (std::min)(tri.maxY, extent + 1.0f);
+
+	const float xs[3] = {tri.v[0].x, tri.v[1].x, tri.v[2].x};
+	const float ys[3] = {tri.v[0].y, tri.v[1].y, tri.v[2].y};
+	tri.edges = RasterCoverage::SetupEdges(xs, ys);
+	tri.invArea = 1.0f / area;
+	tri.material = material;
+	m_triangles.push_back(tri);
+}
+
+void SoftwareRasterizer::BinTriangles(int size) {
+	const int tiles = (size + TILE_SIZE - 1) / TILE_SIZE;
+	m_bins.resize(static_cast<size_t>(tiles) * tiles);
+	for (auto& bin : m_bins) bin.clear();
+
+	for (uint32_t t = 0; t < m_triangles.size(); ++t) {
+		const Triangle& tri = m_triangles[t];
+		const int x0 = (std::max)(0, static_cast<int>(std::floor(tri.minX)) / TILE_SIZE);
+		const int y0 = (std::max)(0, static_cast<int>(std::floor(tri.minY)) / TILE_SIZE);
+		const int x1 = (std::min)(tiles - 1, static_cast<int>(std::floor(tri.maxX)) / TILE_SIZE);
+		const int y1 = (std::min)(tiles - 1, static_cast<int>(std::floor(tri.maxY)) / TILE_SIZE);
+		for (int ty = y0; ty <= y1; ++ty) {
+			for (int tx = x0; tx <= x1; ++tx) {
+				m_bins[static_cast<size_t>(ty) * tiles + tx].push_back(t);
+			}
+		}
+	}
+}
+
+void SoftwareRasterizer::RasterizeTile(int tileX, int tileY, int size) {
+	const int tiles = (size + TILE_SIZE - 1) / TILE_SIZE;
+	const auto& bin = m_bins[static_cast<size_t>(tileY) * tiles + tileX];
+	if (bin.empty()) return;
+
+	const int tileX0 = tileX * TILE_SIZE;
+	const int tileY0 = tileY * TILE_SIZE;
+	const int tileX1 = (std::min)(tileX0 + TILE_SIZE, size) - 1;
+	const int tileY1 = (std::min)(tileY0 + TILE_SIZE, size) - 1;
+
+	for (uint32_t t : bin) {
+		const Triangle& tri = m_triangles[t];
+		const RasterMaterial& mat = m_materials[tri.material];
+
+		// Pixels whose centers fall inside the triangle's bounds
+		const int startX = (std::max)(tileX0, static_cast<int>(std::ceil(tri.minX - 0.5f)));
+		const int endX = (std::min)(tileX1, static_cast<int>(std::floor(tri.maxX - 0.5f)));
+		const int startY = (std::max)(tileY0, static_cast<int>(std::ceil(tri.minY - 0.5f)));
+		const int endY = (std::min)(tileY1, static_cast<int>(std::floor(tri.maxY - 0.5f)));
+		if (startX > endX || startY > endY) continue;
+
+		for (int y = startY; y <= endY; ++y) {
+			const float py = static_cast<float>(y) + 0.5f;
+			const float rowC[3] = {
+				tri.edges.B[0] * py + tri.edges.C[0],
+				tri.edges.B[1] * py + tri.edges.C[1],
+				tri.edges.B[2] * py + tri.edges.C[2]
+			};
+			const size_t rowPixel = static_cast<size_t>(y) * size;
+
+			// Four pixels per step; lanes past endX are masked off
+			for (int x = startX; x <= endX; x += 4) {
+				alignas(16) float e[3][4];
+				int mask = RasterCoverage::Cover(tri.edges, rowC, x, e);
+				if (endX - x < 3) mask &= (1 << (endX - x + 1)) - 1;
+
+				for (int lane = 0; lane < 4; ++lane) {
+					if (!(mask & (1 << lane))) continue;
+					ShadePixel(tri, mat, e[0][lane] * tri.invArea, e[1][lane] * tri.invArea, e[2][lane] * tri.invArea,
+					           rowPixel + x + lane);
+				}
+			}
+		}
+	}
+}
+
+void SoftwareRasterizer::ShadePixel(const Triangle& tri, const RasterMaterial& mat, float w0, float w1, float w2,
+                                    size_t pixel) {
+	auto compare = [](CompareFunc func, float a, float b) {
+		switch (func) {
+			case CompareFunc::Never:        return false;
+			case CompareFunc::Less:         return a < b;
+			case CompareFunc::Equal:        return a == b;
+			case CompareFunc::LessEqual:    return a <= b;
+			case CompareFunc::Greater:      return a > b;
+			case CompareFunc::NotEqual:     return a != b;
+			case CompareFunc::GreaterEqual: return a >= b;
+			default:                        return true;
+		}
+	};
+
+	const ScreenVertex& v0 = tri.v[0];
+	const ScreenVertex& v1 = tri.v[1];
+	const ScreenVertex& v2 = tri.v[2];
+
+	// Depth clipping and depth test
+	const float z = w0 * v0.z + w1 * v1.z + w2 * v2.z;
+	if (z < 0.0f || z > 1.0f) return;
+	if (mat.depthTest && !compare(mat.depthFunc, z, m_depth[pixel])) return;
+
+	// Pixel shader: texture * vertex color, then alpha test
+	float src[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	if (mat.texture) {
+		const float u = w0 * v0.u + w1 * v1.u + w2 * v2.u;
+		const float v = w0 * v0.v + w1 * v1.v + w2 * v2.v;
+		Sample(*mat.texture, mat, u, v, src);
+	}
+	src[0] *= w0 * v0.r + w1 * v1.r + w2 * v2.r;
+	src[1] *= w0 * v0.g + w1 * v1.g + w2 * v2.g;
+	src[2] *= w0 * v0.b + w1 * v1.b + w2 * v2.b;
+	src[3] *= w0 * v0.a + w1 * v1.a + w2 * v2.a;
+
+	if (!compare(mat.alphaFunc, src[3], mat.alphaThreshold)) return;
+
+	for (float& c : src) c = Saturate(c);
+
+	uint8_t* dstPixel = &m_color[pixel * 4];
+	if (mat.blend) {
+		const float dst[4] = {
+			dstPixel[0] / 255.0f, dstPixel[1] / 255.0f, dstPixel[2] / 255.0f, dstPixel[3] / 255.0f
+		};
+		auto factor = [&](BlendFactor f, int c) {
+			switch (f) {
+				case BlendFactor::Zero:        return 0.0f;
+				case BlendFactor::One:         return 1.0f;
+				case BlendFactor::SrcColor:    return src[c];
+				case BlendFactor::InvSrcColor: return 1.0f - src[c];
+				case BlendFactor::SrcAlpha:    return src[3];
+				case BlendFactor::InvSrcAlpha: return 1.0f - src[3];
+				case BlendFactor::DstAlpha:    return dst[3];
+				case BlendFactor::InvDstAlpha: return 1.0f - dst[3];
+				case BlendFactor::DstColor:    return dst[c];
+				case BlendFactor::InvDstColor: return 1.0f - dst[c];
+				default:                       return (std::min)(src[3], 1.0f - dst[3]); // SrcAlphaSat
+			}
+		};
+		// Color is blended; alpha takes the source value (ONE/ZERO), as in the D3D11 blend state
+		for (int c = 0; c < 3; ++c) {
+			dstPixel[c] = ToUNorm8(src[c] * factor(mat.srcBlend, c) + dst[c] * factor(mat.dstBlend, c));
+		}
+		dstPixel[3] = ToUNorm8(src[3]);
+	} else {
+		for (int c = 0; c < 4; ++c) dstPixel[c] = ToUNorm8(src[c]);
+	}
+
+	if (mat.depthWrite) m_depth[pixel] = z;
+}
+
+void SoftwareRasterizer::Sample(const Texture& tex, const RasterMaterial& mat, float u, float v, float out[4]) {
+	const int w = static_cast<int>(tex.width);
+	const int h = static_cast<int>(tex.height);
+	const int modeU = static_cast<int>(mat.wrapU);
+	const int modeV = static_cast<int>(mat.wrapV);
+
+	auto fetch = [&](int x, int y, float weight) {
+		const uint8_t* texel = &tex.rgba[(static_cast<size_t>(WrapTexel(y, h, modeV)) * w + WrapTexel(x, w, modeU)) * 4];
+		for (int c = 0; c < 4; ++c) out[c] += texel[c] * weight;
+	};
+
+	out[0] = out[1] = out[2] = out[3] = 0.0f;
+	const float scale = 1.0f / 255.0f;
+	if (!std::isfinite(u) || !std::isfinite(v)) return;
+
+	// Only the position within the wrap period matters; keep texel indices within int range
+	constexpr float UV_LIMIT = 65536.0f;
+	u = (std::max)(-UV_LIMIT, (std::min)(u, UV_LIMIT));
+	v = (std::max)(-UV_LIMIT, (std::min)(v, UV_LIMIT));
+
+	if (mat.linear) {
+		// Texel centers sit at (i + 0.5) / size
+		const float fx = u * w - 0.5f;
+		const float fy = v * h - 0.5f;
+		const float x0f = std::floor(fx);
+		const float y0f = std::floor(fy);
+		const float tx = fx - x0f;
+		const float ty = fy - y0f;
+		const int x0 = static_cast<int>(x0f);
+		const int y0 = static_cast<int>(y0f);
+		fetch(x0, y0, (1.0f - tx) * (1.0f - ty) * scale);
+		fetch(x0 + 1, y0, tx * (1.0f - ty) * scale);
+		fetch(x0, y0 + 1, (1.0f - tx) * ty * scale);
+		fetch(x0 + 1, y0 + 1, tx * ty * scale);
+	} else {
+		fetch(static_cast<int>(std::floor(u * w)), static_cast<int>(std::floor(v * h)), scale);
+	}
+}
+
+} // namespace S3D
@@ -0,0 +1,107 @@
+#pragma once
+#include "S3DStructures.h"
+#include "FSHStructures.h"
+#include "S3DRasterCoverage.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Headless CPU backend for S3D thumbnails
+// OS-independent and free of global state: each thread can own a rasterizer and render in
+// parallel. Follows the D3D11 renderer's pipeline (camera, culling, alpha test, blending,
+// depth test/writes) so both backends produce the same image for the same model.
+
+namespace S3D {
+
+class SoftwareRasterizer {
+public:
+	// Resolves a material texture ID to its parsed FSH file; nullptr if the texture is missing
+	using TextureSource = std::function<std::shared_ptr<const FSH::File>(uint32_t textureID)>;
+
+	static constexpr int TILE_SIZE = 16;
+
+	// Copy the model and decode its textures. 'textureSizeHint' picks the mip level that is
+	// sampled (0 = main level), like the D3D11 renderer's texture upload.
+	bool LoadModel(const Model& model, const TextureSource& textures, uint32_t textureSizeHint = 0);
+	void ClearModel();
+	bool HasModel() const { return m_modelLoaded; }
+
+	// Render the loaded model into 'outRGBA' (size * size RGBA8 pixels, top row first)
+	bool RenderThumbnail(int size, std::vector<uint8_t>& outRGBA, int frameIdx = 0);
+
+private:
+	enum class Wrap : uint8_t { Repeat, Clamp, Mirror };
+
+	// Same order as EnumMappings::MapAlphaFunc
+	enum class CompareFunc : uint8_t { Never, Less, Equal, LessEqual, Greater, NotEqual, GreaterEqual, Always };
+
+	enum class BlendFactor : uint8_t {
+		Zero, One, SrcColor, InvSrcColor, SrcAlpha, InvSrcAlpha,
+		DstAlpha, InvDstAlpha, DstColor, InvDstColor, SrcAlphaSat
+	};
+
+	struct Texture {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<uint8_t> rgba;
+	};
+
+	struct RasterMaterial {
+		const Texture* texture = nullptr;   // nullptr samples as transparent black, like an unbound SRV
+		Wrap wrapU = Wrap::Repeat;
+		Wrap wrapV = Wrap::Repeat;
+		bool linear = true;
+		CompareFunc alphaFunc = CompareFunc::Always;
+		float alphaThreshold = 0.5f;
+		bool blend = false;
+		BlendFactor srcBlend = BlendFactor::One;
+		BlendFactor dstBlend = BlendFactor::Zero;
+		bool depthTest = false;
+		bool depthWrite = false;
+		CompareFunc depthFunc = CompareFunc::LessEqual;
+	};
+
+	struct ScreenVertex {
+		float x, y, z;      // Pixel coordinates and [0, 1] depth
+		float r, g, b, a;
+		float u, v;
+	};
+
+	struct Triangle {
+		ScreenVertex v[3];
+		uint32_t material;
+		float minX, minY, maxX, maxY;
+
+		RasterCoverage::Edges edges;
+		float invArea;
+	};
+
+	void LoadTexture(uint32_t textureID, const TextureSource& textures, uint32_t textureSizeHint);
+	RasterMaterial BuildMaterial(const Material& mat) const;
+
+	void SetupTriangles(int size, int frameIdx);
+	void AddTriangle(uint32_t i0, uint32_t i1, uint32_t i2, uint32_t material, int size);
+	void BinTriangles(int size);
+	void RasterizeTile(int tileX, int tileY, int size);
+	void ShadePixel(const Triangle& tri, const RasterMaterial& mat, float w0, float w1, float w2,
+	                size_t pixel);
+
+	static void Sample(const Texture& tex, const RasterMaterial& mat, float u, float v, float out[4]);
+
+	Model m_model;
+	bool m_modelLoaded = false;
+
+	std::unordered_map<uint32_t, Texture> m_textures;  // textureID -> sampled level (empty if missing)
+	std::vector<RasterMaterial> m_materials;
+
+	// Per-render scratch, kept to avoid reallocating for every thumbnail
+	std::vector<ScreenVertex> m_screenVerts;   // Current vertex block, transformed
+	std::vector<Triangle> m_triangles;
+	std::vector<std::vector<uint32_t>> m_bins;  // Triangle indices per tile, in submission order
+	std::vector<uint8_t> m_color;
+	std::vector<float> m_depth;
+};
+
+} // namespace S3D
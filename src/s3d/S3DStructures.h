@@ -2,19 +2,47 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#ifdef _WIN32
 #include <SimpleMath.h>
+#endif
 
 // S3D File Format Structures
 // Based on: https://wiki.sc4devotion.com/index.php?title=S3D
 
 namespace S3D {
 
+// Vector types: DirectXTK SimpleMath on Windows, plain structs with the same layout
+// elsewhere so models can be parsed and software-rendered without DirectX
+#ifdef _WIN32
+using Vector2 = DirectX::SimpleMath::Vector2;
+using Vector3 = DirectX::SimpleMath::Vector3;
+using Vector4 = DirectX::SimpleMath::Vector4;
+#else
+struct Vector2 {
+	float x = 0, y = 0;
+	Vector2() = default;
+	Vector2(float x_, float y_) : x(x_), y(y_) {}
+};
+
+struct Vector3 {
+	float x = 0, y = 0, z = 0;
+	Vector3() = default;
+	Vector3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+};
+
+struct Vector4 {
+	float x = 0, y = 0, z = 0, w = 0;
+	Vector4() = default;
+	Vector4(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+};
+#endif
+
 // Vertex format - simplified to most common layout
 struct Vertex {
-	DirectX::SimpleMath::Vector3 position;
-	DirectX::SimpleMath::Vector4 color;      // RGBA, default to white if not present
-	DirectX::SimpleMath::Vector2 uv;         // Primary texture coordinates
-	DirectX::SimpleMath::Vector2 uv2;        // Secondary texture coordinates (if present)
+	Vector3 position;
+	Vector4 color;      // RGBA, default to white if not present
+	Vector2 uv;         // Primary texture coordinates
+	Vector2 uv2;        // Secondary texture coordinates (if present)
 };
 
 // Vertex buffer block
@@ -24,8 +52,8 @@ struct VertexBuffer {
 	uint32_t format;
 
 	// Bounding box computed from vertices
-	DirectX::SimpleMath::Vector3 bbMin;
-	DirectX::SimpleMath::Vector3 bbMax;
+	Vector3 bbMin;
+	Vector3 bbMax;
 };
 
 // Index buffer block
@@ -120,8 +148,8 @@ struct Model {
 	Animation animation;
 
 	// Overall bounding box
-	DirectX::SimpleMath::Vector3 bbMin;
-	DirectX::SimpleMath::Vector3 bbMax;
+	Vector3 bbMin;
+	Vector3 bbMax;
 
 	Model() : majorVersion(0), minorVersion(0),
 	          bbMin(0, 0, 0), bbMax(0, 0, 0) {}
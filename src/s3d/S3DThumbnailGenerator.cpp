@@ -21,6 +21,8 @@
 #include "S3DThumbnailGenerator.h"
 #include "S3DReader.h"
 #include "S3DRenderer.h"
+#include "S3DSoftwareRasterizer.h"
+#include "FSHTextureCache.h"
 #include "cGZPersistResourceKey.h"
 #include "cIGZPersistDBRecord.h"
 #include "cIGZPersistResourceManager.h"
@@ -32,6 +34,30 @@
 
 namespace S3D {
 
+std::unique_ptr<Renderer> ThumbnailGenerator::s_renderer;
+
+Renderer* ThumbnailGenerator::GetRenderer(ID3D11Device* pDevice, ID3D11DeviceContext* pContext) {
+    if (s_renderer && !s_renderer->UsesDevice(pDevice, pContext)) {
+        LOG_INFO("S3D thumbnail: D3D11 device changed, recreating renderer");
+        s_renderer.reset();
+    }
+
+    if (!s_renderer) {
+        s_renderer = std::make_unique<Renderer>(pDevice, pContext);
+        if (!s_renderer->IsInitialized()) {
+            LOG_ERROR("S3D thumbnail: Failed to initialize renderer");
+            s_renderer.reset();
+            return nullptr;
+        }
+    }
+
+    return s_renderer.get();
+}
+
+void ThumbnailGenerator::Shutdown() {
+    s_renderer.reset();
+}
+
 bool ThumbnailGenerator::GetS3DResourceKey(
     cISCPropertyHolder* pBuildingExemplar,
     uint32_t& outType,
@@ -166,18 +192,16 @@ uint32_t ThumbnailGenerator::CalculateS3DInstance(
     return baseInstance + zoomOffset + rotationOffset;
 }
 
-ID3D11ShaderResourceView* ThumbnailGenerator::GenerateThumbnailFromExemplar(
+bool ThumbnailGenerator::ReadModelRecord(
     cISCPropertyHolder* pBuildingExemplar,
     cIGZPersistResourceManager* pRM,
-    ID3D11Device* pDevice,
-    ID3D11DeviceContext* pContext,
-    int thumbnailSize,
     int zoomLevel,
-    int rotation
+    int rotation,
+    std::vector<uint8_t>& outData,
+    uint32_t& outGroup
 ) {
-    if (!pBuildingExemplar || !pRM || !pDevice || !pContext) {
-        LOG_DEBUG("S3D thumbnail: Invalid parameters");
-        return nullptr;
+    if (!pBuildingExemplar || !pRM) {
+        return false;
     }
 
     // Extract S3D resource key from building exemplar
@@ -187,7 +211,7 @@ ID3D11ShaderResourceView* ThumbnailGenerator::GenerateThumbnailFromExemplar(
 
     if (!GetS3DResourceKey(pBuildingExemplar, s3dType, s3dGroup, baseInstance)) {
         LOG_DEBUG("S3D thumbnail: No RKT property found in building exemplar");
-        return nullptr;
+        return false;
     }
 
     // Determine which RKT type was found and calculate final instance accordingly
@@ -262,47 +286,94 @@ ID3D11ShaderResourceView* ThumbnailGenerator::GenerateThumbnailFromExemplar(
     if (!pRM->OpenDBRecord(s3dKey, &pRecord, false)) {
         LOG_DEBUG("S3D thumbnail: S3D resource not found - TGI {:08X}-{:08X}-{:08X}",
                   s3dType, s3dGroup, finalInstance);
-        return nullptr;
+        return false;
     }
 
     uint32_t dataSize = pRecord->GetSize();
     if (dataSize == 0) {
         LOG_DEBUG("S3D thumbnail: S3D record has zero size");
         pRecord->Close();
-        return nullptr;
+        return false;
     }
 
     // Read S3D data
-    std::vector<uint8_t> s3dData(dataSize);
-    if (!pRecord->GetFieldVoid(s3dData.data(), dataSize)) {
+    outData.resize(dataSize);
+    if (!pRecord->GetFieldVoid(outData.data(), dataSize)) {
         LOG_DEBUG("S3D thumbnail: Failed to read S3D data");
         pRecord->Close();
-        return nullptr;
+        outData.clear();
+        return false;
     }
 
     pRecord->Close();
 
+    outGroup = s3dGroup;
+    return true;
+}
+
+bool ThumbnailGenerator::LoadModelFromExemplar(
+    cISCPropertyHolder* pBuildingExemplar,
+    cIGZPersistResourceManager* pRM,
+    int zoomLevel,
+    int rotation,
+    Model& outModel,
+    uint32_t& outGroup
+) {
+    std::vector<uint8_t> s3dData;
+    if (!ReadModelRecord(pBuildingExemplar, pRM, zoomLevel, rotation, s3dData, outGroup)) {
+        return false;
+    }
+
     // Parse S3D model
-    S3D::Model model;
-    if (!S3D::Reader::Parse(s3dData.data(), dataSize, model)) {
+    if (!S3D::Reader::Parse(s3dData.data(), s3dData.size(), outModel)) {
         LOG_DEBUG("S3D thumbnail: Failed to parse S3D model");
-        return nullptr;
+        return false;
     }
 
     LOG_TRACE("S3D thumbnail: Model parsed - {} meshes, {} frames",
-              model.animation.animatedMeshes.size(), model.animation.frameCount);
+              outModel.animation.animatedMeshes.size(), outModel.animation.frameCount);
+
+    return true;
+}
+
+ID3D11ShaderResourceView* ThumbnailGenerator::GenerateThumbnailFromExemplar(
+    cISCPropertyHolder* pBuildingExemplar,
+    cIGZPersistResourceManager* pRM,
+    ID3D11Device* pDevice,
+    ID3D11DeviceContext* pContext,
+    int thumbnailSize,
+    int zoomLevel,
+    int rotation
+) {
+    if (!pBuildingExemplar || !pRM || !pDevice || !pContext) {
+        LOG_DEBUG("S3D thumbnail: Invalid parameters");
+        return nullptr;
+    }
 
-    // Create renderer
-    S3D::Renderer renderer(pDevice, pContext);
+    S3D::Model model;
+    uint32_t s3dGroup = 0;
+    if (!LoadModelFromExemplar(pBuildingExemplar, pRM, zoomLevel, rotation, model, s3dGroup)) {
+        return nullptr;
+    }
+
+    // Reuse the shared renderer; only the model's buffers and materials are swapped
+    Renderer* renderer = GetRenderer(pDevice, pContext);
+    if (!renderer) {
+        return nullptr;
+    }
 
     // Load model into renderer
-    if (!renderer.LoadModel(model, pRM, s3dGroup)) {
+    if (!renderer->LoadModel(model, pRM, s3dGroup, static_cast<uint32_t>(thumbnailSize))) {
         LOG_DEBUG("S3D thumbnail: Failed to load model into renderer");
+        renderer->ClearModel();
         return nullptr;
     }
 
     // Generate thumbnail
-    ID3D11ShaderResourceView* thumbnailSRV = renderer.GenerateThumbnail(thumbnailSize);
+    ID3D11ShaderResourceView* thumbnailSRV = renderer->GenerateThumbnail(thumbnailSize);
+
+    // Don't hold on to this model's buffers until the next thumbnail
+    renderer->ClearModel();
 
     if (!thumbnailSRV) {
         LOG_DEBUG("S3D thumbnail: Failed to generate thumbnail texture");
@@ -314,5 +385,50 @@ ID3D11ShaderResourceView* ThumbnailGenerator::GenerateThumbnailFromExemplar(
     return thumbnailSRV;
 }
 
+bool ThumbnailGenerator::RenderThumbnailPixelsFromExemplar(
+    cISCPropertyHolder* pBuildingExemplar,
+    cIGZPersistResourceManager* pRM,
+    int thumbnailSize,
+    std::vector<uint8_t>& outRGBA,
+    int zoomLevel,
+    int rotation
+) {
+    if (!pBuildingExemplar || !pRM || thumbnailSize <= 0) {
+        LOG_DEBUG("S3D software thumbnail: Invalid parameters");
+        return false;
+    }
+
+    S3D::Model model;
+    uint32_t s3dGroup = 0;
+    if (!LoadModelFromExemplar(pBuildingExemplar, pRM, zoomLevel, rotation, model, s3dGroup)) {
+        return false;
+    }
+
+    // Same texture groups as Renderer::CreateMaterials, through the shared decoded file cache
+    const SoftwareRasterizer::TextureSource textures = [pRM, s3dGroup](uint32_t textureID) {
+        const uint32_t textureGroups[] = {s3dGroup, 0x1abe787d};
+        for (uint32_t tryGroup : textureGroups) {
+            if (auto file = FSH::TextureCache::AcquireDecoded(pRM, tryGroup, textureID)) {
+                return file;
+            }
+        }
+        return std::shared_ptr<const FSH::File>();
+    };
+
+    SoftwareRasterizer rasterizer;
+    if (!rasterizer.LoadModel(model, textures, static_cast<uint32_t>(thumbnailSize))) {
+        LOG_DEBUG("S3D software thumbnail: Failed to load model into rasterizer");
+        return false;
+    }
+
+    if (!rasterizer.RenderThumbnail(thumbnailSize, outRGBA)) {
+        LOG_DEBUG("S3D software thumbnail: Failed to rasterize thumbnail");
+        return false;
+    }
+
+    LOG_DEBUG("S3D software thumbnail: Successfully rendered {}x{} thumbnail", thumbnailSize, thumbnailSize);
+    return true;
+}
+
 } // namespace S3D
 
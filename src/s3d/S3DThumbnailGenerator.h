@@ -22,6 +22,8 @@
 
 #include <cstdint>
 #include <d3d11.h>
+#include <memory>
+#include <vector>
 
 // Forward declarations
 class cISCPropertyHolder;
@@ -29,6 +31,9 @@ class cIGZPersistResourceManager;
 
 namespace S3D {
 
+class Renderer;
+struct Model;
+
 /**
  * Utility class for generating S3D thumbnails from building exemplars.
  *
@@ -46,7 +51,8 @@ namespace S3D {
  * - RKT5: Calculated instance per zoom/rotation with state support
  *
  * Architecture:
- * - Static methods for stateless operations
+ * - Static methods; one renderer is kept alive between calls so shaders, states and
+ *   render targets are created once and only per-model resources change
  * - Handles zoom level and rotation selection for optimal thumbnail view
  * - Returns D3D11 shader resource views compatible with ImGui
  */
@@ -85,6 +91,48 @@ public:
         int rotation = 0
     );
 
+    /**
+     * Renders a thumbnail from a building exemplar's S3D model on the CPU.
+     *
+     * Uses the headless software rasterizer instead of D3D11, producing the same image as
+     * GenerateThumbnailFromExemplar. Resource reads go through the resource manager, so this
+     * must be called on the main thread; the rasterizer itself can run anywhere.
+     *
+     * @param pBuildingExemplar The building exemplar containing RKT property
+     * @param pRM Resource manager for loading S3D and FSH data
+     * @param thumbnailSize Desired thumbnail dimension (square)
+     * @param outRGBA Receives thumbnailSize * thumbnailSize RGBA8 pixels, top row first
+     * @param zoomLevel SC4 zoom level (1=farthest, 5=closest)
+     * @param rotation SC4 rotation (0-3 for S,E,N,W)
+     * @return true if the model was found and rendered
+     */
+    static bool RenderThumbnailPixelsFromExemplar(
+        cISCPropertyHolder* pBuildingExemplar,
+        cIGZPersistResourceManager* pRM,
+        int thumbnailSize,
+        std::vector<uint8_t>& outRGBA,
+        int zoomLevel = 5,
+        int rotation = 0
+    );
+
+    /**
+     * Resolves the exemplar's S3D resource for the zoom/rotation and reads its raw bytes.
+     * Touches the resource manager, so call it on the main thread; parsing the data with
+     * S3D::Reader::Parse can then happen on any thread.
+     *
+     * @param outData Receives the S3D record
+     * @param outGroup Receives the S3D resource group (first group searched for textures)
+     * @return true if the record was found and read
+     */
+    static bool ReadModelRecord(
+        cISCPropertyHolder* pBuildingExemplar,
+        cIGZPersistResourceManager* pRM,
+        int zoomLevel,
+        int rotation,
+        std::vector<uint8_t>& outData,
+        uint32_t& outGroup
+    );
+
     /**
      * Extracts S3D resource key from building exemplar's RKT properties.
      *
@@ -129,6 +177,34 @@ public:
         int zoomLevel,
         int rotation
     );
+
+    /**
+     * Releases the shared renderer and its pooled render targets.
+     * Must be called before the D3D11 device is destroyed.
+     */
+    static void Shutdown();
+
+private:
+    /**
+     * ReadModelRecord followed by S3D::Reader::Parse.
+     * @return true if the model was loaded
+     */
+    static bool LoadModelFromExemplar(
+        cISCPropertyHolder* pBuildingExemplar,
+        cIGZPersistResourceManager* pRM,
+        int zoomLevel,
+        int rotation,
+        Model& outModel,
+        uint32_t& outGroup
+    );
+
+    /**
+     * Returns the shared renderer, creating it on first use or when the device changes.
+     * @return Renderer, or nullptr if its shaders could not be created
+     */
+    static Renderer* GetRenderer(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+
+    static std::unique_ptr<Renderer> s_renderer;
 };
 
 } // namespace S3D
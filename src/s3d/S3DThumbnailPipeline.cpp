@@ -0,0 +1,286 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "S3DThumbnailPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#include "FSHReader.h"
+#include "FSHTextureCache.h"
+#include "S3DReader.h"
+#include "S3DSoftwareRasterizer.h"
+#include "S3DThumbnailGenerator.h"
+#include "../utils/Logger.h"
+
+namespace S3D {
+
+namespace {
+    // Same fallback group as Renderer::CreateMaterials
+    constexpr uint32_t kMaxisTextureGroup = 0x1abe787d;
+
+    uint64_t TextureKey(uint32_t groupID, uint32_t instanceID) {
+        return (static_cast<uint64_t>(groupID) << 32) | instanceID;
+    }
+
+    // One rasterizer per worker keeps its scratch buffers between thumbnails
+    SoftwareRasterizer& WorkerRasterizer() {
+        thread_local SoftwareRasterizer rasterizer;
+        return rasterizer;
+    }
+}
+
+struct ThumbnailPipeline::Job {
+    struct Texture {
+        uint32_t textureID = 0;
+        uint32_t groupID = 0;
+        std::vector<uint8_t> raw;                   // Read on the main thread, parsed on a worker
+        std::shared_ptr<const FSH::File> file;      // Already decoded, or parsed from 'raw'
+    };
+
+    uint32_t id = 0;
+    int size = 0;
+    uint32_t generation = 0;
+    uint32_t s3dGroup = 0;
+
+    std::vector<uint8_t> s3dData;
+    Model model;
+    std::vector<uint32_t> textureIDs;
+    std::vector<Texture> textures;
+
+    std::vector<uint8_t> rgba;
+    bool rendered = false;
+};
+
+ThumbnailPipeline::ThumbnailPipeline(unsigned workerCount)
+    : finished(RESULT_QUEUE_CAPACITY)
+    , workers(workerCount)
+{
+    LOG_INFO("S3D thumbnail pipeline: {} worker threads", workers.GetThreadCount());
+}
+
+ThumbnailPipeline::~ThumbnailPipeline() {
+    // Release workers blocked on a full queue so the pool can join them
+    ++generation;
+    workers.CancelPending();
+    finished.Close();
+}
+
+bool ThumbnailPipeline::Submit(
+    uint32_t id,
+    cISCPropertyHolder* pBuildingExemplar,
+    cIGZPersistResourceManager* pRM,
+    int thumbnailSize,
+    int zoomLevel,
+    int rotation
+) {
+    if (!pBuildingExemplar || !pRM || thumbnailSize <= 0) {
+        return false;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->id = id;
+    job->size = thumbnailSize;
+    job->generation = generation;
+
+    if (!ThumbnailGenerator::ReadModelRecord(pBuildingExemplar, pRM, zoomLevel, rotation, job->s3dData, job->s3dGroup)) {
+        return false;
+    }
+
+    ++pending;
+    workers.Submit([this, job] { ParseModel(job); }, [this, job] { FailJob(job); });
+    return true;
+}
+
+void ThumbnailPipeline::ParseModel(const std::shared_ptr<Job>& job) {
+    if (job->generation != generation) return;
+
+    const bool parsedOk = Reader::Parse(job->s3dData.data(), job->s3dData.size(), job->model);
+    job->s3dData = std::vector<uint8_t>();
+
+    if (!parsedOk) {
+        LOG_DEBUG("S3D pipeline: Failed to parse S3D model for request 0x{:08X}", job->id);
+        finished.Push(job); // Reported as a failed thumbnail
+        return;
+    }
+
+    // Only the first texture of a textured material is sampled, as in the D3D11 renderer
+    for (const auto& mat : job->model.materials) {
+        if (!(mat.flags & MAT_TEXTURE) || mat.textures.empty()) continue;
+        const uint32_t textureID = mat.textures[0].textureID;
+        if (std::find(job->textureIDs.begin(), job->textureIDs.end(), textureID) == job->textureIDs.end()) {
+            job->textureIDs.push_back(textureID);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(parsedMutex);
+    parsed.push_back(job);
+}
+
+void ThumbnailPipeline::ReadTextures(Job& job, cIGZPersistResourceManager* pRM) {
+    const uint32_t textureGroups[] = {job.s3dGroup, kMaxisTextureGroup};
+
+    job.textures.reserve(job.textureIDs.size());
+    for (uint32_t textureID : job.textureIDs) {
+        Job::Texture texture;
+        texture.textureID = textureID;
+
+        // Shared textures are usually decoded already; only read what isn't
+        for (uint32_t tryGroup : textureGroups) {
+            if ((texture.file = FSH::TextureCache::FindDecoded(tryGroup, textureID))) {
+                texture.groupID = tryGroup;
+                break;
+            }
+        }
+
+        for (uint32_t tryGroup : textureGroups) {
+            if (texture.file) break;
+
+            // A failed read already searched every group, so don't repeat it for other models
+            const uint64_t key = TextureKey(tryGroup, textureID);
+            if (missingTextures.count(key)) continue;
+
+            if (FSH::Reader::ReadRecordFromResourceManager(pRM, tryGroup, textureID, texture.raw)) {
+                texture.groupID = tryGroup;
+                break;
+            }
+            missingTextures.insert(key);
+        }
+
+        job.textures.push_back(std::move(texture));
+    }
+}
+
+void ThumbnailPipeline::RenderJob(const std::shared_ptr<Job>& job) {
+    if (job->generation != generation) return;
+
+    for (auto& texture : job->textures) {
+        if (texture.file || texture.raw.empty()) continue;
+
+        auto file = std::make_shared<FSH::File>();
+        if (FSH::Reader::Parse(texture.raw.data(), texture.raw.size(), *file)) {
+            texture.file = FSH::TextureCache::StoreDecoded(texture.groupID, texture.textureID, std::move(file));
+        } else {
+            LOG_DEBUG("S3D pipeline: Failed to parse FSH texture 0x{:08X}", texture.textureID);
+        }
+        texture.raw = std::vector<uint8_t>();
+    }
+
+    const SoftwareRasterizer::TextureSource source = [&job](uint32_t textureID) {
+        for (const auto& texture : job->textures) {
+            if (texture.textureID == textureID) return texture.file;
+        }
+        return std::shared_ptr<const FSH::File>();
+    };
+
+    SoftwareRasterizer& rasterizer = WorkerRasterizer();
+    if (rasterizer.LoadModel(job->model, source, static_cast<uint32_t>(job->size))) {
+        job->rendered = rasterizer.RenderThumbnail(job->size, job->rgba);
+    }
+    rasterizer.ClearModel();
+
+    job->model = Model();
+    job->textures.clear();
+
+    if (job->generation == generation) {
+        finished.Push(job);
+    }
+}
+
+void ThumbnailPipeline::FailJob(const std::shared_ptr<Job>& job) {
+    LOG_WARN("S3D pipeline: Thumbnail request 0x{:08X} failed", job->id);
+    WorkerRasterizer().ClearModel();
+
+    job->s3dData = std::vector<uint8_t>();
+    job->model = Model();
+    job->textures.clear();
+    job->rgba = std::vector<uint8_t>();
+    job->rendered = false;
+
+    if (job->generation == generation) {
+        finished.Push(job);
+    }
+}
+
+void ThumbnailPipeline::Pump(
+    cIGZPersistResourceManager* pRM,
+    int maxItems,
+    std::vector<Result>& outResults
+) {
+    if (pending == 0) return;
+
+    // Stage 3: texture reads for parsed models
+    for (int reads = 0; reads < maxItems && pRM; ) {
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lock(parsedMutex);
+            if (parsed.empty()) break;
+            job = std::move(parsed.front());
+            parsed.pop_front();
+        }
+        if (job->generation != generation) continue;
+
+        ReadTextures(*job, pRM);
+        workers.Submit([this, job] { RenderJob(job); }, [this, job] { FailJob(job); });
+        ++reads;
+    }
+
+    // Stage 5: hand back finished thumbnails
+    std::shared_ptr<Job> job;
+    for (int returned = 0; returned < maxItems && finished.TryPop(job); ) {
+        if (job->generation != generation) continue;
+
+        --pending;
+        Result result{job->id, {}, job->size};
+        if (job->rendered) {
+            result.rgba = std::move(job->rgba);
+        }
+        outResults.push_back(std::move(result));
+        ++returned;
+    }
+}
+
+void ThumbnailPipeline::Drain(cIGZPersistResourceManager* pRM, std::vector<Result>& outResults) {
+    while (pending > 0) {
+        const size_t before = pending;
+        Pump(pRM, INT_MAX, outResults);
+        if (pending == before) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void ThumbnailPipeline::Cancel() {
+    if (pending == 0) return;
+
+    LOG_DEBUG("S3D pipeline: Cancelling {} pending thumbnails", pending);
+    ++generation;
+    workers.CancelPending();
+    {
+        std::lock_guard<std::mutex> lock(parsedMutex);
+        parsed.clear();
+    }
+    finished.Clear();
+    pending = 0;
+}
+
+} // namespace S3D
@@ -0,0 +1,128 @@
+/*
+ * This file is part of sc4-imgui-advanced-lotplop, a DLL Plugin for
+ * SimCity 4 that offers some extra terrain utilities.
+ *
+ * Copyright (C) 2025 Casper Van Gheluwe
+ *
+ * sc4-imgui-advanced-lotplop is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * sc4-imgui-advanced-lotplop is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with sc4-imgui-advanced-lotplop.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "../utils/BoundedQueue.h"
+#include "../utils/WorkerPool.h"
+
+// Forward declarations
+class cISCPropertyHolder;
+class cIGZPersistResourceManager;
+
+namespace S3D {
+
+/**
+ * Staged S3D thumbnail generation for cache builds.
+ *
+ * Only the steps that need game state run on the main thread:
+ * 1. Submit (main): resolve the RKT property and read the S3D record
+ * 2. Worker: parse the S3D model and list the textures it uses
+ * 3. Pump (main): read the raw FSH records that aren't decoded yet
+ * 4. Worker: QFS-decompress and parse the FSH files, rasterize the model on the CPU
+ * 5. Pump (main): hand the finished RGBA8 thumbnails back for upload
+ *
+ * Finished thumbnails wait in a bounded queue, so workers stall instead of
+ * outrunning the caller. Use from a single (main) thread.
+ */
+class ThumbnailPipeline {
+public:
+    struct Result {
+        uint32_t id;                        // Caller-chosen request ID
+        std::vector<uint8_t> rgba;          // size x size RGBA8; empty if no thumbnail could be made
+        int size;
+    };
+
+    static constexpr size_t RESULT_QUEUE_CAPACITY = 32;
+
+    explicit ThumbnailPipeline(unsigned workerCount = 0);
+    ~ThumbnailPipeline();
+
+    ThumbnailPipeline(const ThumbnailPipeline&) = delete;
+    ThumbnailPipeline& operator=(const ThumbnailPipeline&) = delete;
+
+    /**
+     * Reads the exemplar's S3D record and queues it for rendering.
+     * @return false if the exemplar has no readable model (no Result will be produced)
+     */
+    bool Submit(
+        uint32_t id,
+        cISCPropertyHolder* pBuildingExemplar,
+        cIGZPersistResourceManager* pRM,
+        int thumbnailSize,
+        int zoomLevel = 5,
+        int rotation = 0
+    );
+
+    /**
+     * Advances the main-thread stages (call once per frame).
+     * @param maxItems Cap on texture reads and on results returned in this call
+     * @param outResults Receives the thumbnails finished in this call
+     */
+    void Pump(
+        cIGZPersistResourceManager* pRM,
+        int maxItems,
+        std::vector<Result>& outResults
+    );
+
+    /**
+     * Pumps until every submitted request has a Result (for blocking builds).
+     */
+    void Drain(cIGZPersistResourceManager* pRM, std::vector<Result>& outResults);
+
+    /**
+     * Abandons all outstanding requests; none of them will produce a Result.
+     */
+    void Cancel();
+
+    // Requests submitted but not yet returned by Pump
+    size_t GetPendingCount() const { return pending; }
+    bool IsIdle() const { return pending == 0; }
+
+private:
+    struct Job;
+
+    void ParseModel(const std::shared_ptr<Job>& job);
+    void RenderJob(const std::shared_ptr<Job>& job);
+    // A stage threw: hand the job back as a failed thumbnail so it is still counted off
+    void FailJob(const std::shared_ptr<Job>& job);
+    void ReadTextures(Job& job, cIGZPersistResourceManager* pRM);
+
+    // Declared before the pool so workers are joined before the queues go away
+    std::mutex parsedMutex;
+    std::deque<std::shared_ptr<Job>> parsed;            // Waiting for their FSH reads
+    BoundedQueue<std::shared_ptr<Job>> finished;        // Waiting to be handed back
+    std::atomic<uint32_t> generation{0};                // Bumped by Cancel to disown running jobs
+    size_t pending = 0;                                 // Main thread only
+    std::unordered_set<uint64_t> missingTextures;       // (group << 32 | instance) not found; main thread only
+
+    WorkerPool workers;
+};
+
+} // namespace S3D
@@ -0,0 +1,52 @@
+#pragma once
+#include "S3DStructures.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// GPU vertex layout for S3D models
+// S3D::Vertex keeps float colours and both UV sets for the parser and the software
+// rasterizer; the D3D11 renderer only needs position, an 8-bit colour and the first
+// UV set. OS-independent, so the conversion can be checked without DirectX.
+
+namespace S3D {
+
+// Matches the renderer's input layout:
+// POSITION R32G32B32_FLOAT @0, COLOR R8G8B8A8_UNORM @12, TEXCOORD0 R32G32_FLOAT @16
+struct PackedVertex {
+	float position[3];
+	uint8_t color[4];   // RGBA
+	float uv[2];
+};
+static_assert(sizeof(PackedVertex) == 24, "PackedVertex must match the D3D11 input layout");
+
+// Float [0, 1] -> UNORM8. S3D colours come from 8-bit BGRA, so this round-trips exactly.
+inline uint8_t PackUnorm8(float value) {
+	if (!(value > 0.0f)) return 0;      // Also catches NaN
+	if (value >= 1.0f) return 255;
+	return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+inline PackedVertex PackVertex(const Vertex& v) {
+	PackedVertex out;
+	out.position[0] = v.position.x;
+	out.position[1] = v.position.y;
+	out.position[2] = v.position.z;
+	out.color[0] = PackUnorm8(v.color.x);
+	out.color[1] = PackUnorm8(v.color.y);
+	out.color[2] = PackUnorm8(v.color.z);
+	out.color[3] = PackUnorm8(v.color.w);
+	out.uv[0] = v.uv.x;
+	out.uv[1] = v.uv.y;
+	return out;
+}
+
+// Converts a parsed vertex block for upload (reuses outPacked's storage)
+inline void PackVertices(const std::vector<Vertex>& vertices, std::vector<PackedVertex>& outPacked) {
+	outPacked.resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		outPacked[i] = PackVertex(vertices[i]);
+	}
+}
+
+} // namespace S3D
@@ -0,0 +1,31 @@
+// S3D vertex shader (vs_4_0)
+
+cbuffer Constants : register(b0)
+{
+    matrix viewProj;
+};
+
+struct VS_INPUT
+{
+    float3 position : POSITION;
+    float4 color : COLOR;       // R8G8B8A8_UNORM, expanded to [0, 1] by the input assembler
+    float2 uv : TEXCOORD0;
+};
+
+struct PS_INPUT
+{
+    float4 position : SV_POSITION;
+    float4 color : COLOR;
+    float2 uv : TEXCOORD0;
+};
+
+PS_INPUT main(VS_INPUT input)
+{
+    PS_INPUT output;
+    // Use column-vector multiplication (standard for DirectX)
+    output.position = mul(viewProj, float4(input.position, 1.0));
+    output.color = input.color;
+    // Pass UVs through as-is
+    output.uv = input.uv;
+    return output;
+}
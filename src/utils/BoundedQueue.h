@@ -0,0 +1,71 @@
+/*
+ * Fixed-capacity FIFO for handing work between threads.
+ * Producers block while the queue is full, so a slow consumer (the frame callback)
+ * throttles the workers instead of letting finished payloads pile up in memory.
+ */
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    // Blocks until there is room. Returns false (dropping the item) once the queue is closed.
+    bool Push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        return true;
+    }
+
+    // Never blocks; returns false if the queue is empty
+    bool TryPop(T& out) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (items.empty()) return false;
+            out = std::move(items.front());
+            items.pop_front();
+        }
+        notFull.notify_one();
+        return true;
+    }
+
+    // Drop everything queued and wake blocked producers
+    void Clear() {
+        std::deque<T> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dropped.swap(items);
+        }
+        notFull.notify_all();
+    }
+
+    // Reject all further pushes and release blocked producers (used on shutdown)
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            items.clear();
+        }
+        notFull.notify_all();
+    }
+
+    size_t Size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    size_t Capacity() const { return capacity; }
+
+private:
+    const size_t capacity;
+    std::deque<T> items;
+    mutable std::mutex mutex;
+    std::condition_variable notFull;
+    bool closed = false;
+};
@@ -26,7 +26,7 @@ namespace Config {
         return s.substr(a, b - a + 1);
     }
 
-    static std::string GetModuleDir() {
+    std::string GetModuleDir() {
         char path[MAX_PATH] = {0};
         HMODULE hMod = nullptr;
         if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
@@ -52,6 +52,27 @@ namespace Config {
         return static_cast<uint32_t>(strtoul(t.c_str(), nullptr, 10));
     }
 
+    // Comma-separated IDs ("0x1500,0x1501"); zeros are skipped
+    static std::vector<uint32_t> ParseIDList(const std::string& csv) {
+        std::vector<uint32_t> ids;
+        std::istringstream iss(csv);
+        std::string tok;
+        while (std::getline(iss, tok, ',')) {
+            uint32_t id = ParseUInt(tok);
+            if (id) ids.push_back(id);
+        }
+        return ids;
+    }
+
+    static std::string FormatIDList(const std::vector<uint32_t>& ids) {
+        std::ostringstream oss;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i) oss << ",";
+            oss << "0x" << std::hex << std::uppercase << ids[i] << std::dec;
+        }
+        return oss.str();
+    }
+
     static void LoadInternal() {
         // Try to load SC4AdvancedLotPlop.ini next to the DLL
         std::string iniPath = GetModuleDir() + "\\SC4AdvancedLotPlop.ini";
@@ -92,16 +113,9 @@ namespace Config {
                 if (uiSec.has("MaxSizeZ")) st.maxSizeZ = ParseUInt(uiSec["MaxSizeZ"]);
                 if (uiSec.has("Search")) st.search = uiSec["Search"];
                 if (uiSec.has("SelectedLot")) st.selectedLotID = ParseUInt(uiSec["SelectedLot"]);
-                if (uiSec.has("SelectedGroups")) {
-                    st.selectedGroups.clear();
-                    std::string csv = uiSec["SelectedGroups"];
-                    std::istringstream iss(csv);
-                    std::string tok;
-                    while (std::getline(iss, tok, ',')) {
-                        uint32_t id = ParseUInt(tok);
-                        if (id) st.selectedGroups.push_back(id);
-                    }
-                }
+                if (uiSec.has("SelectedGroups")) st.selectedGroups = ParseIDList(uiSec["SelectedGroups"]);
+                if (uiSec.has("RequiredGroups")) st.requiredGroups = ParseIDList(uiSec["RequiredGroups"]);
+                if (uiSec.has("ExcludedGroups")) st.excludedGroups = ParseIDList(uiSec["ExcludedGroups"]);
                 if (uiSec.has("Favorites")) {
                     st.favorites.clear();
                     std::string csv = uiSec["Favorites"];
@@ -160,12 +174,9 @@ namespace Config {
         uiSec["MaxSizeZ"] = std::to_string(state.maxSizeZ);
         uiSec["Search"] = state.search;
         uiSec["SelectedLot"] = std::to_string(state.selectedLotID);
-        std::ostringstream oss;
-        for (size_t i=0;i<state.selectedGroups.size();++i){
-            if(i) oss << ",";
-            oss << "0x" << std::hex << std::uppercase << state.selectedGroups[i] << std::dec;
-        }
-        uiSec["SelectedGroups"] = oss.str();
+        uiSec["SelectedGroups"] = FormatIDList(state.selectedGroups);
+        uiSec["RequiredGroups"] = FormatIDList(state.requiredGroups);
+        uiSec["ExcludedGroups"] = FormatIDList(state.excludedGroups);
         std::ostringstream favoss; for (size_t i=0;i<state.favorites.size();++i){ if(i) favoss << ","; favoss << "0x" << std::hex << std::uppercase << state.favorites[i] << std::dec; }
         uiSec["Favorites"] = favoss.str();
         uiSec["FavoritesOnly"] = state.favoritesOnly ? "1" : "0";
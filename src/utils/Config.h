@@ -21,7 +21,9 @@ namespace Config {
         uint32_t minSizeX = 1, maxSizeX = 16;
         uint32_t minSizeZ = 1, maxSizeZ = 16;
         std::string search; // raw search buffer
-        std::vector<uint32_t> selectedGroups; // occupant groups selected in filter
+        std::vector<uint32_t> selectedGroups; // occupant group filter: any of these
+        std::vector<uint32_t> requiredGroups; // occupant group filter: all of these
+        std::vector<uint32_t> excludedGroups; // occupant group filter: none of these
         uint32_t selectedLotID = 0; // last selected lot
         std::vector<uint32_t> favorites; // persisted favorite lot IDs
         bool favoritesOnly = false; // show only favorites filter
@@ -0,0 +1,89 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "Logger.h"
+
+namespace {
+    constexpr unsigned kMaxThreads = 8;
+
+    // An exception escaping a worker thread would terminate the game
+    bool RunGuarded(const WorkerPool::Task& task, const char* what) {
+        try {
+            task();
+            return true;
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR("Worker pool: {} threw: {}", what, e.what());
+        }
+        catch (...) {
+            LOG_ERROR("Worker pool: {} threw an unknown exception", what);
+        }
+        return false;
+    }
+}
+
+WorkerPool::WorkerPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        const unsigned cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+    threadCount = std::clamp(threadCount, 1u, kMaxThreads);
+
+    threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+    LOG_DEBUG("Worker pool started with {} threads", threadCount);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        tasks.clear();
+    }
+    wake.notify_all();
+
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkerPool::Submit(Task task, Task onFailure) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) return;
+        tasks.push_back({std::move(task), std::move(onFailure)});
+    }
+    wake.notify_one();
+}
+
+size_t WorkerPool::CancelPending() {
+    std::deque<QueuedTask> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dropped.swap(tasks);
+    }
+    // Destroy the tasks (and whatever they captured) outside the lock
+    return dropped.size();
+}
+
+void WorkerPool::WorkerLoop() {
+    for (;;) {
+        QueuedTask task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        if (!RunGuarded(task.run, "task") && task.onFailure) {
+            RunGuarded(task.onFailure, "failure handler");
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * Fixed-size thread pool for background work that must stay off the Present hook
+ * (parsing, decompression, software rendering). Tasks never touch game or D3D11 state;
+ * results are handed back to the main thread through a BoundedQueue.
+ */
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    // 0 picks one thread per core, leaving one core for the game
+    explicit WorkerPool(unsigned threadCount = 0);
+
+    // Drops tasks that haven't started and joins the threads
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // onFailure runs on the worker if task throws, so whoever waits for the task's result can
+    // still count it off; the exception itself is logged and dropped
+    void Submit(Task task, Task onFailure = nullptr);
+
+    // Drop queued tasks; tasks already running finish normally. Returns the number dropped.
+    size_t CancelPending();
+
+    size_t GetThreadCount() const { return threads.size(); }
+
+private:
+    struct QueuedTask {
+        Task run;
+        Task onFailure;
+    };
+
+    void WorkerLoop();
+
+    std::vector<std::thread> threads;
+    std::deque<QueuedTask> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
@@ -0,0 +1,46 @@
+/*
+ * Timing helpers for the benchmark executables. Each benchmark reports the median time of
+ * several runs; "--quick" cuts the repetitions so ctest can run them as smoke tests.
+ */
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace BenchHarness {
+    inline bool IsQuick(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--quick") == 0) return true;
+        }
+        return false;
+    }
+
+    inline volatile size_t g_sink;
+
+    // Keeps a result alive so the measured work isn't optimised away
+    inline void DoNotOptimize(size_t value) {
+        g_sink = value;
+    }
+
+    /**
+     * Runs fn (which does `iterations` units of work) `repetitions` times and prints the
+     * median time per unit. Returns that time in nanoseconds.
+     */
+    template <typename Fn>
+    double Measure(const char* name, size_t iterations, int repetitions, Fn&& fn) {
+        std::vector<double> samples;
+        samples.reserve(repetitions);
+        for (int rep = 0; rep < repetitions; ++rep) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+        const double median = samples[samples.size() / 2];
+        std::printf("%-48s %12.1f ns/op\n", name, median);
+        return median;
+    }
+} // namespace BenchHarness
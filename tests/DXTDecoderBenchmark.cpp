@@ -0,0 +1,43 @@
+// Throughput of the BC1/BC2 decoder (s3d/FSHDXTDecoder.cpp) on full mip levels
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "s3d/FSHDXTDecoder.h"
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 9;
+
+    std::mt19937 rng(0xB1);
+    for (uint32_t dim : {64u, 256u, 1024u}) {
+        const size_t pixels = static_cast<size_t>(dim) * dim;
+        std::vector<uint8_t> bc1(FSH::DXT::GetBC1Size(dim, dim));
+        std::vector<uint8_t> bc2(FSH::DXT::GetBC2Size(dim, dim));
+        for (uint8_t& b : bc1) b = static_cast<uint8_t>(rng());
+        for (uint8_t& b : bc2) b = static_cast<uint8_t>(rng());
+        std::vector<uint8_t> rgba(pixels * 4);
+
+        const size_t images = quick ? 1 : (16u * 1024 * 1024) / pixels + 1;
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "BC1 %ux%u (per pixel)", dim, dim);
+        BenchHarness::Measure(name, images * pixels, repetitions, [&] {
+            for (size_t i = 0; i < images; ++i) {
+                FSH::DXT::DecodeBC1(bc1.data(), bc1.size(), dim, dim, rgba.data());
+                BenchHarness::DoNotOptimize(rgba[i % rgba.size()]);
+            }
+        });
+
+        std::snprintf(name, sizeof(name), "BC2 %ux%u (per pixel)", dim, dim);
+        BenchHarness::Measure(name, images * pixels, repetitions, [&] {
+            for (size_t i = 0; i < images; ++i) {
+                FSH::DXT::DecodeBC2(bc2.data(), bc2.size(), dim, dim, rgba.data());
+                BenchHarness::DoNotOptimize(rgba[i % rgba.size()]);
+            }
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Golden-image and reference tests for the BC1/BC2 decoder (s3d/FSHDXTDecoder.cpp)
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+#include "s3d/FSHDXTDecoder.h"
+
+namespace {
+    using Bytes = std::vector<uint8_t>;
+
+    struct RGBA {
+        uint8_t r, g, b, a;
+        bool operator==(const RGBA&) const = default;
+    };
+
+    RGBA Expand565(uint16_t c) {
+        const uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        return {static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+                static_cast<uint8_t>((b << 3) | (b >> 2)), 255};
+    }
+
+    // Texel-by-texel decode straight from the BC1/BC2 format description
+    void ReferenceDecodeBlock(const uint8_t* block, bool isBC2, RGBA out[16]) {
+        const uint8_t* color = isBC2 ? block + 8 : block;
+        const uint16_t c0 = static_cast<uint16_t>(color[0] | (color[1] << 8));
+        const uint16_t c1 = static_cast<uint16_t>(color[2] | (color[3] << 8));
+        const RGBA e0 = Expand565(c0), e1 = Expand565(c1);
+
+        RGBA palette[4] = {e0, e1, {}, {}};
+        auto mix = [](uint8_t a, uint8_t b, int wa, int wb, int d) {
+            return static_cast<uint8_t>((wa * a + wb * b) / d);
+        };
+        if (c0 > c1 || isBC2) {
+            palette[2] = {mix(e0.r, e1.r, 2, 1, 3), mix(e0.g, e1.g, 2, 1, 3), mix(e0.b, e1.b, 2, 1, 3), 255};
+            palette[3] = {mix(e0.r, e1.r, 1, 2, 3), mix(e0.g, e1.g, 1, 2, 3), mix(e0.b, e1.b, 1, 2, 3), 255};
+        } else {
+            palette[2] = {mix(e0.r, e1.r, 1, 1, 2), mix(e0.g, e1.g, 1, 1, 2), mix(e0.b, e1.b, 1, 1, 2), 255};
+            palette[3] = {0, 0, 0, 0};
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            out[i] = palette[(color[4 + i / 4] >> ((i % 4) * 2)) & 0x3];
+            if (isBC2) {
+                const uint8_t nibble = (block[i / 2] >> ((i % 2) * 4)) & 0xF;
+                out[i].a = static_cast<uint8_t>(nibble * 17);
+            }
+        }
+    }
+
+    RGBA PixelAt(const Bytes& rgba, uint32_t width, uint32_t x, uint32_t y) {
+        const uint8_t* p = rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+        return {p[0], p[1], p[2], p[3]};
+    }
+
+    Bytes RandomBytes(size_t size, uint32_t seed) {
+        std::mt19937 rng(seed);
+        Bytes bytes(size);
+        for (uint8_t& b : bytes) b = static_cast<uint8_t>(rng());
+        return bytes;
+    }
+
+    bool MatchesReference(const Bytes& blocks, bool isBC2, uint32_t width, uint32_t height, const Bytes& rgba) {
+        const size_t blockBytes = isBC2 ? 16 : 8;
+        const uint32_t blocksX = (width + 3) / 4;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                RGBA expected[16];
+                ReferenceDecodeBlock(blocks.data() + ((y / 4) * blocksX + x / 4) * blockBytes, isBC2, expected);
+                if (!(PixelAt(rgba, width, x, y) == expected[(y % 4) * 4 + x % 4])) return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE(BC1GoldenFourColorBlock) {
+    // c0 = pure red (0xF800) > c1 = pure blue (0x001F): 4-color mode
+    // Rows use indices 0,1,2,3 / 3,2,1,0 / all 2 / all 3
+    const uint8_t block[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x1B, 0xAA, 0xFF};
+    uint8_t rgba[64];
+    FSH::DXT::DecodeBC1Block(block, rgba);
+
+    const RGBA red{255, 0, 0, 255}, blue{0, 0, 255, 255}, twoThirdsRed{170, 0, 85, 255}, oneThirdRed{85, 0, 170, 255};
+    const RGBA expected[16] = {
+        red, blue, twoThirdsRed, oneThirdRed,
+        oneThirdRed, twoThirdsRed, blue, red,
+        twoThirdsRed, twoThirdsRed, twoThirdsRed, twoThirdsRed,
+        oneThirdRed, oneThirdRed, oneThirdRed, oneThirdRed,
+    };
+    for (int i = 0; i < 16; ++i) {
+        CHECK((RGBA{rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2], rgba[i * 4 + 3]} == expected[i]));
+    }
+}
+
+TEST_CASE(BC1GoldenPunchThroughBlock) {
+    // c0 = green (0x07E0) <= c1 = white (0xFFFF): 3-color mode, index 3 is transparent black
+    const uint8_t block[8] = {0xE0, 0x07, 0xFF, 0xFF, 0xE4, 0xE4, 0xE4, 0xE4};
+    uint8_t rgba[64];
+    FSH::DXT::DecodeBC1Block(block, rgba);
+
+    const RGBA expected[4] = {{0, 255, 0, 255}, {255, 255, 255, 255}, {127, 255, 127, 255}, {0, 0, 0, 0}};
+    for (int i = 0; i < 16; ++i) {
+        CHECK((RGBA{rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2], rgba[i * 4 + 3]} == expected[i % 4]));
+    }
+}
+
+TEST_CASE(BC2GoldenExplicitAlpha) {
+    // Alpha nibbles 0..15 in texel order; the color block uses the 4-color mode even though c0 < c1
+    uint8_t block[16] = {0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE,
+                         0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t rgba[64];
+    FSH::DXT::DecodeBC2Block(block, rgba);
+
+    for (int i = 0; i < 16; ++i) {
+        CHECK_EQ(rgba[i * 4 + 3], static_cast<uint8_t>(i * 17));
+        // Index 3 = (c0 + 2 * c1) / 3 with c0 blue and c1 red
+        CHECK((RGBA{rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2], 0} == RGBA{170, 0, 85, 0}));
+    }
+}
+
+TEST_CASE(RandomBlocksMatchReference) {
+    // Every 565 endpoint pair shape (equal, ascending, descending) shows up many times
+    const Bytes bc1 = RandomBytes(8 * 4096, 0xD71);
+    const Bytes bc2 = RandomBytes(16 * 4096, 0xD73);
+    for (size_t i = 0; i < 4096; ++i) {
+        uint8_t actual[64];
+        RGBA expected[16];
+
+        FSH::DXT::DecodeBC1Block(bc1.data() + i * 8, actual);
+        ReferenceDecodeBlock(bc1.data() + i * 8, false, expected);
+        for (int p = 0; p < 16; ++p) {
+            CHECK((RGBA{actual[p * 4], actual[p * 4 + 1], actual[p * 4 + 2], actual[p * 4 + 3]} == expected[p]));
+        }
+
+        FSH::DXT::DecodeBC2Block(bc2.data() + i * 16, actual);
+        ReferenceDecodeBlock(bc2.data() + i * 16, true, expected);
+        for (int p = 0; p < 16; ++p) {
+            CHECK((RGBA{actual[p * 4], actual[p * 4 + 1], actual[p * 4 + 2], actual[p * 4 + 3]} == expected[p]));
+        }
+    }
+}
+
+TEST_CASE(AllEndpointExpansionsMatchReference) {
+    // Each 565 value as c0 with a fixed c1, so every 5- and 6-bit expansion is covered
+    for (uint32_t c = 0; c <= 0xFFFF; ++c) {
+        const uint8_t block[8] = {static_cast<uint8_t>(c), static_cast<uint8_t>(c >> 8), 0x55, 0xAD, 0xE4, 0x1B, 0x4E, 0xB1};
+        uint8_t actual[64];
+        RGBA expected[16];
+        FSH::DXT::DecodeBC1Block(block, actual);
+        ReferenceDecodeBlock(block, false, expected);
+        bool same = true;
+        for (int p = 0; p < 16; ++p) {
+            same = same && RGBA{actual[p * 4], actual[p * 4 + 1], actual[p * 4 + 2], actual[p * 4 + 3]} == expected[p];
+        }
+        CHECK(same);
+    }
+}
+
+TEST_CASE(ImagesWithPartialBlocksMatchReference) {
+    const uint32_t sizes[][2] = {{1, 1}, {3, 5}, {4, 4}, {7, 9}, {64, 64}, {130, 66}, {256, 3}};
+    for (const auto& size : sizes) {
+        const uint32_t width = size[0], height = size[1];
+        for (bool isBC2 : {false, true}) {
+            const size_t blockSize = isBC2 ? FSH::DXT::GetBC2Size(width, height) : FSH::DXT::GetBC1Size(width, height);
+            const Bytes blocks = RandomBytes(blockSize, width * 31 + height);
+
+            // A canary after the image catches writes past the last row
+            Bytes rgba(static_cast<size_t>(width) * height * 4 + 16, 0xCD);
+            const bool ok = isBC2
+                ? FSH::DXT::DecodeBC2(blocks.data(), blocks.size(), width, height, rgba.data())
+                : FSH::DXT::DecodeBC1(blocks.data(), blocks.size(), width, height, rgba.data());
+            CHECK(ok);
+            CHECK(MatchesReference(blocks, isBC2, width, height, rgba));
+            for (size_t i = rgba.size() - 16; i < rgba.size(); ++i) CHECK_EQ(rgba[i], 0xCD);
+        }
+    }
+}
+
+TEST_CASE(RejectsTruncatedInput) {
+    CHECK_EQ(FSH::DXT::GetBC1Size(5, 5), size_t(32));
+    CHECK_EQ(FSH::DXT::GetBC2Size(5, 5), size_t(64));
+
+    const Bytes blocks(64, 0);
+    Bytes rgba(5 * 5 * 4);
+    CHECK(!FSH::DXT::DecodeBC1(blocks.data(), 31, 5, 5, rgba.data()));
+    CHECK(!FSH::DXT::DecodeBC2(blocks.data(), 63, 5, 5, rgba.data()));
+    CHECK(!FSH::DXT::DecodeBC1(nullptr, 32, 5, 5, rgba.data()));
+    CHECK(!FSH::DXT::DecodeBC1(blocks.data(), 32, 0, 5, rgba.data()));
+    CHECK(FSH::DXT::DecodeBC1(blocks.data(), 32, 5, 5, rgba.data()));
+}
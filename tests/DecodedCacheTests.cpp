@@ -0,0 +1,270 @@
+// Tests for the byte-budgeted LRU cache (s3d/LRUCache.h) and the decoded FSH file cache built
+// on it (s3d/FSHDecodedCache.cpp): eviction order, the byte budget, negative entries, and
+// loads that race a Clear() or throw
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "TestHarness.h"
+#include "s3d/FSHDecodedCache.h"
+#include "s3d/LRUCache.h"
+
+namespace {
+    using namespace std::chrono_literals;
+    using Cache = LRUCache<int, std::string>;
+
+    // Loader producing a file with 'bitmaps' bitmaps of 'bytes' bytes each
+    FSH::DecodedFileCache::Loader MakeLoader(std::atomic<int>& calls, size_t bytes, size_t bitmaps = 1) {
+        return [&calls, bytes, bitmaps](FSH::File& file) {
+            ++calls;
+            file.bitmaps.resize(bitmaps);
+            for (auto& bitmap : file.bitmaps) {
+                bitmap.code = FSH::CODE_32BIT;
+                bitmap.width = 4;
+                bitmap.height = 4;
+                bitmap.data.assign(bytes, 0xAB);
+            }
+            return true;
+        };
+    }
+
+    // Spin until another thread has registered itself (bounded, so a bug fails instead of hanging)
+    bool WaitFor(const std::atomic<bool>& flag) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!flag && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(1ms);
+        return flag;
+    }
+
+    constexpr FSH::TextureKey kKey{0x1ABE787D, 0x1234, 0};
+} // namespace
+
+TEST_CASE(LRUEvictsLeastRecentlyUsedFirst) {
+    Cache cache(30);
+    cache.Insert(1, "one", 10);
+    cache.Insert(2, "two", 10);
+    cache.Insert(3, "three", 10);
+    CHECK(cache.Find(1) != nullptr); // 1 is now the most recently used; 2 is the oldest
+
+    cache.Insert(4, "four", 10);
+    CHECK(cache.Find(2) == nullptr);
+    CHECK(cache.Find(1) != nullptr);
+    CHECK(cache.Find(3) != nullptr);
+    CHECK(cache.Find(4) != nullptr);
+
+    // Order is now 4, 3, 1 (oldest last), so the next two inserts evict 1 then 3
+    cache.Insert(5, "five", 10);
+    CHECK(cache.Find(1) == nullptr);
+    cache.Insert(6, "six", 10);
+    CHECK(cache.Find(3) == nullptr);
+    CHECK_EQ(cache.GetStats().evictions, uint64_t(3));
+}
+
+TEST_CASE(LRUKeepsToTheByteBudget) {
+    Cache cache(100);
+    for (int i = 0; i < 10; ++i) cache.Insert(i, "x", 25);
+    CHECK_EQ(cache.GetStats().bytes, size_t(100));
+    CHECK_EQ(cache.GetStats().entries, size_t(4));
+    for (int i = 6; i < 10; ++i) CHECK(cache.Find(i) != nullptr);
+
+    // Replacing an entry recharges it instead of counting it twice
+    cache.Insert(9, "y", 40);
+    CHECK_EQ(cache.GetStats().bytes, size_t(90));
+    CHECK_EQ(*cache.Find(9), std::string("y"));
+
+    // One entry over the whole budget evicts everything else but is itself kept
+    cache.Insert(42, "huge", 500);
+    CHECK_EQ(cache.GetStats().entries, size_t(1));
+    CHECK_EQ(cache.GetStats().bytes, size_t(500));
+    CHECK(cache.Find(42) != nullptr);
+
+    // A smaller budget takes effect on the next insert
+    cache.SetBudget(20);
+    cache.Insert(1, "a", 10);
+    cache.Insert(2, "b", 10);
+    CHECK_EQ(cache.GetStats().bytes, size_t(20));
+    CHECK(cache.Find(42) == nullptr);
+
+    CHECK(cache.Erase(1));
+    CHECK(!cache.Erase(1));
+    CHECK_EQ(cache.GetStats().bytes, size_t(10));
+
+    const uint64_t hits = cache.GetStats().hits;
+    cache.Clear();
+    CHECK_EQ(cache.GetStats().entries, size_t(0));
+    CHECK_EQ(cache.GetStats().bytes, size_t(0));
+    CHECK_EQ(cache.GetStats().hits, hits); // Counters survive a Clear()
+}
+
+TEST_CASE(DecodedCacheLoadsOnceAndTrims) {
+    FSH::DecodedFileCache cache(1 << 20);
+    std::atomic<int> calls{0};
+    const auto loader = MakeLoader(calls, 64, 3);
+
+    auto first = cache.Load(kKey, loader);
+    auto second = cache.Load(kKey, loader);
+    CHECK(first != nullptr);
+    CHECK(first == second);
+    CHECK_EQ(calls.load(), 1);
+    CHECK_EQ(first->bitmaps.size(), size_t(1)); // Only the main bitmap is kept
+    CHECK_EQ(cache.GetStats().bytes, sizeof(FSH::File) + 64);
+    CHECK(cache.Find(kKey) == first);
+
+    // Store() trims the same way and replaces the entry
+    auto stored = std::make_shared<FSH::File>();
+    stored->bitmaps.resize(2);
+    stored->bitmaps[0].data.assign(32, 0);
+    auto shared = cache.Store(kKey, stored);
+    CHECK(shared != nullptr && shared->bitmaps.size() == 1);
+    CHECK(cache.Find(kKey) == shared);
+    CHECK(cache.Store(FSH::TextureKey{1, 2, 0}, std::make_shared<FSH::File>()) == nullptr);
+}
+
+TEST_CASE(DecodedCacheEvictsByBytes) {
+    const size_t fileBytes = sizeof(FSH::File) + 1000;
+    FSH::DecodedFileCache cache(fileBytes * 3);
+    std::atomic<int> calls{0};
+    const auto loader = MakeLoader(calls, 1000);
+
+    for (uint32_t i = 0; i < 5; ++i) cache.Load(FSH::TextureKey{1, i, 0}, loader);
+    CHECK_EQ(cache.GetStats().entries, size_t(3));
+    CHECK_EQ(cache.GetStats().evictions, uint64_t(2));
+    CHECK(cache.Find(FSH::TextureKey{1, 0, 0}) == nullptr);
+    CHECK(cache.Find(FSH::TextureKey{1, 4, 0}) != nullptr);
+
+    // Evicted files are loaded again on demand
+    CHECK(cache.Load(FSH::TextureKey{1, 0, 0}, loader) != nullptr);
+    CHECK_EQ(calls.load(), 6);
+}
+
+TEST_CASE(DecodedCacheRemembersFailures) {
+    FSH::DecodedFileCache cache(1 << 20);
+    std::atomic<int> calls{0};
+    const FSH::DecodedFileCache::Loader failing = [&calls](FSH::File&) { ++calls; return false; };
+    const FSH::DecodedFileCache::Loader empty = [&calls](FSH::File&) { ++calls; return true; };
+
+    CHECK(cache.Load(kKey, failing) == nullptr);
+    CHECK(cache.Load(kKey, failing) == nullptr);
+    CHECK_EQ(calls.load(), 1);
+    CHECK_EQ(cache.GetStats().entries, size_t(1));
+    CHECK_EQ(cache.GetStats().bytes, FSH::DecodedFileCache::NEGATIVE_ENTRY_BYTES);
+    CHECK(cache.Find(kKey) == nullptr);
+
+    // A file without bitmaps is a failure too
+    const FSH::TextureKey other{kKey.groupID, kKey.instanceID + 1, 0};
+    CHECK(cache.Load(other, empty) == nullptr);
+    CHECK(cache.Load(other, empty) == nullptr);
+    CHECK_EQ(calls.load(), 2);
+
+    // Negative entries age out like any other entry
+    FSH::DecodedFileCache small(FSH::DecodedFileCache::NEGATIVE_ENTRY_BYTES * 2);
+    for (uint32_t i = 0; i < 3; ++i) small.Load(FSH::TextureKey{2, i, 0}, failing);
+    CHECK_EQ(small.GetStats().entries, size_t(2));
+    CHECK_EQ(small.GetStats().evictions, uint64_t(1));
+    small.Load(FSH::TextureKey{2, 0, 0}, failing);
+    CHECK_EQ(calls.load(), 6);
+
+    cache.Clear();
+    CHECK(cache.Load(kKey, failing) == nullptr);
+    CHECK_EQ(calls.load(), 7);
+}
+
+TEST_CASE(DecodedCacheSharesOneLoadBetweenCallers) {
+    FSH::DecodedFileCache cache(1 << 20);
+    std::atomic<int> calls{0};
+    std::atomic<bool> started{false};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    const auto fill = MakeLoader(calls, 16);
+    const FSH::DecodedFileCache::Loader blocking = [&](FSH::File& file) {
+        started = true;
+        released.wait();
+        return fill(file);
+    };
+
+    auto loading = std::async(std::launch::async, [&] { return cache.Load(kKey, blocking); });
+    CHECK(WaitFor(started));
+    auto waiting = std::async(std::launch::async, [&] { return cache.Load(kKey, blocking); });
+    std::this_thread::sleep_for(50ms); // Let the second caller find the load in flight
+    release.set_value();
+
+    auto a = loading.get();
+    auto b = waiting.get();
+    CHECK(a != nullptr);
+    CHECK(a == b);
+    CHECK_EQ(calls.load(), 1);
+}
+
+TEST_CASE(DecodedCacheClearDuringLoad) {
+    FSH::DecodedFileCache cache(1 << 20);
+    std::atomic<int> calls{0};
+    std::atomic<bool> started{false};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    const auto fill = MakeLoader(calls, 16);
+    const FSH::DecodedFileCache::Loader blocking = [&](FSH::File& file) {
+        started = true;
+        released.wait();
+        return fill(file);
+    };
+
+    auto stale = std::async(std::launch::async, [&] { return cache.Load(kKey, blocking); });
+    CHECK(WaitFor(started));
+    cache.Clear();
+
+    // After the Clear() a new caller starts its own load instead of waiting on the stale one
+    auto fresh = cache.Load(kKey, fill);
+    CHECK(fresh != nullptr);
+    CHECK_EQ(calls.load(), 1);
+
+    release.set_value();
+    auto old = stale.get();
+    CHECK(old != nullptr); // The caller still gets its file...
+    CHECK(old != fresh);
+    CHECK(cache.Find(kKey) == fresh); // ...but it doesn't replace the newer entry
+    CHECK_EQ(cache.GetStats().entries, size_t(1));
+
+    // Nothing is left pending: the next load is a plain cache hit
+    CHECK(cache.Load(kKey, blocking) == fresh);
+    CHECK_EQ(calls.load(), 2);
+}
+
+TEST_CASE(DecodedCacheThrowingLoaderReleasesWaiters) {
+    FSH::DecodedFileCache cache(1 << 20);
+    std::atomic<int> calls{0};
+    std::atomic<bool> started{false};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    const FSH::DecodedFileCache::Loader throwing = [&](FSH::File&) -> bool {
+        ++calls;
+        started = true;
+        released.wait();
+        throw std::runtime_error("corrupt file");
+    };
+
+    auto loading = std::async(std::launch::async, [&] { return cache.Load(kKey, throwing); });
+    CHECK(WaitFor(started));
+    auto waiting = std::async(std::launch::async, [&] { return cache.Load(kKey, throwing); });
+    std::this_thread::sleep_for(50ms);
+    release.set_value();
+
+    bool threw = false;
+    try {
+        loading.get();
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(waiting.get() == nullptr); // Released rather than left with a broken promise
+    CHECK_EQ(calls.load(), 1);
+
+    // The failure isn't cached and nothing is left pending, so the next load runs again
+    CHECK_EQ(cache.GetStats().entries, size_t(0));
+    std::atomic<int> retries{0};
+    CHECK(cache.Load(kKey, MakeLoader(retries, 16)) != nullptr);
+    CHECK_EQ(retries.load(), 1);
+}
@@ -0,0 +1,159 @@
+// Tests for the FSH mip chain layout and first-level selection (s3d/FSHMipChain.h)
+#include <cstdint>
+#include <vector>
+
+#include "TestHarness.h"
+#include "s3d/FSHMipChain.h"
+
+namespace {
+    struct Expected {
+        uint32_t width, height;
+        size_t offset, size;
+    };
+
+    bool Matches(const std::vector<FSH::MipLevelInfo>& levels, const std::vector<Expected>& expected) {
+        if (levels.size() != expected.size()) return false;
+        for (size_t i = 0; i < levels.size(); ++i) {
+            if (levels[i].width != expected[i].width || levels[i].height != expected[i].height ||
+                levels[i].offset != expected[i].offset || levels[i].size != expected[i].size) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t TotalBytes(const std::vector<FSH::MipLevelInfo>& levels) {
+        return levels.empty() ? 0 : levels.back().offset + levels.back().size;
+    }
+
+    // Every level the bitmap can hold, with all the bytes it needs
+    std::vector<FSH::MipLevelInfo> FullChain(uint8_t code, uint32_t width, uint32_t height) {
+        return FSH::ComputeMipChain(code, width, height, FSH::GetMaxMipLevels(width, height), SIZE_MAX);
+    }
+} // namespace
+
+TEST_CASE(MaxMipLevels) {
+    CHECK_EQ(FSH::GetMaxMipLevels(1, 1), uint32_t(1));
+    CHECK_EQ(FSH::GetMaxMipLevels(2, 2), uint32_t(2));
+    CHECK_EQ(FSH::GetMaxMipLevels(128, 128), uint32_t(8));
+    CHECK_EQ(FSH::GetMaxMipLevels(256, 32), uint32_t(9));   // The larger side decides
+    CHECK_EQ(FSH::GetMaxMipLevels(12, 20), uint32_t(5));    // 20, 10, 5, 2, 1
+}
+
+TEST_CASE(DXT1ChainLayout) {
+    // 8 bytes per 4x4 block; levels below 4x4 still take a whole block
+    CHECK(Matches(FullChain(FSH::CODE_DXT1, 128, 128), {
+        {128, 128, 0, 8192}, {64, 64, 8192, 2048}, {32, 32, 10240, 512}, {16, 16, 10752, 128},
+        {8, 8, 10880, 32}, {4, 4, 10912, 8}, {2, 2, 10920, 8}, {1, 1, 10928, 8}}));
+}
+
+TEST_CASE(DXT3ChainLayout) {
+    // 16 bytes per block; a non-square chain keeps halving the longer side after the short one hits 1
+    CHECK(Matches(FullChain(FSH::CODE_DXT3, 64, 32), {
+        {64, 32, 0, 2048}, {32, 16, 2048, 512}, {16, 8, 2560, 128}, {8, 4, 2688, 32},
+        {4, 2, 2720, 16}, {2, 1, 2736, 16}, {1, 1, 2752, 16}}));
+}
+
+TEST_CASE(UncompressedChainLayout) {
+    CHECK(Matches(FullChain(FSH::CODE_32BIT, 16, 8), {
+        {16, 8, 0, 512}, {8, 4, 512, 128}, {4, 2, 640, 32}, {2, 1, 672, 8}, {1, 1, 680, 4}}));
+
+    const std::vector<Expected> sixteenBit = {
+        {32, 32, 0, 2048}, {16, 16, 2048, 512}, {8, 8, 2560, 128}, {4, 4, 2688, 32}, {2, 2, 2720, 8}, {1, 1, 2728, 2}};
+    CHECK(Matches(FullChain(FSH::CODE_16BIT_4444, 32, 32), sixteenBit));
+    CHECK(Matches(FullChain(FSH::CODE_16BIT_0565, 32, 32), sixteenBit));
+    CHECK(Matches(FullChain(FSH::CODE_16BIT_1555, 32, 32), sixteenBit));
+
+    CHECK(Matches(FullChain(FSH::CODE_24BIT, 4, 4), {{4, 4, 0, 48}, {2, 2, 48, 12}, {1, 1, 60, 3}}));
+}
+
+TEST_CASE(LevelCountIsClampedAndHonoured) {
+    // More levels than the size allows are clamped to the full chain
+    CHECK_EQ(FSH::ComputeMipChain(FSH::CODE_32BIT, 16, 16, 100, SIZE_MAX).size(), size_t(5));
+    CHECK_EQ(FSH::ComputeMipChain(FSH::CODE_32BIT, 16, 16, 3, SIZE_MAX).size(), size_t(3));
+    CHECK_EQ(FSH::ComputeMipChain(FSH::CODE_32BIT, 16, 16, 1, SIZE_MAX).size(), size_t(1));
+    CHECK(FSH::ComputeMipChain(FSH::CODE_32BIT, 16, 16, 0, SIZE_MAX).empty());
+
+    // Degenerate sizes and unknown formats have no levels
+    CHECK(FSH::ComputeMipChain(FSH::CODE_32BIT, 0, 16, 1, SIZE_MAX).empty());
+    CHECK(FSH::ComputeMipChain(FSH::CODE_DXT1, 16, 0, 1, SIZE_MAX).empty());
+    CHECK(FSH::ComputeMipChain(0x42, 16, 16, 5, SIZE_MAX).empty());
+}
+
+TEST_CASE(TruncatedDataDropsIncompleteLevels) {
+    for (uint8_t code : {FSH::CODE_DXT1, FSH::CODE_DXT3, FSH::CODE_32BIT, FSH::CODE_16BIT_0565}) {
+        const auto full = FullChain(code, 64, 64);
+        const size_t total = TotalBytes(full);
+
+        // One byte short loses the last level only
+        const auto shortByOne = FSH::ComputeMipChain(code, 64, 64, 7, total - 1);
+        CHECK_EQ(shortByOne.size(), full.size() - 1);
+
+        // A cut in the middle of a level keeps every level before it
+        const size_t cut = full[3].offset + full[3].size / 2;
+        const auto middle = FSH::ComputeMipChain(code, 64, 64, 7, cut);
+        CHECK_EQ(middle.size(), size_t(3));
+        CHECK(TotalBytes(middle) <= cut);
+
+        // Exactly the main level, and less than that
+        CHECK_EQ(FSH::ComputeMipChain(code, 64, 64, 7, full[0].size).size(), size_t(1));
+        CHECK(FSH::ComputeMipChain(code, 64, 64, 7, full[0].size - 1).empty());
+        CHECK(FSH::ComputeMipChain(code, 64, 64, 7, 0).empty());
+    }
+}
+
+TEST_CASE(BlockCompressedSizesThatAreNotMultiplesOfFour) {
+    // Partial blocks round up: 12x20 is 3x5 blocks, 6x10 is 2x3, 3x5 is 1x2
+    CHECK(Matches(FullChain(FSH::CODE_DXT1, 12, 20), {
+        {12, 20, 0, 120}, {6, 10, 120, 48}, {3, 5, 168, 16}, {1, 2, 184, 8}, {1, 1, 192, 8}}));
+    CHECK(Matches(FullChain(FSH::CODE_DXT3, 10, 6), {
+        {10, 6, 0, 96}, {5, 3, 96, 32}, {2, 1, 128, 16}, {1, 1, 144, 16}}));
+
+    // A 6x10 level can't be the top of a BC texture, so the main level stays first
+    const auto odd = FullChain(FSH::CODE_DXT1, 12, 20);
+    CHECK_EQ(FSH::SelectFirstMip(odd, FSH::CODE_DXT1, 6), uint32_t(0));
+
+    // Uncompressed formats have no such restriction
+    const auto oddRGBA = FullChain(FSH::CODE_32BIT, 12, 20);
+    CHECK_EQ(FSH::SelectFirstMip(oddRGBA, FSH::CODE_32BIT, 6), uint32_t(1)); // 6x10
+}
+
+TEST_CASE(FirstMipForThumbnailSizes) {
+    // 256x256 DXT1: 128 and 64 still cover both 44 and 64 pixel thumbnails, 32 doesn't
+    const auto dxt = FullChain(FSH::CODE_DXT1, 256, 256);
+    CHECK_EQ(FSH::SelectFirstMip(dxt, FSH::CODE_DXT1, 44), uint32_t(2));
+    CHECK_EQ(FSH::SelectFirstMip(dxt, FSH::CODE_DXT1, 64), uint32_t(2));
+    CHECK_EQ(dxt[2].width, uint32_t(64));
+
+    // 128x64 32-bit: the larger side decides, so 64x32 covers both sizes
+    const auto wide = FullChain(FSH::CODE_32BIT, 128, 64);
+    CHECK_EQ(FSH::SelectFirstMip(wide, FSH::CODE_32BIT, 44), uint32_t(1));
+    CHECK_EQ(FSH::SelectFirstMip(wide, FSH::CODE_32BIT, 64), uint32_t(1));
+
+    // 64x64: only the main level covers a 64 pixel thumbnail, and 32 is too small for 44
+    const auto small = FullChain(FSH::CODE_DXT3, 64, 64);
+    CHECK_EQ(FSH::SelectFirstMip(small, FSH::CODE_DXT3, 44), uint32_t(0));
+    CHECK_EQ(FSH::SelectFirstMip(small, FSH::CODE_DXT3, 64), uint32_t(0));
+
+    // Non-power-of-two 96x96 16-bit: 48x48 covers 44 but not 64
+    const auto odd = FullChain(FSH::CODE_16BIT_1555, 96, 96);
+    CHECK_EQ(FSH::SelectFirstMip(odd, FSH::CODE_16BIT_1555, 44), uint32_t(1));
+    CHECK_EQ(FSH::SelectFirstMip(odd, FSH::CODE_16BIT_1555, 64), uint32_t(0));
+}
+
+TEST_CASE(FirstMipEdgeCases) {
+    const auto dxt = FullChain(FSH::CODE_DXT1, 64, 64);
+    CHECK_EQ(FSH::SelectFirstMip(dxt, FSH::CODE_DXT1, 0), uint32_t(0));     // 0 keeps the main level
+    CHECK_EQ(FSH::SelectFirstMip(dxt, FSH::CODE_DXT1, 1000), uint32_t(0));  // Larger than the texture
+    CHECK_EQ(FSH::SelectFirstMip({}, FSH::CODE_DXT1, 44), uint32_t(0));
+
+    // BC levels stop at 4x4: 2x2 and 1x1 are never the top level, however small the target
+    CHECK_EQ(FSH::SelectFirstMip(dxt, FSH::CODE_DXT1, 1), uint32_t(4));
+    const auto rgba = FullChain(FSH::CODE_32BIT, 64, 64);
+    CHECK_EQ(FSH::SelectFirstMip(rgba, FSH::CODE_32BIT, 1), uint32_t(6));
+
+    // Only the levels present in the (truncated) chain can be chosen
+    const auto truncated = FSH::ComputeMipChain(FSH::CODE_DXT1, 256, 256, 9, dxt[0].size * 16 + 1);
+    CHECK_EQ(truncated.size(), size_t(1));
+    CHECK_EQ(FSH::SelectFirstMip(truncated, FSH::CODE_DXT1, 44), uint32_t(0));
+}
@@ -0,0 +1,72 @@
+/*
+ * Synthetic lot catalogs for the lot search, query and filter tests and benchmarks.
+ * Names, descriptions, sizes and occupant groups follow the shape of a large plugin folder:
+ * short names with a few accented words, descriptions of a few hundred bytes, mostly small lots.
+ */
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lots/LotCatalog.h"
+
+namespace LotCatalogFixture {
+    inline const char* const kWords[] = {
+        "cottage", "tower", "apartments", "office", "plaza", "factory", "warehouse", "farm",
+        "church", "school", "park", "station", "market", "hotel", "Café", "Église", "Résidence",
+        "Maxis", "modern", "victorian", "brick", "glass", "small", "large", "corner", "garden",
+    };
+    inline const char* const kSentences[] = {
+        "A compact building that fits well on corner lots. ",
+        "Provides jobs for the local workforce and draws commuters from nearby towns. ",
+        "Designed for dense urban cores with good transit coverage. ",
+        "Built with brick and glass, this landmark is popular with tourists. ",
+        "Low pollution, moderate demand; grows best next to parks. ",
+        "Part of a set of matching lots; see the readme for dependencies. ",
+    };
+    constexpr uint32_t kGroupIDs[] = {0x1000, 0x1001, 0x1002, 0x1010, 0x1011, 0x1300, 0x1301, 0x1500, 0x1503, 0xB5C00A0};
+
+    inline LotCatalog::LotInfo MakeLot(uint32_t index, std::mt19937& rng) {
+        LotCatalog::LotInfo lot;
+        lot.id = 0x60000000u + index;
+
+        const size_t wordCount = sizeof(kWords) / sizeof(kWords[0]);
+        for (int w = 0, n = 2 + static_cast<int>(rng() % 3); w < n; ++w) {
+            if (w) lot.name += ' ';
+            lot.name += kWords[rng() % wordCount];
+        }
+        lot.name += " #";
+        lot.name += std::to_string(index);
+
+        for (int s = 0, n = 2 + static_cast<int>(rng() % 5); s < n; ++s) {
+            lot.description += kSentences[rng() % (sizeof(kSentences) / sizeof(kSentences[0]))];
+        }
+
+        lot.sizeX = 1 + rng() % (rng() % 4 == 0 ? 8 : 3);
+        lot.sizeZ = 1 + rng() % (rng() % 4 == 0 ? 8 : 3);
+        lot.growthStage = static_cast<uint8_t>(rng() % 16);
+        lot.minCapacity = static_cast<uint16_t>(rng() % 200);
+        lot.maxCapacity = static_cast<uint16_t>(lot.minCapacity + rng() % 800);
+        lot.zoneMask = 1u << (1 + rng() % 9);
+        lot.wealthMask = static_cast<uint8_t>(1u << (1 + rng() % 3));
+        for (uint32_t group : kGroupIDs) {
+            if (rng() % 4 == 0) lot.occupantGroups.push_back(group);
+        }
+        return lot;
+    }
+
+    inline std::vector<LotCatalog::LotInfo> MakeLots(size_t count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<LotCatalog::LotInfo> lots;
+        lots.reserve(count);
+        for (size_t i = 0; i < count; ++i) lots.push_back(MakeLot(static_cast<uint32_t>(i), rng));
+        return lots;
+    }
+
+    inline void Fill(LotCatalog& catalog, const std::vector<LotCatalog::LotInfo>& lots) {
+        catalog.Clear();
+        catalog.Reserve(lots.size());
+        for (const auto& lot : lots) catalog.Add(lot);
+    }
+} // namespace LotCatalogFixture
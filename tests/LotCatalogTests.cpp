@@ -0,0 +1,176 @@
+// Tests for the occupant group bitsets in LotCatalog (lots/LotCatalog.cpp), including catalogs
+// with more groups than one or two 64-bit words hold, which widen every row while lots are added
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TestHarness.h"
+#include "lots/LotCatalog.h"
+
+namespace {
+    using Groups = std::vector<uint32_t>;
+
+    uint32_t GroupID(size_t index) {
+        return 0x2000u + static_cast<uint32_t>(index) * 7u;
+    }
+
+    LotCatalog::LotInfo MakeLot(uint32_t index, Groups groups) {
+        LotCatalog::LotInfo lot;
+        lot.id = 0x60000000u + index;
+        lot.name = "Lot " + std::to_string(index);
+        lot.occupantGroups = std::move(groups);
+        return lot;
+    }
+
+    // Catalog and the groups each row should report
+    struct Built {
+        LotCatalog catalog;
+        std::vector<std::set<uint32_t>> reference;
+        std::vector<uint32_t> groups; // Every group used, in first-use order
+    };
+
+    // 'rows' lots over 'groupCount' groups. New groups keep appearing while rows are added, so
+    // the bitsets widen with rows already holding bits; rows also repeat and mix old groups.
+    void Build(Built& built, size_t rows, size_t groupCount, uint32_t seed) {
+        std::mt19937 rng(seed);
+        built.catalog.Clear();
+        built.reference.clear();
+        built.groups.clear();
+
+        size_t introduced = 0;
+        for (size_t row = 0; row < rows; ++row) {
+            Groups groups;
+            // Introduce the next group on most rows until every group is in use
+            if (introduced < groupCount && row % 3 != 2) groups.push_back(GroupID(introduced++));
+            for (int n = static_cast<int>(rng() % 6); introduced > 0 && n > 0; --n) {
+                groups.push_back(GroupID(rng() % introduced));
+            }
+            if (!groups.empty() && rng() % 5 == 0) groups.push_back(groups.front()); // Duplicate
+
+            for (uint32_t g : groups) {
+                if (std::find(built.groups.begin(), built.groups.end(), g) == built.groups.end()) built.groups.push_back(g);
+            }
+            built.reference.emplace_back(groups.begin(), groups.end());
+            built.catalog.Add(MakeLot(static_cast<uint32_t>(row), std::move(groups)));
+        }
+    }
+
+    bool GroupsMatch(const Built& built) {
+        std::vector<uint32_t> out;
+        for (LotHandle handle = 0; handle < built.catalog.GetCount(); ++handle) {
+            out.clear();
+            built.catalog.GetOccupantGroups(handle, out);
+            const std::set<uint32_t> got(out.begin(), out.end());
+            if (got.size() != out.size() || got != built.reference[handle]) return false;
+        }
+        return true;
+    }
+
+    bool HasMatches(const Built& built) {
+        for (LotHandle handle = 0; handle < built.catalog.GetCount(); ++handle) {
+            const auto& expected = built.reference[handle];
+            for (uint32_t g : built.groups) {
+                if (built.catalog.HasOccupantGroup(handle, g) != (expected.count(g) != 0)) return false;
+            }
+            // IDs no lot has, and IDs between the used ones
+            if (built.catalog.HasOccupantGroup(handle, 0xDEADBEEF)) return false;
+            if (built.catalog.HasOccupantGroup(handle, GroupID(3) + 1)) return false;
+        }
+        return true;
+    }
+
+    size_t ExpectedWords(size_t groupCount) {
+        size_t words = 1;
+        while (groupCount > words * 64) words *= 2;
+        return words;
+    }
+} // namespace
+
+TEST_CASE(GroupWordsGrowAtSixtyFourAndOneTwentyEight) {
+    LotCatalog catalog;
+    CHECK_EQ(catalog.GetGroupWords(), size_t(1));
+    for (size_t i = 0; i < 200; ++i) {
+        catalog.Add(MakeLot(static_cast<uint32_t>(i), {GroupID(i)}));
+        CHECK_EQ(catalog.GetGroupCount(), i + 1);
+        CHECK_EQ(catalog.GetGroupWords(), ExpectedWords(i + 1));
+        CHECK_EQ(catalog.GetGroupBitsColumn().size(), catalog.GetCount() * catalog.GetGroupWords());
+    }
+    CHECK_EQ(catalog.GetGroupWords(), size_t(4));
+
+    // Every row kept its single bit through both widenings
+    bool single = true;
+    for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+        std::vector<uint32_t> out;
+        catalog.GetOccupantGroups(handle, out);
+        single = single && out.size() == 1 && out[0] == GroupID(handle) && catalog.GetGroupID(handle) == GroupID(handle);
+    }
+    CHECK(single);
+
+    catalog.Clear();
+    CHECK_EQ(catalog.GetGroupWords(), size_t(1));
+    CHECK_EQ(catalog.GetGroupCount(), size_t(0));
+}
+
+TEST_CASE(WideCatalogsMatchTheReference) {
+    // Just past one word, exactly two words, just past two words, and well into four
+    for (size_t groupCount : {65, 128, 129, 200}) {
+        Built built;
+        Build(built, groupCount * 3, groupCount, static_cast<uint32_t>(groupCount));
+        CHECK_EQ(built.catalog.GetGroupCount(), groupCount);
+        CHECK_EQ(built.catalog.GetGroupWords(), ExpectedWords(groupCount));
+        CHECK(GroupsMatch(built));
+        CHECK(HasMatches(built));
+    }
+}
+
+TEST_CASE(WideGroupMasksSelectTheRightRows) {
+    Built built;
+    Build(built, 600, 200, 23);
+    const LotCatalog& catalog = built.catalog;
+    CHECK_EQ(catalog.GetGroupWords(), size_t(4));
+
+    std::mt19937 rng(5);
+    std::vector<uint64_t> mask;
+    bool masksMatch = true;
+    bool rowsMatch = true;
+    for (int trial = 0; trial < 200; ++trial) {
+        // A few groups from anywhere in the index range, plus IDs no lot has
+        Groups query;
+        std::set<uint32_t> wanted;
+        for (int n = 1 + static_cast<int>(rng() % 4); n > 0; --n) {
+            const uint32_t g = built.groups[rng() % built.groups.size()];
+            query.push_back(g);
+            wanted.insert(g);
+        }
+        if (trial % 3 == 0) query.push_back(0xDEADBEEF);
+
+        const size_t found = catalog.BuildGroupMask(query, mask);
+        masksMatch = masksMatch && found == query.size() - (trial % 3 == 0 ? 1 : 0);
+        masksMatch = masksMatch && mask.size() == catalog.GetGroupWords();
+
+        size_t bitsSet = 0;
+        for (uint64_t word : mask) bitsSet += static_cast<size_t>(std::popcount(word));
+        masksMatch = masksMatch && bitsSet == wanted.size();
+
+        for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+            const uint64_t* bits = catalog.GetGroupBits(handle);
+            bool any = false;
+            for (size_t w = 0; w < catalog.GetGroupWords(); ++w) any = any || (bits[w] & mask[w]) != 0;
+
+            bool expected = false;
+            for (uint32_t g : wanted) expected = expected || built.reference[handle].count(g) != 0;
+            rowsMatch = rowsMatch && any == expected;
+        }
+    }
+    CHECK(masksMatch);
+    CHECK(rowsMatch);
+
+    // Only unknown groups: an all-zero mask of the full width
+    CHECK_EQ(catalog.BuildGroupMask({0xDEADBEEF, 1}, mask), size_t(0));
+    CHECK_EQ(mask.size(), size_t(4));
+    CHECK(std::all_of(mask.begin(), mask.end(), [](uint64_t w) { return w == 0; }));
+}
@@ -0,0 +1,113 @@
+// Filter time for search box queries over a 50k-lot catalog: LotFilterer's sampled
+// predicate ordering (lots/LotFilterer.cpp) versus testing every criterion per lot in a fixed
+// order (columns, then groups, then text), and versus narrowing the previous result.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "LotCatalogFixture.h"
+#include "lots/LotCatalog.h"
+#include "lots/LotFilterer.h"
+#include "lots/LotQuery.h"
+#include "lots/LotSearchIndex.h"
+#include "lots/OccupantGroupQuery.h"
+
+namespace {
+    // The query tested one lot at a time, every criterion in declaration order
+    size_t FilterFixedOrder(const LotCatalog& catalog, const LotSearchIndex& index, const LotQuery& query,
+                            const CompiledGroupQuery& groups, std::vector<LotHandle>& out) {
+        out.clear();
+        if (query.matchesNothing || groups.matchesNothing) return 0;
+        for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+            if (!query.sizeX.Contains(catalog.GetSizeX(handle)) || !query.sizeZ.Contains(catalog.GetSizeZ(handle))) continue;
+            if (!query.growthStage.Contains(catalog.GetGrowthStage(handle))) continue;
+            if (!query.capacity.Contains(catalog.GetMaxCapacity(handle))) continue;
+            const bool zones = std::all_of(query.zoneMasks.begin(), query.zoneMasks.end(),
+                [&](uint32_t mask) { return (catalog.GetZoneMask(handle) & mask) != 0; });
+            const bool wealths = std::all_of(query.wealthMasks.begin(), query.wealthMasks.end(),
+                [&](uint8_t mask) { return (catalog.GetWealthMask(handle) & mask) != 0; });
+            if (!zones || !wealths) continue;
+            if (groups.active && !groups.Matches(catalog.GetGroupBits(handle))) continue;
+            const bool text = std::all_of(query.textTerms.begin(), query.textTerms.end(),
+                [&](const std::string& term) { return index.SlotContains(handle, term); });
+            if (text) out.push_back(handle);
+        }
+        return out.size();
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 9;
+    const size_t lotCount = quick ? 5000 : 50000;
+
+    const auto lots = LotCatalogFixture::MakeLots(lotCount, 25);
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+    LotSearchIndex index;
+    index.Build(catalog);
+
+    // Broad criteria listed before selective ones, so declaration order is the slow order
+    const char* const searches[] = {
+        "size:..8x8 zone:R stage:15",
+        "size:..3x3 wealth:$$ group:0x1000 -group:0x1001 cap:>750",
+        "commuters size:..4x4 zone:C",
+        "modern brick size:..2x2",
+        "\"corner lots\" cap:<50",
+        "size:..8x8 qqq",
+    };
+
+    std::printf("%zu lots\n", catalog.GetCount());
+    const size_t loops = quick ? 1 : 20;
+    char name[128];
+    std::vector<LotHandle> fixed, ordered;
+    for (const char* search : searches) {
+        LotQuery query;
+        query.ParseSearch(search);
+        LotQuery normalized = query;
+        normalized.Normalize();
+        CompiledGroupQuery groups;
+        groups.Compile(normalized.groups, catalog);
+
+        std::snprintf(name, sizeof(name), "'%s', fixed order", search);
+        BenchHarness::Measure(name, loops, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) BenchHarness::DoNotOptimize(FilterFixedOrder(catalog, index, normalized, groups, fixed));
+        });
+
+        LotFilterer filterer;
+        std::snprintf(name, sizeof(name), "'%s', ordered", search);
+        BenchHarness::Measure(name, loops, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) {
+                filterer.Reset();
+                filterer.FilterLots(catalog, index, ordered, query);
+                BenchHarness::DoNotOptimize(ordered.size());
+            }
+        });
+        std::printf("    plan: %s\n", filterer.DescribeLastPlan().c_str());
+
+        if (fixed != ordered) {
+            std::fprintf(stderr, "Result mismatch for '%s': %zu vs %zu lots\n", search, fixed.size(), ordered.size());
+            return 1;
+        }
+    }
+
+    // Typing a search word by word: each keystroke narrows the previous result
+    const char* const keystrokes[] = {"z", "zo", "zone", "zone:R", "zone:R c", "zone:R co", "zone:R cot", "zone:R cott"};
+    for (bool narrow : {false, true}) {
+        LotFilterer filterer;
+        BenchHarness::Measure(narrow ? "typing 'zone:R cott', narrowing (per keystroke)"
+                                     : "typing 'zone:R cott', full scans (per keystroke)",
+                              std::size(keystrokes), repetitions, [&] {
+            for (const char* text : keystrokes) {
+                if (!narrow) filterer.Reset();
+                LotQuery query;
+                query.ParseSearch(text);
+                filterer.FilterLots(catalog, index, ordered, query);
+                BenchHarness::DoNotOptimize(ordered.size());
+            }
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+// Tests for search box parsing (lots/LotQuery.cpp) and the predicate pipeline (lots/LotFilterer.cpp)
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LotCatalogFixture.h"
+#include "TestHarness.h"
+#include "cISC4LotConfiguration.h"
+#include "lots/LotCatalog.h"
+#include "lots/LotFilterer.h"
+#include "lots/LotQuery.h"
+#include "lots/LotSearchIndex.h"
+
+namespace {
+    using Groups = std::vector<uint32_t>;
+
+    LotQuery Parse(const char* text) {
+        static const std::unordered_map<uint32_t, std::string> groupNames = {{0x1500, "Landmark"}, {0x1503, "Place of Worship"}};
+        LotQuery query;
+        query.ParseSearch(text, &groupNames);
+        query.Normalize();
+        return query;
+    }
+
+    bool SizeIs(const LotQuery& query, uint32_t minX, uint32_t maxX, uint32_t minZ, uint32_t maxZ) {
+        return query.sizeX == LotQuery::Range{minX, maxX} && query.sizeZ == LotQuery::Range{minZ, maxZ} && query.textTerms.empty();
+    }
+
+    // Every criterion checked on the raw lot, as the query documents it
+    bool ReferenceMatches(const LotQuery& query, const LotCatalog::LotInfo& lot) {
+        if (query.matchesNothing) return false;
+        if (!query.sizeX.Contains(lot.sizeX) || !query.sizeZ.Contains(lot.sizeZ)) return false;
+        if (!query.growthStage.Contains(lot.growthStage) || !query.capacity.Contains(lot.maxCapacity)) return false;
+        for (uint32_t mask : query.zoneMasks) {
+            if ((lot.zoneMask & mask) == 0) return false;
+        }
+        for (uint8_t mask : query.wealthMasks) {
+            if ((lot.wealthMask & mask) == 0) return false;
+        }
+
+        auto has = [&](uint32_t g) { return std::find(lot.occupantGroups.begin(), lot.occupantGroups.end(), g) != lot.occupantGroups.end(); };
+        const auto& groups = query.groups;
+        if (!groups.anyOf.empty() && std::none_of(groups.anyOf.begin(), groups.anyOf.end(), has)) return false;
+        if (!std::all_of(groups.allOf.begin(), groups.allOf.end(), has)) return false;
+        if (std::any_of(groups.noneOf.begin(), groups.noneOf.end(), has)) return false;
+
+        std::string name, description;
+        LotSearchIndex::Fold(lot.name, name);
+        LotSearchIndex::Fold(lot.description, description);
+        for (const std::string& term : query.textTerms) {
+            if (name.find(term) == std::string::npos && description.find(term) == std::string::npos) return false;
+        }
+        return true;
+    }
+
+    std::vector<LotHandle> Reference(const LotQuery& query, const std::vector<LotCatalog::LotInfo>& lots) {
+        std::vector<LotHandle> handles;
+        for (size_t i = 0; i < lots.size(); ++i) {
+            if (ReferenceMatches(query, lots[i])) handles.push_back(static_cast<LotHandle>(i));
+        }
+        return handles;
+    }
+
+    struct FakeConfiguration : cISC4LotConfiguration {
+        uint32_t zones = 0;
+        uint32_t wealths = 0;
+
+        bool IsCompatibleWithZoneType(cISC4ZoneManager::ZoneType zoneType) override {
+            return (zones >> static_cast<uint32_t>(zoneType)) & 1u;
+        }
+        bool IsCompatibleWithWealthType(cISC4BuildingOccupant::WealthType wealthType) override {
+            return (wealths >> static_cast<uint32_t>(wealthType)) & 1u;
+        }
+    };
+} // namespace
+
+TEST_CASE(ParsesDecimalAndHexSizes) {
+    CHECK(SizeIs(Parse("size:2x3"), 2, 2, 3, 3));
+    CHECK(SizeIs(Parse("size:2X3"), 2, 2, 3, 3));
+    CHECK(SizeIs(Parse("size:0x2x3"), 2, 2, 3, 3));
+    CHECK(SizeIs(Parse("size:2x0x3"), 2, 2, 3, 3));
+    CHECK(SizeIs(Parse("size:0x2X0x3"), 2, 2, 3, 3));
+    CHECK(SizeIs(Parse("size:0xAx0x10"), 10, 10, 16, 16));
+    CHECK(SizeIs(Parse("size:2x3..0x4x4"), 2, 4, 3, 4));
+    CHECK(SizeIs(Parse("size:..3x3"), 0, 3, 0, 3));
+    CHECK(SizeIs(Parse("size:2x2.."), 2, UINT32_MAX, 2, UINT32_MAX));
+}
+
+TEST_CASE(MalformedSizesAreText) {
+    for (const char* text : {"size:0x", "size:0x2", "size:2x", "size:x3", "size:2x3x4", "size:0x2x", "size:.."}) {
+        const LotQuery query = Parse(text);
+        CHECK(query.sizeX.IsAll() && query.sizeZ.IsAll());
+        CHECK_EQ(query.textTerms.size(), size_t(1));
+    }
+}
+
+TEST_CASE(ParsesFieldTerms) {
+    const LotQuery query = Parse("zone:R wealth:$$ stage:>=3 cap:100..500 group:Landmark -group:0x1503 \"High School\" Café");
+    CHECK_EQ(query.zoneMasks.size(), size_t(1));
+    CHECK((query.wealthMasks == std::vector<uint8_t>{1u << 2}));
+    CHECK((query.growthStage == LotQuery::Range{3, UINT32_MAX}));
+    CHECK((query.capacity == LotQuery::Range{100, 500}));
+    CHECK((query.groups.allOf == Groups{0x1500}));
+    CHECK((query.groups.noneOf == Groups{0x1503}));
+    CHECK((query.textTerms == std::vector<std::string>{"cafe", "high school"}));
+    CHECK(!query.matchesNothing);
+
+    const LotQuery ranges = Parse("stage:>3 cap:<10 stage:<=8");
+    CHECK((ranges.growthStage == LotQuery::Range{4, 8}));
+    CHECK((ranges.capacity == LotQuery::Range{0, 9}));
+}
+
+TEST_CASE(UnknownFieldsAndValuesAreText) {
+    const LotQuery query = Parse("zone:Q group:Unknown foo:bar");
+    CHECK(query.zoneMasks.empty());
+    CHECK(query.groups.IsEmpty());
+    CHECK((query.textTerms == std::vector<std::string>{"foo:bar", "group:unknown", "zone:q"}));
+}
+
+TEST_CASE(ContradictoryGroupsMatchNothing) {
+    CHECK(Parse("group:Landmark -group:Landmark").matchesNothing);
+    CHECK(Parse("-group:0x1500 group:0x1500").matchesNothing);
+    CHECK(!Parse("group:Landmark -group:0x1503").matchesNothing);
+
+    // The widgets' any-of groups, all excluded by the search box
+    LotQuery query;
+    query.groups.anyOf = {0x1500, 0x1503};
+    query.ParseSearch("-group:0x1500 -group:0x1503");
+    query.Normalize();
+    CHECK(query.matchesNothing);
+}
+
+TEST_CASE(ComputesCompatibilityMasks) {
+    FakeConfiguration config;
+    config.zones = (1u << 1) | (1u << 15);
+    config.wealths = (1u << 2) | (1u << 3) | 1u;
+    CHECK_EQ(LotFilterer::ComputeZoneMask(&config), (1u << 1) | (1u << 15));
+    // WealthType::None is not a wealth level
+    CHECK_EQ(LotFilterer::ComputeWealthMask(&config), uint8_t((1u << 2) | (1u << 3)));
+    CHECK_EQ(LotFilterer::ComputeZoneMask(nullptr), 0u);
+    CHECK_EQ(LotFilterer::ComputeWealthMask(nullptr), uint8_t(0));
+}
+
+TEST_CASE(FilterMatchesTheReference) {
+    const auto lots = LotCatalogFixture::MakeLots(4000, 25);
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+    LotSearchIndex index;
+    index.Build(catalog);
+
+    const char* const searches[] = {
+        "", "cottage", "size:2x2", "size:..2x3 zone:R", "zone:C wealth:$$$ stage:>8", "cap:>700 group:0x1000",
+        "-group:0x1001 -group:0x1002 brick", "group:0x1000 -group:0x1000", "\"corner lots\" zone:I wealth:$",
+        "eglise size:0x1x1..0x3x3", "qqq", "zone:R zone:C", "stage:3 cap:..300 garden",
+    };
+    LotFilterer filterer;
+    std::vector<LotHandle> handles;
+    for (const char* search : searches) {
+        LotQuery query;
+        query.ParseSearch(search);
+        filterer.FilterLots(catalog, index, handles, query);
+
+        query.Normalize();
+        CHECK((handles == Reference(query, lots)));
+    }
+}
+
+TEST_CASE(NarrowingMatchesAFullScan) {
+    const auto lots = LotCatalogFixture::MakeLots(3000, 26);
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+    LotSearchIndex index;
+    index.Build(catalog);
+
+    // Keystrokes and widget changes that each can only remove lots, then one that widens
+    const char* const steps[] = {
+        "c", "co", "cot", "cott zone:R", "cott zone:R size:..3x3", "cott zone:R size:..2x2 group:0x1000",
+        "cott zone:R size:..2x2 group:0x1000 -group:0x1300", "cott zone:R size:..2x2 group:0x1000 -group:0x1300 cap:>100",
+        "cott",
+    };
+    LotFilterer incremental;
+    std::vector<LotHandle> narrowed, scanned;
+    for (const char* step : steps) {
+        LotQuery query;
+        query.ParseSearch(step);
+        incremental.FilterLots(catalog, index, narrowed, query);
+
+        LotFilterer fresh;
+        fresh.FilterLots(catalog, index, scanned, query);
+        CHECK((narrowed == scanned));
+        CHECK(!fresh.WasLastNarrowed());
+    }
+    CHECK(!incremental.WasLastNarrowed());
+
+    // A rebuilt index invalidates the previous result
+    LotQuery query;
+    query.ParseSearch("cott");
+    index.Build(catalog);
+    incremental.FilterLots(catalog, index, narrowed, query);
+    CHECK(!incremental.WasLastNarrowed());
+    query.ParseSearch("zone:R");
+    incremental.FilterLots(catalog, index, narrowed, query);
+    CHECK(incremental.WasLastNarrowed());
+}
+
+TEST_CASE(PlanRunsSelectivePredicatesFirst) {
+    const auto lots = LotCatalogFixture::MakeLots(5000, 27);
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+    LotSearchIndex index;
+    index.Build(catalog);
+
+    // size:..8x8 keeps every lot; stage:15 keeps about 1 in 16
+    LotQuery query;
+    query.ParseSearch("size:..8x8 stage:15");
+    LotFilterer filterer;
+    std::vector<LotHandle> handles;
+    filterer.FilterLots(catalog, index, handles, query);
+
+    const auto& plan = filterer.GetLastPlan();
+    CHECK(!plan.empty());
+    CHECK(plan.front().kind == LotFilterer::PredicateKind::GrowthStage);
+    CHECK_EQ(plan.back().remaining, handles.size());
+}
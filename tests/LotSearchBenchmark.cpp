@@ -0,0 +1,80 @@
+// Lot search filter latency against lot count: the folded LotSearchIndex arena
+// (lots/LotSearchIndex.cpp) versus lowercasing each lot's name and description per query,
+// as LotFilterer::MatchesSearchFilter did before the index.
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "LotCatalogFixture.h"
+#include "lots/LotCatalog.h"
+#include "lots/LotSearchIndex.h"
+
+namespace {
+    // The per-lot check the index replaced: three lowercase copies per lot per query
+    bool MatchesByCopy(const LotCatalog::LotInfo& lot, const char* searchText) {
+        if (!searchText || searchText[0] == '\0') return true;
+
+        auto lower = [](std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return s;
+        };
+        const std::string searchLower = lower(searchText);
+        if (lower(lot.name).find(searchLower) != std::string::npos) return true;
+        return lower(lot.description).find(searchLower) != std::string::npos;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 7;
+    // Successive keystrokes of a search, plus a query that matches nothing
+    const char* const queries[] = {"c", "co", "cott", "cottage", "commuters", "qqq"};
+
+    for (size_t lotCount : {1000u, 10000u, 50000u}) {
+        const auto lots = LotCatalogFixture::MakeLots(lotCount, 7);
+        LotCatalog catalog;
+        LotCatalogFixture::Fill(catalog, lots);
+
+        LotSearchIndex index;
+        char name[96];
+        std::snprintf(name, sizeof(name), "build index, %zu lots (per lot)", lotCount);
+        BenchHarness::Measure(name, lotCount, repetitions, [&] {
+            index.Build(catalog);
+            BenchHarness::DoNotOptimize(index.GetArenaSize());
+        });
+
+        const size_t loops = quick ? 1 : (std::max<size_t>)(1, 200000 / lotCount);
+        for (const char* query : queries) {
+            size_t copyMatches = 0, indexMatches = 0;
+            std::snprintf(name, sizeof(name), "  '%s' %zu lots, lowercase copies (per filter)", query, lotCount);
+            BenchHarness::Measure(name, loops, repetitions, [&] {
+                for (size_t i = 0; i < loops; ++i) {
+                    copyMatches = 0;
+                    for (const auto& lot : lots) copyMatches += MatchesByCopy(lot, query);
+                    BenchHarness::DoNotOptimize(copyMatches);
+                }
+            });
+
+            std::vector<uint8_t> matches;
+            std::snprintf(name, sizeof(name), "  '%s' %zu lots, search index (per filter)", query, lotCount);
+            BenchHarness::Measure(name, loops, repetitions, [&] {
+                for (size_t i = 0; i < loops; ++i) {
+                    index.Search(query, matches);
+                    BenchHarness::DoNotOptimize(matches.size());
+                }
+            });
+            for (uint8_t match : matches) indexMatches += match;
+
+            // ASCII-only queries, so both must agree
+            if (copyMatches != indexMatches) {
+                std::fprintf(stderr, "Match count mismatch for '%s': %zu vs %zu\n", query, copyMatches, indexMatches);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Tests for the folded lot search arena (lots/LotSearchIndex.cpp)
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LotCatalogFixture.h"
+#include "TestHarness.h"
+#include "lots/LotCatalog.h"
+#include "lots/LotSearchIndex.h"
+
+namespace {
+    std::string Fold(std::string_view text) {
+        std::string out;
+        LotSearchIndex::Fold(text, out);
+        return out;
+    }
+
+    LotCatalog::LotInfo Lot(uint32_t id, const char* name, const char* description) {
+        LotCatalog::LotInfo lot;
+        lot.id = id;
+        lot.name = name;
+        lot.description = description;
+        return lot;
+    }
+
+    std::vector<uint32_t> MatchingIDs(const LotCatalog& catalog, const LotSearchIndex& index, std::string_view query) {
+        std::vector<uint8_t> matches;
+        index.Search(query, matches);
+        std::vector<uint32_t> ids;
+        for (size_t i = 0; i < matches.size(); ++i) {
+            if (matches[i]) ids.push_back(catalog.GetID(static_cast<LotHandle>(i)));
+        }
+        return ids;
+    }
+} // namespace
+
+TEST_CASE(FoldLowercasesAndStripsAccents) {
+    CHECK_EQ(Fold("Maxis HQ"), std::string("maxis hq"));
+    CHECK_EQ(Fold("\xC3\x89glise Saint-Andr\xC3\xA9"), std::string("eglise saint-andre"));   // UTF-8
+    CHECK_EQ(Fold("\xC9glise Saint-Andr\xE9"), std::string("eglise saint-andre"));           // Windows-1252
+    CHECK_EQ(Fold("Stra\xC3\x9F" "e \xC3\x86gir"), std::string("strasse aegir"));
+    CHECK_EQ(Fold("2\xC3\x97" "3"), std::string("2\xC3\x97" "3"));                            // U+00D7 is kept
+    CHECK_EQ(Fold("\xE2\x82\xAC 5"), std::string("\xE2\x82\xAC 5"));                          // Other UTF-8 is kept
+}
+
+TEST_CASE(SearchMatchesNamesAndDescriptions) {
+    LotCatalog catalog;
+    catalog.Add(Lot(1, "Victorian Cottage", "A small house."));
+    catalog.Add(Lot(2, "Office Tower", "Tall glass COTTAGE-free offices."));
+    catalog.Add(Lot(3, "Caf\xC3\xA9 Am\xC3\xA9lie", ""));
+    catalog.Add(Lot(4, "Warehouse", "Storage near the station"));
+
+    LotSearchIndex index;
+    index.Build(catalog);
+    CHECK_EQ(index.GetSlotCount(), size_t(4));
+
+    CHECK((MatchingIDs(catalog, index, "cottage") == std::vector<uint32_t>{1, 2}));
+    CHECK((MatchingIDs(catalog, index, "CAFE") == std::vector<uint32_t>{3}));
+    CHECK((MatchingIDs(catalog, index, "caf\xC3\xA9") == std::vector<uint32_t>{3}));
+    CHECK((MatchingIDs(catalog, index, "station") == std::vector<uint32_t>{4}));
+    CHECK((MatchingIDs(catalog, index, "") == std::vector<uint32_t>{1, 2, 3, 4}));
+    CHECK(MatchingIDs(catalog, index, "nothing like this").empty());
+    // A match may not span the name and the description
+    CHECK(MatchingIDs(catalog, index, "cottagea").empty());
+}
+
+TEST_CASE(SlotContainsAgreesWithSearch) {
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, LotCatalogFixture::MakeLots(2000, 19));
+    LotSearchIndex index;
+    index.Build(catalog);
+
+    for (const char* query : {"c", "ca", "cottage", "eglise", "glass", "commuters", "#1999", "zzz"}) {
+        std::vector<uint8_t> matches;
+        index.Search(query, matches);
+        const std::string folded = Fold(query);
+        bool same = true;
+        for (uint32_t slot = 0; slot < matches.size(); ++slot) {
+            same = same && (matches[slot] != 0) == index.SlotContains(slot, folded);
+        }
+        CHECK(same);
+    }
+}
+
+TEST_CASE(RebuildChangesGeneration) {
+    LotCatalog catalog;
+    catalog.Add(Lot(1, "A", "B"));
+    LotSearchIndex index;
+    index.Build(catalog);
+    const uint32_t built = index.GetGeneration();
+    index.Clear();
+    CHECK(index.GetGeneration() != built);
+    CHECK_EQ(index.GetSlotCount(), size_t(0));
+
+    std::vector<uint8_t> matches{1, 1};
+    index.Search("a", matches);
+    CHECK(matches.empty());
+}
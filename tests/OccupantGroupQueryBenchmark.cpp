@@ -0,0 +1,102 @@
+// Occupant group filter time over a 50k-lot catalog: compiled bitset queries
+// (lots/OccupantGroupQuery.cpp) versus one hash lookup per query group per lot.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "LotCatalogFixture.h"
+#include "lots/LotCatalog.h"
+#include "lots/OccupantGroupQuery.h"
+
+namespace {
+    struct NamedQuery {
+        const char* name;
+        OccupantGroupQuery query;
+    };
+
+    bool MatchesByLookup(const OccupantGroupQuery& query, const std::unordered_set<uint32_t>& groups) {
+        bool any = query.anyOf.empty();
+        for (uint32_t g : query.anyOf) {
+            if (groups.count(g)) { any = true; break; }
+        }
+        if (!any) return false;
+        for (uint32_t g : query.allOf) {
+            if (!groups.count(g)) return false;
+        }
+        for (uint32_t g : query.noneOf) {
+            if (groups.count(g)) return false;
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 9;
+    const size_t lotCount = quick ? 5000 : 50000;
+
+    // Real plugin folders use a few hundred groups, so widen the bitsets to several words
+    auto lots = LotCatalogFixture::MakeLots(lotCount, 50);
+    std::mt19937 rng(0x1500);
+    for (auto& lot : lots) {
+        for (int extra = static_cast<int>(rng() % 4); extra > 0; --extra) lot.occupantGroups.push_back(0x2000 + rng() % 300);
+    }
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+
+    std::vector<std::unordered_set<uint32_t>> groupSets;
+    groupSets.reserve(lots.size());
+    for (const auto& lot : lots) groupSets.emplace_back(lot.occupantGroups.begin(), lot.occupantGroups.end());
+
+    std::vector<NamedQuery> queries(4);
+    queries[0].name = "any of 1";
+    queries[0].query.anyOf = {0x1000};
+    queries[1].name = "R AND landmark AND NOT worship";
+    queries[1].query.allOf = {0x1000, 0x1500};
+    queries[1].query.noneOf = {0x1503};
+    queries[2].name = "any of 8, none of 4";
+    queries[2].query.anyOf = {0x1000, 0x1001, 0x1002, 0x1010, 0x2001, 0x2050, 0x2100, 0x2200};
+    queries[2].query.noneOf = {0x1300, 0x1301, 0x2007, 0x2150};
+    queries[3].name = "any of 40 wide groups";
+    for (uint32_t g = 0; g < 40; ++g) queries[3].query.anyOf.push_back(0x2000 + g * 7);
+
+    std::printf("%zu lots, %zu groups (%zu words per lot)\n", catalog.GetCount(), catalog.GetGroupCount(), catalog.GetGroupWords());
+    const size_t loops = quick ? 1 : 50;
+    char name[96];
+    for (auto& [label, query] : queries) {
+        query.Normalize();
+        size_t lookupMatches = 0, compiledMatches = 0;
+
+        std::snprintf(name, sizeof(name), "%s, hash lookups (per filter)", label);
+        BenchHarness::Measure(name, loops, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) {
+                lookupMatches = 0;
+                for (const auto& groups : groupSets) lookupMatches += MatchesByLookup(query, groups);
+                BenchHarness::DoNotOptimize(lookupMatches);
+            }
+        });
+
+        std::snprintf(name, sizeof(name), "%s, compiled bitsets (per filter)", label);
+        BenchHarness::Measure(name, loops, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) {
+                CompiledGroupQuery compiled;
+                compiled.Compile(query, catalog);
+                compiledMatches = 0;
+                for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+                    compiledMatches += compiled.Matches(catalog.GetGroupBits(handle));
+                }
+                BenchHarness::DoNotOptimize(compiledMatches);
+            }
+        });
+
+        if (lookupMatches != compiledMatches) {
+            std::fprintf(stderr, "Match count mismatch for '%s': %zu vs %zu\n", label, lookupMatches, compiledMatches);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Tests for the any/all/none occupant group queries (lots/OccupantGroupQuery.cpp)
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "LotCatalogFixture.h"
+#include "TestHarness.h"
+#include "lots/LotCatalog.h"
+#include "lots/OccupantGroupQuery.h"
+
+namespace {
+    using Groups = std::vector<uint32_t>;
+    using Role = OccupantGroupQuery::Role;
+
+    OccupantGroupQuery Query(Groups anyOf, Groups allOf, Groups noneOf) {
+        OccupantGroupQuery query;
+        query.anyOf = std::move(anyOf);
+        query.allOf = std::move(allOf);
+        query.noneOf = std::move(noneOf);
+        return query;
+    }
+
+    // The query's meaning taken literally, whatever the sets contain
+    bool ReferenceMatches(const OccupantGroupQuery& query, const Groups& lotGroups) {
+        auto has = [&](uint32_t g) { return std::find(lotGroups.begin(), lotGroups.end(), g) != lotGroups.end(); };
+        const bool any = query.anyOf.empty() || std::any_of(query.anyOf.begin(), query.anyOf.end(), has);
+        return any && std::all_of(query.allOf.begin(), query.allOf.end(), has) &&
+               std::none_of(query.noneOf.begin(), query.noneOf.end(), has);
+    }
+
+    size_t CountMatches(const OccupantGroupQuery& normalized, const LotCatalog& catalog) {
+        CompiledGroupQuery compiled;
+        compiled.Compile(normalized, catalog);
+        size_t count = 0;
+        for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+            count += compiled.Matches(catalog.GetGroupBits(handle));
+        }
+        return count;
+    }
+} // namespace
+
+TEST_CASE(NormalizeSortsAndDeduplicates) {
+    auto query = Query({9, 3, 9}, {7, 1, 7}, {5, 5});
+    query.Normalize();
+    CHECK((query.anyOf == Groups{3, 9}));
+    CHECK((query.allOf == Groups{1, 7}));
+    CHECK((query.noneOf == Groups{5}));
+    CHECK(!query.matchesNothing);
+}
+
+TEST_CASE(RequiredAndExcludedGroupMatchesNothing) {
+    auto query = Query({}, {1, 2}, {2});
+    query.Normalize();
+    CHECK(query.matchesNothing);
+    // Kept as written so saving the settings doesn't turn it into "require 1 and 2"
+    CHECK((query.allOf == Groups{1, 2}));
+    CHECK((query.noneOf == Groups{2}));
+}
+
+TEST_CASE(EveryAnyGroupExcludedMatchesNothing) {
+    auto query = Query({4, 6}, {}, {4, 6, 8});
+    query.Normalize();
+    CHECK(query.matchesNothing);
+    CHECK((query.anyOf == Groups{4, 6}));
+}
+
+TEST_CASE(ExcludedAnyGroupIsDropped) {
+    // (4 or 6) and not 4 is 6 and not 4
+    auto query = Query({4, 6}, {}, {4});
+    query.Normalize();
+    CHECK(!query.matchesNothing);
+    CHECK((query.anyOf == Groups{6}));
+    CHECK((query.noneOf == Groups{4}));
+}
+
+TEST_CASE(RequiredAnyGroupLiftsAnyOf) {
+    // (4 or 6) and 4 is 4, not "4 and 6"
+    auto query = Query({4, 6}, {4}, {});
+    query.Normalize();
+    CHECK(!query.matchesNothing);
+    CHECK(query.anyOf.empty());
+    CHECK((query.allOf == Groups{4}));
+}
+
+TEST_CASE(SetRoleResolvesAContradiction) {
+    auto query = Query({}, {1, 2}, {2});
+    query.Normalize();
+    CHECK(query.matchesNothing);
+    CHECK(query.GetRole(2) == Role::All);
+
+    query.SetRole(2, Role::Exclude);
+    CHECK(!query.matchesNothing);
+    CHECK((query.allOf == Groups{1}));
+    CHECK((query.noneOf == Groups{2}));
+
+    query.SetRole(1, Role::Exclude);
+    query.SetRole(3, Role::Any);
+    CHECK(query.GetRole(3) == Role::Any);
+    CHECK(!query.matchesNothing);
+
+    query.Clear();
+    CHECK(query.IsEmpty());
+    CHECK(!query.matchesNothing);
+}
+
+TEST_CASE(IsNarrowedBy) {
+    const auto base = Query({1, 2, 3}, {4}, {5});
+    CHECK(base.IsNarrowedBy(Query({1, 2}, {4}, {5})));
+    CHECK(base.IsNarrowedBy(Query({1, 2, 3}, {4, 6}, {5, 7})));
+    CHECK(!base.IsNarrowedBy(Query({1, 2, 3, 8}, {4}, {5})));
+    CHECK(!base.IsNarrowedBy(Query({}, {4}, {5})));
+    CHECK(!base.IsNarrowedBy(Query({1}, {}, {5})));
+    CHECK(Query({}, {}, {}).IsNarrowedBy(base));
+
+    auto nothing = Query({}, {4}, {4});
+    nothing.Normalize();
+    CHECK(base.IsNarrowedBy(nothing));
+    CHECK(!nothing.IsNarrowedBy(base));
+    CHECK(nothing.IsNarrowedBy(nothing));
+}
+
+TEST_CASE(CompiledQueriesMatchTheReference) {
+    const auto lots = LotCatalogFixture::MakeLots(3000, 24);
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+
+    // Fixture groups plus one no lot has; sets may overlap like hand-edited settings
+    std::vector<uint32_t> pool(std::begin(LotCatalogFixture::kGroupIDs), std::end(LotCatalogFixture::kGroupIDs));
+    pool.push_back(0xDEAD);
+    std::mt19937 rng(0x24);
+    auto pick = [&](int maxCount) {
+        Groups groups;
+        for (int n = static_cast<int>(rng() % (maxCount + 1)); n > 0; --n) groups.push_back(pool[rng() % pool.size()]);
+        return groups;
+    };
+
+    for (int round = 0; round < 400; ++round) {
+        const auto raw = Query(pick(4), pick(2), pick(2));
+        auto normalized = raw;
+        normalized.Normalize();
+
+        CompiledGroupQuery compiled;
+        compiled.Compile(normalized, catalog);
+        bool same = true;
+        for (LotHandle handle = 0; handle < catalog.GetCount(); ++handle) {
+            same = same && compiled.Matches(catalog.GetGroupBits(handle)) == ReferenceMatches(raw, lots[handle].occupantGroups);
+        }
+        CHECK(same);
+    }
+}
+
+TEST_CASE(ContradictionsMatchNoLot) {
+    const auto lots = LotCatalogFixture::MakeLots(500, 3);
+    LotCatalog catalog;
+    LotCatalogFixture::Fill(catalog, lots);
+    const uint32_t g = LotCatalogFixture::kGroupIDs[0];
+
+    auto requireAndExclude = Query({}, {g}, {g});
+    requireAndExclude.Normalize();
+    CHECK_EQ(CountMatches(requireAndExclude, catalog), size_t(0));
+
+    auto allAnyExcluded = Query({g}, {}, {g});
+    allAnyExcluded.Normalize();
+    CHECK_EQ(CountMatches(allAnyExcluded, catalog), size_t(0));
+
+    auto requireOnly = Query({}, {g}, {});
+    requireOnly.Normalize();
+    CHECK(CountMatches(requireOnly, catalog) > 0);
+}
@@ -0,0 +1,58 @@
+// Throughput of the uncompressed FSH pixel kernels (s3d/FSHPixelConvert.cpp), per kernel set
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "s3d/FSHPixelConvert.h"
+
+int main(int argc, char** argv) {
+    using FSH::PixelConvert::KernelSet;
+
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 9;
+
+    struct Format {
+        const char* name;
+        FSH::PixelConvert::ConvertFn KernelSet::*kernel;
+        size_t bytesPerPixel;
+    };
+    const Format formats[] = {
+        {"bgra8888", &KernelSet::bgra8888, 4},
+        {"bgr888", &KernelSet::bgr888, 3},
+        {"argb4444", &KernelSet::argb4444, 2},
+        {"rgb565", &KernelSet::rgb565, 2},
+        {"argb1555", &KernelSet::argb1555, 2},
+    };
+    const KernelSet* sets[] = {
+        &FSH::PixelConvert::GetScalarKernels(),
+        FSH::PixelConvert::GetSSE2Kernels(),
+        FSH::PixelConvert::GetAVX2Kernels(),
+    };
+
+    std::mt19937 rng(0xF5);
+    for (uint32_t dim : {256u, 512u}) {
+        const size_t pixels = static_cast<size_t>(dim) * dim;
+        std::vector<uint8_t> src(pixels * 4);
+        for (uint8_t& b : src) b = static_cast<uint8_t>(rng());
+        std::vector<uint8_t> rgba(pixels * 4);
+        const size_t images = quick ? 1 : (16u * 1024 * 1024) / pixels;
+
+        for (const Format& format : formats) {
+            for (const KernelSet* kernels : sets) {
+                if (!kernels) continue;
+                char name[64];
+                std::snprintf(name, sizeof(name), "%s %ux%u, %s (per pixel)", format.name, dim, dim, kernels->name);
+                const auto convert = kernels->*format.kernel;
+                BenchHarness::Measure(name, images * pixels, repetitions, [&] {
+                    for (size_t i = 0; i < images; ++i) {
+                        convert(src.data(), rgba.data(), pixels);
+                        BenchHarness::DoNotOptimize(rgba[i % rgba.size()]);
+                    }
+                });
+            }
+        }
+    }
+    return 0;
+}
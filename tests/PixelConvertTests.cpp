@@ -0,0 +1,123 @@
+// Tests for the uncompressed FSH pixel kernels (s3d/FSHPixelConvert.cpp): the scalar
+// kernels against known pixels, and every SIMD kernel set bit-exact against the scalar one
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+#include "s3d/FSHPixelConvert.h"
+#include "s3d/FSHStructures.h"
+
+namespace {
+    using Bytes = std::vector<uint8_t>;
+    using FSH::PixelConvert::ConvertFn;
+    using FSH::PixelConvert::KernelSet;
+
+    struct Format {
+        const char* name;
+        ConvertFn KernelSet::*kernel;
+        size_t bytesPerPixel;
+    };
+
+    constexpr Format kFormats[] = {
+        {"bgra8888", &KernelSet::bgra8888, 4},
+        {"bgr888", &KernelSet::bgr888, 3},
+        {"argb4444", &KernelSet::argb4444, 2},
+        {"rgb565", &KernelSet::rgb565, 2},
+        {"argb1555", &KernelSet::argb1555, 2},
+    };
+
+    constexpr uint8_t kCanary = 0xCD;
+
+    Bytes Convert(ConvertFn fn, const Bytes& src, size_t count) {
+        Bytes dst(count * 4, 0);
+        fn(src.data(), dst.data(), count);
+        return dst;
+    }
+
+    // Runs kernels against the scalar reference for count pixels read from srcOffset bytes into a
+    // random buffer and written dstOffset bytes into an output with a canary on either side
+    bool MatchesScalar(const KernelSet& kernels, const Format& format, size_t count, size_t srcOffset,
+                       size_t dstOffset, std::mt19937& rng) {
+        Bytes src(srcOffset + count * format.bytesPerPixel);
+        for (uint8_t& b : src) b = static_cast<uint8_t>(rng());
+
+        Bytes expected(count * 4 + 1);
+        (FSH::PixelConvert::GetScalarKernels().*format.kernel)(src.data() + srcOffset, expected.data(), count);
+
+        Bytes actual(dstOffset + count * 4 + 16, kCanary);
+        (kernels.*format.kernel)(src.data() + srcOffset, actual.data() + dstOffset, count);
+
+        for (size_t i = 0; i < actual.size(); ++i) {
+            const bool inside = i >= dstOffset && i < dstOffset + count * 4;
+            if (actual[i] != (inside ? expected[i - dstOffset] : kCanary)) {
+                std::fprintf(stderr, "  %s %s: count %zu, src +%zu, dst +%zu differs at byte %zu\n",
+                             kernels.name, format.name, count, srcOffset, dstOffset, i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CheckKernelSet(const KernelSet* kernels) {
+        if (!kernels) {
+            std::printf("  kernel set not available here, skipped\n");
+            return;
+        }
+        std::mt19937 rng(0x505);
+        for (const Format& format : kFormats) {
+            CHECK((kernels->*format.kernel) != nullptr);
+
+            // Every tail length for the widest vectors, then a few odd sizes past them
+            bool same = true;
+            for (size_t count = 0; count < 300 && same; ++count) {
+                same = MatchesScalar(*kernels, format, count, count % 4, (count / 4) % 3, rng);
+            }
+            for (size_t count : {1023u, 4097u, 65537u}) {
+                for (size_t offset = 0; offset < 4 && same; ++offset) {
+                    same = MatchesScalar(*kernels, format, count, offset, 3 - offset, rng);
+                }
+            }
+            CHECK(same);
+        }
+    }
+} // namespace
+
+TEST_CASE(ScalarKernelsMatchKnownPixels) {
+    const KernelSet& scalar = FSH::PixelConvert::GetScalarKernels();
+
+    CHECK((Convert(scalar.bgra8888, {0x10, 0x20, 0x30, 0x40}, 1) == Bytes{0x30, 0x20, 0x10, 0x40}));
+    CHECK((Convert(scalar.bgr888, {0x10, 0x20, 0x30, 0x01, 0x02, 0x03}, 2) ==
+           Bytes{0x30, 0x20, 0x10, 0xFF, 0x03, 0x02, 0x01, 0xFF}));
+    // 0x8A5C: a=8 r=A g=5 b=C
+    CHECK((Convert(scalar.argb4444, {0x5C, 0x8A}, 1) == Bytes{0xAA, 0x55, 0xCC, 0x88}));
+    // Full and empty 565 channels expand to 255 and 0; r=1 g=1 b=1 keep their low bits
+    CHECK((Convert(scalar.rgb565, {0xFF, 0xFF, 0x00, 0x00, 0x21, 0x08}, 3) ==
+           Bytes{0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x08, 0x04, 0x08, 0xFF}));
+    // Alpha is the top bit only
+    CHECK((Convert(scalar.argb1555, {0xFF, 0xFF, 0xFF, 0x7F}, 2) ==
+           Bytes{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00}));
+}
+
+TEST_CASE(SSE2KernelsMatchScalar) {
+    CheckKernelSet(FSH::PixelConvert::GetSSE2Kernels());
+}
+
+TEST_CASE(AVX2KernelsMatchScalar) {
+    CheckKernelSet(FSH::PixelConvert::GetAVX2Kernels());
+}
+
+TEST_CASE(DispatchedKernelsMatchScalar) {
+    CheckKernelSet(&FSH::PixelConvert::GetKernels());
+}
+
+TEST_CASE(ConvertLevelChecksSizes) {
+    const Bytes level(8 * 4 * 2, 0x7F);
+    Bytes rgba(8 * 4 * 4, 0);
+    CHECK(FSH::PixelConvert::ConvertLevelToRGBA8(FSH::CODE_16BIT_0565, 8, 4, level.data(), level.size(), rgba.data()));
+    CHECK(!FSH::PixelConvert::ConvertLevelToRGBA8(FSH::CODE_16BIT_0565, 8, 4, level.data(), level.size() - 1, rgba.data()));
+    CHECK(!FSH::PixelConvert::ConvertLevelToRGBA8(FSH::CODE_32BIT, 8, 4, level.data(), level.size(), rgba.data()));
+    CHECK(!FSH::PixelConvert::ConvertLevelToRGBA8(0x42, 8, 4, level.data(), level.size(), rgba.data()));
+    CHECK(!FSH::PixelConvert::ConvertLevelToRGBA8(FSH::CODE_16BIT_0565, 8, 4, nullptr, level.size(), rgba.data()));
+}
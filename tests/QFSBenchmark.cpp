@@ -0,0 +1,59 @@
+// QFS/RefPack decode throughput (s3d/QFSCore.h) in MB/s of decoded output.
+// Pass .qfs/.fsh files to measure real samples: compressed files are decoded as they are
+// (bare or with a DBPF size prefix), uncompressed ones are compressed first. Without files,
+// synthetic FSH textures and random bytes are used.
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "QFSSamples.h"
+#include "s3d/QFSCompressor.h"
+#include "s3d/QFSCore.h"
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 9;
+
+    auto samples = QFSSamples::LoadFiles(argc, argv);
+    if (samples.empty()) samples = QFSSamples::MakeSynthetic();
+
+    for (const auto& sample : samples) {
+        if (sample.data.empty()) {
+            std::fprintf(stderr, "%s: empty, skipped\n", sample.name.c_str());
+            continue;
+        }
+        std::vector<uint8_t> stream = sample.data;
+        QFS::Framing framing = QFS::Framing::Bare;
+        QFS::Header header;
+        if (QFS::ParseHeader(stream.data(), stream.size(), framing, header) != QFS::Status::Ok) {
+            framing = QFS::Framing::DBPFPrefix;
+            if (QFS::ParseHeader(stream.data(), stream.size(), framing, header) != QFS::Status::Ok) {
+                framing = QFS::Framing::Bare;
+                QFS::Compressor::Compress(sample.data.data(), sample.data.size(), stream);
+                QFS::ParseHeader(stream.data(), stream.size(), framing, header);
+            }
+        }
+
+        std::vector<uint8_t> output(header.uncompressedSize + QFS::OUTPUT_SLACK);
+        const uint8_t* body = stream.data() + header.headerSize;
+        const size_t bodySize = stream.size() - header.headerSize;
+        if (QFS::DecodeBody(body, bodySize, output.data(), header.uncompressedSize) != QFS::Status::Ok) {
+            std::fprintf(stderr, "%s: not a valid QFS stream\n", sample.name.c_str());
+            return 1;
+        }
+
+        const size_t loops = quick ? 1 : (64u * 1024 * 1024) / (header.uncompressedSize + 1) + 1;
+        char name[128];
+        std::snprintf(name, sizeof(name), "%s, %zu -> %u bytes (per byte)", sample.name.c_str(),
+                      stream.size(), header.uncompressedSize);
+        const double nsPerByte = BenchHarness::Measure(name, loops * header.uncompressedSize, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) {
+                QFS::DecodeBody(body, bodySize, output.data(), header.uncompressedSize);
+                BenchHarness::DoNotOptimize(output[i % header.uncompressedSize]);
+            }
+        });
+        std::printf("    decode %.0f MB/s\n", 1000.0 / nsPerByte);
+    }
+    return 0;
+}
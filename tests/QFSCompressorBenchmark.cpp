@@ -0,0 +1,70 @@
+// Compression ratio and throughput of the QFS compressor (s3d/QFSCompressor.cpp) per
+// CompressionLevel, on lot cache snapshot payloads and FSH textures (or files given on the
+// command line). Every stream is decoded again to check it round-trips.
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "QFSSamples.h"
+#include "s3d/QFSCompressor.h"
+#include "s3d/QFSCore.h"
+
+namespace {
+    bool RoundTrips(const std::vector<uint8_t>& stream, const std::vector<uint8_t>& expected) {
+        QFS::Header header;
+        if (QFS::ParseHeader(stream.data(), stream.size(), QFS::Framing::Bare, header) != QFS::Status::Ok) return false;
+        if (header.uncompressedSize != expected.size()) return false;
+        std::vector<uint8_t> output(expected.size() + QFS::OUTPUT_SLACK);
+        const auto status = QFS::DecodeBody(stream.data() + header.headerSize, stream.size() - header.headerSize,
+                                            output.data(), expected.size());
+        output.resize(expected.size());
+        return status == QFS::Status::Ok && output == expected;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 5;
+
+    auto samples = QFSSamples::LoadFiles(argc, argv);
+    if (samples.empty()) {
+        samples = {
+            {"snapshot payload, 2k lots", QFSSamples::MakeSnapshotPayload(quick ? 200 : 2000, 4)},
+            {"snapshot payload, 20k lots", QFSSamples::MakeSnapshotPayload(quick ? 500 : 20000, 4)},
+        };
+        for (auto& sample : QFSSamples::MakeSynthetic()) samples.push_back(std::move(sample));
+    }
+
+    struct Level {
+        const char* name;
+        QFS::CompressionLevel level;
+    };
+    const Level levels[] = {
+        {"fast", QFS::CompressionLevel::Fast},
+        {"normal", QFS::CompressionLevel::Normal},
+        {"best", QFS::CompressionLevel::Best},
+    };
+
+    for (const auto& sample : samples) {
+        if (sample.data.empty()) continue;
+        for (const Level& level : levels) {
+            std::vector<uint8_t> stream;
+            char name[128];
+            std::snprintf(name, sizeof(name), "%s, %s (per byte)", sample.name.c_str(), level.name);
+            const double nsPerByte = BenchHarness::Measure(name, sample.data.size(), repetitions, [&] {
+                QFS::Compressor::Compress(sample.data.data(), sample.data.size(), stream, level.level);
+                BenchHarness::DoNotOptimize(stream.size());
+            });
+            std::printf("    %zu -> %zu bytes, ratio %.1f%%, compress %.1f MB/s\n", sample.data.size(), stream.size(),
+                        100.0 * static_cast<double>(stream.size()) / static_cast<double>(sample.data.size()),
+                        1000.0 / nsPerByte);
+
+            if (!RoundTrips(stream, sample.data)) {
+                std::fprintf(stderr, "%s, %s: the stream does not decode back to the input\n", sample.name.c_str(), level.name);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
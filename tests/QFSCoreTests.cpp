@@ -0,0 +1,220 @@
+// Round-trip and error-path tests for the QFS/RefPack codec (s3d/QFSCore.h, s3d/QFSCompressor.cpp)
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TestHarness.h"
+#include "s3d/QFSCompressor.h"
+#include "s3d/QFSCore.h"
+
+namespace {
+    using Bytes = std::vector<uint8_t>;
+
+    // Straightforward byte-at-a-time decoder, the reference for DecodeBody's chunked copies
+    bool ReferenceDecode(const Bytes& stream, size_t headerSize, size_t outputSize, Bytes& out) {
+        out.clear();
+        size_t in = headerSize;
+        auto literals = [&](size_t count) {
+            if (in + count > stream.size()) return false;
+            out.insert(out.end(), stream.begin() + in, stream.begin() + in + count);
+            in += count;
+            return true;
+        };
+        while (in < stream.size()) {
+            const uint8_t b0 = stream[in];
+            size_t literal = 0, length = 0, offset = 0;
+            if (b0 <= 0x7F) {
+                if (in + 2 > stream.size()) return false;
+                literal = b0 & 0x03;
+                length = ((b0 & 0x1C) >> 2) + 3;
+                offset = ((b0 & 0x60) << 3) + stream[in + 1] + 1;
+                in += 2;
+            } else if (b0 <= 0xBF) {
+                if (in + 3 > stream.size()) return false;
+                literal = (stream[in + 1] >> 6) & 0x03;
+                length = (b0 & 0x3F) + 4;
+                offset = ((stream[in + 1] & 0x3F) << 8) + stream[in + 2] + 1;
+                in += 3;
+            } else if (b0 <= 0xDF) {
+                if (in + 4 > stream.size()) return false;
+                literal = b0 & 0x03;
+                length = ((b0 & 0x0C) << 6) + stream[in + 3] + 5;
+                offset = ((b0 & 0x10) << 12) + (stream[in + 1] << 8) + stream[in + 2] + 1;
+                in += 4;
+            } else if (b0 <= 0xFB) {
+                literal = ((b0 & 0x1F) << 2) + 4;
+                in += 1;
+            } else {
+                in += 1;
+                if (!literals(b0 & 0x03)) return false;
+                break;
+            }
+            if (!literals(literal)) return false;
+            if (offset > out.size()) return false;
+            for (size_t i = 0; i < length; ++i) out.push_back(out[out.size() - offset]);
+        }
+        return out.size() == outputSize;
+    }
+
+    QFS::Status Decode(const Bytes& stream, QFS::Framing framing, Bytes& out) {
+        QFS::Header header;
+        const QFS::Status status = QFS::ParseHeader(stream.data(), stream.size(), framing, header);
+        if (status != QFS::Status::Ok) return status;
+        out.assign(header.uncompressedSize + QFS::OUTPUT_SLACK, 0);
+        const QFS::Status body = QFS::DecodeBody(stream.data() + header.headerSize, stream.size() - header.headerSize,
+                                                 out.data(), header.uncompressedSize);
+        out.resize(header.uncompressedSize);
+        return body;
+    }
+
+    void CheckRoundTrip(const Bytes& input, QFS::CompressionLevel level) {
+        Bytes compressed;
+        CHECK(QFS::Compressor::Compress(input.data(), input.size(), compressed, level));
+        CHECK(compressed.size() <= QFS::Compressor::GetMaxCompressedSize(input.size()));
+
+        Bytes decoded;
+        CHECK(Decode(compressed, QFS::Framing::Bare, decoded) == QFS::Status::Ok);
+        CHECK(decoded == input);
+
+        QFS::Header header;
+        CHECK(QFS::ParseHeader(compressed.data(), compressed.size(), QFS::Framing::Bare, header) == QFS::Status::Ok);
+        Bytes reference;
+        CHECK(ReferenceDecode(compressed, header.headerSize, input.size(), reference));
+        CHECK(reference == input);
+    }
+
+    void CheckAllLevels(const Bytes& input) {
+        CheckRoundTrip(input, QFS::CompressionLevel::Fast);
+        CheckRoundTrip(input, QFS::CompressionLevel::Normal);
+        CheckRoundTrip(input, QFS::CompressionLevel::Best);
+    }
+
+    Bytes RandomBytes(size_t size, uint32_t seed, int alphabet = 256) {
+        std::mt19937 rng(seed);
+        Bytes bytes(size);
+        for (uint8_t& b : bytes) b = static_cast<uint8_t>(rng() % alphabet);
+        return bytes;
+    }
+
+    // Bare header for a hand-written stream
+    Bytes Header(uint32_t uncompressedSize) {
+        return {0x10, 0xFB, static_cast<uint8_t>(uncompressedSize >> 16),
+                static_cast<uint8_t>(uncompressedSize >> 8), static_cast<uint8_t>(uncompressedSize)};
+    }
+
+    // Two-byte match opcode: literal 0..3, length 3..10, offset 1..1024
+    void ShortMatch(Bytes& stream, uint8_t literal, size_t length, size_t offset) {
+        stream.push_back(static_cast<uint8_t>((((offset - 1) >> 3) & 0x60) | ((length - 3) << 2) | literal));
+        stream.push_back(static_cast<uint8_t>((offset - 1) & 0xFF));
+    }
+} // namespace
+
+TEST_CASE(RoundTripsEmptyInput) {
+    CheckAllLevels({});
+}
+
+TEST_CASE(RoundTripsIncompressibleData) {
+    CheckAllLevels(RandomBytes(1, 1));
+    CheckAllLevels(RandomBytes(7, 2));
+    CheckAllLevels(RandomBytes(4096, 3));
+    CheckAllLevels(RandomBytes(100000, 4));
+}
+
+TEST_CASE(RoundTripsRepetitiveData) {
+    CheckAllLevels(Bytes(100000, 0xAB));
+    CheckAllLevels(RandomBytes(50000, 5, 4));
+
+    // Every short period, which DecodeBody copies with a replicated pattern
+    for (size_t period = 1; period <= 17; ++period) {
+        Bytes input;
+        for (size_t i = 0; i < 3000; ++i) input.push_back(static_cast<uint8_t>('a' + i % period));
+        CheckRoundTrip(input, QFS::CompressionLevel::Normal);
+    }
+}
+
+TEST_CASE(RoundTripsPastTheMatchWindow) {
+    // Repeats further back than the 128 KiB window must not be referenced
+    const Bytes block = RandomBytes(70000, 6);
+    Bytes input;
+    for (int i = 0; i < 4; ++i) input.insert(input.end(), block.begin(), block.end());
+    CheckRoundTrip(input, QFS::CompressionLevel::Fast);
+    CheckRoundTrip(input, QFS::CompressionLevel::Best);
+}
+
+TEST_CASE(RoundTripsLargeSizes) {
+    // Over 16 MiB needs the 4-byte size fields
+    Bytes input(0x1000010, 0);
+    for (size_t i = 0; i < input.size(); i += 4093) input[i] = static_cast<uint8_t>(i);
+    Bytes compressed;
+    CHECK(QFS::Compressor::Compress(input.data(), input.size(), compressed, QFS::CompressionLevel::Fast));
+    CHECK(compressed[0] & QFS::FLAG_LARGE_SIZES);
+    Bytes decoded;
+    CHECK(Decode(compressed, QFS::Framing::Bare, decoded) == QFS::Status::Ok);
+    CHECK(decoded == input);
+}
+
+TEST_CASE(DecodesHandWrittenOverlappingMatches) {
+    // "ab" then a 10-byte match at offset 2 overlapping its own output
+    Bytes stream = Header(12);
+    ShortMatch(stream, 2, 10, 2);
+    stream.push_back('a');
+    stream.push_back('b');
+    stream.push_back(0xFC);
+
+    Bytes decoded;
+    CHECK(Decode(stream, QFS::Framing::Bare, decoded) == QFS::Status::Ok);
+    CHECK(std::string(decoded.begin(), decoded.end()) == "abababababab");
+}
+
+TEST_CASE(ReadsTheFramingTheCallerStates) {
+    Bytes compressed;
+    const Bytes input = RandomBytes(256, 7, 3);
+    CHECK(QFS::Compressor::Compress(input.data(), input.size(), compressed));
+
+    // The same stream behind a DBPF compressed-size prefix
+    Bytes prefixed = {0, 0, 0, 0};
+    const uint32_t total = static_cast<uint32_t>(compressed.size() + 4);
+    for (int i = 0; i < 4; ++i) prefixed[i] = static_cast<uint8_t>(total >> (8 * i));
+    prefixed.insert(prefixed.end(), compressed.begin(), compressed.end());
+
+    Bytes decoded;
+    CHECK(Decode(prefixed, QFS::Framing::DBPFPrefix, decoded) == QFS::Status::Ok);
+    CHECK(decoded == input);
+    CHECK(Decode(prefixed, QFS::Framing::Bare, decoded) == QFS::Status::BadMagic);
+    CHECK(Decode(compressed, QFS::Framing::DBPFPrefix, decoded) != QFS::Status::Ok);
+
+    // Bytes 4-5 of a bare buffer that look like a magic are not a header
+    const Bytes lookalike = {'S', 'H', 'P', 'I', 0x10, 0xFB, 0, 0, 4, 0, 0, 0};
+    CHECK(!QFS::IsCompressed(lookalike.data(), lookalike.size(), QFS::Framing::Bare));
+    CHECK(!QFS::IsCompressed(lookalike.data(), 3, QFS::Framing::DBPFPrefix));
+}
+
+TEST_CASE(RejectsMalformedStreams) {
+    Bytes decoded;
+    CHECK(Decode({0x00, 0x00, 0x00, 0x00, 0x05}, QFS::Framing::Bare, decoded) == QFS::Status::BadMagic);
+    CHECK(Decode({0x10, 0xFB, 0x00}, QFS::Framing::Bare, decoded) == QFS::Status::TruncatedHeader);
+
+    // Match before the start of the output
+    Bytes badOffset = Header(4);
+    ShortMatch(badOffset, 0, 4, 1);
+    CHECK(Decode(badOffset, QFS::Framing::Bare, decoded) == QFS::Status::BadOffset);
+
+    // Literal run longer than the declared size
+    Bytes overrun = Header(2);
+    overrun.push_back(0xE0);
+    overrun.insert(overrun.end(), 4, 'x');
+    CHECK(Decode(overrun, QFS::Framing::Bare, decoded) == QFS::Status::OutputOverrun);
+
+    // Literal run cut short by the end of the input
+    Bytes truncated = Header(8);
+    truncated.push_back(0xE1);
+    truncated.insert(truncated.end(), 3, 'x');
+    CHECK(Decode(truncated, QFS::Framing::Bare, decoded) == QFS::Status::TruncatedInput);
+
+    // Stream ends before producing the declared size
+    Bytes shortStream = Header(10);
+    shortStream.push_back(0xFD);
+    shortStream.push_back('x');
+    CHECK(Decode(shortStream, QFS::Framing::Bare, decoded) == QFS::Status::SizeMismatch);
+}
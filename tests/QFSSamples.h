@@ -0,0 +1,155 @@
+/*
+ * Sample inputs for the QFS benchmarks: single-bitmap FSH files shaped like plugin textures
+ * (flat panels with sparse noise, or DXT blocks), lot cache snapshot payloads and
+ * incompressible bytes, plus loading of real .qfs/.fsh files given on the command line.
+ */
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LotCatalogFixture.h"
+#include "cache/LotCacheSnapshot.h"
+#include "s3d/FSHStructures.h"
+
+namespace QFSSamples {
+    using Bytes = std::vector<uint8_t>;
+
+    struct Sample {
+        std::string name;
+        Bytes data;
+    };
+
+    template <typename T>
+    void Append(Bytes& out, const T& value) {
+        const size_t at = out.size();
+        out.resize(at + sizeof(T));
+        std::memcpy(out.data() + at, &value, sizeof(T));
+    }
+
+    // An SHPI file holding one dim x dim bitmap of the given code (32-bit, 565 or DXT1)
+    inline Bytes MakeFSH(uint8_t code, uint32_t dim, uint32_t seed) {
+        std::mt19937 rng(seed);
+        Bytes pixels;
+        // Flat 16x16 panels (walls, roofs, windows) with sparse one-step noise
+        auto channel = [&](uint32_t x, uint32_t y, uint32_t phase) {
+            const uint32_t panel = ((x / 16) * 7919u + (y / 16) * 104729u + phase * 31u) * 2654435761u;
+            const int noise = rng() % 8 == 0 ? static_cast<int>(rng() % 3) - 1 : 0;
+            return static_cast<uint8_t>(static_cast<int>((panel >> 24) | 1) + noise);
+        };
+        if (code == FSH::CODE_DXT1) {
+            // Endpoints follow the gradient block by block; indices are mostly runs
+            for (uint32_t by = 0; by < dim / 4; ++by) {
+                for (uint32_t bx = 0; bx < dim / 4; ++bx) {
+                    const auto c0 = static_cast<uint16_t>(((bx * 2) & 0x1F) << 11 | ((by * 4) & 0x3F) << 5 | 0x10);
+                    const auto c1 = static_cast<uint16_t>(c0 - 0x0841);
+                    Append(pixels, c0);
+                    Append(pixels, c1);
+                    const uint32_t indices = rng() % 4 == 0 ? static_cast<uint32_t>(rng()) : 0x55AA55AAu >> (rng() % 2);
+                    Append(pixels, indices);
+                }
+            }
+        }
+        else {
+            for (uint32_t y = 0; y < dim; ++y) {
+                for (uint32_t x = 0; x < dim; ++x) {
+                    const uint8_t r = channel(x, y, 0), g = channel(x, y, 1), b = channel(x, y, 2);
+                    if (code == FSH::CODE_16BIT_0565) {
+                        Append(pixels, static_cast<uint16_t>((r >> 3) << 11 | (g >> 2) << 5 | (b >> 3)));
+                    }
+                    else {
+                        const uint8_t bgra[4] = {b, g, r, static_cast<uint8_t>(x < dim / 8 ? 0 : 255)};
+                        pixels.insert(pixels.end(), bgra, bgra + 4);
+                    }
+                }
+            }
+        }
+
+        Bytes file;
+        const uint32_t entryOffset = sizeof(FSH::FileHeader) + sizeof(FSH::DirectoryEntry);
+        const uint32_t size = entryOffset + static_cast<uint32_t>(sizeof(FSH::BitmapHeader) + pixels.size());
+        Append(file, FSH::FileHeader{FSH::MAGIC_SHPI, size, 1, 0x584D4947});
+        FSH::DirectoryEntry entry{};
+        std::memcpy(entry.name, "0000", 4);
+        entry.offset = entryOffset;
+        Append(file, entry);
+        const uint32_t codeAndSize = code | (static_cast<uint32_t>(sizeof(FSH::BitmapHeader) + pixels.size()) << 8);
+        Append(file, FSH::BitmapHeader{codeAndSize, static_cast<uint16_t>(dim), static_cast<uint16_t>(dim), {}});
+        file.insert(file.end(), pixels.begin(), pixels.end());
+        return file;
+    }
+
+    // The payload LotCacheSnapshot::Save compresses: records, then group IDs, then strings
+    inline Bytes MakeSnapshotPayload(size_t lotCount, uint32_t seed) {
+        const auto lots = LotCatalogFixture::MakeLots(lotCount, seed);
+        std::vector<LotCacheSnapshot::SnapshotEntry> entries;
+        std::vector<uint32_t> groups;
+        std::string strings;
+        for (const auto& lot : lots) {
+            LotCacheSnapshot::SnapshotEntry rec{};
+            rec.id = lot.id;
+            rec.nameOffset = static_cast<uint32_t>(strings.size());
+            rec.nameLength = static_cast<uint32_t>(lot.name.size());
+            strings += lot.name;
+            rec.descriptionOffset = static_cast<uint32_t>(strings.size());
+            rec.descriptionLength = static_cast<uint32_t>(lot.description.size());
+            strings += lot.description;
+            rec.sizeX = lot.sizeX;
+            rec.sizeZ = lot.sizeZ;
+            rec.minCapacity = lot.minCapacity;
+            rec.maxCapacity = lot.maxCapacity;
+            rec.growthStage = lot.growthStage;
+            rec.wealthMask = lot.wealthMask;
+            rec.zoneMask = lot.zoneMask;
+            rec.groupsOffset = static_cast<uint32_t>(groups.size());
+            rec.groupsCount = static_cast<uint32_t>(lot.occupantGroups.size());
+            groups.insert(groups.end(), lot.occupantGroups.begin(), lot.occupantGroups.end());
+            rec.iconInstance = lot.id ^ 0x2A3858E4u;
+            rec.buildingExemplarGroup = 0x07BDDF1C;
+            rec.buildingExemplarID = lot.id + 0x1000;
+            entries.push_back(rec);
+        }
+
+        Bytes payload;
+        for (const auto& rec : entries) Append(payload, rec);
+        for (uint32_t group : groups) Append(payload, group);
+        payload.insert(payload.end(), strings.begin(), strings.end());
+        return payload;
+    }
+
+    inline Bytes MakeRandom(size_t size, uint32_t seed) {
+        std::mt19937 rng(seed);
+        Bytes out(size);
+        for (uint8_t& b : out) b = static_cast<uint8_t>(rng());
+        return out;
+    }
+
+    inline std::vector<Sample> MakeSynthetic() {
+        return {
+            {"fsh 32-bit 256x256", MakeFSH(FSH::CODE_32BIT, 256, 1)},
+            {"fsh 565 256x256", MakeFSH(FSH::CODE_16BIT_0565, 256, 2)},
+            {"fsh dxt1 512x512", MakeFSH(FSH::CODE_DXT1, 512, 3)},
+            {"random 256 KiB", MakeRandom(256 * 1024, 4)},
+        };
+    }
+
+    // Files named on the command line (anything not starting with "--")
+    inline std::vector<Sample> LoadFiles(int argc, char** argv) {
+        std::vector<Sample> samples;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strncmp(argv[i], "--", 2) == 0) continue;
+            std::ifstream file(argv[i], std::ios::binary);
+            if (!file) {
+                std::fprintf(stderr, "Cannot open %s\n", argv[i]);
+                continue;
+            }
+            samples.push_back({argv[i], Bytes(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>())});
+        }
+        return samples;
+    }
+} // namespace QFSSamples
@@ -0,0 +1,195 @@
+// Vertex decode throughput of S3D::Reader::Parse against the per-field reads it replaced.
+//
+//   s3d_reader_benchmark [--quick] [model.s3d ...]
+//
+// Pass real .S3D files (e.g. exported from a plugin with a DBPF editor) to time those;
+// without files a set of synthetic models in the common layouts is used.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "S3DTestModel.h"
+#include "s3d/S3DReader.h"
+
+namespace {
+    struct Sample {
+        std::string name;
+        std::vector<uint8_t> bytes;
+        size_t vertexCount = 0;
+    };
+
+    // The reader's decode before bulk decoding: every field through a bounds-checked read,
+    // with the bounding box updated per vertex.
+    // Walks HEAD, VERT and INDX only, which is where the models spend their bytes.
+    class PerFieldReader {
+    public:
+        static bool Decode(const uint8_t* data, size_t size, std::vector<S3D::Vertex>& vertices,
+                           std::vector<uint16_t>& indices, float& bounds) {
+            const uint8_t* ptr = data + 8;
+            const uint8_t* end = data + size;
+            uint16_t major, minor;
+            if (!Skip(ptr, end, 8) || !Read(ptr, end, major) || !Read(ptr, end, minor)) return false;
+
+            uint32_t blocks;
+            if (!Skip(ptr, end, 8) || !Read(ptr, end, blocks)) return false;
+            for (uint32_t b = 0; b < blocks; ++b) {
+                uint16_t flags, count;
+                uint32_t format, stride;
+                if (!Read(ptr, end, flags) || !Read(ptr, end, count)) return false;
+                if (minor >= 4) {
+                    if (!Read(ptr, end, format)) return false;
+                    stride = 12 * (format & 0x3) + 4 * ((format >> 8) & 0x3) + 8 * ((format >> 14) & 0x3);
+                } else {
+                    uint16_t format16, stride16;
+                    if (!Read(ptr, end, format16) || !Read(ptr, end, stride16)) return false;
+                    format = format16;
+                    stride = stride16;
+                }
+                vertices.resize(count);
+                S3D::Vector3 bbMin, bbMax;
+                for (uint16_t v = 0; v < count; ++v) {
+                    if (!ReadVertex(ptr, end, format, stride, vertices[v])) return false;
+
+                    const auto& pos = vertices[v].position;
+                    if (v == 0) {
+                        bbMin = bbMax = pos;
+                    } else {
+                        bbMin = S3D::Vector3((std::min)(bbMin.x, pos.x), (std::min)(bbMin.y, pos.y), (std::min)(bbMin.z, pos.z));
+                        bbMax = S3D::Vector3((std::max)(bbMax.x, pos.x), (std::max)(bbMax.y, pos.y), (std::max)(bbMax.z, pos.z));
+                    }
+                }
+                bounds = bbMax.x - bbMin.x;
+            }
+
+            if (!Skip(ptr, end, 8) || !Read(ptr, end, blocks)) return false;
+            for (uint32_t b = 0; b < blocks; ++b) {
+                uint16_t flags, stride, count;
+                if (!Read(ptr, end, flags) || !Read(ptr, end, stride) || !Read(ptr, end, count)) return false;
+                indices.resize(count);
+                for (uint16_t i = 0; i < count; ++i) {
+                    if (!Read(ptr, end, indices[i])) return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        template <typename T>
+        static bool Read(const uint8_t*& ptr, const uint8_t* end, T& value) {
+            if (ptr + sizeof(T) > end) return false;
+            std::memcpy(&value, ptr, sizeof(T));
+            ptr += sizeof(T);
+            return true;
+        }
+
+        static bool Skip(const uint8_t*& ptr, const uint8_t* end, size_t count) {
+            if (ptr + count > end) return false;
+            ptr += count;
+            return true;
+        }
+
+        static bool ReadVertex(const uint8_t*& ptr, const uint8_t* end, uint32_t format, uint32_t stride, S3D::Vertex& out) {
+            const uint8_t* start = ptr;
+            int colors = 0, texs = 1;
+            if (format & 0x80000000) {
+                colors = (format >> 8) & 0x3;
+                texs = (format >> 14) & 0x3;
+            } else if (format == 1 || format == 10 || format == 11) {
+                colors = 1;
+                texs = format == 1 ? 0 : format - 9;
+            } else if (format == 3) {
+                texs = 2;
+            }
+
+            if (!Read(ptr, end, out.position.x) || !Read(ptr, end, out.position.y) || !Read(ptr, end, out.position.z)) return false;
+            if (colors > 0) {
+                uint8_t b, g, r, a;
+                if (!Read(ptr, end, b) || !Read(ptr, end, g) || !Read(ptr, end, r) || !Read(ptr, end, a)) return false;
+                out.color = S3D::Vector4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
+            } else {
+                out.color = S3D::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+            }
+            out.uv = S3D::Vector2(0.0f, 0.0f);
+            out.uv2 = S3D::Vector2(0.0f, 0.0f);
+            if (texs > 0 && (!Read(ptr, end, out.uv.x) || !Read(ptr, end, out.uv.y))) return false;
+            if (texs > 1 && (!Read(ptr, end, out.uv2.x) || !Read(ptr, end, out.uv2.y))) return false;
+
+            const size_t used = static_cast<size_t>(ptr - start);
+            return used >= stride || Skip(ptr, end, stride - used);
+        }
+    };
+
+    std::vector<Sample> LoadSamples(int argc, char** argv) {
+        std::vector<Sample> samples;
+        for (int i = 1; i < argc; ++i) {
+            if (argv[i][0] == '-') continue;
+            std::ifstream file(argv[i], std::ios::binary);
+            Sample sample{argv[i], std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {})};
+            S3D::Model model;
+            if (!S3D::Reader::Parse(sample.bytes.data(), sample.bytes.size(), model)) {
+                std::fprintf(stderr, "Skipping %s: not a readable S3D file\n", argv[i]);
+                continue;
+            }
+            for (const auto& vb : model.vertexBuffers) sample.vertexCount += vb.vertices.size();
+            samples.push_back(std::move(sample));
+        }
+        if (!samples.empty()) return samples;
+
+        // Typical building layouts: textured, textured + colored, and a legacy strided format
+        S3DTestModel::Layout textured;
+        textured.hasColor = false;
+        S3DTestModel::Layout colored;
+        S3DTestModel::Layout legacy;
+        legacy.minorVersion = 3;
+        legacy.legacyFormat = 11;
+        legacy.uvSets = 2;
+        legacy.legacyStride = 36;
+
+        const std::pair<const char*, S3DTestModel::Layout> layouts[] = {
+            {"synthetic v1.5 xyz+uv", textured}, {"synthetic v1.5 xyz+bgra+uv", colored}, {"synthetic v1.3 format 11 stride 36", legacy}};
+        for (const auto& [name, layout] : layouts) {
+            auto built = S3DTestModel::Build(layout, 4096, 6144, 42);
+            samples.push_back({name, std::move(built.bytes), built.vertices.size()});
+        }
+        return samples;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = BenchHarness::IsQuick(argc, argv);
+    const int repetitions = quick ? 1 : 9;
+
+    for (const Sample& sample : LoadSamples(argc, argv)) {
+        if (sample.vertexCount == 0) continue;
+        const size_t loops = quick ? 1 : (std::max<size_t>)(1, 4'000'000 / sample.vertexCount);
+        const size_t work = loops * sample.vertexCount;
+        std::printf("%s (%zu vertices)\n", sample.name.c_str(), sample.vertexCount);
+
+        const double before = BenchHarness::Measure("  per-field reads (VERT+INDX only), per vertex", work, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) {
+                std::vector<S3D::Vertex> vertices;
+                std::vector<uint16_t> indices;
+                float bounds = 0.0f;
+                PerFieldReader::Decode(sample.bytes.data(), sample.bytes.size(), vertices, indices, bounds);
+                BenchHarness::DoNotOptimize(vertices.size() + indices.size() + static_cast<size_t>(bounds));
+            }
+        });
+
+        const double after = BenchHarness::Measure("  Reader::Parse (whole model), per vertex", work, repetitions, [&] {
+            for (size_t i = 0; i < loops; ++i) {
+                S3D::Model model;
+                S3D::Reader::Parse(sample.bytes.data(), sample.bytes.size(), model);
+                BenchHarness::DoNotOptimize(model.vertexBuffers.size());
+            }
+        });
+
+        std::printf("  %.1f -> %.1f Mvertices/s\n", 1e3 / before, 1e3 / after);
+    }
+    return 0;
+}
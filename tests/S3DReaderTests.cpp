@@ -0,0 +1,95 @@
+// Tests for the bulk vertex and index decoding in S3D::Reader (s3d/S3DReader.cpp)
+#include <cstdint>
+#include <vector>
+
+#include "S3DTestModel.h"
+#include "TestHarness.h"
+#include "s3d/S3DReader.h"
+
+namespace {
+    bool SameVertex(const S3D::Vertex& a, const S3D::Vertex& b) {
+        return std::memcmp(&a.position, &b.position, sizeof(a.position)) == 0 &&
+               std::memcmp(&a.color, &b.color, sizeof(a.color)) == 0 &&
+               std::memcmp(&a.uv, &b.uv, sizeof(a.uv)) == 0 &&
+               std::memcmp(&a.uv2, &b.uv2, sizeof(a.uv2)) == 0;
+    }
+
+    void CheckDecodes(const S3DTestModel::Layout& layout, uint16_t vertexCount, uint16_t indexCount) {
+        const auto built = S3DTestModel::Build(layout, vertexCount, indexCount, vertexCount * 7u + layout.uvSets);
+        S3D::Model model;
+        CHECK(S3D::Reader::Parse(built.bytes.data(), built.bytes.size(), model));
+        if (model.vertexBuffers.size() != 1 || model.indexBuffers.size() != 1) {
+            CHECK(!"expected one vertex and one index buffer");
+            return;
+        }
+
+        const auto& vertices = model.vertexBuffers[0].vertices;
+        CHECK_EQ(vertices.size(), built.vertices.size());
+        bool same = vertices.size() == built.vertices.size();
+        for (size_t v = 0; same && v < vertices.size(); ++v) same = SameVertex(vertices[v], built.vertices[v]);
+        CHECK(same);
+        CHECK(model.indexBuffers[0].indices == built.indices);
+
+        if (!built.vertices.empty()) {
+            S3D::Vector3 lo = built.vertices[0].position, hi = lo;
+            for (const auto& vert : built.vertices) {
+                lo = S3D::Vector3((std::min)(lo.x, vert.position.x), (std::min)(lo.y, vert.position.y), (std::min)(lo.z, vert.position.z));
+                hi = S3D::Vector3((std::max)(hi.x, vert.position.x), (std::max)(hi.y, vert.position.y), (std::max)(hi.z, vert.position.z));
+            }
+            CHECK(lo.x == model.bbMin.x && lo.y == model.bbMin.y && lo.z == model.bbMin.z);
+            CHECK(hi.x == model.bbMax.x && hi.y == model.bbMax.y && hi.z == model.bbMax.z);
+        }
+    }
+} // namespace
+
+TEST_CASE(DecodesEveryModernLayout) {
+    for (bool hasColor : {false, true}) {
+        for (int uvSets = 0; uvSets <= 3; ++uvSets) {
+            S3DTestModel::Layout layout;
+            layout.hasColor = hasColor;
+            layout.uvSets = uvSets;
+            CheckDecodes(layout, 257, 600);
+        }
+    }
+}
+
+TEST_CASE(DecodesLegacyFormatsWithWideStrides) {
+    struct Legacy { uint16_t format; bool hasColor; int uvSets; };
+    const Legacy formats[] = {{1, true, 0}, {2, false, 1}, {3, false, 2}, {10, true, 1}, {11, true, 2}};
+    for (const Legacy& legacy : formats) {
+        for (uint16_t extra : {0, 4, 13}) {
+            S3DTestModel::Layout layout;
+            layout.minorVersion = 3;
+            layout.legacyFormat = legacy.format;
+            layout.hasColor = legacy.hasColor;
+            layout.uvSets = legacy.uvSets;
+            layout.legacyStride = static_cast<uint16_t>(S3DTestModel::PackedSize(layout) + extra);
+            CheckDecodes(layout, 100, 30);
+        }
+    }
+}
+
+TEST_CASE(ShortLegacyStrideIsTreatedAsPacked) {
+    S3DTestModel::Layout layout;
+    layout.minorVersion = 2;
+    layout.legacyStride = 8;
+    CheckDecodes(layout, 33, 9);
+}
+
+TEST_CASE(EmptyBlocks) {
+    S3DTestModel::Layout layout;
+    CheckDecodes(layout, 0, 0);
+}
+
+TEST_CASE(RejectsTruncatedVertexAndIndexBlocks) {
+    S3DTestModel::Layout layout;
+    const auto built = S3DTestModel::Build(layout, 64, 96, 1);
+
+    // Offsets inside the vertex block and inside the index block
+    const size_t vertexBlockStart = 8 + 12 + 8 + 4 + 8;
+    const size_t indexBlockStart = vertexBlockStart + 64 * S3DTestModel::PackedSize(layout) + 8 + 4 + 6;
+    for (size_t cut : {vertexBlockStart + 1, vertexBlockStart + 64 * 24 - 1, indexBlockStart + 1, indexBlockStart + 191}) {
+        S3D::Model model;
+        CHECK(!S3D::Reader::Parse(built.bytes.data(), cut, model));
+    }
+}
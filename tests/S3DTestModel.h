@@ -0,0 +1,145 @@
+/*
+ * Builds in-memory S3D files (one vertex, index, primitive and material block, one animated
+ * mesh) for the S3D reader tests and benchmark, and records the vertices they should decode to.
+ */
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "s3d/S3DStructures.h"
+
+namespace S3DTestModel {
+    struct Layout {
+        uint16_t minorVersion = 5;
+        bool hasColor = true;
+        int uvSets = 1;           // 0..3; only the first two are decoded
+        uint16_t legacyStride = 0; // v1-v3 only: stride written to the header (0 = packed size)
+        uint16_t legacyFormat = 10;
+    };
+
+    struct Built {
+        std::vector<uint8_t> bytes;
+        std::vector<S3D::Vertex> vertices;
+        std::vector<uint16_t> indices;
+    };
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, T value) {
+        uint8_t raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        out.insert(out.end(), raw, raw + sizeof(T));
+    }
+
+    inline void PutTag(std::vector<uint8_t>& out, const char* tag) {
+        out.insert(out.end(), tag, tag + 4);
+        Put<uint32_t>(out, 0); // Chunk length; the reader doesn't use it
+    }
+
+    inline size_t PackedSize(const Layout& layout) {
+        return 12 + (layout.hasColor ? 4 : 0) + 8 * static_cast<size_t>(layout.uvSets);
+    }
+
+    inline Built Build(const Layout& layout, uint16_t vertexCount, uint16_t indexCount, uint32_t seed) {
+        Built built;
+        std::vector<uint8_t>& out = built.bytes;
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coord(-64.0f, 64.0f);
+
+        out.insert(out.end(), {'3', 'D', 'M', 'D'});
+        Put<uint32_t>(out, 0);
+
+        PutTag(out, "HEAD");
+        Put<uint16_t>(out, 1);
+        Put<uint16_t>(out, layout.minorVersion);
+
+        PutTag(out, "VERT");
+        Put<uint32_t>(out, 1);
+        Put<uint16_t>(out, 0);
+        Put<uint16_t>(out, vertexCount);
+        size_t stride = PackedSize(layout);
+        if (layout.minorVersion >= 4) {
+            Put<uint32_t>(out, 0x80000001u | ((layout.hasColor ? 1u : 0u) << 8) | (static_cast<uint32_t>(layout.uvSets) << 14));
+        } else {
+            Put<uint16_t>(out, layout.legacyFormat);
+            Put<uint16_t>(out, layout.legacyStride);
+            stride = (std::max)(stride, static_cast<size_t>(layout.legacyStride));
+        }
+
+        for (uint16_t v = 0; v < vertexCount; ++v) {
+            const size_t start = out.size();
+            S3D::Vertex vert;
+            vert.position = S3D::Vector3(coord(rng), coord(rng), coord(rng));
+            Put(out, vert.position.x);
+            Put(out, vert.position.y);
+            Put(out, vert.position.z);
+
+            vert.color = S3D::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+            if (layout.hasColor) {
+                const uint8_t b = static_cast<uint8_t>(rng()), g = static_cast<uint8_t>(rng());
+                const uint8_t r = static_cast<uint8_t>(rng()), a = static_cast<uint8_t>(rng());
+                out.insert(out.end(), {b, g, r, a});
+                vert.color = S3D::Vector4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
+            }
+
+            vert.uv = S3D::Vector2(0.0f, 0.0f);
+            vert.uv2 = S3D::Vector2(0.0f, 0.0f);
+            for (int set = 0; set < layout.uvSets; ++set) {
+                const S3D::Vector2 uv(coord(rng) / 64.0f, coord(rng) / 64.0f);
+                Put(out, uv.x);
+                Put(out, uv.y);
+                if (set == 0) vert.uv = uv;
+                if (set == 1) vert.uv2 = uv;
+            }
+
+            out.resize(start + stride, 0xEE); // Fields the reader skips
+            built.vertices.push_back(vert);
+        }
+
+        PutTag(out, "INDX");
+        Put<uint32_t>(out, 1);
+        Put<uint16_t>(out, 0);
+        Put<uint16_t>(out, 2);
+        Put<uint16_t>(out, indexCount);
+        for (uint16_t i = 0; i < indexCount; ++i) {
+            const uint16_t index = vertexCount ? static_cast<uint16_t>(rng() % vertexCount) : 0;
+            Put(out, index);
+            built.indices.push_back(index);
+        }
+
+        PutTag(out, "PRIM");
+        Put<uint32_t>(out, 1);
+        Put<uint16_t>(out, 1);
+        Put<uint32_t>(out, 0);
+        Put<uint32_t>(out, 0);
+        Put<uint32_t>(out, indexCount);
+
+        PutTag(out, "MATS");
+        Put<uint32_t>(out, 1);
+        Put<uint32_t>(out, S3D::MAT_TEXTURE | S3D::MAT_DEPTH_TEST);
+        out.insert(out.end(), {7, 3, 1, 0});
+        Put<uint16_t>(out, 0x8000);
+        Put<uint32_t>(out, 0);
+        out.insert(out.end(), {0, 1}); // Reserved, one texture
+        Put<uint32_t>(out, 0x12345678);
+        out.insert(out.end(), {0, 0});
+        if (layout.minorVersion == 5) out.insert(out.end(), {1, 1});
+        Put<uint16_t>(out, 0);
+        Put<uint16_t>(out, 0);
+        out.push_back(0);
+
+        PutTag(out, "ANIM");
+        Put<uint16_t>(out, 1);
+        Put<uint16_t>(out, 0);
+        Put<uint16_t>(out, 0);
+        Put<uint32_t>(out, 0);
+        Put<float>(out, 0.0f);
+        Put<uint16_t>(out, 1);
+        out.insert(out.end(), {5, 0, 'm', 'e', 's', 'h', '\0'});
+        for (int i = 0; i < 4; ++i) Put<uint16_t>(out, 0);
+
+        return built;
+    }
+} // namespace S3DTestModel
@@ -0,0 +1,131 @@
+// Tests for the GPU vertex packing in s3d/S3DVertexPacking.h: UNORM8 colour conversion and the
+// byte layout the D3D11 input layout reads
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "TestHarness.h"
+#include "s3d/S3DVertexPacking.h"
+
+namespace {
+    float ReadFloat(const uint8_t* bytes, size_t offset) {
+        float value;
+        std::memcpy(&value, bytes + offset, sizeof(value));
+        return value;
+    }
+
+    S3D::Vertex MakeVertex(float seed) {
+        S3D::Vertex v;
+        v.position = S3D::Vector3(seed, -2.0f * seed, seed + 0.25f);
+        v.color = S3D::Vector4(0.0f, 64.0f / 255.0f, 128.0f / 255.0f, 1.0f);
+        v.uv = S3D::Vector2(seed * 0.5f, 1.0f - seed);
+        v.uv2 = S3D::Vector2(99.0f, 99.0f); // Not uploaded
+        return v;
+    }
+} // namespace
+
+TEST_CASE(Unorm8RoundTripsEveryByte) {
+    // The S3D reader turns each BGRA byte into byte / 255.0f; packing must give the byte back
+    int mismatches = 0;
+    for (int i = 0; i < 256; ++i) {
+        if (S3D::PackUnorm8(static_cast<float>(i) / 255.0f) != i) ++mismatches;
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST_CASE(Unorm8RoundsToNearest) {
+    int mismatches = 0;
+    for (int i = 0; i < 256; ++i) {
+        const float below = (static_cast<float>(i) - 0.49f) / 255.0f;
+        const float above = (static_cast<float>(i) + 0.49f) / 255.0f;
+        if (i > 0 && S3D::PackUnorm8(below) != i) ++mismatches;
+        if (i < 255 && S3D::PackUnorm8(above) != i) ++mismatches;
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(S3D::PackUnorm8(0.5f), uint8_t(128));
+}
+
+TEST_CASE(Unorm8ClampsOutOfRangeInput) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    CHECK_EQ(S3D::PackUnorm8(nan), uint8_t(0));
+    CHECK_EQ(S3D::PackUnorm8(-nan), uint8_t(0));
+    CHECK_EQ(S3D::PackUnorm8(std::numeric_limits<float>::signaling_NaN()), uint8_t(0));
+
+    CHECK_EQ(S3D::PackUnorm8(-0.0f), uint8_t(0));
+    CHECK_EQ(S3D::PackUnorm8(-1e-30f), uint8_t(0));
+    CHECK_EQ(S3D::PackUnorm8(-0.5f), uint8_t(0));
+    CHECK_EQ(S3D::PackUnorm8(-inf), uint8_t(0));
+    CHECK_EQ(S3D::PackUnorm8(std::numeric_limits<float>::denorm_min()), uint8_t(0));
+
+    CHECK_EQ(S3D::PackUnorm8(1.0f), uint8_t(255));
+    CHECK_EQ(S3D::PackUnorm8(std::nextafter(1.0f, 2.0f)), uint8_t(255));
+    CHECK_EQ(S3D::PackUnorm8(1.5f), uint8_t(255));
+    CHECK_EQ(S3D::PackUnorm8(256.0f), uint8_t(255));
+    CHECK_EQ(S3D::PackUnorm8(std::numeric_limits<float>::max()), uint8_t(255));
+    CHECK_EQ(S3D::PackUnorm8(inf), uint8_t(255));
+}
+
+TEST_CASE(PackedVertexMatchesTheInputLayout) {
+    // POSITION R32G32B32_FLOAT @0, COLOR R8G8B8A8_UNORM @12, TEXCOORD0 R32G32_FLOAT @16, stride 24
+    CHECK_EQ(sizeof(S3D::PackedVertex), size_t(24));
+    CHECK_EQ(offsetof(S3D::PackedVertex, position), size_t(0));
+    CHECK_EQ(offsetof(S3D::PackedVertex, color), size_t(12));
+    CHECK_EQ(offsetof(S3D::PackedVertex, uv), size_t(16));
+    CHECK(std::is_standard_layout_v<S3D::PackedVertex>);
+    CHECK(std::is_trivially_copyable_v<S3D::PackedVertex>);
+
+    // The bytes the GPU reads: floats in order, then colour bytes in R, G, B, A order
+    S3D::Vertex v;
+    v.position = S3D::Vector3(1.5f, -2.25f, 3.0f);
+    v.color = S3D::Vector4(10.0f / 255.0f, 20.0f / 255.0f, 30.0f / 255.0f, 40.0f / 255.0f);
+    v.uv = S3D::Vector2(0.125f, 0.875f);
+    const S3D::PackedVertex packed = S3D::PackVertex(v);
+
+    uint8_t bytes[sizeof(S3D::PackedVertex)];
+    std::memcpy(bytes, &packed, sizeof(bytes));
+    CHECK_EQ(ReadFloat(bytes, 0), 1.5f);
+    CHECK_EQ(ReadFloat(bytes, 4), -2.25f);
+    CHECK_EQ(ReadFloat(bytes, 8), 3.0f);
+    CHECK_EQ(bytes[12], uint8_t(10));
+    CHECK_EQ(bytes[13], uint8_t(20));
+    CHECK_EQ(bytes[14], uint8_t(30));
+    CHECK_EQ(bytes[15], uint8_t(40));
+    CHECK_EQ(ReadFloat(bytes, 16), 0.125f);
+    CHECK_EQ(ReadFloat(bytes, 20), 0.875f);
+}
+
+TEST_CASE(PackVerticesKeepsOrderAndReusesStorage) {
+    std::vector<S3D::Vertex> vertices;
+    for (int i = 0; i < 100; ++i) vertices.push_back(MakeVertex(static_cast<float>(i)));
+
+    std::vector<S3D::PackedVertex> packed;
+    S3D::PackVertices(vertices, packed);
+    CHECK_EQ(packed.size(), vertices.size());
+    bool same = packed.size() == vertices.size();
+    for (size_t i = 0; same && i < packed.size(); ++i) {
+        const S3D::PackedVertex expected = S3D::PackVertex(vertices[i]);
+        same = std::memcmp(&packed[i], &expected, sizeof(expected)) == 0;
+    }
+    CHECK(same);
+    CHECK_EQ(packed[7].position[0], 7.0f);
+    CHECK_EQ(packed[7].color[1], uint8_t(64));
+    CHECK_EQ(packed[7].color[2], uint8_t(128));
+    CHECK_EQ(packed[7].uv[1], -6.0f);
+
+    // A smaller block shrinks the output without reallocating
+    const S3D::PackedVertex* storage = packed.data();
+    vertices.resize(10);
+    S3D::PackVertices(vertices, packed);
+    CHECK_EQ(packed.size(), size_t(10));
+    CHECK(packed.data() == storage);
+
+    vertices.clear();
+    S3D::PackVertices(vertices, packed);
+    CHECK(packed.empty());
+}
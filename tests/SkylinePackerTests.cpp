@@ -0,0 +1,126 @@
+// Tests for the atlas rectangle packer (gfx/SkylinePacker.cpp)
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "TestHarness.h"
+#include "gfx/SkylinePacker.h"
+
+namespace {
+    struct Rect {
+        int x, y, w, h;
+    };
+
+    // Every placed rectangle lies on the page and no two share a pixel
+    bool ValidPacking(const std::vector<Rect>& rects, int pageWidth, int pageHeight) {
+        std::vector<uint8_t> covered(static_cast<size_t>(pageWidth) * pageHeight, 0);
+        for (const Rect& r : rects) {
+            if (r.x < 0 || r.y < 0 || r.x + r.w > pageWidth || r.y + r.h > pageHeight) return false;
+            for (int y = r.y; y < r.y + r.h; ++y) {
+                for (int x = r.x; x < r.x + r.w; ++x) {
+                    uint8_t& cell = covered[static_cast<size_t>(y) * pageWidth + x];
+                    if (cell) return false;
+                    cell = 1;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE(PlacesBottomLeftFirst) {
+    gfx::SkylinePacker packer(64, 64);
+    int x = -1, y = -1;
+    CHECK(packer.Insert(32, 16, x, y));
+    CHECK(x == 0 && y == 0);
+    CHECK(packer.Insert(32, 8, x, y));
+    CHECK(x == 32 && y == 0);
+    // Lowest resting place is on top of the shorter rectangle
+    CHECK(packer.Insert(32, 8, x, y));
+    CHECK(x == 32 && y == 8);
+    // Both columns are now 16 high and merged into one segment
+    CHECK(packer.Insert(64, 16, x, y));
+    CHECK(x == 0 && y == 16);
+    CHECK_EQ(packer.GetUsedArea(), size_t(32 * 16 + 32 * 8 * 2 + 64 * 16));
+}
+
+TEST_CASE(FillsAPageOfEqualIconsExactly) {
+    gfx::SkylinePacker packer(128, 128);
+    std::vector<Rect> rects;
+    int x, y;
+    for (int i = 0; i < 64; ++i) {
+        CHECK(packer.Insert(16, 16, x, y));
+        rects.push_back({x, y, 16, 16});
+    }
+    CHECK(!packer.Insert(16, 16, x, y));
+    CHECK(!packer.Insert(1, 1, x, y));
+    CHECK_EQ(packer.GetUsedArea(), size_t(128 * 128));
+    CHECK(ValidPacking(rects, 128, 128));
+}
+
+TEST_CASE(RejectsRectanglesThatCannotFit) {
+    gfx::SkylinePacker packer(32, 16);
+    int x = 7, y = 7;
+    CHECK(!packer.Insert(0, 4, x, y));
+    CHECK(!packer.Insert(4, 0, x, y));
+    CHECK(!packer.Insert(-1, 4, x, y));
+    CHECK(!packer.Insert(33, 4, x, y));
+    CHECK(!packer.Insert(4, 17, x, y));
+    CHECK(x == 7 && y == 7);
+    CHECK_EQ(packer.GetUsedArea(), size_t(0));
+
+    CHECK(packer.Insert(32, 16, x, y));
+    CHECK(!packer.Insert(1, 1, x, y));
+}
+
+TEST_CASE(UsesGapsNextToTallerNeighbours) {
+    gfx::SkylinePacker packer(48, 32);
+    int x, y;
+    CHECK(packer.Insert(16, 32, x, y)); // Full-height column on the left
+    CHECK(packer.Insert(16, 8, x, y));
+    CHECK(x == 16 && y == 0);
+    CHECK(packer.Insert(16, 24, x, y));
+    CHECK(x == 32 && y == 0);
+    // Anything wider than the gap above the short rectangle rests on the 24 px column
+    CHECK(!packer.Insert(17, 9, x, y));
+    CHECK(packer.Insert(16, 24, x, y));
+    CHECK(x == 16 && y == 8);
+}
+
+TEST_CASE(ResetForgetsPlacedRectangles) {
+    gfx::SkylinePacker packer(32, 32);
+    int x, y;
+    CHECK(packer.Insert(32, 32, x, y));
+    CHECK(!packer.Insert(1, 1, x, y));
+
+    packer.Reset();
+    CHECK_EQ(packer.GetUsedArea(), size_t(0));
+    CHECK(packer.Insert(32, 32, x, y));
+    CHECK(x == 0 && y == 0);
+}
+
+TEST_CASE(RandomIconSizesNeverOverlap) {
+    // Icon-like sizes: mostly square, 8..64 px, on a 256 x 256 page until it is full
+    std::mt19937 rng(0x5C4);
+    for (int round = 0; round < 50; ++round) {
+        gfx::SkylinePacker packer(256, 256);
+        std::vector<Rect> rects;
+        size_t area = 0;
+        int failures = 0;
+        while (failures < 20) {
+            const int w = 8 + static_cast<int>(rng() % 57);
+            const int h = rng() % 4 == 0 ? 8 + static_cast<int>(rng() % 57) : w;
+            int x, y;
+            if (!packer.Insert(w, h, x, y)) {
+                ++failures;
+                continue;
+            }
+            rects.push_back({x, y, w, h});
+            area += static_cast<size_t>(w) * h;
+        }
+        CHECK(ValidPacking(rects, 256, 256));
+        CHECK_EQ(packer.GetUsedArea(), area);
+        // Bottom-left skyline packing of similar sizes should use most of the page
+        CHECK(area > 256 * 256 * 6 / 10);
+    }
+}
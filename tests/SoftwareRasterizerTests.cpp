@@ -0,0 +1,485 @@
+// Tests for the CPU thumbnail renderer (s3d/S3DSoftwareRasterizer.cpp): coverage, the top-left
+// fill rule, depth, alpha test and blending, and the SSE2 coverage path against the scalar one
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "S3DTestModel.h"
+#include "TestHarness.h"
+#include "s3d/S3DCamera.h"
+#include "s3d/S3DGLEnums.h"
+#include "s3d/S3DRasterCoverage.h"
+#include "s3d/S3DReader.h"
+#include "s3d/S3DSoftwareRasterizer.h"
+
+namespace {
+    using namespace S3D::EnumMappings;
+
+    constexpr int kSize = 64;
+    constexpr uint8_t kClear = 38; // The renderers' background gray
+    constexpr uint32_t kTextureID = 0x12345678; // The texture S3DTestModel's material refers to
+
+    // A point in thumbnail pixels (y down) with [0, 1] depth, and its vertex color
+    struct Point {
+        float x, y, z;
+        S3D::Vector4 color{1.0f, 1.0f, 1.0f, 1.0f};
+    };
+
+    // 4x4 opaque white 32-bit texture, so a pixel's color is its vertex color
+    std::shared_ptr<const FSH::File> WhiteTexture(uint32_t) {
+        auto file = std::make_shared<FSH::File>();
+        FSH::Bitmap bitmap;
+        bitmap.code = FSH::CODE_32BIT;
+        bitmap.width = 4;
+        bitmap.height = 4;
+        bitmap.data.assign(4 * 4 * 4, 0xFF);
+        file->bitmaps.push_back(std::move(bitmap));
+        return file;
+    }
+
+    // Model parsed from an S3DTestModel file, emptied so each test places its own triangles in
+    // screen space. Every Draw() becomes one animated mesh, rendered in the order added.
+    class Scene {
+    public:
+        Scene() {
+            const auto built = S3DTestModel::Build(S3DTestModel::Layout{}, 3, 3, 1);
+            m_parsed = S3D::Reader::Parse(built.bytes.data(), built.bytes.size(), m_model);
+            m_template = m_model.materials.empty() ? S3D::Material{} : m_model.materials[0];
+            m_model.vertexBuffers.clear();
+            m_model.indexBuffers.clear();
+            m_model.primitiveBlocks.clear();
+            m_model.materials.clear();
+            m_model.animation.animatedMeshes.clear();
+
+            // Fixed bounds, so the camera (and with it the screen mapping) is known up front
+            m_model.bbMin = S3D::Vector3(-16.0f, -16.0f, -16.0f);
+            m_model.bbMax = S3D::Vector3(16.0f, 16.0f, 16.0f);
+            m_camera = S3D::ComputeThumbnailCamera(m_model.bbMin, m_model.bbMax);
+        }
+
+        bool Parsed() const { return m_parsed && !m_template.textures.empty(); }
+
+        // Opaque, textured (nearest filtering), no tests: what a material without flags draws
+        S3D::Material Material(uint32_t flags = 0) const {
+            S3D::Material mat = m_template;
+            mat.flags = S3D::MAT_TEXTURE | flags;
+            mat.alphaFunc = GL_ALWAYS;
+            mat.alphaThreshold = 0.5f;
+            mat.depthFunc = GL_LEQUAL;
+            mat.srcBlend = GL_SRC_ALPHA;
+            mat.dstBlend = GL_ONE_MINUS_SRC_ALPHA;
+            mat.textures.resize(1);
+            mat.textures[0].textureID = kTextureID;
+            mat.textures[0].minFilter = GL_NEAREST;
+            mat.textures[0].magFilter = GL_NEAREST;
+            return mat;
+        }
+
+        void Draw(const std::vector<Point>& points, const std::vector<uint16_t>& indices, const S3D::Material& mat) {
+            S3D::VertexBuffer vb{};
+            for (const Point& p : points) {
+                S3D::Vertex v;
+                v.position = World(p.x, p.y, p.z);
+                v.color = p.color;
+                vb.vertices.push_back(v);
+            }
+            const auto block = static_cast<uint16_t>(m_model.vertexBuffers.size());
+            m_model.vertexBuffers.push_back(std::move(vb));
+            m_model.indexBuffers.push_back(S3D::IndexBuffer{indices, 0});
+            m_model.primitiveBlocks.emplace_back(); // Empty: the whole index buffer is a triangle list
+            m_model.materials.push_back(mat);
+
+            S3D::AnimatedMesh mesh;
+            mesh.frames.push_back(S3D::Frame{block, block, block, block});
+            m_model.animation.animatedMeshes.push_back(std::move(mesh));
+        }
+
+        void Triangle(const Point& a, const Point& b, const Point& c, const S3D::Material& mat) {
+            Draw({a, b, c}, {0, 1, 2}, mat);
+        }
+
+        // Axis-aligned rectangle as two triangles
+        void Rect(float x0, float y0, float x1, float y1, float z, S3D::Vector4 color, const S3D::Material& mat) {
+            Draw({{x0, y0, z, color}, {x1, y0, z, color}, {x1, y1, z, color}, {x0, y1, z, color}},
+                 {0, 1, 2, 0, 2, 3}, mat);
+        }
+
+        std::vector<uint8_t> Render() const {
+            S3D::SoftwareRasterizer rasterizer;
+            std::vector<uint8_t> rgba;
+            if (!rasterizer.LoadModel(m_model, WhiteTexture) || !rasterizer.RenderThumbnail(kSize, rgba)) {
+                return {};
+            }
+            return rgba;
+        }
+
+    private:
+        // Inverse of the rasterizer's transform: clip = [x y z 1] * viewProj (affine, w = 1)
+        S3D::Vector3 World(float sx, float sy, float z) const {
+            const auto& m = m_camera.viewProj.m;
+            const double clip[3] = {
+                2.0 * sx / kSize - 1.0 - m[3][0],
+                1.0 - 2.0 * sy / kSize - m[3][1],
+                z - m[3][2]
+            };
+            // p * L = clip, with L the upper 3x3; solve with Cramer's rule on the transpose
+            auto det3 = [](double a, double b, double c, double d, double e, double f, double g, double h, double i) {
+                return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+            };
+            const double det = det3(m[0][0], m[1][0], m[2][0], m[0][1], m[1][1], m[2][1], m[0][2], m[1][2], m[2][2]);
+            const double x = det3(clip[0], m[1][0], m[2][0], clip[1], m[1][1], m[2][1], clip[2], m[1][2], m[2][2]) / det;
+            const double y = det3(m[0][0], clip[0], m[2][0], m[0][1], clip[1], m[2][1], m[0][2], clip[2], m[2][2]) / det;
+            const double w = det3(m[0][0], m[1][0], clip[0], m[0][1], m[1][1], clip[1], m[0][2], m[1][2], clip[2]) / det;
+            return S3D::Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(w));
+        }
+
+        S3D::Model m_model{};
+        S3D::Material m_template{};
+        S3D::ThumbnailCamera m_camera{};
+        bool m_parsed = false;
+    };
+
+    const uint8_t* Pixel(const std::vector<uint8_t>& rgba, int x, int y) {
+        return &rgba[(static_cast<size_t>(y) * kSize + x) * 4];
+    }
+
+    bool IsClear(const std::vector<uint8_t>& rgba, int x, int y) {
+        const uint8_t* p = Pixel(rgba, x, y);
+        return p[0] == kClear && p[1] == kClear && p[2] == kClear && p[3] == 255;
+    }
+
+    bool Near(const uint8_t* p, int r, int g, int b, int a) {
+        return std::abs(p[0] - r) <= 1 && std::abs(p[1] - g) <= 1 && std::abs(p[2] - b) <= 1 && std::abs(p[3] - a) <= 1;
+    }
+
+    // Signed distance (in pixels) of a pixel center from the inside of a triangle; positive inside
+    double InsideDistance(const Point& a, const Point& b, const Point& c, double px, double py) {
+        const Point* v[3] = {&a, &b, &c};
+        const double area = (b.x - a.x) * double(c.y - a.y) - (b.y - a.y) * double(c.x - a.x);
+        double distance = 1e9;
+        for (int i = 0; i < 3; ++i) {
+            const Point& p = *v[i];
+            const Point& q = *v[(i + 1) % 3];
+            const double edge = (q.x - p.x) * (py - p.y) - (q.y - p.y) * (px - p.x);
+            const double length = std::hypot(q.x - p.x, q.y - p.y);
+            distance = (std::min)(distance, (area > 0 ? edge : -edge) / length);
+        }
+        return distance;
+    }
+} // namespace
+
+TEST_CASE(RendersAParsedTestModel) {
+    const auto built = S3DTestModel::Build(S3DTestModel::Layout{}, 60, 300, 3);
+    S3D::Model model;
+    CHECK(S3D::Reader::Parse(built.bytes.data(), built.bytes.size(), model));
+
+    S3D::SoftwareRasterizer rasterizer;
+    std::vector<uint8_t> rgba;
+    CHECK(rasterizer.LoadModel(model, WhiteTexture));
+    CHECK(rasterizer.RenderThumbnail(kSize, rgba));
+    CHECK_EQ(rgba.size(), size_t(kSize) * kSize * 4);
+    if (rgba.size() != size_t(kSize) * kSize * 4) return;
+
+    // The camera fits the model, so it covers the middle and leaves the background around it
+    int drawn = 0;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) drawn += IsClear(rgba, x, y) ? 0 : 1;
+    }
+    CHECK(drawn > 0 && drawn < kSize * kSize);
+    CHECK(!IsClear(rgba, kSize / 2, kSize / 2));
+    CHECK(IsClear(rgba, 0, 0));
+
+    // A model without geometry is rejected rather than drawn as background
+    Scene empty;
+    CHECK(empty.Parsed());
+    CHECK(empty.Render().empty());
+}
+
+TEST_CASE(CoversPixelCentersInsideTheTriangle) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-8.0f, kSize + 8.0f);
+    for (int t = 0; t < 40; ++t) {
+        const Point a{coord(rng), coord(rng), 0.5f}, b{coord(rng), coord(rng), 0.5f}, c{coord(rng), coord(rng), 0.5f};
+        Scene scene;
+        scene.Triangle(a, b, c, scene.Material());
+        const auto rgba = scene.Render();
+        if (rgba.empty()) {
+            CHECK(!"render failed");
+            continue;
+        }
+
+        // Pixels within rounding distance of an edge may go either way
+        bool matches = true;
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                const double d = InsideDistance(a, b, c, x + 0.5, y + 0.5);
+                if (d > 1e-3) matches = matches && Near(Pixel(rgba, x, y), 255, 255, 255, 255);
+                if (d < -1e-3) matches = matches && IsClear(rgba, x, y);
+            }
+        }
+        CHECK(matches);
+    }
+}
+
+TEST_CASE(WindingDoesNotMatter) {
+    const Point a{10.3f, 5.7f, 0.5f}, b{50.2f, 20.1f, 0.5f}, c{22.9f, 58.4f, 0.5f};
+    Scene ccw, cw;
+    ccw.Triangle(a, b, c, ccw.Material());
+    cw.Triangle(a, c, b, cw.Material());
+    const auto first = ccw.Render();
+    CHECK(!first.empty());
+    CHECK(first == cw.Render());
+}
+
+// Triangles sharing edges must cover every pixel once: no gaps and no double hits, even where
+// pixel centers lie on the shared edges
+TEST_CASE(TopLeftFillRuleCoversSharedEdgesOnce) {
+    struct Tri { Point a, b, c; };
+    std::vector<Tri> mesh;
+
+    // Grid of quads whose edges and diagonals run through pixel centers
+    constexpr int kCells = 4;
+    constexpr float kOrigin = 8.5f, kCell = 12.0f;
+    auto grid = [&](int i, int j) { return Point{kOrigin + i * kCell, kOrigin + j * kCell, 0.5f}; };
+    for (int j = 0; j < kCells; ++j) {
+        for (int i = 0; i < kCells; ++i) {
+            if ((i + j) % 2 == 0) {
+                mesh.push_back({grid(i, j), grid(i + 1, j), grid(i + 1, j + 1)});
+                mesh.push_back({grid(i, j), grid(i + 1, j + 1), grid(i, j + 1)});
+            } else {
+                mesh.push_back({grid(i, j), grid(i + 1, j), grid(i, j + 1)});
+                mesh.push_back({grid(i + 1, j), grid(i + 1, j + 1), grid(i, j + 1)});
+            }
+        }
+    }
+
+    // Each triangle alone, so overlaps show up as counts above one
+    std::vector<int> hits(size_t(kSize) * kSize, 0);
+    for (const Tri& tri : mesh) {
+        Scene scene;
+        scene.Triangle(tri.a, tri.b, tri.c, scene.Material());
+        const auto rgba = scene.Render();
+        if (rgba.empty()) {
+            CHECK(!"render failed");
+            return;
+        }
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) hits[size_t(y) * kSize + x] += IsClear(rgba, x, y) ? 0 : 1;
+        }
+    }
+
+    const float lo = kOrigin, hi = kOrigin + kCells * kCell;
+    bool once = true;
+    int covered = 0;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            const int h = hits[size_t(y) * kSize + x];
+            const float px = x + 0.5f, py = y + 0.5f;
+            const bool inside = px > lo && px < hi && py > lo && py < hi;
+            const bool outside = px < lo || px > hi || py < lo || py > hi;
+            if (inside) once = once && h == 1;
+            if (outside) once = once && h == 0;
+            covered += h;
+        }
+    }
+    CHECK(once);
+    CHECK(covered > 0);
+}
+
+// Same mesh with exact coordinates, straight through the coverage step: centers on the outer
+// boundary belong to the top and left sides only
+TEST_CASE(TopLeftFillRuleOnExactEdges) {
+    constexpr int kCells = 4;
+    constexpr float kOrigin = 8.5f, kCell = 12.0f;
+    std::vector<int> hits(size_t(kSize) * kSize, 0);
+    auto cover = [&](float x0, float y0, float x1, float y1, float x2, float y2) {
+        float xs[3] = {x0, x1, x2}, ys[3] = {y0, y1, y2};
+        if ((x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0) < 0.0f) {
+            std::swap(xs[1], xs[2]);
+            std::swap(ys[1], ys[2]);
+        }
+        const auto edges = S3D::RasterCoverage::SetupEdges(xs, ys);
+        for (int y = 0; y < kSize; ++y) {
+            const float py = y + 0.5f;
+            const float rowC[3] = {edges.B[0] * py + edges.C[0], edges.B[1] * py + edges.C[1], edges.B[2] * py + edges.C[2]};
+            for (int x = 0; x < kSize; x += 4) {
+                alignas(16) float e[3][4];
+                const int mask = S3D::RasterCoverage::Cover(edges, rowC, x, e);
+                for (int lane = 0; lane < 4; ++lane) hits[size_t(y) * kSize + x + lane] += (mask >> lane) & 1;
+            }
+        }
+    };
+    for (int j = 0; j < kCells; ++j) {
+        for (int i = 0; i < kCells; ++i) {
+            const float x0 = kOrigin + i * kCell, y0 = kOrigin + j * kCell, x1 = x0 + kCell, y1 = y0 + kCell;
+            // Both diagonals, in both windings
+            if ((i + j) % 2 == 0) {
+                cover(x0, y0, x1, y0, x1, y1);
+                cover(x0, y0, x0, y1, x1, y1);
+            } else {
+                cover(x0, y0, x1, y0, x0, y1);
+                cover(x1, y0, x0, y1, x1, y1);
+            }
+        }
+    }
+
+    const int lo = static_cast<int>(kOrigin), hi = static_cast<int>(kOrigin + kCells * kCell);
+    bool once = true;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            const bool inside = x >= lo && x < hi && y >= lo && y < hi; // Top-left in, bottom-right out
+            once = once && hits[size_t(y) * kSize + x] == (inside ? 1 : 0);
+        }
+    }
+    CHECK(once);
+
+    // A lone edge on a pixel center: the left edge of a triangle takes the column, the right
+    // edge of its neighbour doesn't
+    std::fill(hits.begin(), hits.end(), 0);
+    cover(10.5f, 10.5f, 20.5f, 30.5f, 10.5f, 30.5f);
+    CHECK_EQ(hits[size_t(20) * kSize + 10], 1);
+    cover(0.5f, 10.5f, 10.5f, 10.5f, 10.5f, 30.5f);
+    CHECK_EQ(hits[size_t(20) * kSize + 10], 1);
+    // Horizontal edges: the top edge takes the row, the bottom edge doesn't
+    std::fill(hits.begin(), hits.end(), 0);
+    cover(30.5f, 40.5f, 50.5f, 40.5f, 40.5f, 50.5f);
+    CHECK_EQ(hits[size_t(40) * kSize + 40], 1);
+    cover(30.5f, 40.5f, 50.5f, 40.5f, 40.5f, 34.5f);
+    CHECK_EQ(hits[size_t(40) * kSize + 40], 1);
+}
+
+TEST_CASE(DepthTestKeepsTheNearestSurface) {
+    const S3D::Vector4 red{1.0f, 0.0f, 0.0f, 1.0f}, green{0.0f, 1.0f, 0.0f, 1.0f};
+
+    for (bool nearFirst : {true, false}) {
+        Scene scene;
+        const auto mat = scene.Material(S3D::MAT_DEPTH_TEST | S3D::MAT_DEPTH_WRITES);
+        if (nearFirst) {
+            scene.Rect(8, 8, 40, 40, 0.45f, red, mat);
+            scene.Rect(24, 24, 56, 56, 0.55f, green, mat);
+        } else {
+            scene.Rect(24, 24, 56, 56, 0.55f, green, mat);
+            scene.Rect(8, 8, 40, 40, 0.45f, red, mat);
+        }
+        const auto rgba = scene.Render();
+        CHECK(!rgba.empty());
+        if (rgba.empty()) continue;
+        CHECK(Near(Pixel(rgba, 30, 30), 255, 0, 0, 255)); // Overlap: the near red quad wins
+        CHECK(Near(Pixel(rgba, 12, 12), 255, 0, 0, 255));
+        CHECK(Near(Pixel(rgba, 50, 50), 0, 255, 0, 255));
+    }
+
+    // Without depth writes the near quad leaves the depth buffer untouched, so draw order wins
+    Scene noWrites;
+    const auto mat = noWrites.Material(S3D::MAT_DEPTH_TEST);
+    noWrites.Rect(8, 8, 40, 40, 0.45f, red, mat);
+    noWrites.Rect(24, 24, 56, 56, 0.55f, green, mat);
+    const auto rgba = noWrites.Render();
+    CHECK(!rgba.empty());
+    if (!rgba.empty()) CHECK(Near(Pixel(rgba, 30, 30), 0, 255, 0, 255));
+
+    // Depth writes need the depth test, like the D3D11 depth-stencil state
+    Scene writesOnly;
+    writesOnly.Rect(8, 8, 40, 40, 0.45f, red, writesOnly.Material(S3D::MAT_DEPTH_WRITES));
+    writesOnly.Rect(24, 24, 56, 56, 0.55f, green, writesOnly.Material(S3D::MAT_DEPTH_TEST));
+    const auto unwritten = writesOnly.Render();
+    CHECK(!unwritten.empty());
+    if (!unwritten.empty()) CHECK(Near(Pixel(unwritten, 30, 30), 0, 255, 0, 255));
+
+    // GL_GREATER keeps the farther surface instead
+    Scene greater;
+    auto far = greater.Material(S3D::MAT_DEPTH_TEST | S3D::MAT_DEPTH_WRITES);
+    greater.Rect(0, 0, kSize, kSize, 0.05f, S3D::Vector4{0.0f, 0.0f, 0.0f, 1.0f}, far); // Depth buffer near 0
+    far.depthFunc = GL_GREATER;
+    greater.Rect(8, 8, 40, 40, 0.55f, green, far);
+    greater.Rect(8, 8, 40, 40, 0.45f, red, far);
+    const auto farthest = greater.Render();
+    CHECK(!farthest.empty());
+    if (!farthest.empty()) CHECK(Near(Pixel(farthest, 20, 20), 0, 255, 0, 255));
+}
+
+TEST_CASE(AlphaTestDiscardsFailingPixels) {
+    Scene scene;
+    auto mat = scene.Material(S3D::MAT_ALPHA_TEST);
+    mat.alphaFunc = GL_GREATER;
+    scene.Rect(4, 4, 28, 28, 0.5f, S3D::Vector4{1.0f, 0.0f, 0.0f, 0.25f}, mat);  // Fails
+    scene.Rect(36, 4, 60, 28, 0.5f, S3D::Vector4{1.0f, 0.0f, 0.0f, 0.75f}, mat); // Passes
+
+    // Alpha ramp from 0 (left) to 1 (right): only the right half passes
+    scene.Draw({{4, 36, 0.5f, {0, 1, 0, 0}}, {60, 36, 0.5f, {0, 1, 0, 1}},
+                {60, 60, 0.5f, {0, 1, 0, 1}}, {4, 60, 0.5f, {0, 1, 0, 0}}},
+               {0, 1, 2, 0, 2, 3}, mat);
+
+    // Without the flag the function is ignored
+    auto off = scene.Material();
+    off.alphaFunc = GL_NEVER;
+    scene.Rect(30, 30, 34, 34, 0.5f, S3D::Vector4{0.0f, 0.0f, 1.0f, 1.0f}, off);
+
+    const auto rgba = scene.Render();
+    CHECK(!rgba.empty());
+    if (rgba.empty()) return;
+    CHECK(IsClear(rgba, 16, 16));
+    CHECK(Near(Pixel(rgba, 48, 16), 255, 0, 0, 191));
+    CHECK(Near(Pixel(rgba, 32, 32), 0, 0, 255, 255));
+
+    bool ramp = true;
+    for (int x = 4; x < 60; ++x) {
+        const float alpha = (x + 0.5f - 4.0f) / 56.0f;
+        if (alpha < 0.49f) ramp = ramp && IsClear(rgba, x, 48);
+        if (alpha > 0.51f) ramp = ramp && Pixel(rgba, x, 48)[1] == 255;
+    }
+    CHECK(ramp);
+}
+
+TEST_CASE(BlendingMixesWithTheBackground) {
+    Scene scene;
+    const auto blend = scene.Material(S3D::MAT_BLEND);
+    scene.Rect(8, 8, 40, 40, 0.5f, S3D::Vector4{1.0f, 0.0f, 0.0f, 1.0f}, scene.Material());
+    scene.Rect(24, 24, 56, 56, 0.5f, S3D::Vector4{0.0f, 0.0f, 1.0f, 0.5f}, blend);
+
+    const auto rgba = scene.Render();
+    CHECK(!rgba.empty());
+    if (rgba.empty()) return;
+
+    // SRC_ALPHA / ONE_MINUS_SRC_ALPHA on color; alpha takes the source value
+    CHECK(Near(Pixel(rgba, 30, 30), 128, 0, 128, 128));
+    CHECK(Near(Pixel(rgba, 50, 50), 19, 19, 147, 128));
+    CHECK(Near(Pixel(rgba, 12, 12), 255, 0, 0, 255));
+}
+
+TEST_CASE(SSE2CoverageMatchesScalar) {
+#if S3D_RASTERIZER_SSE2
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coef(-64.0f, 64.0f);
+    std::uniform_int_distribution<int> column(-8, 80);
+    int mismatches = 0;
+    for (int trial = 0; trial < 200000; ++trial) {
+        S3D::RasterCoverage::Edges edges{};
+        float rowC[3];
+        const int x = column(rng);
+        for (int i = 0; i < 3; ++i) {
+            edges.A[i] = coef(rng);
+            rowC[i] = coef(rng) * 16.0f;
+            edges.topLeft[i] = (rng() & 1) != 0;
+        }
+        // Integer edges through a pixel center make exact zeros, where only the fill rule decides
+        if (trial % 4 == 0) {
+            const int i = trial / 4 % 3;
+            edges.A[i] = static_cast<float>(static_cast<int>(edges.A[i]));
+            rowC[i] = -edges.A[i] * (static_cast<float>(x + static_cast<int>(rng() % 4)) + 0.5f);
+        }
+
+        alignas(16) float eScalar[3][4], eSSE2[3][4];
+        const int scalar = S3D::RasterCoverage::CoverScalar(edges, rowC, x, eScalar);
+        const int sse2 = S3D::RasterCoverage::CoverSSE2(edges, rowC, x, eSSE2);
+        if (scalar != sse2 || std::memcmp(eScalar, eSSE2, sizeof(eScalar)) != 0) ++mismatches;
+    }
+    CHECK_EQ(mismatches, 0);
+#else
+    std::printf("  (no SSE2 on this target)\n");
+#endif
+}
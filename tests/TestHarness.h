@@ -0,0 +1,61 @@
+/*
+ * Minimal test harness for the OS-independent parts of the plugin.
+ * TEST_CASE registers a function; CHECK/CHECK_EQ record a failure and keep going, so one
+ * run reports every broken expectation. TestMain.cpp runs all cases (or those whose name
+ * contains the first argument) and exits non-zero if any check failed.
+ */
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace TestHarness {
+    struct TestCase {
+        const char* name;
+        void (*run)();
+    };
+
+    inline std::vector<TestCase>& Registry() {
+        static std::vector<TestCase> cases;
+        return cases;
+    }
+
+    inline int& FailureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*run)()) { Registry().push_back({name, run}); }
+    };
+
+    inline void Fail(const char* file, int line, const char* expression) {
+        std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+        ++FailureCount();
+    }
+
+    inline int RunAll(int argc, char** argv) {
+        const char* filter = argc > 1 ? argv[1] : nullptr;
+        int run = 0;
+        for (const TestCase& test : Registry()) {
+            if (filter && !std::strstr(test.name, filter)) continue;
+            const int before = FailureCount();
+            test.run();
+            std::printf("%s %s\n", FailureCount() == before ? "[ ok ]" : "[FAIL]", test.name);
+            ++run;
+        }
+        std::printf("%d test(s), %d failed check(s)\n", run, FailureCount());
+        return FailureCount() == 0 && run > 0 ? 0 : 1;
+    }
+} // namespace TestHarness
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const TestHarness::Registrar name##Registrar(#name, &name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { if (!(condition)) TestHarness::Fail(__FILE__, __LINE__, #condition); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { if (!((actual) == (expected))) TestHarness::Fail(__FILE__, __LINE__, #actual " == " #expected); } while (0)
@@ -0,0 +1,5 @@
+#include "TestHarness.h"
+
+int main(int argc, char** argv) {
+    return TestHarness::RunAll(argc, argv);
+}
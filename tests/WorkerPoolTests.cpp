@@ -0,0 +1,170 @@
+// Tests for the background worker pool (utils/WorkerPool.cpp) and the queue that hands
+// results back (utils/BoundedQueue.h)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "TestHarness.h"
+#include "utils/BoundedQueue.h"
+#include "utils/WorkerPool.h"
+
+namespace {
+    using namespace std::chrono_literals;
+
+    // Long enough for a thread that isn't blocked to have finished
+    constexpr auto kSettle = 50ms;
+
+    // Collects one value per task, so the test can wait for exactly that many
+    struct Results {
+        BoundedQueue<int> queue{1024};
+
+        std::vector<int> Take(size_t count) {
+            std::vector<int> out;
+            const auto deadline = std::chrono::steady_clock::now() + 5s;
+            int value = 0;
+            while (out.size() < count && std::chrono::steady_clock::now() < deadline) {
+                if (queue.TryPop(value)) out.push_back(value);
+                else std::this_thread::sleep_for(1ms);
+            }
+            return out;
+        }
+    };
+} // namespace
+
+TEST_CASE(RunsEverySubmittedTask) {
+    WorkerPool pool(4);
+    CHECK_EQ(pool.GetThreadCount(), size_t(4));
+
+    Results results;
+    for (int i = 0; i < 200; ++i) pool.Submit([&results, i] { results.queue.Push(i); });
+
+    auto values = results.Take(200);
+    std::sort(values.begin(), values.end());
+    bool all = values.size() == 200;
+    for (int i = 0; all && i < 200; ++i) all = values[i] == i;
+    CHECK(all);
+}
+
+TEST_CASE(ThrowingTaskRunsItsFailureHandler) {
+    WorkerPool pool(1);
+    Results results;
+    pool.Submit([] { throw std::runtime_error("corrupt file"); }, [&results] { results.queue.Push(-1); });
+    pool.Submit([] { throw 42; }, [&results] { results.queue.Push(-2); });
+    pool.Submit([] { throw std::bad_alloc(); });
+    // Handlers that throw are caught too, and a successful task never runs its handler
+    pool.Submit([] { throw std::runtime_error("first"); }, [] { throw std::runtime_error("second"); });
+    pool.Submit([&results] { results.queue.Push(1); }, [&results] { results.queue.Push(-3); });
+
+    // The single worker survived every exception
+    CHECK((results.Take(3) == std::vector<int>{-1, -2, 1}));
+    std::this_thread::sleep_for(kSettle);
+    CHECK_EQ(results.queue.Size(), size_t(0));
+}
+
+TEST_CASE(CancelDropsQueuedTasks) {
+    WorkerPool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> ran{0};
+
+    Results results;
+    pool.Submit([&results, released] { results.queue.Push(0); released.wait(); });
+    CHECK_EQ(results.Take(1).size(), size_t(1));   // The worker is now busy
+
+    for (int i = 0; i < 10; ++i) pool.Submit([&ran] { ++ran; });
+    CHECK_EQ(pool.CancelPending(), size_t(10));
+    CHECK_EQ(pool.CancelPending(), size_t(0));
+
+    pool.Submit([&results] { results.queue.Push(1); });
+    release.set_value();
+    CHECK((results.Take(1) == std::vector<int>{1}));
+    CHECK_EQ(ran.load(), 0);
+}
+
+TEST_CASE(DestructorDropsUnstartedTasks) {
+    std::atomic<int> ran{0};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> started;
+    std::thread releaser;
+    {
+        WorkerPool pool(1);
+        pool.Submit([&started, released] { started.set_value(); released.wait(); });
+        started.get_future().wait();
+        for (int i = 0; i < 5; ++i) pool.Submit([&ran] { ++ran; });
+
+        // The destructor runs while the first task still blocks the worker
+        releaser = std::thread([&release] {
+            std::this_thread::sleep_for(kSettle);
+            release.set_value();
+        });
+    }
+    releaser.join();
+    CHECK_EQ(ran.load(), 0);
+}
+
+TEST_CASE(QueueIsFirstInFirstOut) {
+    BoundedQueue<int> queue(4);
+    CHECK_EQ(queue.Capacity(), size_t(4));
+    for (int i = 0; i < 4; ++i) CHECK(queue.Push(i));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.TryPop(value));
+        CHECK_EQ(value, i);
+    }
+    CHECK(!queue.TryPop(value));
+    CHECK_EQ(BoundedQueue<int>(0).Capacity(), size_t(1));
+}
+
+TEST_CASE(FullQueueBlocksProducersUntilPopped) {
+    BoundedQueue<int> queue(2);
+    std::atomic<int> pushed{0};
+    std::thread producer([&] {
+        for (int i = 0; i < 5; ++i) {
+            if (queue.Push(i)) ++pushed;
+        }
+    });
+
+    std::this_thread::sleep_for(kSettle);
+    CHECK_EQ(pushed.load(), 2);
+    CHECK_EQ(queue.Size(), size_t(2));
+
+    // Each pop makes room for exactly one more item
+    int value = -1;
+    std::vector<int> popped;
+    while (popped.size() < 5) {
+        if (queue.TryPop(value)) popped.push_back(value);
+        else std::this_thread::sleep_for(1ms);
+        CHECK(queue.Size() <= 2);
+    }
+    producer.join();
+    CHECK((popped == std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST_CASE(ClearAndCloseReleaseBlockedProducers) {
+    BoundedQueue<int> queue(1);
+    CHECK(queue.Push(0));
+
+    std::promise<bool> cleared;
+    std::thread afterClear([&] { cleared.set_value(queue.Push(1)); });
+    std::this_thread::sleep_for(kSettle);
+    queue.Clear();
+    CHECK(cleared.get_future().get());
+    afterClear.join();
+
+    std::promise<bool> closed;
+    std::thread afterClose([&] { closed.set_value(queue.Push(2)); });
+    std::this_thread::sleep_for(kSettle);
+    queue.Close();
+    CHECK(!closed.get_future().get());
+    afterClose.join();
+
+    int value = -1;
+    CHECK(!queue.TryPop(value));
+    CHECK(!queue.Push(3));
+}
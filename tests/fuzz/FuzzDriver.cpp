@@ -0,0 +1,72 @@
+/*
+ * main() for fuzz targets built without libFuzzer. Replays the files given on the command line;
+ * with no arguments, runs a deterministic generated corpus: random buffers, valid streams and
+ * valid streams with a few bytes mutated (the inputs most likely to reach deep decoder paths).
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "s3d/QFSCompressor.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+    constexpr int kGeneratedInputs = 3000;
+
+    std::vector<uint8_t> GenerateInput(std::mt19937& rng) {
+        std::vector<uint8_t> input(rng() % 2048);
+        const uint32_t alphabet = 1 + rng() % 256;
+        for (uint8_t& b : input) b = static_cast<uint8_t>(rng() % alphabet);
+
+        switch (rng() % 3) {
+            case 0:
+                return input;
+            case 1: {
+                // A valid stream, optionally behind a DBPF prefix
+                std::vector<uint8_t> stream;
+                QFS::Compressor::Compress(input.data(), input.size(), stream);
+                if (rng() % 2) stream.insert(stream.begin(), 4, 0);
+                return stream;
+            }
+            default: {
+                std::vector<uint8_t> stream;
+                QFS::Compressor::Compress(input.data(), input.size(), stream);
+                const int mutations = 1 + static_cast<int>(rng() % 4);
+                for (int i = 0; i < mutations && !stream.empty(); ++i) {
+                    stream[rng() % stream.size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+                }
+                if (!stream.empty() && rng() % 4 == 0) stream.resize(rng() % stream.size());
+                return stream;
+            }
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream file(argv[i], std::ios::binary);
+            if (!file) {
+                std::fprintf(stderr, "Cannot read %s\n", argv[i]);
+                return 1;
+            }
+            const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        std::printf("Replayed %d input(s)\n", argc - 1);
+        return 0;
+    }
+
+    std::mt19937 rng(0x51F5);
+    for (int i = 0; i < kGeneratedInputs; ++i) {
+        const std::vector<uint8_t> input = GenerateInput(rng);
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    std::printf("Ran %d generated input(s)\n", kGeneratedInputs);
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Fuzz target for the QFS codec core. Every input is decoded as a bare and as a DBPF-prefixed
+ * stream (which must fail cleanly or stay inside the declared size), then compressed and
+ * decoded again (which must reproduce it exactly).
+ *
+ * With Clang, -DALP_BUILD_FUZZERS=ON links this against libFuzzer. Otherwise FuzzDriver.cpp
+ * supplies main() and replays files or a generated corpus, so ctest runs it as a smoke test.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "s3d/QFSCompressor.h"
+#include "s3d/QFSCore.h"
+
+namespace {
+    // Larger declared sizes are skipped rather than allocated
+    constexpr uint32_t kMaxDecodedSize = 1u << 24;
+
+    void DecodeUntrusted(const uint8_t* data, size_t size, QFS::Framing framing) {
+        QFS::Header header;
+        if (QFS::ParseHeader(data, size, framing, header) != QFS::Status::Ok) return;
+        if (header.headerSize > size || header.uncompressedSize > kMaxDecodedSize) return;
+
+        // Canary bytes after the slack catch writes past what DecodeBody may touch
+        constexpr uint8_t kCanary = 0xA5;
+        std::vector<uint8_t> output(header.uncompressedSize + QFS::OUTPUT_SLACK + 16, kCanary);
+        QFS::DecodeBody(data + header.headerSize, size - header.headerSize, output.data(), header.uncompressedSize);
+        for (size_t i = header.uncompressedSize + QFS::OUTPUT_SLACK; i < output.size(); ++i) {
+            if (output[i] != kCanary) std::abort();
+        }
+    }
+
+    void RoundTrip(const uint8_t* data, size_t size, QFS::CompressionLevel level) {
+        std::vector<uint8_t> compressed;
+        if (!QFS::Compressor::Compress(data, size, compressed, level)) std::abort();
+        if (compressed.size() > QFS::Compressor::GetMaxCompressedSize(size)) std::abort();
+
+        QFS::Header header;
+        if (QFS::ParseHeader(compressed.data(), compressed.size(), QFS::Framing::Bare, header) != QFS::Status::Ok) std::abort();
+        if (header.uncompressedSize != size) std::abort();
+
+        std::vector<uint8_t> decoded(size + QFS::OUTPUT_SLACK);
+        const QFS::Status status = QFS::DecodeBody(compressed.data() + header.headerSize,
+                                                   compressed.size() - header.headerSize, decoded.data(), size);
+        if (status != QFS::Status::Ok) std::abort();
+        if (size && std::memcmp(decoded.data(), data, size) != 0) std::abort();
+    }
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    DecodeUntrusted(data, size, QFS::Framing::Bare);
+    DecodeUntrusted(data, size, QFS::Framing::DBPFPrefix);
+
+    // The first byte picks the level, so the fuzzer explores all of them
+    const auto level = static_cast<QFS::CompressionLevel>(size ? data[0] % 3 : 0);
+    RoundTrip(data, size, level);
+    return 0;
+}
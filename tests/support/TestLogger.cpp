@@ -0,0 +1,32 @@
+// Logger for test and benchmark executables: utils/Logger.cpp needs the MSVC debug sink, so
+// this defines the same interface over a logger that discards everything.
+#include "utils/Logger.h"
+
+#include "spdlog/sinks/null_sink.h"
+
+std::shared_ptr<spdlog::logger> Logger::s_logger = nullptr;
+bool Logger::s_initialized = false;
+std::string Logger::s_logName = "Tests";
+
+std::shared_ptr<spdlog::logger> Logger::Get()
+{
+    if (!s_initialized)
+    {
+        Initialize();
+    }
+    return s_logger;
+}
+
+void Logger::Initialize(const std::string& logName, const std::string&)
+{
+    s_logName = logName;
+    s_logger = std::make_shared<spdlog::logger>(logName, std::make_shared<spdlog::sinks::null_sink_mt>());
+    s_logger->set_level(spdlog::level::off);
+    s_initialized = true;
+}
+
+void Logger::Shutdown()
+{
+    s_logger.reset();
+    s_initialized = false;
+}
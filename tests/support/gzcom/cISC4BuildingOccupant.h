@@ -0,0 +1,15 @@
+/*
+ * Test stand-in for the gzcom-dll header: only the wealth types the lot filters read.
+ */
+#pragma once
+#include <cstdint>
+
+class cISC4BuildingOccupant {
+public:
+    enum class WealthType : uint8_t {
+        None = 0,
+        Low = 1,
+        Medium = 2,
+        High = 3,
+    };
+};
@@ -0,0 +1,15 @@
+/*
+ * Test stand-in for the gzcom-dll header: the compatibility queries LotFilterer calls
+ * when it computes a lot's zone and wealth masks.
+ */
+#pragma once
+#include "cISC4BuildingOccupant.h"
+#include "cISC4ZoneManager.h"
+
+class cISC4LotConfiguration {
+public:
+    virtual ~cISC4LotConfiguration() = default;
+
+    virtual bool IsCompatibleWithZoneType(cISC4ZoneManager::ZoneType zoneType) = 0;
+    virtual bool IsCompatibleWithWealthType(cISC4BuildingOccupant::WealthType wealthType) = 0;
+};
@@ -0,0 +1,28 @@
+/*
+ * Test stand-in for the gzcom-dll header: only the zone types the lot filters read.
+ * Values match the game's (and gzcom-dll's) ZoneType enumeration.
+ */
+#pragma once
+#include <cstdint>
+
+class cISC4ZoneManager {
+public:
+    enum class ZoneType : uint8_t {
+        None = 0,
+        ResidentialLowDensity = 1,
+        ResidentialMediumDensity = 2,
+        ResidentialHighDensity = 3,
+        CommercialLowDensity = 4,
+        CommercialMediumDensity = 5,
+        CommercialHighDensity = 6,
+        Agriculture = 7,
+        IndustrialMediumDensity = 8,
+        IndustrialHighDensity = 9,
+        Military = 10,
+        Airport = 11,
+        Seaport = 12,
+        Spaceport = 13,
+        Landfill = 14,
+        Plopped = 15,
+    };
+};